@@ -21,17 +21,44 @@ greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
 CONFIG += c++11
 CONFIG += no_batch
 
+LIBS += -lsqlite3
+
 TARGET = sosicon
 #TEMPLATE = app
 
 SOURCES += main.cpp\
-    ../../src/byte_order.cpp \
     ../../src/command_line.cpp \
     ../../src/converter_sosi_stat.cpp \
     ../../src/converter_sosi2tsv.cpp \
     ../../src/converter_sosi2xml.cpp \
     ../../src/factory.cpp \
     ../../src/utils.cpp \
+    ../../src/converter_sosi_stream.cpp \
+    ../../src/parquet/snappy.cpp \
+    ../../src/converter_sosi2parquet.cpp \
+    ../../src/arrow/record_batch.cpp \
+    ../../src/arrow/ipc_writer.cpp \
+    ../../src/arrow/feature_table.cpp \
+    ../../src/parquet/thrift_writer.cpp \
+    ../../src/parquet/parquet_writer.cpp \
+    ../../src/gpkg/rtree_loader.cpp \
+    ../../src/converter_sosi2gpkg.cpp \
+    ../../src/gpkg/geopackage.cpp \
+    ../../src/fgb/packed_rtree.cpp \
+    ../../src/fgb/flat_buffer_writer.cpp \
+    ../../src/fgb/flatgeobuf.cpp \
+    ../../src/converter_sosi2fgb.cpp \
+    ../../src/converter_sosi2geojson.cpp \
+    ../../src/feature_fields.cpp \
+    ../../src/ring_builder.cpp \
+    ../../src/geometry_cache.cpp \
+    ../../src/geometry_buffer.cpp \
+    ../../src/file_batch.cpp \
+    ../../src/projection.cpp \
+    ../../src/row_spool.cpp \
+    ../../src/wkb_writer.cpp \
+    ../../src/sosi_cache.cpp \
+    ../../src/mapped_file.cpp \
     ../../src/converter_sosi2psql.cpp \
     ../../src/converter_sosi2shp.cpp \
     ../../src/coordinate_collection.cpp \
@@ -42,12 +69,16 @@ SOURCES += main.cpp\
     ../../src/sosi_origo_ne_ragel.cpp \
     ../../src/sosi_ref_ragel.cpp \
     ../../src/sosi/sosi_element_search.cpp \
+    ../../src/sosi/sosi_element_index.cpp \
+    ../../src/sosi/sosi_element_table.cpp \
     ../../src/sosi/sosi_element.cpp \
     ../../src/sosi/sosi_north_east.cpp \
     ../../src/sosi/sosi_origo_ne.cpp \
     ../../src/sosi/sosi_ref_list.cpp \
     ../../src/sosi/sosi_unit.cpp \
-    ../../src/sosi/sosi_charset_singleton.cpp \
+    ../../src/sosi/sosi_coord_sys.cpp \
+    ../../src/sosi/sosi_header_context.cpp \
+    ../../src/sosi/sosi_charset.cpp \
     ../../src/sosi/sosi_translation_table.cpp \
     ../../src/shape/shapefile.cpp \
     ../../src/logger.cpp \
@@ -58,17 +89,50 @@ HEADERS  += \
     ../../src/common_types.h \
     ../../src/converter_sosi2tsv.h \
     ../../src/converter_sosi2xml.h \
-    ../../src/coordinate.h \
     ../../src/factory.h \
     ../../src/inttypes.h \
     ../../src/utils.h \
+    ../../src/converter_sosi_stream.h \
+    ../../src/parquet/snappy.h \
+    ../../src/converter_sosi2parquet.h \
+    ../../src/arrow/record_batch.h \
+    ../../src/arrow/arrow_types.h \
+    ../../src/arrow/ipc_writer.h \
+    ../../src/arrow/feature_table.h \
+    ../../src/parquet/parquet_types.h \
+    ../../src/parquet/thrift_writer.h \
+    ../../src/parquet/parquet_writer.h \
+    ../../src/gpkg/rtree_loader.h \
+    ../../src/converter_sosi2gpkg.h \
+    ../../src/gpkg/geopackage.h \
+    ../../src/fgb/flatgeobuf_types.h \
+    ../../src/fgb/packed_rtree.h \
+    ../../src/fgb/flat_buffer_writer.h \
+    ../../src/fgb/flatgeobuf.h \
+    ../../src/converter_sosi2fgb.h \
+    ../../src/converter_sosi2geojson.h \
+    ../../src/feature_fields.h \
+    ../../src/ring_builder.h \
+    ../../src/geometry_cache.h \
+    ../../src/geometry_buffer.h \
+    ../../src/file_batch.h \
+    ../../src/projection.h \
+    ../../src/row_spool.h \
+    ../../src/wkb_writer.h \
+    ../../src/sosi_cache.h \
+    ../../src/feature_event.h \
+    ../../src/mapped_file.h \
     ../../src/parser.h \
     ../../src/sosi/sosi_element_search.h \
+    ../../src/sosi/sosi_element_index.h \
+    ../../src/sosi/sosi_element_table.h \
     ../../src/sosi/sosi_junction_point.h \
     ../../src/sosi/sosi_origo_ne.h \
     ../../src/sosi/sosi_ref_list.h \
     ../../src/sosi/sosi_unit.h \
-    ../../src/sosi/sosi_charset_singleton.h \
+    ../../src/sosi/sosi_coord_sys.h \
+    ../../src/sosi/sosi_header_context.h \
+    ../../src/sosi/sosi_charset.h \
     ../../src/sosi/sosi_translation_table.h \
     ../../src/sosi/sosi_types.h \
     ../../src/sosi/sosi_element.h \
@@ -82,16 +146,13 @@ HEADERS  += \
     ../../src/shape/shapefile_types.h \
     ../../src/shape/shapefile.h \
     ../../src/interface/i_converter.h \
-    ../../src/interface/i_coordinate.h \
+    ../../src/interface/i_batch_writer.h \
     ../../src/interface/i_lookup_table.h \
     ../../src/interface/i_rectangle.h \
     ../../src/interface/i_shape_element_header.h \
     ../../src/interface/i_shape_element.h \
     ../../src/interface/i_shape_header.h \
-    ../../src/interface/i_shapefile_dbf_part.h \
     ../../src/interface/i_shapefile_prj_part.h \
-    ../../src/interface/i_shapefile_shp_part.h \
-    ../../src/interface/i_shapefile_shx_part.h \
     ../../src/interface/i_shapefile.h \
     ../../src/interface/i_sosi_element.h \
     ../../src/interface/i_sosi_head_member.h \
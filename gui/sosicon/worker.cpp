@@ -27,7 +27,7 @@ startConversion( QString cmdStr, QMutex *mutex, bool *cancel ) {
             sosicon::logstream << "*** Conversion completed! ***\n";
         }
     }
-    catch( std::exception ex ) {
+    catch( const std::exception& ex ) {
         sosicon::logstream << ex.what() << "\n";
     }
     sosicon::logstream.removeEventListener( this );
@@ -0,0 +1,134 @@
+/*
+ *  This file is part of the command-line tool sosicon.
+ *  Copyright (C) 2014  Espen Andersen, Norwegian Broadcast Corporation (NRK)
+ *
+ *  This is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __ARROW_TYPES_H__
+#define __ARROW_TYPES_H__
+
+#include <cstddef>
+
+namespace sosicon {
+
+    namespace arrow {
+
+        //! Format version of the IPC metadata
+        const short METADATA_VERSION_V5 = 4;
+
+        //! Message header types
+        /*!
+            The numeric values are in accordance with the Arrow IPC schema (Message.fbs).
+         */
+        enum MessageHeader {
+            message_header_schema          = 1,
+            message_header_dictionaryBatch = 2,
+            message_header_recordBatch     = 3
+        };
+
+        //! Logical types
+        /*!
+            The numeric values are in accordance with the Arrow IPC schema (Schema.fbs).
+         */
+        enum TypeId {
+            type_id_int           =  2,
+            type_id_floatingPoint =  3,
+            type_id_binary        =  4,
+            type_id_utf8          =  5,
+            type_id_date          =  8,
+            type_id_struct        = 13
+        };
+
+        //! Precision of FloatingPoint
+        const short PRECISION_DOUBLE = 2;
+
+        //! Unit of Date
+        const short DATE_UNIT_DAY = 0;
+
+        //! Field ids of table Message
+        enum MessageField {
+            message_version     = 0,
+            message_header_type = 1,
+            message_header      = 2,
+            message_body_length = 3
+        };
+
+        //! Field ids of table Schema
+        enum SchemaField {
+            schema_endianness      = 0,
+            schema_fields          = 1,
+            schema_custom_metadata = 2
+        };
+
+        //! Field ids of table Field
+        enum FieldField {
+            field_name            = 0,
+            field_nullable        = 1,
+            field_type_type       = 2,
+            field_type            = 3,
+            field_dictionary      = 4,
+            field_children        = 5,
+            field_custom_metadata = 6
+        };
+
+        //! Field ids of table KeyValue
+        enum KeyValueField {
+            key_value_key   = 0,
+            key_value_value = 1
+        };
+
+        //! Field ids of table DictionaryEncoding
+        enum DictionaryEncodingField {
+            dictionary_encoding_id         = 0,
+            dictionary_encoding_index_type = 1
+        };
+
+        //! Field ids of table Int
+        enum IntField {
+            int_bit_width = 0,
+            int_is_signed = 1
+        };
+
+        //! Field ids of table RecordBatch
+        enum RecordBatchField {
+            record_batch_length  = 0,
+            record_batch_nodes   = 1,
+            record_batch_buffers = 2
+        };
+
+        //! Field ids of table DictionaryBatch
+        enum DictionaryBatchField {
+            dictionary_batch_id   = 0,
+            dictionary_batch_data = 1
+        };
+
+        //! Field ids of table Footer
+        enum FooterField {
+            footer_version        = 0,
+            footer_schema         = 1,
+            footer_dictionaries   = 2,
+            footer_record_batches = 3
+        };
+
+        //! Size of a serialized FieldNode or Buffer struct (two longs)
+        const size_t FIELD_NODE_SIZE = 16;
+
+        //! Size of a serialized Block struct (long, int, padding, long)
+        const size_t BLOCK_SIZE = 24;
+
+    }; // namespace arrow
+
+}; // namespace sosicon
+
+#endif
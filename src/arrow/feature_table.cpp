@@ -0,0 +1,466 @@
+/*
+ *  This file is part of the command-line tool sosicon.
+ *  Copyright (C) 2014  Espen Andersen, Norwegian Broadcast Corporation (NRK)
+ *
+ *  This is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <algorithm>
+#include <atomic>
+#include <locale>
+#include <sstream>
+#include <thread>
+#include "feature_table.h"
+
+namespace {
+
+    uint32_t loadUint32( const char* p ) {
+        const unsigned char* u = reinterpret_cast<const unsigned char*>( p );
+        return u[ 0 ] | ( u[ 1 ] << 8 ) | ( u[ 2 ] << 16 ) | ( static_cast<uint32_t>( u[ 3 ] ) << 24 );
+    }
+
+    uint16_t loadUint16( const char* p ) {
+        const unsigned char* u = reinterpret_cast<const unsigned char*>( p );
+        return static_cast<uint16_t>( u[ 0 ] | ( u[ 1 ] << 8 ) );
+    }
+
+    //! Find attribute value of encoded feature
+    /*!
+        \param p Encoded feature.
+        \param column Column index.
+        \param size Receives the number of bytes.
+        \return First byte of value, or 0 if the feature has no value for the column.
+     */
+    const char* findValue( const char* p, uint16_t column, size_t& size ) {
+        p += 4 + loadUint32( p );
+        uint16_t count = loadUint16( p );
+        p += 2;
+        for( uint16_t i = 0; i < count; i++ ) {
+            size = loadUint32( p + 2 );
+            if( loadUint16( p ) == column ) {
+                return p + 6;
+            }
+            p += 6 + size;
+        }
+        return 0;
+    }
+
+    //! Integer without leading zeros that fits in 64 bits
+    bool isInteger( const std::string& v ) {
+        size_t i = !v.empty() && v[ 0 ] == '-' ? 1 : 0;
+        size_t digits = v.size() - i;
+        if( digits == 0 || digits > 18 || ( digits > 1 && v[ i ] == '0' ) ) {
+            return false;
+        }
+        for( ; i < v.size(); i++ ) {
+            if( v[ i ] < '0' || v[ i ] > '9' ) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    //! Decimal number without leading zeros in the integer part
+    bool isDecimal( const std::string& v ) {
+        std::string::size_type dot = v.find( '.' );
+        if( dot == std::string::npos ) {
+            return isInteger( v );
+        }
+        if( !isInteger( v.substr( 0, dot ) ) || dot + 1 == v.size() ) {
+            return false;
+        }
+        for( size_t i = dot + 1; i < v.size(); i++ ) {
+            if( v[ i ] < '0' || v[ i ] > '9' ) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    //! Parse digits
+    int digits( const char* p, size_t count ) {
+        int n = 0;
+        for( size_t i = 0; i < count; i++ ) {
+            n = n * 10 + ( p[ i ] - '0' );
+        }
+        return n;
+    }
+
+    //! Valid date, YYYYMMDD
+    bool isDate( const std::string& v ) {
+        if( v.size() != 8 || v[ 0 ] == '0' ) {
+            return false;
+        }
+        for( size_t i = 0; i < 8; i++ ) {
+            if( v[ i ] < '0' || v[ i ] > '9' ) {
+                return false;
+            }
+        }
+        static const int daysInMonth[ 12 ] = { 31, 29, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+        int y = digits( &v[ 0 ], 4 );
+        int m = digits( &v[ 4 ], 2 );
+        int d = digits( &v[ 6 ], 2 );
+        bool leap = ( y % 4 == 0 && y % 100 != 0 ) || y % 400 == 0;
+        return m >= 1 && m <= 12 && d >= 1 && d <= daysInMonth[ m - 1 ] && ( m != 2 || d <= 28 || leap );
+    }
+
+    //! Days since 1970-01-01 of date YYYYMMDD
+    int32_t daysSinceEpoch( const char* p ) {
+        int y = digits( p, 4 );
+        int m = digits( p + 4, 2 );
+        int d = digits( p + 6, 2 );
+        y -= m <= 2 ? 1 : 0;
+        int era = y / 400;
+        int yoe = y - era * 400;
+        int doy = ( 153 * ( m + ( m > 2 ? -3 : 9 ) ) + 2 ) / 5 + d - 1;
+        int doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+        return era * 146097 + doe - 719468;
+    }
+
+    //! Parse integer, as validated by isInteger()
+    int64_t parseInteger( const char* p, size_t size ) {
+        bool negative = size > 0 && *p == '-';
+        int64_t n = 0;
+        for( size_t i = negative ? 1 : 0; i < size; i++ ) {
+            n = n * 10 + ( p[ i ] - '0' );
+        }
+        return negative ? -n : n;
+    }
+
+    const char* const geometryTypeNames[ 4 ] = { "", "Point", "LineString", "Polygon" };
+
+};
+
+sosicon::arrow::ColumnType sosicon::arrow::FeatureTable::Column::
+type() const {
+    if( mCount == 0 ) {
+        return column_type_utf8;
+    }
+    else if( mDate ) {
+        return column_type_date32;
+    }
+    else if( mInt ) {
+        return column_type_int64;
+    }
+    else if( mFloat ) {
+        return column_type_float64;
+    }
+    return column_type_utf8;
+}
+
+bool sosicon::arrow::FeatureTable::Column::
+dictionary() const {
+    return type() == column_type_utf8 && !mOverflow && mCount > 0 && mValues.size() * 2 <= mCount;
+}
+
+sosicon::arrow::FeatureTable::
+FeatureTable( const std::string& fileName, int srid ) :
+    mFileName( fileName ),
+    mSpoolName( fileName + ".spool" ),
+    mSrid( srid ),
+    mSpoolSize( 0 ) {
+    mSpool.open( mSpoolName.c_str(), std::ios::out | std::ios::trunc | std::ios::binary );
+    mExtent.minX = mExtent.minY = +9999999999;
+    mExtent.maxX = mExtent.maxY = -9999999999;
+    mExtent.offset = 0;
+    std::fill( mGeometryTypes, mGeometryTypes + 4, false );
+}
+
+sosicon::arrow::FeatureTable::
+~FeatureTable() {
+    if( mSpool.is_open() ) {
+        mSpool.close();
+    }
+    std::remove( mSpoolName.c_str() );
+}
+
+uint16_t sosicon::arrow::FeatureTable::
+columnIndex( const std::string& name ) {
+    std::map<std::string, uint16_t>::iterator i = mColumnIndex.find( name );
+    if( i != mColumnIndex.end() ) {
+        return i->second;
+    }
+    uint16_t index = static_cast<uint16_t>( mColumns.size() );
+    mColumns.push_back( Column( name ) );
+    mColumnIndex[ name ] = index;
+    return index;
+}
+
+void sosicon::arrow::FeatureTable::
+encodeFeature( WkbWriter& wkb, Wkt geometryType,
+               const GeometryBuffer& geom, const GeometryBuffer& holes,
+               const fgb::Properties& properties, std::string& out ) {
+
+    wkb.clear();
+    wkb.writeHeader( geometryType );
+    switch( geometryType ) {
+        case wkt_point:
+            wkb.writeCoordinate( geom.x( 0 ), geom.y( 0 ) );
+            break;
+        case wkt_linestring:
+            wkb.writePoints( geom );
+            break;
+        case wkt_polygon:
+            wkb.writeCount( 1 + holes.numParts() );
+            wkb.writePoints( geom );
+            for( size_t k = 0; k < holes.numParts(); k++ ) {
+                wkb.writePoints( holes, holes.partBegin( k ), holes.partEnd( k ) );
+            }
+            break;
+        default:
+            break;
+    }
+
+    // WKB size and WKB, then column index, value length and value of each attribute
+    char buf[ 6 ];
+    byteOrder::toLittleEndian( static_cast<uint32_t>( wkb.data().size() ), buf );
+    out.append( buf, 4 );
+    out += wkb.data();
+    size_t countPos = out.size();
+    uint16_t count = 0;
+    out.append( 2, '\0' );
+    for( fgb::Properties::const_iterator i = properties.begin(); i != properties.end(); i++ ) {
+        if( i->second.empty() ) {
+            continue;
+        }
+        byteOrder::toLittleEndian( i->first, buf );
+        byteOrder::toLittleEndian( static_cast<uint32_t>( i->second.size() ), buf + 2 );
+        out.append( buf, 6 );
+        out += i->second;
+        count++;
+    }
+    byteOrder::toLittleEndian( count, &out[ countPos ] );
+}
+
+void sosicon::arrow::FeatureTable::
+append( const char* data, size_t size, const fgb::NodeItem& box, Wkt geometryType ) {
+    mSpool.write( data, size );
+    fgb::NodeItem item = box;
+    item.offset = mSpoolSize;
+    mItems.push_back( item );
+    mExtent.expand( box );
+    mSpoolSize += size;
+    mGeometryTypes[ geometryType ] = true;
+
+    // Column statistics
+    const char* p = data + 4 + loadUint32( data );
+    uint16_t count = loadUint16( p );
+    p += 2;
+    for( uint16_t i = 0; i < count; i++ ) {
+        Column& col = mColumns[ loadUint16( p ) ];
+        std::string value( p + 6, loadUint32( p + 2 ) );
+        p += 6 + value.size();
+        col.mCount++;
+        col.mDate = col.mDate && isDate( value );
+        col.mInt = col.mInt && isInteger( value );
+        col.mFloat = col.mFloat && isDecimal( value );
+        if( !col.mOverflow ) {
+            std::pair<std::unordered_map<std::string, int32_t>::iterator, bool> ins =
+                col.mIndex.insert( std::make_pair( value, static_cast<int32_t>( col.mValues.size() ) ) );
+            if( ins.second ) {
+                col.mValues.push_back( value );
+                if( col.mValues.size() > MAX_DICTIONARY_SIZE ) {
+                    col.mOverflow = true;
+                    std::unordered_map<std::string, int32_t>().swap( col.mIndex );
+                    std::vector<std::string>().swap( col.mValues );
+                }
+            }
+        }
+    }
+}
+
+void sosicon::arrow::FeatureTable::
+buildSchema( Schema& schema, std::vector<Array>& dictionaries ) {
+
+    std::string crs = Projection( mSrid ).projJson();
+    if( crs.empty() ) {
+        sosicon::logstream << "No CRS definition for EPSG:" << mSrid << ", CRS left unknown\n";
+    }
+
+    Field geometry( "geometry", column_type_binary, false );
+    geometry.mMetadata.push_back( std::make_pair( "ARROW:extension:name", "geoarrow.wkb" ) );
+    geometry.mMetadata.push_back( std::make_pair( "ARROW:extension:metadata",
+                                                  crs.empty() ? "{}" : "{\"crs\":" + crs + ",\"crs_type\":\"projjson\"}" ) );
+    schema.mFields.push_back( geometry );
+
+    // Bounding box covering, for row group filtering
+    static const char* const bboxNames[ 4 ] = { "xmin", "ymin", "xmax", "ymax" };
+    Field bbox( "bbox", column_type_struct, false );
+    for( int i = 0; i < 4; i++ ) {
+        bbox.mChildren.push_back( Field( bboxNames[ i ], column_type_float64, false ) );
+    }
+    schema.mFields.push_back( bbox );
+
+    for( std::vector<Column>::iterator c = mColumns.begin(); c != mColumns.end(); c++ ) {
+        Field field( c->mName, c->type() );
+        if( c->dictionary() ) {
+            field.mDictionary = static_cast<int>( dictionaries.size() );
+            ArrayBuilder builder( true );
+            for( std::vector<std::string>::iterator v = c->mValues.begin(); v != c->mValues.end(); v++ ) {
+                builder.appendBytes( v->data(), v->size() );
+            }
+            dictionaries.push_back( Array() );
+            builder.finish( dictionaries.back() );
+        }
+        schema.mFields.push_back( field );
+    }
+
+    // GeoParquet metadata, also understood by readers of GeoArrow in Arrow IPC files
+    std::ostringstream geo;
+    geo.imbue( std::locale::classic() );
+    geo.precision( 15 );
+    geo << "{\"version\":\"1.1.0\",\"primary_column\":\"geometry\",\"columns\":{\"geometry\":{"
+        << "\"encoding\":\"WKB\",\"geometry_types\":[";
+    const char* sep = "";
+    for( int i = wkt_point; i <= wkt_polygon; i++ ) {
+        if( mGeometryTypes[ i ] ) {
+            geo << sep << "\"" << geometryTypeNames[ i ] << "\"";
+            sep = ",";
+        }
+    }
+    geo << "],\"crs\":" << ( crs.empty() ? "null" : crs );
+    if( !mItems.empty() ) {
+        geo << ",\"bbox\":[" << mExtent.minX << "," << mExtent.minY << "," << mExtent.maxX << "," << mExtent.maxY << "]";
+    }
+    geo << ",\"covering\":{\"bbox\":{";
+    for( int i = 0; i < 4; i++ ) {
+        geo << ( i > 0 ? "," : "" ) << "\"" << bboxNames[ i ] << "\":[\"bbox\",\"" << bboxNames[ i ] << "\"]";
+    }
+    geo << "}}}}}";
+    schema.mMetadata.push_back( std::make_pair( "geo", geo.str() ) );
+}
+
+void sosicon::arrow::FeatureTable::
+fillColumn( size_t column, const std::vector<const char*>& rows, Array& array ) const {
+
+    const size_t count = rows.size();
+    if( column == 0 ) {
+        ArrayBuilder builder( true );
+        for( size_t i = 0; i < count; i++ ) {
+            builder.appendBytes( rows[ i ] + 4, loadUint32( rows[ i ] ) );
+        }
+        builder.finish( array );
+        return;
+    }
+    const Column& col = mColumns[ column - 2 ];
+    uint16_t index = static_cast<uint16_t>( column - 2 );
+    ColumnType type = col.type();
+    bool dictionary = col.dictionary();
+    ArrayBuilder builder( type == column_type_utf8 && !dictionary );
+    std::istringstream ss;
+    ss.imbue( std::locale::classic() );
+    for( size_t i = 0; i < count; i++ ) {
+        size_t size = 0;
+        const char* value = findValue( rows[ i ], index, size );
+        if( !value ) {
+            builder.appendNull( type == column_type_date32 || dictionary ? 4 : type == column_type_utf8 ? 0 : 8 );
+            continue;
+        }
+        if( dictionary ) {
+            builder.append( col.mIndex.find( std::string( value, size ) )->second );
+        }
+        else {
+            switch( type ) {
+                case column_type_date32:
+                    builder.append( daysSinceEpoch( value ) );
+                    break;
+                case column_type_int64:
+                    builder.append( parseInteger( value, size ) );
+                    break;
+                case column_type_float64:
+                    {
+                        double d = 0;
+                        ss.clear();
+                        ss.str( std::string( value, size ) );
+                        ss >> d;
+                        builder.append( d );
+                    }
+                    break;
+                default:
+                    builder.appendBytes( value, size );
+                    break;
+            }
+        }
+    }
+    builder.finish( array );
+}
+
+bool sosicon::arrow::FeatureTable::
+complete( IBatchWriter& writer, int threads ) {
+
+    mSpool.close();
+    Schema schema;
+    std::vector<Array> dictionaries;
+    buildSchema( schema, dictionaries );
+    if( !writer.open( mFileName, schema, dictionaries ) ) {
+        return false;
+    }
+    if( mItems.empty() ) {
+        return writer.close();
+    }
+
+    // Rows in index order, so that each batch covers a compact area
+    fgb::PackedRTree::hilbertSort( mItems, mExtent );
+    MappedFile spool;
+    spool.open( mSpoolName );
+    const size_t columns = schema.mFields.size();
+    const size_t workers = std::min( static_cast<size_t>( std::max( 1, threads ) ), columns );
+    bool ok = true;
+    std::vector<const char*> rows;
+    for( size_t begin = 0; ok && begin < mItems.size(); begin += BATCH_ROWS ) {
+        const size_t end = std::min( mItems.size(), begin + BATCH_ROWS );
+        rows.clear();
+        for( size_t i = begin; i < end; i++ ) {
+            rows.push_back( spool.begin() + mItems[ i ].offset );
+        }
+        RecordBatch batch;
+        batch.mLength = static_cast<int64_t>( end - begin );
+        batch.mColumns.resize( columns );
+
+        // Bounding boxes come from the index, the other columns from the spool
+        Array& bbox = batch.mColumns[ 1 ];
+        bbox.mLength = batch.mLength;
+        bbox.mChildren.resize( 4 );
+        ArrayBuilder builder;
+        for( int k = 0; k < 4; k++ ) {
+            for( size_t i = begin; i < end; i++ ) {
+                const fgb::NodeItem& item = mItems[ i ];
+                builder.append( k == 0 ? item.minX : k == 1 ? item.minY : k == 2 ? item.maxX : item.maxY );
+            }
+            builder.finish( bbox.mChildren[ k ] );
+        }
+
+        std::atomic<size_t> next( 0 );
+        auto fill = [ this, &rows, &batch, &next, columns ]() {
+            for( size_t c = next++; c < columns; c = next++ ) {
+                if( c != 1 ) {
+                    fillColumn( c, rows, batch.mColumns[ c ] );
+                }
+            }
+        };
+        std::vector<std::thread> pool;
+        for( size_t t = 1; t < workers; t++ ) {
+            pool.push_back( std::thread( fill ) );
+        }
+        fill();
+        for( std::vector<std::thread>::iterator t = pool.begin(); t != pool.end(); t++ ) {
+            t->join();
+        }
+        ok = writer.write( batch );
+    }
+    spool.close();
+    if( !ok ) {
+        sosicon::logstream << "Could not write " << mFileName << "\n";
+    }
+    return writer.close() && ok;
+}
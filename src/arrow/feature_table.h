@@ -0,0 +1,177 @@
+/*
+ *  This file is part of the command-line tool sosicon.
+ *  Copyright (C) 2014  Espen Andersen, Norwegian Broadcast Corporation (NRK)
+ *
+ *  This is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __FEATURE_TABLE_H__
+#define __FEATURE_TABLE_H__
+
+#include <stdint.h>
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "../interface/i_batch_writer.h"
+#include "../fgb/flatgeobuf.h"
+#include "../fgb/packed_rtree.h"
+#include "../common_types.h"
+#include "../geometry_buffer.h"
+#include "../logger.h"
+#include "../mapped_file.h"
+#include "../projection.h"
+#include "../wkb_writer.h"
+#include "record_batch.h"
+
+namespace sosicon {
+
+    namespace arrow {
+
+        //! Feature table
+        /*!
+            \author Espen Andersen
+            \copyright GNU General Public License
+
+            Collects features with WKB geometry and attributes, and writes them as Arrow
+            record batches through an IBatchWriter. As with fgb::Flatgeobuf, the encoded
+            features are appended to a spool file next to the output file, while only the
+            bounding box and spool position of each feature are kept in memory.
+
+            The column types are inferred from the values seen: a column is date32 if all
+            values are valid dates (YYYYMMDD), else int64 or float64 if all values are
+            numbers, else UTF-8. Numbers with leading zeros, like municipality numbers, stay
+            text. A UTF-8 column with repeating values is dictionary encoded. Empty values
+            are null.
+
+            complete() sorts the features along a Hilbert curve, so that the bbox statistics
+            of each batch cover a compact area, and fills the columns of each batch from the
+            spool in parallel.
+        */
+        class FeatureTable {
+
+            //! Attribute column and the statistics its type is inferred from
+            struct Column {
+                std::string mName;          //!< Column name
+                size_t mCount;              //!< Number of values
+                bool mInt;                  //!< True if all values are integers
+                bool mFloat;                //!< True if all values are decimal numbers
+                bool mDate;                 //!< True if all values are dates, YYYYMMDD
+                bool mOverflow;             //!< True if there are too many distinct values to track
+                std::vector<std::string> mValues;                   //!< Distinct values, in first-seen order
+                std::unordered_map<std::string, int32_t> mIndex;    //!< Index into mValues, by value
+
+                //! Constructor
+                Column( const std::string& name ) :
+                    mName( name ), mCount( 0 ), mInt( true ), mFloat( true ), mDate( true ), mOverflow( false ) { }
+
+                //! Column type
+                ColumnType type() const;
+
+                //! True if the column is dictionary encoded
+                bool dictionary() const;
+            };
+
+            //! Highest number of distinct values tracked per column
+            static const size_t MAX_DICTIONARY_SIZE = 65536;
+
+            //! Number of rows per record batch
+            static const size_t BATCH_ROWS = 65536;
+
+            std::string mFileName;                      //!< Output file path
+            std::string mSpoolName;                     //!< Spool file path
+            int mSrid;                                  //!< EPSG code of the coordinates, or 0 if unknown
+            std::ofstream mSpool;                       //!< Encoded features, in the order appended
+            uint64_t mSpoolSize;                        //!< Number of bytes written to mSpool
+            std::vector<fgb::NodeItem> mItems;          //!< Bounding box and spool position of each feature
+            fgb::NodeItem mExtent;                      //!< Bounding box of all features
+            bool mGeometryTypes[ 4 ];                   //!< Geometry types seen, by Wkt
+            std::vector<Column> mColumns;               //!< Attribute columns, by column index
+            std::map<std::string, uint16_t> mColumnIndex;   //!< Column index by name
+
+            //! Build schema and dictionaries
+            void buildSchema( Schema& schema, std::vector<Array>& dictionaries );
+
+            //! Fill geometry or attribute column of record batch
+            /*!
+                Thread-safe, for distinct columns.
+                \param column Column index in the schema, other than 1 (bbox).
+                \param rows Spool position of each row of the batch.
+                \param array Receives the values.
+             */
+            void fillColumn( size_t column, const std::vector<const char*>& rows, Array& array ) const;
+
+        public:
+
+            //! Constructor
+            /*!
+                \param fileName Output file path. The spool file gets the extension .spool added.
+                \param srid EPSG code of the coordinates, or 0 if unknown.
+             */
+            FeatureTable( const std::string& fileName, int srid );
+
+            //! Destructor
+            /*!
+                Removes the spool file.
+             */
+            ~FeatureTable();
+
+            //! Encode feature
+            /*!
+                Safe to call from several threads, each with its own WkbWriter.
+                \param wkb Work buffer.
+                \param geometryType Geometry type of the feature.
+                \param geom Point, linestring or outer ring of polygon.
+                \param holes Holes of polygon, one part per ring.
+                \param properties Attribute values, UTF-8, by column index. Empty values are left out.
+                \param out The encoded feature is appended to this string.
+             */
+            static void encodeFeature( WkbWriter& wkb, Wkt geometryType,
+                                       const GeometryBuffer& geom, const GeometryBuffer& holes,
+                                       const fgb::Properties& properties, std::string& out );
+
+            //! Get column index of attribute, adding the column if it is new
+            uint16_t columnIndex( const std::string& name );
+
+            //! Append encoded feature
+            /*!
+                \param data Feature, as built by encodeFeature().
+                \param size Number of bytes.
+                \param box Bounding box of the feature geometry.
+                \param geometryType Geometry type of the feature.
+             */
+            void append( const char* data, size_t size, const fgb::NodeItem& box, Wkt geometryType );
+
+            //! Number of features appended
+            size_t size() const { return mItems.size(); }
+
+            //! Output file path
+            const std::string& fileName() const { return mFileName; }
+
+            //! Write the table
+            /*!
+                \param writer Output format.
+                \param threads Maximum number of threads filling columns.
+                \return False if the output file could not be written.
+             */
+            bool complete( IBatchWriter& writer, int threads );
+
+        }; // class FeatureTable
+
+    }; // namespace arrow
+
+}; // namespace sosicon
+
+#endif
@@ -0,0 +1,330 @@
+/*
+ *  This file is part of the command-line tool sosicon.
+ *  Copyright (C) 2014  Espen Andersen, Norwegian Broadcast Corporation (NRK)
+ *
+ *  This is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "ipc_writer.h"
+
+namespace {
+
+    //! Magic bytes at start and end of file
+    const char MAGIC[ 6 ] = { 'A', 'R', 'R', 'O', 'W', '1' };
+
+    //! Append two longs, as struct FieldNode or Buffer
+    void appendLongPair( std::string& out, int64_t a, int64_t b ) {
+        char buf[ 16 ];
+        sosicon::byteOrder::toLittleEndian( a, &buf[ 0 ] );
+        sosicon::byteOrder::toLittleEndian( b, &buf[ 8 ] );
+        out.append( buf, 16 );
+    }
+
+};
+
+void sosicon::arrow::IpcWriter::
+writeBytes( const char* data, size_t size ) {
+    mFile.write( data, size );
+    mPosition += static_cast<int64_t>( size );
+}
+
+size_t sosicon::arrow::IpcWriter::
+writeKeyValues( fgb::FlatBufferWriter& fb, const KeyValues& keyValues ) const {
+    size_t vec = fb.writeOffsetVector( keyValues.size() );
+    for( size_t i = 0; i < keyValues.size(); i++ ) {
+        fb.addField( key_value_key, 4 );
+        fb.addField( key_value_value, 4 );
+        fgb::FlatBufferWriter::Table t = fb.writeTable();
+        fb.setOffsetAt( vec + 4 + 4 * i, t.mPos );
+        fb.setOffset( t, key_value_key, fb.writeString( keyValues[ i ].first ) );
+        fb.setOffset( t, key_value_value, fb.writeString( keyValues[ i ].second ) );
+    }
+    return vec;
+}
+
+size_t sosicon::arrow::IpcWriter::
+writeField( fgb::FlatBufferWriter& fb, const Field& field ) const {
+
+    fb.addField( field_name, 4 );
+    fb.addField( field_nullable, 1 );
+    fb.addField( field_type_type, 1 );
+    fb.addField( field_type, 4 );
+    if( field.mDictionary >= 0 ) {
+        fb.addField( field_dictionary, 4 );
+    }
+    fb.addField( field_children, 4 );
+    if( !field.mMetadata.empty() ) {
+        fb.addField( field_custom_metadata, 4 );
+    }
+    fgb::FlatBufferWriter::Table t = fb.writeTable();
+    fb.setByte( t, field_nullable, field.mNullable ? 1 : 0 );
+    fb.setOffset( t, field_name, fb.writeString( field.mName ) );
+
+    // Type table
+    fgb::FlatBufferWriter::Table type;
+    switch( field.mType ) {
+        case column_type_int64:
+            fb.setByte( t, field_type_type, type_id_int );
+            fb.addField( int_bit_width, 4 );
+            fb.addField( int_is_signed, 1 );
+            type = fb.writeTable();
+            fb.setScalar( type, int_bit_width, static_cast<int32_t>( 64 ) );
+            fb.setByte( type, int_is_signed, 1 );
+            break;
+        case column_type_float64:
+            fb.setByte( t, field_type_type, type_id_floatingPoint );
+            fb.addField( 0, 2 );
+            type = fb.writeTable();
+            fb.setScalar( type, 0, PRECISION_DOUBLE );
+            break;
+        case column_type_date32:
+            // The default unit is milliseconds, so the unit is always written
+            fb.setByte( t, field_type_type, type_id_date );
+            fb.addField( 0, 2 );
+            type = fb.writeTable();
+            fb.setScalar( type, 0, DATE_UNIT_DAY );
+            break;
+        case column_type_binary:
+            fb.setByte( t, field_type_type, type_id_binary );
+            type = fb.writeTable();
+            break;
+        case column_type_struct:
+            fb.setByte( t, field_type_type, type_id_struct );
+            type = fb.writeTable();
+            break;
+        default:
+            fb.setByte( t, field_type_type, type_id_utf8 );
+            type = fb.writeTable();
+            break;
+    }
+    fb.setOffset( t, field_type, type.mPos );
+
+    if( field.mDictionary >= 0 ) {
+        fb.addField( dictionary_encoding_id, 8 );
+        fb.addField( dictionary_encoding_index_type, 4 );
+        fgb::FlatBufferWriter::Table dict = fb.writeTable();
+        fb.setScalar( dict, dictionary_encoding_id, static_cast<int64_t>( field.mDictionary ) );
+        fb.setOffset( t, field_dictionary, dict.mPos );
+        fb.addField( int_bit_width, 4 );
+        fb.addField( int_is_signed, 1 );
+        fgb::FlatBufferWriter::Table indexType = fb.writeTable();
+        fb.setScalar( indexType, int_bit_width, static_cast<int32_t>( 32 ) );
+        fb.setByte( indexType, int_is_signed, 1 );
+        fb.setOffset( dict, dictionary_encoding_index_type, indexType.mPos );
+    }
+
+    // Readers expect the children vector, also when empty
+    size_t children = fb.writeOffsetVector( field.mChildren.size() );
+    fb.setOffset( t, field_children, children );
+    for( size_t i = 0; i < field.mChildren.size(); i++ ) {
+        fb.setOffsetAt( children + 4 + 4 * i, writeField( fb, field.mChildren[ i ] ) );
+    }
+
+    if( !field.mMetadata.empty() ) {
+        fb.setOffset( t, field_custom_metadata, writeKeyValues( fb, field.mMetadata ) );
+    }
+    return t.mPos;
+}
+
+size_t sosicon::arrow::IpcWriter::
+writeSchema( fgb::FlatBufferWriter& fb ) const {
+    fb.addField( schema_fields, 4 );
+    if( !mSchema->mMetadata.empty() ) {
+        fb.addField( schema_custom_metadata, 4 );
+    }
+    fgb::FlatBufferWriter::Table t = fb.writeTable();
+    size_t fields = fb.writeOffsetVector( mSchema->mFields.size() );
+    fb.setOffset( t, schema_fields, fields );
+    for( size_t i = 0; i < mSchema->mFields.size(); i++ ) {
+        fb.setOffsetAt( fields + 4 + 4 * i, writeField( fb, mSchema->mFields[ i ] ) );
+    }
+    if( !mSchema->mMetadata.empty() ) {
+        fb.setOffset( t, schema_custom_metadata, writeKeyValues( fb, mSchema->mMetadata ) );
+    }
+    return t.mPos;
+}
+
+void sosicon::arrow::IpcWriter::
+addBuffer( const std::string& data ) {
+    appendLongPair( mBuffers, static_cast<int64_t>( mBody.size() ), static_cast<int64_t>( data.size() ) );
+    mBody += data;
+    mBody.append( ( 8 - mBody.size() % 8 ) % 8, '\0' );
+}
+
+void sosicon::arrow::IpcWriter::
+addColumn( const Field& field, const Array& array ) {
+    appendLongPair( mNodes, array.mLength, array.mNullCount );
+    addBuffer( array.mNullCount > 0 ? array.mValidity : std::string() );
+    if( field.mType == column_type_struct ) {
+        for( size_t i = 0; i < field.mChildren.size(); i++ ) {
+            addColumn( field.mChildren[ i ], array.mChildren[ i ] );
+        }
+    }
+    else {
+        if( field.mDictionary < 0 && ( field.mType == column_type_binary || field.mType == column_type_utf8 ) ) {
+            addBuffer( array.mOffsets );
+        }
+        addBuffer( array.mValues );
+    }
+}
+
+size_t sosicon::arrow::IpcWriter::
+writeRecordBatch( fgb::FlatBufferWriter& fb, int64_t length ) const {
+    fb.addField( record_batch_length, 8 );
+    fb.addField( record_batch_nodes, 4 );
+    fb.addField( record_batch_buffers, 4 );
+    fgb::FlatBufferWriter::Table t = fb.writeTable();
+    fb.setScalar( t, record_batch_length, length );
+    fb.setOffset( t, record_batch_nodes, fb.writeStructs( mNodes, mNodes.size() / FIELD_NODE_SIZE, 8 ) );
+    fb.setOffset( t, record_batch_buffers, fb.writeStructs( mBuffers, mBuffers.size() / FIELD_NODE_SIZE, 8 ) );
+    return t.mPos;
+}
+
+sosicon::arrow::IpcWriter::Block sosicon::arrow::IpcWriter::
+writeMessage() {
+    const std::string& meta = mFb.data();
+    size_t padding = ( 8 - meta.size() % 8 ) % 8;
+    Block block;
+    block.mOffset = mPosition;
+    block.mMetaDataLength = static_cast<int32_t>( 8 + meta.size() + padding );
+    block.mBodyLength = static_cast<int64_t>( mBody.size() );
+
+    // Continuation marker and metadata size, then metadata and body
+    char prefix[ 8 ];
+    byteOrder::toLittleEndian( static_cast<uint32_t>( 0xFFFFFFFF ), &prefix[ 0 ] );
+    byteOrder::toLittleEndian( static_cast<int32_t>( meta.size() + padding ), &prefix[ 4 ] );
+    writeBytes( prefix, 8 );
+    writeBytes( meta.data(), meta.size() );
+    writeBytes( std::string( padding, '\0' ).data(), padding );
+    writeBytes( mBody.data(), mBody.size() );
+    return block;
+}
+
+bool sosicon::arrow::IpcWriter::
+open( const std::string& fileName, const Schema& schema, const std::vector<Array>& dictionaries ) {
+    mFile.open( fileName.c_str(), std::ios::out | std::ios::trunc | std::ios::binary );
+    if( !mFile.is_open() ) {
+        sosicon::logstream << "Unable to create " << fileName << "\n";
+        return false;
+    }
+    mSchema = &schema;
+    mPosition = 0;
+    writeBytes( MAGIC, 6 );
+    writeBytes( "\0\0", 2 );
+
+    // Schema message, without body
+    mFb.clear();
+    mFb.addField( message_version, 2 );
+    mFb.addField( message_header_type, 1 );
+    mFb.addField( message_header, 4 );
+    fgb::FlatBufferWriter::Table t = mFb.writeTable();
+    mFb.setScalar( t, message_version, METADATA_VERSION_V5 );
+    mFb.setByte( t, message_header_type, message_header_schema );
+    mFb.setOffset( t, message_header, writeSchema( mFb ) );
+    mFb.setRoot( t );
+    mBody.clear();
+    writeMessage();
+
+    // Dictionary batches, one column of UTF-8 values each
+    Field values( "", column_type_utf8, false );
+    for( size_t i = 0; i < dictionaries.size(); i++ ) {
+        mNodes.clear();
+        mBuffers.clear();
+        mBody.clear();
+        addColumn( values, dictionaries[ i ] );
+        mFb.clear();
+        mFb.addField( message_version, 2 );
+        mFb.addField( message_header_type, 1 );
+        mFb.addField( message_header, 4 );
+        mFb.addField( message_body_length, 8 );
+        t = mFb.writeTable();
+        mFb.setScalar( t, message_version, METADATA_VERSION_V5 );
+        mFb.setByte( t, message_header_type, message_header_dictionaryBatch );
+        mFb.setScalar( t, message_body_length, static_cast<int64_t>( mBody.size() ) );
+        mFb.addField( dictionary_batch_id, 8 );
+        mFb.addField( dictionary_batch_data, 4 );
+        fgb::FlatBufferWriter::Table batch = mFb.writeTable();
+        mFb.setOffset( t, message_header, batch.mPos );
+        mFb.setScalar( batch, dictionary_batch_id, static_cast<int64_t>( i ) );
+        mFb.setOffset( batch, dictionary_batch_data, writeRecordBatch( mFb, dictionaries[ i ].mLength ) );
+        mFb.setRoot( t );
+        mDictionaryBlocks.push_back( writeMessage() );
+    }
+    return mFile.good();
+}
+
+bool sosicon::arrow::IpcWriter::
+write( const RecordBatch& batch ) {
+    mNodes.clear();
+    mBuffers.clear();
+    mBody.clear();
+    for( size_t i = 0; i < mSchema->mFields.size(); i++ ) {
+        addColumn( mSchema->mFields[ i ], batch.mColumns[ i ] );
+    }
+    mFb.clear();
+    mFb.addField( message_version, 2 );
+    mFb.addField( message_header_type, 1 );
+    mFb.addField( message_header, 4 );
+    mFb.addField( message_body_length, 8 );
+    fgb::FlatBufferWriter::Table t = mFb.writeTable();
+    mFb.setScalar( t, message_version, METADATA_VERSION_V5 );
+    mFb.setByte( t, message_header_type, message_header_recordBatch );
+    mFb.setScalar( t, message_body_length, static_cast<int64_t>( mBody.size() ) );
+    mFb.setOffset( t, message_header, writeRecordBatch( mFb, batch.mLength ) );
+    mFb.setRoot( t );
+    mRecordBatchBlocks.push_back( writeMessage() );
+    return mFile.good();
+}
+
+bool sosicon::arrow::IpcWriter::
+close() {
+
+    // End-of-stream marker
+    char eos[ 8 ];
+    byteOrder::toLittleEndian( static_cast<uint32_t>( 0xFFFFFFFF ), &eos[ 0 ] );
+    byteOrder::toLittleEndian( static_cast<int32_t>( 0 ), &eos[ 4 ] );
+    writeBytes( eos, 8 );
+
+    std::string blocks[ 2 ];
+    const std::vector<Block>* lists[ 2 ] = { &mDictionaryBlocks, &mRecordBatchBlocks };
+    for( int k = 0; k < 2; k++ ) {
+        for( std::vector<Block>::const_iterator b = lists[ k ]->begin(); b != lists[ k ]->end(); b++ ) {
+            char buf[ BLOCK_SIZE ] = { 0 };
+            byteOrder::toLittleEndian( b->mOffset, &buf[ 0 ] );
+            byteOrder::toLittleEndian( b->mMetaDataLength, &buf[ 8 ] );
+            byteOrder::toLittleEndian( b->mBodyLength, &buf[ 16 ] );
+            blocks[ k ].append( buf, BLOCK_SIZE );
+        }
+    }
+
+    mFb.clear();
+    mFb.addField( footer_version, 2 );
+    mFb.addField( footer_schema, 4 );
+    mFb.addField( footer_dictionaries, 4 );
+    mFb.addField( footer_record_batches, 4 );
+    fgb::FlatBufferWriter::Table t = mFb.writeTable();
+    mFb.setScalar( t, footer_version, METADATA_VERSION_V5 );
+    mFb.setOffset( t, footer_schema, writeSchema( mFb ) );
+    mFb.setOffset( t, footer_dictionaries, mFb.writeStructs( blocks[ 0 ], mDictionaryBlocks.size(), 8 ) );
+    mFb.setOffset( t, footer_record_batches, mFb.writeStructs( blocks[ 1 ], mRecordBatchBlocks.size(), 8 ) );
+    mFb.setRoot( t );
+
+    const std::string& footer = mFb.data();
+    char size[ 4 ];
+    byteOrder::toLittleEndian( static_cast<int32_t>( footer.size() ), size );
+    writeBytes( footer.data(), footer.size() );
+    writeBytes( size, 4 );
+    writeBytes( MAGIC, 6 );
+    mFile.close();
+    return !mFile.fail();
+}
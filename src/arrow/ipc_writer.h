@@ -0,0 +1,123 @@
+/*
+ *  This file is part of the command-line tool sosicon.
+ *  Copyright (C) 2014  Espen Andersen, Norwegian Broadcast Corporation (NRK)
+ *
+ *  This is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __IPC_WRITER_H__
+#define __IPC_WRITER_H__
+
+#include <stdint.h>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "../interface/i_batch_writer.h"
+#include "../fgb/flat_buffer_writer.h"
+#include "../logger.h"
+#include "../byte_order.h"
+#include "arrow_types.h"
+#include "record_batch.h"
+
+namespace sosicon {
+
+    namespace arrow {
+
+        //! Arrow IPC file writer
+        /*!
+            \author Espen Andersen
+            \copyright GNU General Public License
+
+            Writes the Arrow IPC file format (Feather version 2): the schema message, one
+            dictionary batch per dictionary, the record batches, and a footer locating each
+            of them. The message metadata is serialized with fgb::FlatBufferWriter; the
+            message bodies are the array buffers as they are, padded to 8 bytes.
+         */
+        class IpcWriter : public IBatchWriter {
+
+            //! Location of a message in the file
+            struct Block {
+                int64_t mOffset;            //!< File position of the message
+                int32_t mMetaDataLength;    //!< Size of the prefix and metadata, padding included
+                int64_t mBodyLength;        //!< Size of the message body
+            };
+
+            std::ofstream mFile;                        //!< Output file
+            int64_t mPosition;                          //!< Number of bytes written
+            const Schema* mSchema;                      //!< Table layout
+            std::vector<Block> mDictionaryBlocks;       //!< Dictionary batches written
+            std::vector<Block> mRecordBatchBlocks;      //!< Record batches written
+            fgb::FlatBufferWriter mFb;                  //!< Work buffer for message metadata
+            std::string mBody;                          //!< Work buffer for message body
+            std::string mNodes;                         //!< Work buffer for FieldNode structs
+            std::string mBuffers;                       //!< Work buffer for Buffer structs
+
+            //! Write Schema table
+            size_t writeSchema( fgb::FlatBufferWriter& fb ) const;
+
+            //! Write Field table, including children
+            size_t writeField( fgb::FlatBufferWriter& fb, const Field& field ) const;
+
+            //! Write KeyValue vector
+            size_t writeKeyValues( fgb::FlatBufferWriter& fb, const KeyValues& keyValues ) const;
+
+            //! Add buffer to mBody and mBuffers
+            void addBuffer( const std::string& data );
+
+            //! Add field node and buffers of column, including children
+            void addColumn( const Field& field, const Array& array );
+
+            //! Write RecordBatch table for mNodes and mBuffers
+            size_t writeRecordBatch( fgb::FlatBufferWriter& fb, int64_t length ) const;
+
+            //! Write message with metadata from mFb and body from mBody
+            Block writeMessage();
+
+            //! Append bytes to file
+            void writeBytes( const char* data, size_t size );
+
+        public:
+
+            //! Constructor
+            IpcWriter() : mPosition( 0 ), mSchema( 0 ) { }
+
+            //! Create file and write schema and dictionaries
+            /*!
+                Implementation details in sosicon::IBatchWriter::open()
+                \sa sosicon::IBatchWriter::open()
+             */
+            virtual bool open( const std::string& fileName,
+                               const Schema& schema,
+                               const std::vector<Array>& dictionaries );
+
+            //! Write record batch
+            /*!
+                Implementation details in sosicon::IBatchWriter::write()
+                \sa sosicon::IBatchWriter::write()
+             */
+            virtual bool write( const RecordBatch& batch );
+
+            //! Write footer and close file
+            /*!
+                Implementation details in sosicon::IBatchWriter::close()
+                \sa sosicon::IBatchWriter::close()
+             */
+            virtual bool close();
+
+        }; // class IpcWriter
+
+    }; // namespace arrow
+
+}; // namespace sosicon
+
+#endif
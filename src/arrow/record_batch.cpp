@@ -0,0 +1,101 @@
+/*
+ *  This file is part of the command-line tool sosicon.
+ *  Copyright (C) 2014  Espen Andersen, Norwegian Broadcast Corporation (NRK)
+ *
+ *  This is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "record_batch.h"
+
+const char* sosicon::arrow::Array::
+bytes( int64_t i, size_t& size ) const {
+    int32_t begin = load<int32_t>( &mOffsets[ i * 4 ] );
+    size = static_cast<size_t>( load<int32_t>( &mOffsets[ i * 4 + 4 ] ) - begin );
+    return mValues.data() + begin;
+}
+
+void sosicon::arrow::ArrayBuilder::
+reset( bool variable ) {
+    mArray = Array();
+    mVariable = variable;
+    if( mVariable ) {
+        mArray.mOffsets.assign( 4, '\0' );
+    }
+}
+
+void sosicon::arrow::ArrayBuilder::
+reserve( size_t count, size_t bytes ) {
+    mArray.mValues.reserve( bytes );
+    if( mVariable ) {
+        mArray.mOffsets.reserve( 4 * ( count + 1 ) );
+    }
+}
+
+void sosicon::arrow::ArrayBuilder::
+setValid( bool valid ) {
+    int64_t i = mArray.mLength++;
+    if( !valid && mArray.mValidity.empty() ) {
+        // First null: all values so far are valid
+        mArray.mValidity.assign( static_cast<size_t>( ( i + 8 ) / 8 ), '\0' );
+        for( int64_t j = 0; j < i; j++ ) {
+            mArray.mValidity[ j >> 3 ] = static_cast<char>( mArray.mValidity[ j >> 3 ] | ( 1 << ( j & 7 ) ) );
+        }
+    }
+    if( !mArray.mValidity.empty() ) {
+        if( static_cast<size_t>( i >> 3 ) >= mArray.mValidity.size() ) {
+            mArray.mValidity += '\0';
+        }
+        if( valid ) {
+            mArray.mValidity[ i >> 3 ] = static_cast<char>( mArray.mValidity[ i >> 3 ] | ( 1 << ( i & 7 ) ) );
+        }
+    }
+    if( !valid ) {
+        mArray.mNullCount++;
+    }
+}
+
+void sosicon::arrow::ArrayBuilder::
+appendOffset() {
+    char buf[ 4 ];
+    byteOrder::toLittleEndian( static_cast<int32_t>( mArray.mValues.size() ), buf );
+    mArray.mOffsets.append( buf, 4 );
+}
+
+void sosicon::arrow::ArrayBuilder::
+appendBytes( const char* data, size_t size ) {
+    mArray.mValues.append( data, size );
+    appendOffset();
+    setValid( true );
+}
+
+void sosicon::arrow::ArrayBuilder::
+appendNull( size_t width ) {
+    if( mVariable ) {
+        appendOffset();
+    }
+    else {
+        mArray.mValues.append( width, '\0' );
+    }
+    setValid( false );
+}
+
+void sosicon::arrow::ArrayBuilder::
+finish( Array& array ) {
+    array.mLength = mArray.mLength;
+    array.mNullCount = mArray.mNullCount;
+    array.mValidity.swap( mArray.mValidity );
+    array.mOffsets.swap( mArray.mOffsets );
+    array.mValues.swap( mArray.mValues );
+    array.mChildren.clear();
+    reset( mVariable );
+}
@@ -0,0 +1,190 @@
+/*
+ *  This file is part of the command-line tool sosicon.
+ *  Copyright (C) 2014  Espen Andersen, Norwegian Broadcast Corporation (NRK)
+ *
+ *  This is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __RECORD_BATCH_H__
+#define __RECORD_BATCH_H__
+
+#include <stdint.h>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+#include "../byte_order.h"
+
+namespace sosicon {
+
+    //! Apache Arrow columnar format
+    namespace arrow {
+
+        //! Column types
+        enum ColumnType {
+            column_type_binary,         //!< Variable length bytes, 32 bit offsets
+            column_type_utf8,           //!< UTF-8 string, 32 bit offsets
+            column_type_int64,          //!< Signed 64 bit integer
+            column_type_float64,        //!< IEEE 754 double
+            column_type_date32,         //!< Days since 1970-01-01, 32 bit
+            column_type_struct          //!< Child columns of equal length
+        };
+
+        //! Key-value metadata of schema or field
+        typedef std::vector< std::pair<std::string, std::string> > KeyValues;
+
+        //! Column description
+        struct Field {
+            std::string mName;              //!< Column name
+            ColumnType mType;               //!< Column type, or value type of dictionary
+            bool mNullable;                 //!< True if the column may contain nulls
+            int mDictionary;                //!< Dictionary id if the column holds dictionary indices, else -1
+            std::vector<Field> mChildren;   //!< Struct members
+            KeyValues mMetadata;            //!< Field metadata
+
+            //! Constructor
+            Field( const std::string& name = "", ColumnType type = column_type_utf8, bool nullable = true ) :
+                mName( name ), mType( type ), mNullable( nullable ), mDictionary( -1 ) { }
+        };
+
+        //! Table layout
+        struct Schema {
+            std::vector<Field> mFields;     //!< Columns
+            KeyValues mMetadata;            //!< Schema metadata
+        };
+
+        //! Column values
+        /*!
+            The buffers of one column, as laid out by the Arrow columnar format: a validity
+            bitmap (empty if there are no nulls), offsets for variable length types, and the
+            values, little endian. Dictionary encoded columns hold 32 bit indices into the
+            dictionary in mValues.
+         */
+        struct Array {
+            int64_t mLength;                //!< Number of values
+            int64_t mNullCount;             //!< Number of nulls
+            std::string mValidity;          //!< One bit per value, least significant bit first, set if not null
+            std::string mOffsets;           //!< mLength + 1 offsets into mValues, 32 bit
+            std::string mValues;            //!< Values, or bytes of variable length values
+            std::vector<Array> mChildren;   //!< Struct members
+
+            //! Constructor
+            Array() : mLength( 0 ), mNullCount( 0 ) { }
+
+            //! True if value i is not null
+            bool isValid( int64_t i ) const {
+                return mValidity.empty() || ( static_cast<unsigned char>( mValidity[ i >> 3 ] ) >> ( i & 7 ) ) & 1;
+            }
+
+            //! Read little endian value
+            template<typename T>
+            static T load( const char* p ) {
+                T v;
+                char buf[ sizeof( T ) ];
+                memcpy( &v, p, sizeof( T ) );
+                byteOrder::toLittleEndian( v, buf );
+                memcpy( &v, buf, sizeof( T ) );
+                return v;
+            }
+
+            //! Fixed width value i
+            template<typename T>
+            T value( int64_t i ) const { return load<T>( &mValues[ i * sizeof( T ) ] ); }
+
+            //! Variable length value i
+            /*!
+                \param i Value index.
+                \param size Receives the number of bytes.
+                \return Pointer to the first byte.
+             */
+            const char* bytes( int64_t i, size_t& size ) const;
+        };
+
+        //! Rows of a table, column by column
+        struct RecordBatch {
+            int64_t mLength;                //!< Number of rows
+            std::vector<Array> mColumns;    //!< One array per schema field
+
+            //! Constructor
+            RecordBatch() : mLength( 0 ) { }
+        };
+
+        //! Array builder
+        /*!
+            \author Espen Andersen
+            \copyright GNU General Public License
+
+            Appends values to an Array. The validity bitmap is only allocated when the first
+            null is appended. Values and offsets are stored little endian, as required by
+            Parquet and declared in the Arrow schema.
+         */
+        class ArrayBuilder {
+
+            //! Array under construction
+            Array mArray;
+
+            //! True if the array has offsets
+            bool mVariable;
+
+            //! Mark value as valid or null
+            void setValid( bool valid );
+
+            //! Append end offset of the last value
+            void appendOffset();
+
+        public:
+
+            //! Constructor
+            /*!
+                \param variable True for variable length types (binary and UTF-8).
+             */
+            ArrayBuilder( bool variable = false ) { reset( variable ); }
+
+            //! Start new array
+            void reset( bool variable );
+
+            //! Reserve room for values
+            /*!
+                \param count Number of values.
+                \param bytes Number of value bytes.
+             */
+            void reserve( size_t count, size_t bytes );
+
+            //! Append fixed width value
+            template<typename T>
+            void append( T value ) {
+                char buf[ sizeof( T ) ];
+                byteOrder::toLittleEndian( value, buf );
+                mArray.mValues.append( buf, sizeof( T ) );
+                setValid( true );
+            }
+
+            //! Append variable length value
+            void appendBytes( const char* data, size_t size );
+
+            //! Append null
+            /*!
+                \param width Size of fixed width values, or 0 for variable length types.
+             */
+            void appendNull( size_t width );
+
+            //! Take over the built array
+            void finish( Array& array );
+
+        }; // class ArrayBuilder
+
+    }; // namespace arrow
+
+}; // namespace sosicon
+
+#endif
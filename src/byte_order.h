@@ -20,68 +20,147 @@
 
 #ifdef _WIN32
 //#include "inttypes.h"
+#include <stdlib.h>
 #else
 #include <inttypes.h>
 #endif
-#include "logger.h"
-#include <algorithm>
-#include <cmath>
+#include <cstring>
+#include <cstddef>
+
+// Host byte order, resolved at compile time
+#if defined( _WIN32 ) || ( defined( __BYTE_ORDER__ ) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__ )
+#define SOSICON_LITTLE_ENDIAN 1
+#elif defined( __BYTE_ORDER__ ) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+#define SOSICON_LITTLE_ENDIAN 0
+#else
+#error "Unable to determine host byte order"
+#endif
 
 namespace sosicon {
 
     //! Big/low-endian conversions
+    /*!
+        Serializes integers and IEEE 754 doubles to a given byte order for binary embedding
+        in files. The host byte order is known at compile time, so each conversion reduces
+        to a plain copy or a single byte swap.
+     */
     namespace byteOrder {
 
-		//! Big/little flag
-        extern enum Endianness {
-            not_set,
-            big,
-            little
-        } 
-        //! Stores system endianness
-        endianness;
+        //! Unsigned integer of given byte width, with byte swap
+        template<size_t N> struct Word;
+
+        //! 16 bit word
+        template<> struct Word<2> {
+            typedef uint16_t type;
+            static type swap( type v ) { return static_cast<type>( ( v >> 8 ) | ( v << 8 ) ); }
+        };
+
+        //! 32 bit word
+        template<> struct Word<4> {
+            typedef uint32_t type;
+            static type swap( type v ) {
+#if defined( __GNUC__ )
+                return __builtin_bswap32( v );
+#elif defined( _MSC_VER )
+                return _byteswap_ulong( v );
+#else
+                return ( v >> 24 ) | ( ( v >> 8 ) & 0xff00 ) | ( ( v << 8 ) & 0xff0000 ) | ( v << 24 );
+#endif
+            }
+        };
+
+        //! 64 bit word
+        template<> struct Word<8> {
+            typedef uint64_t type;
+            static type swap( type v ) {
+#if defined( __GNUC__ )
+                return __builtin_bswap64( v );
+#elif defined( _MSC_VER )
+                return _byteswap_uint64( v );
+#else
+                return ( static_cast<type>( Word<4>::swap( static_cast<uint32_t>( v ) ) ) << 32 ) |
+                         Word<4>::swap( static_cast<uint32_t>( v >> 32 ) );
+#endif
+            }
+        };
+
+        //! Copy value to buffer, reversing the byte order if required
+        /*!
+            \tparam Reverse True if the byte order is to be reversed.
+            \param from The value to serialize. Integer or floating point type of 2, 4 or 8 bytes.
+            \param to Pointer to destination buffer, at least sizeof( T ) bytes wide.
+         */
+        template<bool Reverse, typename T>
+        inline void encode( T from, char* to ) {
+            typename Word<sizeof( T )>::type w;
+            memcpy( &w, &from, sizeof( w ) );
+            if( Reverse ) {
+                w = Word<sizeof( T )>::swap( w );
+            }
+            memcpy( to, &w, sizeof( w ) );
+        }
+
+        //! Copy array of values to buffer, reversing the byte order if required
+        /*!
+            \tparam Reverse True if the byte order is to be reversed.
+            \param from Pointer to the first value to serialize.
+            \param count Number of values.
+            \param to Pointer to destination buffer, at least count * sizeof( T ) bytes wide.
+         */
+        template<bool Reverse, typename T>
+        inline void encode( const T* from, size_t count, char* to ) {
+            if( !Reverse ) {
+                memcpy( to, from, count * sizeof( T ) );
+            }
+            else {
+                for( size_t i = 0; i < count; i++ ) {
+                    encode<true>( from[ i ], to + i * sizeof( T ) );
+                }
+            }
+        }
 
-        //! Determines system endianness
+        //! Writes big endian representation of value
         /*!
-            Tests byte-order to see if the program runs on a big endian or a little endian
-            architecture. Flags the byteOrder::endian variable.
-            \return System endianness.
-            \retval Endianness::big Big endian system.
-            \retval Endianness::little Little endian system.
+            \param from The value to serialize, e.g. uint16_t, uint32_t or double.
+            \param to Pointer to destination buffer, at least sizeof( T ) bytes wide.
          */
-        Endianness determine();
+        template<typename T>
+        inline void toBigEndian( T from, char* to ) {
+            encode<SOSICON_LITTLE_ENDIAN == 1>( from, to );
+        }
 
-        //! Writes little endian representation of double
+        //! Writes little endian representation of value
         /*!
-            Serializes double-precision floating point value to IEEE little endian representation
-            for binary embedding in files.
-            \param from The double value to parse.
-            \param to pointer to destination buffer. The buffer must be at least 8 bytes wide, as this
-                   is the size of the IEEE 754 format.
+            \param from The value to serialize, e.g. uint16_t, uint32_t or double.
+            \param to Pointer to destination buffer, at least sizeof( T ) bytes wide.
          */
-        void doubleToLittleEndian( double from, char* to );
+        template<typename T>
+        inline void toLittleEndian( T from, char* to ) {
+            encode<SOSICON_LITTLE_ENDIAN == 0>( from, to );
+        }
 
-        //! Reverses buffer to big endian if required
+        //! Writes big endian representation of array
         /*!
-            Copies source buffer to destination buffer. If the program runs on a little-endian
-            system, the byte order will be reversed.
-            \param from pointer to source buffer.
-            \param to pointer to destination buffer. The buffer must be at least as big
-                   as the source buffer.
-            \param bufSize The number of bytes to copy.
+            \param from Pointer to the first value to serialize.
+            \param count Number of values.
+            \param to Pointer to destination buffer, at least count * sizeof( T ) bytes wide.
          */
-        void toBigEndian( const char* from, char* to, size_t bufSize );
+        template<typename T>
+        inline void toBigEndian( const T* from, size_t count, char* to ) {
+            encode<SOSICON_LITTLE_ENDIAN == 1>( from, count, to );
+        }
 
-        //! Reverses buffer to little endian if required
+        //! Writes little endian representation of array
         /*!
-            Copies source buffer to destination buffer. If the program runs on a big-endian
-            system, the byte order will be reversed.
-            \param from pointer to source buffer.
-            \param to pointer to destination buffer. The buffer must be at least as big
-                   as the source buffer.
-            \param bufSize The number of bytes to copy.
+            On little endian systems, this is a single block copy.
+            \param from Pointer to the first value to serialize.
+            \param count Number of values.
+            \param to Pointer to destination buffer, at least count * sizeof( T ) bytes wide.
          */
-        void toLittleEndian( const char* from, char* to, size_t bufSize );
+        template<typename T>
+        inline void toLittleEndian( const T* from, size_t count, char* to ) {
+            encode<SOSICON_LITTLE_ENDIAN == 0>( from, count, to );
+        }
     };
 };
 
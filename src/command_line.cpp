@@ -21,10 +21,18 @@ sosicon::CommandLine::
 CommandLine() {
     mCreateStatements = false;
     mInsertStatements = false;
+    mCopy = false;
+    mCopyBinary = false;
     mVerbose = 0;
+    mThreads = 1;
+    mCache = false;
+    mCacheHash = true;
     mIsTtyIn = isatty( fileno( stdin ) ) != 0;
     mIsTtyOut = isatty( fileno( stdout ) ) != 0;
     mMakeSubDir = false;
+    mIncludeHeader = false;
+    mPrecision = -1;
+    mSequence = false;
 #if defined( _WIN32 )
     HANDLE out = GetStdHandle( STD_OUTPUT_HANDLE );
     CONSOLE_CURSOR_INFO ci;
@@ -134,18 +142,43 @@ parse( int argc, char* argv[] ) {
             else if( "-g" == param && argc > ( ++i ) ) {
                 mGeomTypes = utils::explode( ',', argv[ i ] );
             }
+            else if( "-geom" == param && argc > ( ++i ) ) {
+                mGeomFormat = utils::toLower( argv[ i ] );
+            }
             else if( "-h" == param ) {
                 mIncludeHeader = true;
             }
+            else if( "-j" == param && argc > ( ++i ) ) {
+                mThreads = std::max( 1, atoi( argv[ i ] ) );
+            }
+            else if( "-cache" == param ) {
+                mCache = true;
+            }
+            else if( "-cachenohash" == param ) {
+                mCache = true;
+                mCacheHash = false;
+            }
             else if( "-insert" == param ) {
                 mInsertStatements = true;
             }
+            else if( "-copy" == param ) {
+                mCopy = true;
+            }
+            else if( "-binary" == param ) {
+                mCopy = mCopyBinary = true;
+            }
             else if( "-o" == param && argc > ( ++i ) ) {
                 mOutputFile = utils::unquote( argv[ i ] );
             }
+            else if( "-precision" == param && argc > ( ++i ) ) {
+                mPrecision = std::max( 0, std::min( 15, atoi( argv[ i ] ) ) );
+            }
             else if( "-s" == param ) {
                 mMakeSubDir = true;
             }
+            else if( "-seq" == param ) {
+                mSequence = true;
+            }
             else if( "-schema" == param && argc > ( ++i ) ) {
                 mDbSchema = argv[ i ];
             }
@@ -176,6 +209,24 @@ parse( int argc, char* argv[] ) {
             else if( "-2tsv" == param ) {
                 mCommand = param;
             }
+            else if( "-2xml" == param ) {
+                mCommand = param;
+            }
+            else if( "-2geojson" == param ) {
+                mCommand = param;
+            }
+            else if( "-2fgb" == param ) {
+                mCommand = param;
+            }
+            else if( "-2gpkg" == param ) {
+                mCommand = param;
+            }
+            else if( "-2parquet" == param ) {
+                mCommand = param;
+            }
+            else if( "-2arrow" == param ) {
+                mCommand = param;
+            }
             else if( "-stat" == param ) {
                 mCommand = param;
             }
@@ -232,6 +283,31 @@ outputHelpText() {
     std::cout << "  -2psql\n";
     std::cout << "      Convert SOSI source to PostgreSQL/PostGIS dump.\n";
     std::cout << "\n";
+    std::cout << "  -2tsv\n";
+    std::cout << "      Convert SOSI source to tab separated values, one row\n";
+    std::cout << "      per feature.\n";
+    std::cout << "\n";
+    std::cout << "  -2xml\n";
+    std::cout << "      Convert SOSI source to GML 3.2.\n";
+    std::cout << "\n";
+    std::cout << "  -2geojson\n";
+    std::cout << "      Convert SOSI source to GeoJSON (RFC 7946).\n";
+    std::cout << "\n";
+    std::cout << "  -2fgb\n";
+    std::cout << "      Convert SOSI source to FlatGeobuf, one file per geometry\n";
+    std::cout << "      type, with spatial index.\n";
+    std::cout << "\n";
+    std::cout << "  -2gpkg\n";
+    std::cout << "      Convert SOSI source to GeoPackage, one table per object\n";
+    std::cout << "      type and geometry type, with spatial index.\n";
+    std::cout << "\n";
+    std::cout << "  -2parquet\n";
+    std::cout << "      Convert SOSI source to GeoParquet, one file with WKB\n";
+    std::cout << "      geometry, bbox column and typed attribute columns.\n";
+    std::cout << "\n";
+    std::cout << "  -2arrow\n";
+    std::cout << "      As -2parquet, but writes an Arrow IPC (Feather) file.\n";
+    std::cout << "\n";
     std::cout << "  -stat\n";
     std::cout << "      Print out statistics for a SOSI file.\n";
     std::cout << "\n";
@@ -253,6 +329,32 @@ outputHelpText() {
     std::cout << "  -o <FILENAME>\n";
     std::cout << "      Specify output file path and base name.\n";
     std::cout << "\n";
+    std::cout << "  -srid <EPSG>\n";
+    std::cout << "      Transform coordinates to the given grid. Built-in support\n";
+    std::cout << "      for ETRS89/WGS84 geographic (4258, 4326), UTM (258xx, 326xx)\n";
+    std::cout << "      and NTM (5105-5130). -2psql and -2geojson default to 4326,\n";
+    std::cout << "      and -2psql leaves other grids to ST_Transform in PostGIS.\n";
+    std::cout << "\n";
+    std::cout << "  -j <N>\n";
+    std::cout << "      Parse input using N worker threads. The SOSI file is split\n";
+    std::cout << "      into chunks at top-level elements, which are parsed in\n";
+    std::cout << "      parallel. Output is identical to sequential parsing.\n";
+    std::cout << "      With several SOSI files (-2shp, -2psql, -2mysql), up to N\n";
+    std::cout << "      files are converted at the same time instead, largest\n";
+    std::cout << "      first. Output is identical to converting one at a time.\n";
+    std::cout << "\n";
+    std::cout << "  -cache\n";
+    std::cout << "      Store parsed elements in a binary cache file next to each\n";
+    std::cout << "      SOSI file (<name>.sosc). Later runs load the cache instead\n";
+    std::cout << "      of parsing, as long as the size, modification time and\n";
+    std::cout << "      content hash of the SOSI file are unchanged.\n";
+    std::cout << "\n";
+    std::cout << "  -cachenohash\n";
+    std::cout << "      Like -cache, but trust the size and modification time of\n";
+    std::cout << "      the SOSI file without comparing its content hash. Saves a\n";
+    std::cout << "      pass over the SOSI file, but may load a stale cache if the\n";
+    std::cout << "      file is changed within the resolution of its timestamp.\n";
+    std::cout << "\n";
     std::cout << "-shp options\n";
     std::cout << "  -d <DIRECTORY>\n";
     std::cout << "      Specify a destination directory where the generated files\n";
@@ -280,6 +382,37 @@ outputHelpText() {
     std::cout << "      The schema and table structure is not exported, only the data\n";
     std::cout << "      values.\n";
     std::cout << "\n";
+    std::cout << "  -copy\n";
+    std::cout << "      Load data with COPY ... FROM STDIN instead of INSERT\n";
+    std::cout << "      statements. Geometries are sent as hex encoded EWKB.\n";
+    std::cout << "\n";
+    std::cout << "  -binary\n";
+    std::cout << "      Like -copy, but write the data for each table to a separate\n";
+    std::cout << "      file in PostgreSQL binary COPY format, loaded by \\copy\n";
+    std::cout << "      commands in the SQL script.\n";
+    std::cout << "\n";
+    std::cout << "-2tsv options\n";
+    std::cout << "  -f <FIELDS>\n";
+    std::cout << "      Write the given comma-separated FIELDS only, in the given\n";
+    std::cout << "      order. Without -f, the SOSI files are scanned for fields\n";
+    std::cout << "      before the rows are written.\n";
+    std::cout << "\n";
+    std::cout << "  -geom <FORMAT>\n";
+    std::cout << "      Geometry column format: wkt (default), wkb (hex encoded)\n";
+    std::cout << "      or none.\n";
+    std::cout << "\n";
+    std::cout << "  -h\n";
+    std::cout << "      Write a header line with the column names.\n";
+    std::cout << "\n";
+    std::cout << "-2geojson options\n";
+    std::cout << "  -seq\n";
+    std::cout << "      Write newline-delimited GeoJSON (GeoJSONSeq), one feature\n";
+    std::cout << "      per line, instead of a FeatureCollection.\n";
+    std::cout << "\n";
+    std::cout << "  -precision <N>\n";
+    std::cout << "      Number of decimals in coordinates. Defaults to 6 for\n";
+    std::cout << "      geographic and 2 for projected coordinates.\n";
+    std::cout << "\n";
 }
 
 void sosicon::CommandLine::
@@ -19,6 +19,7 @@
 #define __COMMAND_LINE_H__
 
 #include <stdio.h>
+#include <cstdlib>
 #include <iostream>
 #include <vector>
 #include <string>
@@ -79,6 +80,22 @@ namespace sosicon {
         */
         bool mInsertStatements;
 
+        //! Use COPY instead of INSERT statements
+        /*!
+            For PostgreSQL export: If this flag is set (by specifying the -copy parameter),
+            data is loaded with COPY ... FROM STDIN blocks, with geometries as hex encoded EWKB,
+            instead of INSERT statements.
+        */
+        bool mCopy;
+
+        //! Use binary COPY format
+        /*!
+            For PostgreSQL export: If this flag is set (by specifying the -binary parameter),
+            the COPY data for each table is written to a separate file in PostgreSQL binary
+            COPY format, loaded by \copy commands in the SQL script. Implies mCopy.
+        */
+        bool mCopyBinary;
+
         //! List of input files
         /*!
             String vector containing the list of SOSI input files to be converted. This list is
@@ -171,6 +188,28 @@ namespace sosicon {
          */
         bool mIncludeHeader;
 
+        //! Geometry column format
+        /*!
+            For TSV export: Specified by the -geom argument. "wkt" (default) writes the geometry
+            as well-known text, "wkb" as hex encoded well-known binary, and "none" leaves the
+            geometry column out.
+         */
+        std::string mGeomFormat;
+
+        //! Number of decimals in coordinates
+        /*!
+            For GeoJSON export: Specified by the -precision argument. If negative (default), six
+            decimals are written for geographic coordinates and two for projected coordinates.
+         */
+        int mPrecision;
+
+        //! Write one record per line
+        /*!
+            For GeoJSON export: If the -seq switch is specified, newline-delimited GeoJSON
+            (GeoJSONSeq) is written instead of a FeatureCollection.
+         */
+        bool mSequence;
+
         //! Create a sub directory for the output files
         /*!
             If the /s switch is specified, this flag is set to true. Instead of emitting the output
@@ -181,10 +220,37 @@ namespace sosicon {
 
         //! Specifies SRID for exports
         /*!
-            Used for grid conversion exports to postGIS or other conversions that supports this.
+            Coordinates are transformed while read if both grids are supported by
+            sosicon::Projection. PostGIS exports fall back to ST_Transform for other grids.
          */
         std::string mSrid;
 
+        //! Use binary cache files
+        /*!
+            Specified by the -cache argument. If true, the parsed elements of each SOSI file are
+            stored in a binary sidecar file (.sosc), which is loaded instead of parsing the SOSI
+            file the next time, provided that the SOSI file has not changed.
+         */
+        bool mCache;
+
+        //! Verify binary cache files by content
+        /*!
+            True by default: a content hash of the SOSI file is stored in the cache, and
+            compared before the cache is loaded. Set to false by the -cachenohash argument,
+            which implies -cache. The cache is then trusted if the size and modification time
+            of the SOSI file are unchanged.
+         */
+        bool mCacheHash;
+
+        //! Number of worker threads
+        /*!
+            Specified by the -j argument. If greater than one, large SOSI files are split at
+            top-level elements and parsed in parallel. With several source files, the
+            converters supporting it convert up to mThreads files at the same time instead.
+            Defaults to 1 (sequential parsing).
+         */
+        int mThreads;
+
         //! Verbose output
         /*!
             Verbose level. If this value is 0, no informative output will be emitted during file
@@ -19,16 +19,9 @@
 #define __COMMON_TYPES_H__
 
 #include <vector>
-#include "interface/i_coordinate.h"
 
 namespace sosicon {
 
-    //! List of coordinate pairs
-    /*!
-        Used throughout the application.
-    */
-    typedef std::vector<ICoordinate*> CoordinateList;
-    
     //! List of applied, well-known text geometries
     enum Wkt {
         wkt_unknown = 0,           //!< Unknown geometry
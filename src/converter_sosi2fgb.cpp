@@ -0,0 +1,139 @@
+/*
+ *  This file is part of the command-line tool sosicon.
+ *  Copyright (C) 2014  Espen Andersen, Norwegian Broadcast Corporation (NRK)
+ *
+ *  This is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "converter_sosi2fgb.h"
+
+namespace {
+
+    //! Geometry type and file name suffix of each output file
+    const sosicon::fgb::GeometryType layerTypes[ 3 ] = {
+        sosicon::fgb::geometry_type_point,
+        sosicon::fgb::geometry_type_lineString,
+        sosicon::fgb::geometry_type_polygon
+    };
+    const char* const layerNames[ 3 ] = { "point", "linestring", "polygon" };
+
+};
+
+sosicon::ConverterSosi2fgb::
+~ConverterSosi2fgb() {
+    for( int i = 0; i < 3; i++ ) {
+        delete mLayers[ i ];
+    }
+}
+
+int sosicon::ConverterSosi2fgb::
+targetSrid() {
+    return mSrid;
+}
+
+bool sosicon::ConverterSosi2fgb::
+onHeader() {
+    if( !checkTransformation() ) {
+        return false;
+    }
+    // The layers are labelled with the grid actually read, which is the requested one
+    // for all but the first source file
+    mSrid = mHeader.getSrid();
+    return true;
+}
+
+sosicon::fgb::Flatgeobuf* sosicon::ConverterSosi2fgb::
+getLayer( int layer ) {
+    if( !mLayers[ layer ] ) {
+        std::string fileName = utils::nonExistingFilename( mBasePath + "_" + layerNames[ layer ] + ".fgb" );
+        std::string name = fileName.substr( 0, fileName.size() - 4 );
+        std::string::size_type slash = name.find_last_of( "/\\" );
+        if( slash != std::string::npos ) {
+            name = name.substr( slash + 1 );
+        }
+        mLayers[ layer ] = new fgb::Flatgeobuf( fileName, name, layerTypes[ layer ], mSrid );
+    }
+    return mLayers[ layer ];
+}
+
+void sosicon::ConverterSosi2fgb::
+takeFeature( ISosiElement* feature ) {
+
+    FgbBatchFeature& f = nextFeature();
+    f.mProperties.clear();
+
+    CoordinateCollection cc( mHeader, &mGeometryCache );
+    Wkt geometryType = cc.extractGeometry( feature, f.mGeom, f.mHoles );
+    if( geometryType == wkt_unknown ) {
+        mSkipped++;
+        return;
+    }
+    f.mLayer = geometryType == wkt_point ? 0 : ( geometryType == wkt_linestring ? 1 : 2 );
+    f.mBox.minX = cc.getXmin();
+    f.mBox.minY = cc.getYmin();
+    f.mBox.maxX = cc.getXmax();
+    f.mBox.maxY = cc.getYmax();
+
+    // Column indices are assigned here, in feature order, so that the encoding
+    // threads only read the layers
+    fgb::Flatgeobuf* layer = getLayer( f.mLayer );
+    bool utf8 = mHeader.getEncoding() == sosi::sosi_charset_utf8;
+    std::map<std::string,std::string> fields;
+    featureFields::extract( feature, fields );
+    for( std::map<std::string,std::string>::iterator i = fields.begin(); i != fields.end(); i++ ) {
+        std::string value = utils::copyNormalize( i->second, false );
+        f.mProperties.push_back( std::make_pair( layer->columnIndex( i->first ),
+                                                 utf8 ? value : utils::iso8859_1ToUtf8( mHeader.toIso8859_1( value ) ) ) );
+    }
+    commitFeature();
+}
+
+void sosicon::ConverterSosi2fgb::
+encodeFeature( fgb::FlatBufferWriter& fb, const FgbBatchFeature& f, size_t, std::string& out ) const {
+    fgb::Flatgeobuf::encodeFeature( fb, layerTypes[ f.mLayer ], f.mGeom, f.mHoles, f.mProperties, out );
+}
+
+void sosicon::ConverterSosi2fgb::
+writeFeature( const FgbBatchFeature& f, const char* data, size_t size ) {
+    mLayers[ f.mLayer ]->append( data, size, f.mBox );
+}
+
+void sosicon::ConverterSosi2fgb::
+run( bool* ) {
+
+    mSrid = atoi( mCmd->mSrid.c_str() );
+    mBasePath = mCmd->mOutputFile.empty() ? "sosicon" : mCmd->mOutputFile;
+    if( mBasePath.size() > 4 && utils::toLower( mBasePath.substr( mBasePath.size() - 4 ) ) == ".fgb" ) {
+        mBasePath.erase( mBasePath.size() - 4 );
+    }
+
+    for( std::vector<std::string>::iterator f = mCmd->mSourceFiles.begin(); f != mCmd->mSourceFiles.end(); f++ ) {
+        parseFile( *f );
+    }
+    completeBatch();
+    mGeometryCache.clear();
+
+    for( int i = 0; i < 3; i++ ) {
+        if( mLayers[ i ] && mLayers[ i ]->complete( INDEX_NODE_SIZE ) ) {
+            sosicon::logstream << "    > " << mLayers[ i ]->fileName() << " written, "
+                               << mLayers[ i ]->size() << " features\n";
+        }
+        delete mLayers[ i ];
+        mLayers[ i ] = 0;
+    }
+    if( mSkipped > 0 ) {
+        sosicon::logstream << mSkipped << " features without valid geometry skipped\n";
+    }
+    checkFailures();
+    sosicon::logstream << "Done!\n";
+}
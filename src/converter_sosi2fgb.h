@@ -0,0 +1,153 @@
+/*
+ *  This file is part of the command-line tool sosicon.
+ *  Copyright (C) 2014  Espen Andersen, Norwegian Broadcast Corporation (NRK)
+ *
+ *  This is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __CONVERTER_SOSI2FGB_H__
+#define __CONVERTER_SOSI2FGB_H__
+
+#include "logger.h"
+#include <iostream>
+#include <algorithm>
+#include <vector>
+#include <map>
+#include "converter_sosi_stream.h"
+#include "interface/i_converter.h"
+#include "interface/i_sosi_element.h"
+#include "sosi/sosi_types.h"
+#include "sosi/sosi_element_index.h"
+#include "sosi/sosi_element_search.h"
+#include "sosi/sosi_header_context.h"
+#include "sosi/sosi_north_east.h"
+#include "fgb/flatgeobuf.h"
+#include "coordinate_collection.h"
+#include "feature_fields.h"
+#include "geometry_buffer.h"
+#include "geometry_cache.h"
+#include "command_line.h"
+#include "common_types.h"
+#include "utils.h"
+#include "parser.h"
+
+namespace sosicon {
+
+    //! Feature taken over from the parser by ConverterSosi2fgb, waiting to be encoded
+    struct FgbBatchFeature {
+        int mLayer;                     //!< Index into the output files of the converter
+        fgb::Properties mProperties;    //!< Attribute values, UTF-8, by column index of the layer
+        GeometryBuffer mGeom;           //!< Point, curve, or outer ring of surface
+        GeometryBuffer mHoles;          //!< Surface holes, one part per ring
+        fgb::NodeItem mBox;             //!< Bounding box of the geometry
+    };
+
+    /*!
+        \addtogroup converters
+        @{
+    */
+    //! SOSI to FlatGeobuf converter
+    /*!
+        If command-line parameter -2fgb is specified, this converter will handle the output
+        generation. Produces one FlatGeobuf file for each geometry type (point, linestring
+        and polygon) found in the SOSI source(s), each with a packed Hilbert R-tree index
+        for bounding box queries.
+
+        The source files are parsed in streaming mode. As for -2geojson, the features are
+        taken over from the parser into a batch, which is encoded by the worker threads
+        given by -j when full. The encoded features are spooled by fgb::Flatgeobuf until
+        the index is built at the end.
+     */
+    class ConverterSosi2fgb : public ConverterSosiBatch<FgbBatchFeature, fgb::FlatBufferWriter> {
+
+        //! Maximum number of children of each R-tree node
+        static const uint16_t INDEX_NODE_SIZE = 16;
+
+        //! EPSG code of the output coordinates
+        /*!
+            Given by -srid, or else by the first source file. The source files that follow
+            are transformed to the same grid.
+         */
+        int mSrid;
+
+        //! Base path of the output files, without extension
+        std::string mBasePath;
+
+        //! Output files, by geometry type: point, linestring, polygon
+        fgb::Flatgeobuf* mLayers[ 3 ];
+
+        //! Number of features without valid geometry
+        int mSkipped;
+
+        //! Get output file for geometry type, creating it on first use
+        fgb::Flatgeobuf* getLayer( int layer );
+
+        //! Take over feature from the parser
+        /*!
+            Assembles the geometry and extracts the attributes into the next free batch
+            entry. Features without a valid geometry are skipped, as they cannot be
+            indexed.
+            \sa sosicon::ConverterSosiBatch::takeFeature()
+        */
+        virtual void takeFeature( ISosiElement* feature );
+
+        //! Encode one feature as a FlatGeobuf feature table
+        /*!
+            \sa sosicon::ConverterSosiBatch::encodeFeature()
+        */
+        virtual void encodeFeature( fgb::FlatBufferWriter& fb, const FgbBatchFeature& f, size_t index, std::string& out ) const;
+
+        //! Append one encoded feature to its output file
+        /*!
+            \sa sosicon::ConverterSosiBatch::writeFeature()
+        */
+        virtual void writeFeature( const FgbBatchFeature& f, const char* data, size_t size );
+
+        //! Output grid requested for the source file in process
+        /*!
+            mSrid, that is -srid, or the grid of the first source file.
+            \sa sosicon::ConverterSosiStream::targetSrid()
+         */
+        virtual int targetSrid();
+
+        //! Header context of a source file is set up
+        /*!
+            Takes the output grid from the first source file, unless given by -srid. Source
+            files that cannot be transformed to the output grid are skipped.
+            \sa sosicon::ConverterSosiStream::onHeader()
+         */
+        virtual bool onHeader();
+
+    public:
+
+        //! Constructor
+        ConverterSosi2fgb() :
+            mSrid( 0 ),
+            mSkipped( 0 ) { mLayers[ 0 ] = mLayers[ 1 ] = mLayers[ 2 ] = 0; };
+
+        //! Destructor
+        virtual ~ConverterSosi2fgb();
+
+        //! Start conversion
+        /*!
+            Implementation details in sosicon::IConverter::run()
+            \sa sosicon::IConverter::run()
+         */
+        virtual void run( bool* cancel = 0x00 );
+
+    }; // class ConverterSosi2fgb
+   /*! @} end group converters */
+
+}; // namespace sosicon
+
+#endif
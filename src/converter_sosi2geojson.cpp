@@ -0,0 +1,225 @@
+/*
+ *  This file is part of the command-line tool sosicon.
+ *  Copyright (C) 2014  Espen Andersen, Norwegian Broadcast Corporation (NRK)
+ *
+ *  This is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "converter_sosi2geojson.h"
+
+bool sosicon::ConverterSosi2geojson::
+onHeader() {
+    if( !checkTransformation() ) {
+        return false;
+    }
+    if( mHeader.getSrid() != 4326 ) {
+        sosicon::logstream << "Warning: Coordinates are written in EPSG:" << mHeader.getSrid()
+                           << ", RFC 7946 requires WGS 84 longitude and latitude (EPSG:4326)\n";
+    }
+    if( mCmd->mPrecision >= 0 ) {
+        mPrecision = mCmd->mPrecision;
+    }
+    else {
+        // About 10 cm for geographic coordinates, as suggested by RFC 7946
+        mPrecision = Projection( mHeader.getSrid() ).isGeographic() ? 6 : 2;
+    }
+    return true;
+}
+
+void sosicon::ConverterSosi2geojson::
+takeFeature( ISosiElement* feature ) {
+
+    Feature& f = nextFeature();
+    f.mPrecision = mPrecision;
+    f.mUtf8 = mHeader.getEncoding() == sosi::sosi_charset_utf8;
+    f.mFields.clear();
+
+    std::string serial = feature->getSerial();
+    if( !sosi::SosiElementIndex::parseSerial( serial.data(), serial.data() + serial.size(), f.mId ) ) {
+        f.mId = -1;
+    }
+
+    std::map<std::string,std::string> fields;
+    featureFields::extract( feature, fields );
+    for( std::map<std::string,std::string>::iterator i = fields.begin(); i != fields.end(); i++ ) {
+        std::string value = utils::copyNormalize( i->second, false );
+        f.mFields.push_back( std::make_pair( i->first, f.mUtf8 ? value : mHeader.toIso8859_1( value ) ) );
+    }
+
+    CoordinateCollection cc( mHeader, &mGeometryCache );
+    f.mGeomType = cc.extractGeometry( feature, f.mGeom, f.mHoles );
+    commitFeature();
+}
+
+void sosicon::ConverterSosi2geojson::
+appendString( std::string& out, const std::string& str, bool utf8 ) {
+    static const char hex[] = "0123456789abcdef";
+    out += '"';
+    for( std::string::size_type i = 0; i < str.size(); i++ ) {
+        unsigned char c = static_cast<unsigned char>( str[ i ] );
+        switch( c ) {
+            case '"':
+                out += "\\\"";
+                break;
+            case '\\':
+                out += "\\\\";
+                break;
+            case '\n':
+                out += "\\n";
+                break;
+            case '\r':
+                out += "\\r";
+                break;
+            case '\t':
+                out += "\\t";
+                break;
+            default:
+                if( c < 0x20 ) {
+                    out += "\\u00";
+                    out += hex[ c >> 4 ];
+                    out += hex[ c & 0x0f ];
+                }
+                else if( c < 0x80 || utf8 ) {
+                    out += static_cast<char>( c );
+                }
+                else {
+                    // ISO8859-1 to UTF-8
+                    out += static_cast<char>( 0xc0 | ( c >> 6 ) );
+                    out += static_cast<char>( 0x80 | ( c & 0x3f ) );
+                }
+        }
+    }
+    out += '"';
+}
+
+void sosicon::ConverterSosi2geojson::
+appendPositions( std::string& out, const GeometryBuffer& coords,
+                 size_t begin, size_t end, int precision, bool reverse ) {
+    out += '[';
+    for( size_t n = begin; n < end; n++ ) {
+        size_t i = reverse ? end - 1 - ( n - begin ) : n;
+        if( n > begin ) {
+            out += ',';
+        }
+        out += '[';
+        utils::appendFixed( out, coords.x( i ), precision );
+        out += ',';
+        utils::appendFixed( out, coords.y( i ), precision );
+        out += ']';
+    }
+    out += ']';
+}
+
+void sosicon::ConverterSosi2geojson::
+formatFeature( const Feature& f, bool first, std::string& out ) const {
+
+    if( !mCmd->mSequence && !first ) {
+        out += ",\n";
+    }
+    out += "{\"type\":\"Feature\"";
+    if( f.mId >= 0 ) {
+        out += ",\"id\":" + std::to_string( f.mId );
+    }
+
+    out += ",\"properties\":{";
+    for( std::vector< std::pair<std::string,std::string> >::const_iterator i = f.mFields.begin(); i != f.mFields.end(); i++ ) {
+        if( i != f.mFields.begin() ) {
+            out += ',';
+        }
+        appendString( out, i->first, false );
+        out += ':';
+        appendString( out, i->second, f.mUtf8 );
+    }
+    out += "},\"geometry\":";
+
+    switch( f.mGeomType ) {
+        case wkt_point:
+            out += "{\"type\":\"Point\",\"coordinates\":[";
+            utils::appendFixed( out, f.mGeom.x( 0 ), f.mPrecision );
+            out += ',';
+            utils::appendFixed( out, f.mGeom.y( 0 ), f.mPrecision );
+            out += "]}";
+            break;
+        case wkt_linestring:
+            out += "{\"type\":\"LineString\",\"coordinates\":";
+            appendPositions( out, f.mGeom, 0, f.mGeom.size(), f.mPrecision, false );
+            out += '}';
+            break;
+        case wkt_polygon:
+            // Rings are stored with the outer ring clockwise and holes counter-clockwise.
+            // RFC 7946 asks for the opposite, so all rings are written last to first.
+            out += "{\"type\":\"Polygon\",\"coordinates\":[";
+            appendPositions( out, f.mGeom, 0, f.mGeom.size(), f.mPrecision, true );
+            for( size_t k = 0; k < f.mHoles.numParts(); k++ ) {
+                out += ',';
+                appendPositions( out, f.mHoles, f.mHoles.partBegin( k ), f.mHoles.partEnd( k ), f.mPrecision, true );
+            }
+            out += "]}";
+            break;
+        default:
+            out += "null";
+    }
+    out += '}';
+    if( mCmd->mSequence ) {
+        out += '\n';
+    }
+}
+
+void sosicon::ConverterSosi2geojson::
+encodeFeature( NoBatchEncoder&, const Feature& f, size_t index, std::string& out ) const {
+    // mFeatureCount is the number of features written before the batch
+    formatFeature( f, mFeatureCount + index == 0, out );
+}
+
+void sosicon::ConverterSosi2geojson::
+writeFeature( const Feature&, const char* data, size_t size ) {
+    mOutput.write( data, size );
+    mFeatureCount++;
+}
+
+void sosicon::ConverterSosi2geojson::
+run( bool* ) {
+
+    if( mCmd->mSrid.empty() ) {
+        // RFC 7946 coordinates are WGS 84 longitude and latitude
+        mCmd->mSrid = "4326";
+    }
+
+    std::string defaultOutputFile = mCmd->mOutputFile;
+    if( defaultOutputFile.empty() ) {
+        defaultOutputFile = mCmd->mSequence ? "sosicon.geojsons" : "sosicon.geojson";
+    }
+    std::string outputFileName = utils::nonExistingFilename( defaultOutputFile );
+    mOutput.open( outputFileName.c_str(), std::ios::out | std::ios::trunc | std::ios::binary );
+    if( !mOutput ) {
+        sosicon::logstream << "Could not write " << outputFileName << "\n";
+        return;
+    }
+
+    if( !mCmd->mSequence ) {
+        mOutput << "{\"type\":\"FeatureCollection\",\"features\":[\n";
+    }
+    for( std::vector<std::string>::iterator f = mCmd->mSourceFiles.begin(); f != mCmd->mSourceFiles.end(); f++ ) {
+        parseFile( *f );
+    }
+    completeBatch();
+    if( !mCmd->mSequence ) {
+        mOutput << "\n]}\n";
+    }
+    mOutput.close();
+    mGeometryCache.clear();
+
+    sosicon::logstream << mFeatureCount << " features written to " << outputFileName << "\n";
+    checkFailures();
+    sosicon::logstream << "Done!\n";
+}
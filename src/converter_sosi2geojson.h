@@ -0,0 +1,161 @@
+/*
+ *  This file is part of the command-line tool sosicon.
+ *  Copyright (C) 2014  Espen Andersen, Norwegian Broadcast Corporation (NRK)
+ *
+ *  This is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __CONVERTER_SOSI2GEOJSON_H__
+#define __CONVERTER_SOSI2GEOJSON_H__
+
+#include "logger.h"
+#include <iostream>
+#include <fstream>
+#include <algorithm>
+#include <vector>
+#include <map>
+#include "converter_sosi_stream.h"
+#include "interface/i_converter.h"
+#include "interface/i_sosi_element.h"
+#include "sosi/sosi_types.h"
+#include "sosi/sosi_element_index.h"
+#include "sosi/sosi_element_search.h"
+#include "sosi/sosi_header_context.h"
+#include "sosi/sosi_north_east.h"
+#include "coordinate_collection.h"
+#include "feature_fields.h"
+#include "geometry_buffer.h"
+#include "geometry_cache.h"
+#include "projection.h"
+#include "command_line.h"
+#include "common_types.h"
+#include "utils.h"
+#include "parser.h"
+
+namespace sosicon {
+
+    //! Feature taken over from the parser by ConverterSosi2geojson, waiting to be formatted
+    struct GeojsonBatchFeature {
+        Wkt mGeomType;                                              //!< Geometry type, or wkt_unknown for no geometry
+        long long mId;                                              //!< SOSI serial number, or -1 if none
+        int mPrecision;                                             //!< Number of decimals in coordinates
+        bool mUtf8;                                                 //!< True if field values are UTF-8, else ISO8859-1
+        std::vector< std::pair<std::string,std::string> > mFields;  //!< Attribute values by field name
+        GeometryBuffer mGeom;                                       //!< Point, curve, or outer ring of surface
+        GeometryBuffer mHoles;                                      //!< Surface holes, one part per ring
+    };
+
+    /*!
+        \addtogroup converters
+        @{
+    */
+    //! SOSI to GeoJSON converter
+    /*!
+        If command-line parameter -2geojson is specified, this converter will handle the output
+        generation. Produces a GeoJSON FeatureCollection from the SOSI source(s), or, with
+        -seq, newline-delimited GeoJSON (GeoJSONSeq) with one feature per line. Coordinates
+        are given in EPSG:4326 unless -srid says otherwise.
+
+        The source files are parsed in streaming mode. The attributes and the assembled
+        geometry of each feature are taken over from the parser into a batch, and the batch
+        is formatted as JSON when full. With -j, the batch is split among worker threads,
+        each formatting its share into a buffer of its own, and the buffers are written in
+        feature order.
+     */
+    class ConverterSosi2geojson : public ConverterSosiBatch<GeojsonBatchFeature, NoBatchEncoder> {
+
+        //! Feature taken over from the parser, waiting to be formatted
+        typedef GeojsonBatchFeature Feature;
+
+        //! Target file
+        std::ofstream mOutput;
+
+        //! Number of decimals in coordinates for the source file in process
+        int mPrecision;
+
+        //! Number of features written
+        int mFeatureCount;
+
+        //! Take over feature from the parser
+        /*!
+            Extracts the attributes and assembles the geometry into the next free batch
+            entry, so that the feature may be formatted after the parser has freed it.
+            \sa sosicon::ConverterSosiBatch::takeFeature()
+        */
+        virtual void takeFeature( ISosiElement* feature );
+
+        //! Format one feature as GeoJSON
+        /*!
+            \sa sosicon::ConverterSosiBatch::encodeFeature()
+        */
+        virtual void encodeFeature( NoBatchEncoder&, const Feature& f, size_t index, std::string& out ) const;
+
+        //! Write one formatted feature
+        /*!
+            \sa sosicon::ConverterSosiBatch::writeFeature()
+        */
+        virtual void writeFeature( const Feature& f, const char* data, size_t size );
+
+        //! Format one feature as GeoJSON
+        /*!
+            \param f The feature.
+            \param first True if this is the first feature of the output file.
+            \param out The JSON text is appended to this string.
+        */
+        void formatFeature( const Feature& f, bool first, std::string& out ) const;
+
+        //! Append JSON string literal
+        /*!
+            Escapes the string, converting ISO8859-1 to UTF-8 unless utf8 is set.
+        */
+        static void appendString( std::string& out, const std::string& str, bool utf8 );
+
+        //! Append JSON coordinate array [[x,y],...] of vertices [begin, end)
+        /*!
+            \param reverse If true, the vertices are given last to first.
+        */
+        static void appendPositions( std::string& out, const GeometryBuffer& coords,
+                                     size_t begin, size_t end, int precision, bool reverse );
+
+        //! Header context of a source file is set up
+        /*!
+            Sets up the coordinate precision for the grid of the source file. Source files
+            that cannot be transformed to the requested grid are skipped, and a warning is
+            logged if another grid than EPSG:4326 is requested by -srid.
+            \sa sosicon::ConverterSosiStream::onHeader()
+         */
+        virtual bool onHeader();
+
+    public:
+
+        //! Constructor
+        ConverterSosi2geojson() :
+            mPrecision( 6 ),
+            mFeatureCount( 0 ) { };
+
+        //! Destructor
+        virtual ~ConverterSosi2geojson() { };
+
+        //! Start conversion
+        /*!
+            Implementation details in sosicon::IConverter::run()
+            \sa sosicon::IConverter::run()
+         */
+        virtual void run( bool* cancel = 0x00 );
+
+    }; // class ConverterSosi2geojson
+   /*! @} end group converters */
+
+}; // namespace sosicon
+
+#endif
@@ -0,0 +1,121 @@
+/*
+ *  This file is part of the command-line tool sosicon.
+ *  Copyright (C) 2014  Espen Andersen, Norwegian Broadcast Corporation (NRK)
+ *
+ *  This is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "converter_sosi2gpkg.h"
+
+int sosicon::ConverterSosi2gpkg::
+targetSrid() {
+    return mSrid;
+}
+
+bool sosicon::ConverterSosi2gpkg::
+onHeader() {
+    if( !mOk || !checkTransformation() ) {
+        return false;
+    }
+    if( !mGeopackage.hasSrs() ) {
+        // The tables are created with the grid actually read from the first source file
+        // accepted, which the source files that follow are transformed to
+        mSrid = mHeader.getSrid();
+        std::stringstream ss;
+        ss << mSrid;
+        sosi::CoordSys& cs = sosi::SosiTranslationTable().sridToCoordSys( ss.str() );
+        mOk = mGeopackage.setSrs( mSrid, cs.displayString(), cs.prjString() );
+    }
+    return mOk;
+}
+
+void sosicon::ConverterSosi2gpkg::
+onFeature( ISosiElement* feature ) {
+    if( mOk ) {
+        insertFeature( feature );
+    }
+}
+
+const std::string& sosicon::ConverterSosi2gpkg::
+tableName( const std::string& objType, Wkt geometryType ) {
+    const char* suffix = geometryType == wkt_point ? "point" : geometryType == wkt_linestring ? "linestring" : "polygon";
+    std::string key = objType + "\n" + suffix;
+    std::map<std::string, std::string>::iterator i = mTableNames.find( key );
+    if( i == mTableNames.end() ) {
+        // Lower case, with Norwegian characters substituted, as for column names
+        std::string name = utils::iso8859_1ToUtf8( utils::toFieldname( mHeader.toIso8859_1( objType ) ) );
+        name = name.empty() ? suffix : name + "_" + suffix;
+        i = mTableNames.insert( std::make_pair( key, name ) ).first;
+    }
+    return i->second;
+}
+
+void sosicon::ConverterSosi2gpkg::
+insertFeature( ISosiElement* feature ) {
+
+    CoordinateCollection cc( mHeader, &mGeometryCache );
+    Wkt geometryType = cc.extractGeometry( feature, mGeom, mHoles );
+    if( geometryType == wkt_unknown ) {
+        mSkipped++;
+        return;
+    }
+    fgb::NodeItem box;
+    box.minX = cc.getXmin();
+    box.minY = cc.getYmin();
+    box.maxX = cc.getXmax();
+    box.maxY = cc.getYmax();
+
+    bool utf8 = mHeader.getEncoding() == sosi::sosi_charset_utf8;
+    std::map<std::string,std::string> fields;
+    featureFields::extract( feature, fields );
+    mFields.clear();
+    for( std::map<std::string,std::string>::iterator i = fields.begin(); i != fields.end(); i++ ) {
+        std::string name = i->first;
+        if( name == "fid" || name == "geom" ) {
+            // Reserved by the primary key and geometry columns
+            name += "_";
+        }
+        std::string value = utils::copyNormalize( i->second, false );
+        mFields.push_back( std::make_pair( name, utf8 ? value : utils::iso8859_1ToUtf8( mHeader.toIso8859_1( value ) ) ) );
+    }
+    mOk = mGeopackage.insert( tableName( feature->getObjType(), geometryType ), geometryType, mGeom, mHoles, box, mFields );
+}
+
+void sosicon::ConverterSosi2gpkg::
+run( bool* ) {
+
+    mSrid = atoi( mCmd->mSrid.c_str() );
+    std::string fileName = utils::nonExistingFilename( mCmd->mOutputFile.empty() ? "sosicon.gpkg" : mCmd->mOutputFile );
+    if( !mGeopackage.create( fileName ) ) {
+        return;
+    }
+
+    for( std::vector<std::string>::iterator f = mCmd->mSourceFiles.begin(); mOk && f != mCmd->mSourceFiles.end(); f++ ) {
+        parseFile( *f );
+    }
+    mGeometryCache.clear();
+
+    if( mOk ) {
+        sosicon::logstream << "Building spatial index...\n";
+        mOk = mGeopackage.complete();
+    }
+    if( mOk ) {
+        sosicon::logstream << "    > " << fileName << " written, " << mGeopackage.numTables() << " tables, "
+                           << mGeopackage.numRows() << " features\n";
+    }
+    if( mSkipped > 0 ) {
+        sosicon::logstream << mSkipped << " features without valid geometry skipped\n";
+    }
+    checkFailures();
+    sosicon::logstream << "Done!\n";
+}
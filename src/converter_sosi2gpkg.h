@@ -0,0 +1,144 @@
+/*
+ *  This file is part of the command-line tool sosicon.
+ *  Copyright (C) 2014  Espen Andersen, Norwegian Broadcast Corporation (NRK)
+ *
+ *  This is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __CONVERTER_SOSI2GPKG_H__
+#define __CONVERTER_SOSI2GPKG_H__
+
+#include "logger.h"
+#include <iostream>
+#include <algorithm>
+#include <sstream>
+#include <vector>
+#include <map>
+#include "converter_sosi_stream.h"
+#include "interface/i_converter.h"
+#include "interface/i_sosi_element.h"
+#include "sosi/sosi_types.h"
+#include "sosi/sosi_element_index.h"
+#include "sosi/sosi_element_search.h"
+#include "sosi/sosi_header_context.h"
+#include "sosi/sosi_north_east.h"
+#include "sosi/sosi_translation_table.h"
+#include "gpkg/geopackage.h"
+#include "coordinate_collection.h"
+#include "feature_fields.h"
+#include "geometry_buffer.h"
+#include "geometry_cache.h"
+#include "command_line.h"
+#include "common_types.h"
+#include "utils.h"
+#include "parser.h"
+
+namespace sosicon {
+
+    /*!
+        \addtogroup converters
+        @{
+    */
+    //! SOSI to GeoPackage converter
+    /*!
+        If command-line parameter -2gpkg is specified, this converter will handle the output
+        generation. Produces one GeoPackage file with one feature table for each combination
+        of object type and geometry type (point, linestring and polygon) found in the SOSI
+        source(s), e.g. bygning_point or innsjoe_polygon.
+
+        The source files are parsed in streaming mode, and each feature is inserted as soon
+        as it is taken over from the parser. See gpkg::Geopackage for how the file is bulk
+        loaded and indexed.
+     */
+    class ConverterSosi2gpkg : public ConverterSosiStream {
+
+        //! EPSG code of the output coordinates
+        /*!
+            Given by -srid, or else by the first source file. The source files that follow
+            are transformed to the same grid.
+         */
+        int mSrid;
+
+        //! Output file
+        gpkg::Geopackage mGeopackage;
+
+        //! False if writing to the output file failed
+        bool mOk;
+
+        //! Work buffers of the feature being inserted
+        GeometryBuffer mGeom;
+        GeometryBuffer mHoles;
+        gpkg::Fields mFields;
+
+        //! Table names by object type and geometry type
+        std::map<std::string, std::string> mTableNames;
+
+        //! Number of features without valid geometry
+        int mSkipped;
+
+        //! Insert feature into the table of its object type and geometry type
+        /*!
+            Features without a valid geometry are skipped, as they cannot be indexed.
+         */
+        void insertFeature( ISosiElement* feature );
+
+        //! Get table name of object type and geometry type
+        const std::string& tableName( const std::string& objType, Wkt geometryType );
+
+        //! Output grid requested for the source file in process
+        /*!
+            mSrid, that is -srid, or the grid of the first source file.
+            \sa sosicon::ConverterSosiStream::targetSrid()
+         */
+        virtual int targetSrid();
+
+        //! Header context of a source file is set up
+        /*!
+            Registers the grid of the first source file as the spatial reference system of
+            the tables. Source files that cannot be transformed to the requested grid are
+            skipped.
+            \sa sosicon::ConverterSosiStream::onHeader()
+         */
+        virtual bool onHeader();
+
+        //! Receive feature from parser
+        /*!
+            Inserts the feature into the GeoPackage.
+            \sa sosicon::ConverterSosiStream::onFeature()
+         */
+        virtual void onFeature( ISosiElement* feature );
+
+    public:
+
+        //! Constructor
+        ConverterSosi2gpkg() :
+            mSrid( 0 ),
+            mOk( true ),
+            mSkipped( 0 ) { };
+
+        //! Destructor
+        virtual ~ConverterSosi2gpkg() { };
+
+        //! Start conversion
+        /*!
+            Implementation details in sosicon::IConverter::run()
+            \sa sosicon::IConverter::run()
+         */
+        virtual void run( bool* cancel = 0x00 );
+
+    }; // class ConverterSosi2gpkg
+   /*! @} end group converters */
+
+}; // namespace sosicon
+
+#endif
@@ -305,17 +305,14 @@ getSrid( ISosiElement* sosiTree ) {
 }
 
 void sosicon::ConverterSosi2mysql::
-insertPoint( ISosiElement* point,
-             std::string sridSource,
-             std::string sridDest,
-             std::string geomField ) {
+insertPoint( ISosiElement* point, SourceFile& src) {
 
     sosi::SosiElementSearch srcNe = sosi::SosiElementSearch( sosi::sosi_element_ne );
 
     if( point->getChild( srcNe ) ) {
 
-        sosi::SosiNorthEast ne = sosi::SosiNorthEast( srcNe.element() );
-        ICoordinate* coord = ne.front();
+        sosi::SosiNorthEast ne( srcNe.element(), src.mHeader );
+        const GeometryBuffer& coord = ne.getCoordinates();
         std::stringstream ss;
 
         std::map<std::string,std::string>* row = 0;
@@ -324,53 +321,49 @@ insertPoint( ISosiElement* point,
             row = new std::map<std::string,std::string>();
         }
 
-        ss.precision( 5 );
+        ss.precision( src.mPrecision );
         ss  << std::fixed
             << "ST_GeomFromText('POINT("
-            << coord->getE()
+            << coord.x( 0 )
             << " "
-            << coord->getN()
+            << coord.y( 0 )
             << ")',"
-            << sridSource
+            << src.mSridSource
             << ")";
 
         std::string data = ss.str();
 
         if( mCmd->mInsertStatements ) {
-            ( *row )[ geomField ] = data;
+            ( *row )[ mGeomField ] = data;
         }
 
-        FieldsList& hdr = ( *mFieldsListCollection[ wkt_point ] );
-        hdr[ geomField ].expand( data );
+        FieldsList& hdr = ( *src.mFieldsListCollection[ wkt_point ] );
+        hdr[ mGeomField ].expand( data );
 
         extractData( point, hdr, row );
 
         if( mCmd->mInsertStatements ) {
-            mRowsListCollection[ wkt_point ]->push_back( row );
+            src.mRowsListCollection[ wkt_point ]->push_back( row );
         }
     }
 }
 
 void sosicon::ConverterSosi2mysql::
-insertLineString( ISosiElement* lineString,
-                  std::string sridSource,
-                  std::string sridDest,
-                  std::string geomField ) {
+insertLineString( ISosiElement* lineString, SourceFile& src) {
 
-    CoordinateCollection cc;
+    CoordinateCollection cc( src.mHeader, &src.mGeometryCache );
     cc.discoverCoords( lineString );
 
-    std::vector<ICoordinate*> theGeom = cc.getGeom();
+    const GeometryBuffer& theGeom = cc.getGeom();
     std::stringstream ssGeomCoord;
 
-    ssGeomCoord.precision( 5 );
+    ssGeomCoord.precision( src.mPrecision );
     ssGeomCoord << std::fixed;
 
-    for( std::vector<ICoordinate*>::iterator i = theGeom.begin(); i != theGeom.end(); i++ ) {
-        ICoordinate* c = *i;
-        ssGeomCoord << c->getE()
+    for( size_t i = 0; i < theGeom.size(); i++ ) {
+        ssGeomCoord << theGeom.x( i )
                     << " "
-                    << c->getN()
+                    << theGeom.y( i )
                     << ",";
     }
 
@@ -381,7 +374,7 @@ insertLineString( ISosiElement* lineString,
     ss << "ST_GeomFromText('LINESTRING("
        << geom
        << ")',"
-       << sridSource
+       << src.mSridSource
        << ")";
 
     std::string data = ss.str();
@@ -389,42 +382,37 @@ insertLineString( ISosiElement* lineString,
     std::map<std::string,std::string>* row = 0;
     if( mCmd->mInsertStatements ) {
         row = new std::map<std::string,std::string>();
-        ( *row )[ geomField ] = data;
+        ( *row )[ mGeomField ] = data;
     }
 
-    FieldsList& hdr = ( *mFieldsListCollection[ wkt_linestring ] );
-    hdr[ geomField ].expand( data );
+    FieldsList& hdr = ( *src.mFieldsListCollection[ wkt_linestring ] );
+    hdr[ mGeomField ].expand( data );
 
     extractData( lineString, hdr, row );
 
     if( mCmd->mInsertStatements ) {
-        mRowsListCollection[ wkt_linestring ]->push_back( row );
+        src.mRowsListCollection[ wkt_linestring ]->push_back( row );
     }
 }
 
 void sosicon::ConverterSosi2mysql::
-insertPolygon( ISosiElement* polygon,
-               std::string sridSource,
-               std::string sridDest,
-               std::string geomField ) {
+insertPolygon( ISosiElement* polygon, SourceFile& src) {
 
-    CoordinateCollection cc;
+    CoordinateCollection cc( src.mHeader, &src.mGeometryCache );
     cc.discoverCoords( polygon );
 
-    std::vector<ICoordinate*> theGeom = cc.getGeom();
-    std::vector<ICoordinate*> theHoles = cc.getHoles();
-    std::vector<int> holeSizes = cc.getHoleSizes();
+    const GeometryBuffer& theGeom = cc.getGeom();
+    const GeometryBuffer& theHoles = cc.getHoles();
     std::stringstream ssGeomCoord;
 
-    ssGeomCoord.precision( 5 );
+    ssGeomCoord.precision( src.mPrecision );
     ssGeomCoord << std::fixed
                 << "(";
 
-    for( std::vector<ICoordinate*>::iterator i = theGeom.begin(); i != theGeom.end(); i++ ) {
-        ICoordinate* c = *i;
-        ssGeomCoord << c->getE()
+    for( size_t i = 0; i < theGeom.size(); i++ ) {
+        ssGeomCoord << theGeom.x( i )
                     << " "
-                    << c->getN()
+                    << theGeom.y( i )
                     << ",";
     }
 
@@ -433,32 +421,27 @@ insertPolygon( ISosiElement* polygon,
     geom += ")";
 
     std::stringstream ssHolesCoord;
-    ssHolesCoord.precision( 5 );
+    ssHolesCoord.precision( src.mPrecision );
     ssHolesCoord << std::fixed;
 
-    int offset = 0;
-    ICoordinate* first = 0, * last = 0;
-    for( std::vector<int>::iterator i = holeSizes.begin(); i != holeSizes.end(); i++ ) {
+    for( size_t k = 0; k < theHoles.numParts(); k++ ) {
+        size_t begin = theHoles.partBegin( k );
+        size_t end = theHoles.partEnd( k );
         ssHolesCoord << ",(";
-        for( int j = 0; j < *i; j++ ) {
-            ICoordinate* c = theHoles[ offset++ ];
-            if( j == 0 ) {
-                first = c;
-            }
-            else {
+        for( size_t i = begin; i < end; i++ ) {
+            if( i > begin ) {
                 ssHolesCoord << ",";
-                last = c;
             }
-            ssHolesCoord << c->getE()
+            ssHolesCoord << theHoles.x( i )
                          << " "
-                         << c->getN();
+                         << theHoles.y( i );
         }
-        if( !first->equals( last ) ) {
+        if( begin != end && !theHoles.equals( begin, end - 1 ) ) {
             // Close polygon if open
             ssHolesCoord << ","
-                         << first->getE()
+                         << theHoles.x( begin )
                          << " "
-                         << first->getN();
+                         << theHoles.y( begin );
         }
         ssHolesCoord << ")";
     }
@@ -468,7 +451,7 @@ insertPolygon( ISosiElement* polygon,
     ss << "ST_GeomFromText('POLYGON("
        << geom
        << ")',"
-       << sridSource
+       << src.mSridSource
        << ")";
 
     std::string data = ss.str();
@@ -476,60 +459,160 @@ insertPolygon( ISosiElement* polygon,
     std::map<std::string,std::string>* row = 0;
     if( mCmd->mInsertStatements ) {
         row = new std::map<std::string,std::string>();
-        ( *row )[ geomField ] = data;
+        ( *row )[ mGeomField ] = data;
     }
 
-    FieldsList& hdr = ( *mFieldsListCollection[ wkt_polygon ] );
-    hdr[ geomField ].expand( data );
+    FieldsList& hdr = ( *src.mFieldsListCollection[ wkt_polygon ] );
+    hdr[ mGeomField ].expand( data );
 
     extractData( polygon, hdr, row );
 
     if( mCmd->mInsertStatements ) {
-        mRowsListCollection[ wkt_polygon ]->push_back( row );
+        src.mRowsListCollection[ wkt_polygon ]->push_back( row );
     }
 }
 
 void sosicon::ConverterSosi2mysql::
-makemysql( ISosiElement* sosiTree,
-          std::string sridDest,
-          std::string,
-          std::string dbTable ) {
-
-    std::string sridSource = getSrid( sosiTree );
-    std::string geomField = dbTable + "_geom";
-    sosi::SosiTranslationTable ttbl;
-
-    std::vector<sosi::ElementType> pointTypes;
-    pointTypes.push_back( sosi::sosi_element_point );
-    pointTypes.push_back( sosi::sosi_element_text );
-    sosi::SosiElementSearch srcPoint = sosi::SosiElementSearch( pointTypes );
-    while( sosiTree->getChild( srcPoint ) ) {
-        if( objTypeExcluded( srcPoint ) ) continue;
-        insertPoint( srcPoint.element(), sridSource, sridDest, geomField );
-    }
-
-    std::vector<sosi::ElementType> lineStringTypes;
-    lineStringTypes.push_back( sosi::sosi_element_curve );
-    sosi::SosiElementSearch srcLineString = sosi::SosiElementSearch( lineStringTypes );
-    while( sosiTree->getChild( srcLineString ) ) {
-        if( objTypeExcluded( srcLineString ) ) continue;
-        insertLineString( srcLineString.element(), sridSource, sridDest, geomField );
-    }
-
-    std::vector<sosi::ElementType> polygonTypes;
-    polygonTypes.push_back( sosi::sosi_element_surface );
-    sosi::SosiElementSearch srcPolygon = sosi::SosiElementSearch( polygonTypes );
-    while( sosiTree->getChild( srcPolygon ) ) {
-        if( objTypeExcluded( srcPolygon ) ) continue;
-        insertPolygon( srcPolygon.element(), sridSource, sridDest, geomField );
+insertFeature( ISosiElement* feature, SourceFile& src ) {
+    if( objTypeExcluded( feature ) ) {
+        return;
+    }
+    switch( feature->getType() ) {
+        case sosi::sosi_element_point:
+        case sosi::sosi_element_text:
+            insertPoint( feature, src );
+            break;
+        case sosi::sosi_element_curve:
+            insertLineString( feature, src );
+            break;
+        case sosi::sosi_element_surface:
+            insertPolygon( feature, src );
+            break;
+        default:
+            break;
     }
 }
 
 bool sosicon::ConverterSosi2mysql::
-objTypeExcluded( sosi::SosiElementSearch& src )
+objTypeExcluded( ISosiElement* element )
 {
     std::vector<std::string>& ot = mCmd->mObjTypes;
-    return ot.size() > 0 && std::find( ot.begin(), ot.end(), utils::toLower( src.element()->getObjType() ) ) == ot.end();
+    return ot.size() > 0 && std::find( ot.begin(), ot.end(), utils::toLower( element->getObjType() ) ) == ot.end();
+}
+
+sosicon::ConverterSosi2mysql::SourceFile::
+SourceFile( ConverterSosi2mysql* converter ) : mConverter( converter ), mPrecision( 5 ) {
+
+    mFieldsListCollection[ wkt_point ] = new FieldsList();
+    mFieldsListCollection[ wkt_linestring ] = new FieldsList();
+    mFieldsListCollection[ wkt_polygon ] = new FieldsList();
+
+    mRowsListCollection[ wkt_point ] = new RowsList();
+    mRowsListCollection[ wkt_linestring ] = new RowsList();
+    mRowsListCollection[ wkt_polygon ] = new RowsList();
+}
+
+sosicon::ConverterSosi2mysql::SourceFile::
+~SourceFile() {
+    for( FieldsListCollection::iterator i = mFieldsListCollection.begin(); i != mFieldsListCollection.end(); i++ ) {
+        delete i->second;
+    }
+    for( RowsListCollection::iterator i = mRowsListCollection.begin(); i != mRowsListCollection.end(); i++ ) {
+        for( RowsList::iterator j = i->second->begin(); j != i->second->end(); j++ ) {
+            delete *j;
+        }
+        delete i->second;
+    }
+}
+
+void sosicon::ConverterSosi2mysql::SourceFile::
+onEvent( FeatureEvent& e, EventDispatcher<FeatureEvent>& ) {
+    if( e.mReleased ) {
+        std::string serial = e.mFeature->getSerial();
+        long long key;
+        if( sosi::SosiElementIndex::parseSerial( serial.data(), serial.data() + serial.size(), key ) ) {
+            mGeometryCache.erase( key );
+        }
+        return;
+    }
+    if( mSridSource.empty() ) {
+        mConverter->initSourceFile( *this, e.mFeature->getRoot() );
+    }
+    mConverter->insertFeature( e.mFeature, *this );
+}
+
+void sosicon::ConverterSosi2mysql::
+initSourceFile( SourceFile& src, ISosiElement* root ) {
+    src.mHeader = sosi::HeaderContext( root, atoi( mSridDest.c_str() ) );
+    src.mSridSource = getSrid( root );
+    if( src.mHeader.getSrid() == atoi( mSridDest.c_str() ) ) {
+        // Coordinates are transformed while read
+        src.mSridSource = mSridDest;
+    }
+    src.mPrecision = Projection( atoi( src.mSridSource.c_str() ) ).isGeographic() ? 9 : 5;
+}
+
+void sosicon::ConverterSosi2mysql::
+convertFile( size_t index, bool concurrent ) {
+    const std::string& sourceFile = mCmd->mSourceFiles[ index ];
+    if( !utils::fileExists( sourceFile ) ) {
+        sosicon::logstream << sourceFile << " not found\n";
+        return;
+    }
+    sosicon::logstream << "Reading " << sourceFile << "\n";
+    SourceFile* src = new SourceFile( this );
+    mSourceFiles[ index ] = src;
+    Parser p;
+    MappedFile mf;
+    mf.open( sourceFile );
+    p.streamFeatures( src, mf.begin(), mf.end() );
+    const char* blkBegin = 0;
+    const char* blkEnd = 0;
+    int n = 0;
+    if( mCmd->mCache && p.loadCache( sourceFile, mf.begin(), mf.end(), n, mCmd->mCacheHash ) ) {
+        sosicon::logstream << "Loaded from " << SosiCache::cacheFileName( sourceFile ) << "\n";
+    }
+    else if( mCmd->mThreads > 1 && !concurrent ) {
+        sosicon::logstream << "Parsing with " << mCmd->mThreads << " threads...";
+        n = p.parseParallel( mf.begin(), mf.end(), mCmd->mThreads );
+    }
+    else {
+        while( mf.getBlock( blkBegin, blkEnd ) ) {
+            n += p.ragelParseSosi( blkBegin, blkEnd );
+            if( !concurrent ) {
+                sosicon::logstream << "\rParsing line " << n;
+            }
+        }
+    }
+    p.complete();
+    p.commitCache( n );
+
+    mf.close();
+    sosicon::logstream << "\r" << n << " lines parsed        \n";
+    if( src->mSridSource.empty() ) {
+        getSrid( p.getRootElement() );
+    }
+}
+
+void sosicon::ConverterSosi2mysql::
+commitFile( size_t index ) {
+    SourceFile* src = mSourceFiles[ index ];
+    if( !src ) {
+        return;
+    }
+    for( FieldsListCollection::iterator i = src->mFieldsListCollection.begin(); i != src->mFieldsListCollection.end(); i++ ) {
+        FieldsList& hdr = *mFieldsListCollection[ i->first ];
+        for( FieldsList::iterator f = i->second->begin(); f != i->second->end(); f++ ) {
+            hdr[ f->first ].merge( f->second );
+        }
+    }
+    for( RowsListCollection::iterator i = src->mRowsListCollection.begin(); i != src->mRowsListCollection.end(); i++ ) {
+        RowsList* rows = mRowsListCollection[ i->first ];
+        rows->insert( rows->end(), i->second->begin(), i->second->end() );
+        i->second->clear();
+    }
+    delete src;
+    mSourceFiles[ index ] = 0;
 }
 
 void sosicon::ConverterSosi2mysql::
@@ -543,45 +626,22 @@ run( bool* ) {
     mRowsListCollection[ wkt_linestring ] = new RowsList();
     mRowsListCollection[ wkt_polygon ] = new RowsList();
 
-    std::string sridDest = mCmd->mSrid.empty() ? "4326" : mCmd->mSrid;
+    mSridDest = mCmd->mSrid.empty() ? "4326" : mCmd->mSrid;
 
     std::string dbSchema = mCmd->mDbSchema.empty() ? "sosicon" : mCmd->mDbSchema;
     std::string dbTable = mCmd->mDbTable.empty() ? "object" : mCmd->mDbTable;
-    std::string geomField = dbTable + "_geom";
+    mGeomField = dbTable + "_geom";
 
-    ( *mFieldsListCollection[ wkt_point ] )[ geomField ] = Field();
-    ( *mFieldsListCollection[ wkt_linestring ] )[ geomField ] = Field();
-    ( *mFieldsListCollection[ wkt_polygon ] )[ geomField ] = Field();
+    ( *mFieldsListCollection[ wkt_point ] )[ mGeomField ] = Field();
+    ( *mFieldsListCollection[ wkt_linestring ] )[ mGeomField ] = Field();
+    ( *mFieldsListCollection[ wkt_polygon ] )[ mGeomField ] = Field();
 
-    for( std::vector<std::string>::iterator f = mCmd->mSourceFiles.begin(); f != mCmd->mSourceFiles.end(); f++ ) {
-        mCurrentSourcefile = *f;
-        if( !utils::fileExists( mCurrentSourcefile ) ) {
-            sosicon::logstream << mCurrentSourcefile << " not found\n";
-        }
-        else {
-            sosicon::logstream << "Reading " << mCurrentSourcefile << "\n";
-            Parser p;
-            char ln[ 1024 ];
-            std::ifstream ifs( mCurrentSourcefile.c_str() );
-            int n = 0;
-            while( !ifs.eof() ) {
-                if( ++n % 100 == 0 ) {
-                    sosicon::logstream << "\rParsing line " << n;
-                }
-               memset( ln, 0x00, sizeof ln );
-                ifs.getline( ln, sizeof ln );
-                p.ragelParseSosiLine( ln );
-            }
-            p.complete();
+    FileBatch batch( mCmd->mSourceFiles, mCmd->mThreads );
+    mSourceFiles.assign( batch.size(), 0 );
+    batch.run( [ this, &batch ]( size_t i ) { convertFile( i, batch.concurrent() ); },
+               [ this ]( size_t i ) { commitFile( i ); } );
 
-            ifs.close();
-            sosicon::logstream << "\r" << n << " lines parsed        \n";
-            sosicon::logstream << "Building MySQL export...\n";
-            ISosiElement* root = p.getRootElement();
-            makemysql( root, sridDest, dbSchema, dbTable );
-        }
-    }
-    writemysql( sridDest, dbSchema, dbTable );
+    writemysql( mSridDest, dbSchema, dbTable );
     cleanup();
     sosicon::logstream << "Done!\n";
 }
@@ -25,6 +25,8 @@
 #include <sstream>
 #include <vector>
 #include <climits>
+#include <limits>
+#include <algorithm>
 #include <cmath>
 #include <map>
 #include "utils.h"
@@ -33,9 +35,13 @@
 #include "sosi/sosi_types.h"
 #include "sosi/sosi_translation_table.h"
 #include "coordinate_collection.h"
+#include "geometry_cache.h"
+#include "sosi/sosi_header_context.h"
 #include "sosi/sosi_north_east.h"
+#include "projection.h"
 #include "command_line.h"
 #include "common_types.h"
+#include "file_batch.h"
 #include "parser.h"
 
 namespace sosicon {
@@ -48,6 +54,12 @@ namespace sosicon {
     /*!
         If command-line parameter -2mysql is specified, this converter will handle the output
         generation. Produces a PostgreSQL/PostGIS dump file from the SOSI source(s).
+        The source files are parsed in streaming mode, so that only the extracted rows, not
+        the complete element tree, are held in memory.
+
+        With -j and more than one source file, the files are converted at the same time,
+        each into rows of its own, which are appended to the tables in source file order
+        (see sosicon::FileBatch).
      */
     class ConverterSosi2mysql : public IConverter {
 
@@ -74,6 +86,7 @@ namespace sosicon {
             Field() {
                 mIsNumeric = true;
                 mMaxLength = 0;
+                mMinLength = std::numeric_limits<std::string::size_type>::max();
             }
             Field( std::string& str ) {
                 mIsNumeric = true;
@@ -90,6 +103,11 @@ namespace sosicon {
                 }
                 return mMaxLength;
             }
+            void merge( const Field& other ) {
+                mMinLength = std::min( mMinLength, other.mMinLength );
+                mMaxLength = std::max( mMaxLength, other.mMaxLength );
+                mIsNumeric = mIsNumeric && other.mIsNumeric;
+            }
         };
 
         typedef std::map< std::string,Field > FieldsList;
@@ -97,11 +115,65 @@ namespace sosicon {
         typedef std::vector< std::map< std::string,std::string >* > RowsList;
         typedef std::map< Wkt, RowsList* > RowsListCollection;
 
+        //! Source file in process
+        /*!
+            Holds the state of one source file, so that several files may be converted at
+            the same time. Receives the features of the file from the parser, and collects
+            the field statistics and the converted rows, until they are merged into the
+            tables of the converter by commitFile().
+         */
+        class SourceFile : public FeatureEventDispatcher::Listener {
+
+            //! Converter receiving the features
+            ConverterSosi2mysql* mConverter;
+
+        public:
+
+            //! Header context of the file
+            sosi::HeaderContext mHeader;
+
+            //! Spatial reference grid ID for the coordinates, set by the first feature
+            std::string mSridSource;
+
+            //! Number of decimals in WKT coordinates (more for geographic coordinates)
+            int mPrecision;
+
+            //! Decoded curves referred to by surfaces not yet converted
+            GeometryCache mGeometryCache;
+
+            //! Collection of fields, one item for each geometry type
+            FieldsListCollection mFieldsListCollection;
+
+            //! Collection of rows, one item for each geometry type
+            RowsListCollection mRowsListCollection;
+
+            //! Constructor
+            /*!
+                \param converter Converter receiving the features.
+             */
+            SourceFile( ConverterSosi2mysql* converter );
+
+            //! Destructor
+            /*!
+                Releases the rows not handed over to the converter.
+             */
+            virtual ~SourceFile();
+
+            //! Receive feature from parser
+            /*!
+                Called by the parser for each feature in the source file, and for each
+                surface REF target when it is no longer needed.
+                \sa sosicon::Parser::streamFeatures()
+             */
+            virtual void onEvent( FeatureEvent& e, EventDispatcher<FeatureEvent>& d );
+
+        }; // class SourceFile
+
         //! Command line wrapper
         CommandLine* mCmd;
 
-        //! Souce file currently in process
-        std::string mCurrentSourcefile;
+        //! Source files in process, or converted but not yet committed
+        std::vector<SourceFile*> mSourceFiles;
 
         //! Collection of fields, one item for each geometry type
         FieldsListCollection mFieldsListCollection;
@@ -109,6 +181,12 @@ namespace sosicon {
         //! Collection of rows, one item for each geometry type
         RowsListCollection mRowsListCollection;
 
+        //! Spatial reference grid ID for the target file
+        std::string mSridDest;
+
+        //! Name of the geometry field within the recordset
+        std::string mGeomField;
+
         //! Build SQL insert statements for all geometries
         /*!
             This function calls sosicon::ConverterSosi2mysql::buildInsertStatement
@@ -226,15 +304,9 @@ namespace sosicon {
             \see sosicon::ConverterSosi2mysql::insertPoint()
             \see sosicon::ConverterSosi2mysql::insertPolygon()
             \param lineString SOSI geometry element (typically "KURVE").
-            \param sridSource Spatial reference grid ID for the source file.
-            \param sridDest Spatial reference grid ID for the target file.
-            \param geomField The name of the field within the recordset
-                             representing the geometry data.
+            \param src Source file of the element.
         */
-        void insertLineString( ISosiElement* lineString,
-                               std::string sridSource,
-                               std::string sridDest,
-                               std::string geomField );
+        void insertLineString( ISosiElement* lineString, SourceFile& src );
 
         //! Convert single point geomery (sosi PUNKT) to SQL export data
         /*!
@@ -243,15 +315,9 @@ namespace sosicon {
             \see sosicon::ConverterSosi2mysql::insertLineString()
             \see sosicon::ConverterSosi2mysql::insertPolygon()
             \param point SOSI geometry element (typically "PUNKT" or "TEKST").
-            \param sridSource Spatial reference grid ID for the source file.
-            \param sridDest Spatial reference grid ID for the target file.
-            \param geomField The name of the field within the recordset
-                             representing the geometry data.
+            \param src Source file of the element.
         */
-        void insertPoint( ISosiElement* point,
-                          std::string sridSource,
-                          std::string sridDest,
-                          std::string geomField );
+        void insertPoint( ISosiElement* point, SourceFile& src );
 
         //! Convert polygons (sosi FLATE) to SQL export data
         /*!
@@ -260,44 +326,56 @@ namespace sosicon {
             \see sosicon::ConverterSosi2mysql::insertLineString()
             \see sosicon::ConverterSosi2mysql::insertPoint()
             \param point SOSI geometry element (typically "FLATE").
-            \param sridSource Spatial reference grid ID for the source file.
-            \param sridDest Spatial reference grid ID for the target file.
-            \param geomField The name of the field within the recordset
-                             representing the geometry data.
+            \param src Source file of the element.
         */
-        void insertPolygon( ISosiElement* polygon,
-                            std::string sridSource,
-                            std::string sridDest,
-                            std::string geomField );
+        void insertPolygon( ISosiElement* polygon, SourceFile& src );
 
-        //! Make SQL dump from SOSI tree
+        //! Convert feature to SQL export data
         /*!
-            Iterates the SOSI tree once for each geometry to be exported, extracting
-            relevant elements and passing them on to one of the insertion routines.
-            \param sosiTree Pointer to the root SOSI element.
-            \param sridDest Spatial reference grid ID for the target file.
-            \param dbSchema String representing the name of the database schema.
-            \param dbTable String representing the base name of the database table.
-                           The name of the geometry for that table will be prepended
-                           to the base name.
+            Passes the feature on to one of the insertion routines, according to its
+            geometry type. Features of other types, and features filtered out by the -t
+            parameter, are ignored.
+            \param feature Top-level SOSI element.
+            \param src Source file of the feature.
             \see sosicon::ConverterSosi2mysql::insertPoint()
             \see sosicon::ConverterSosi2mysql::insertLineString()
             \see sosicon::ConverterSosi2mysql::insertPolygon()
         */
-        void makemysql( ISosiElement* sosiTree,
-                       std::string sridDest,
-                       std::string dbSchema,
-                       std::string dbTable );
+        void insertFeature( ISosiElement* feature, SourceFile& src );
+
+        //! Prepare source file for its first feature
+        /*!
+            Reads the header of the source file, and decides whether its coordinates are
+            transformed while read.
+            \param src Source file.
+            \param root Root element of the source file.
+         */
+        void initSourceFile( SourceFile& src, ISosiElement* root );
+
+        //! Convert one source file
+        /*!
+            \param index Position of the file among the source files.
+            \param concurrent True if other files are converted at the same time. The file
+                   is then parsed on the calling thread only.
+         */
+        void convertFile( size_t index, bool concurrent );
+
+        //! Merge converted source file into the tables of the converter
+        /*!
+            Called for each source file in turn, in source file order.
+            \param index Position of the file among the source files.
+         */
+        void commitFile( size_t index );
 
         //! Test if current element is filtered out by -t parameter
         /*!
             If the user uses the -t parameter to specify which OBJTYPE elements to
             include in the export, this function tests if current element is opted
             out of the export.
-            \param src SOSI element serch result to test.
+            \param element SOSI element to test.
             \return True if current element should be excluded from the export file.
         */
-        bool objTypeExcluded( sosi::SosiElementSearch& src );
+        bool objTypeExcluded( ISosiElement* element );
 
         //! Write SQL content
         /*!
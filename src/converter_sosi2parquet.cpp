@@ -0,0 +1,109 @@
+/*
+ *  This file is part of the command-line tool sosicon.
+ *  Copyright (C) 2014  Espen Andersen, Norwegian Broadcast Corporation (NRK)
+ *
+ *  This is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "converter_sosi2parquet.h"
+
+int sosicon::ConverterSosi2parquet::
+targetSrid() {
+    return mSrid;
+}
+
+bool sosicon::ConverterSosi2parquet::
+onHeader() {
+    if( !checkTransformation() ) {
+        return false;
+    }
+    // The table is labelled with the grid actually read, which is the requested one for
+    // all but the first source file
+    mSrid = mHeader.getSrid();
+    return true;
+}
+
+void sosicon::ConverterSosi2parquet::
+takeFeature( ISosiElement* feature ) {
+
+    ParquetBatchFeature& f = nextFeature();
+    f.mProperties.clear();
+
+    CoordinateCollection cc( mHeader, &mGeometryCache );
+    f.mGeometryType = cc.extractGeometry( feature, f.mGeom, f.mHoles );
+    if( f.mGeometryType == wkt_unknown ) {
+        mSkipped++;
+        return;
+    }
+    f.mBox.minX = cc.getXmin();
+    f.mBox.minY = cc.getYmin();
+    f.mBox.maxX = cc.getXmax();
+    f.mBox.maxY = cc.getYmax();
+
+    // Column indices are assigned here, in feature order, so that the encoding
+    // threads only read the table
+    if( !mTable ) {
+        mTable = new arrow::FeatureTable( mFileName, mSrid );
+    }
+    bool utf8 = mHeader.getEncoding() == sosi::sosi_charset_utf8;
+    std::map<std::string,std::string> fields;
+    featureFields::extract( feature, fields );
+    for( std::map<std::string,std::string>::iterator i = fields.begin(); i != fields.end(); i++ ) {
+        std::string value = utils::copyNormalize( i->second, false );
+        f.mProperties.push_back( std::make_pair( mTable->columnIndex( i->first ),
+                                                 utf8 ? value : utils::iso8859_1ToUtf8( mHeader.toIso8859_1( value ) ) ) );
+    }
+    commitFeature();
+}
+
+void sosicon::ConverterSosi2parquet::
+encodeFeature( WkbWriter& wkb, const ParquetBatchFeature& f, size_t, std::string& out ) const {
+    arrow::FeatureTable::encodeFeature( wkb, f.mGeometryType, f.mGeom, f.mHoles, f.mProperties, out );
+}
+
+void sosicon::ConverterSosi2parquet::
+writeFeature( const ParquetBatchFeature& f, const char* data, size_t size ) {
+    mTable->append( data, size, f.mBox, f.mGeometryType );
+}
+
+void sosicon::ConverterSosi2parquet::
+run( bool* ) {
+
+    bool arrowIpc = mCmd->mCommand == "-2arrow";
+    mSrid = atoi( mCmd->mSrid.c_str() );
+    std::string defaultOutputFile = arrowIpc ? "sosicon.arrow" : "sosicon.parquet";
+    mFileName = utils::nonExistingFilename( mCmd->mOutputFile.empty() ? defaultOutputFile : mCmd->mOutputFile );
+
+    for( std::vector<std::string>::iterator f = mCmd->mSourceFiles.begin(); f != mCmd->mSourceFiles.end(); f++ ) {
+        parseFile( *f );
+    }
+    completeBatch();
+    mGeometryCache.clear();
+
+    if( !mTable ) {
+        mTable = new arrow::FeatureTable( mFileName, mSrid );
+    }
+    arrow::IpcWriter ipcWriter;
+    parquet::ParquetWriter parquetWriter( mCmd->mThreads );
+    IBatchWriter& writer = arrowIpc ? static_cast<IBatchWriter&>( ipcWriter ) : static_cast<IBatchWriter&>( parquetWriter );
+    if( mTable->complete( writer, mCmd->mThreads ) ) {
+        sosicon::logstream << "    > " << mTable->fileName() << " written, " << mTable->size() << " features\n";
+    }
+    delete mTable;
+    mTable = 0;
+    if( mSkipped > 0 ) {
+        sosicon::logstream << mSkipped << " features without valid geometry skipped\n";
+    }
+    checkFailures();
+    sosicon::logstream << "Done!\n";
+}
@@ -0,0 +1,150 @@
+/*
+ *  This file is part of the command-line tool sosicon.
+ *  Copyright (C) 2014  Espen Andersen, Norwegian Broadcast Corporation (NRK)
+ *
+ *  This is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __CONVERTER_SOSI2PARQUET_H__
+#define __CONVERTER_SOSI2PARQUET_H__
+
+#include "logger.h"
+#include <iostream>
+#include <algorithm>
+#include <vector>
+#include <map>
+#include "converter_sosi_stream.h"
+#include "interface/i_converter.h"
+#include "interface/i_sosi_element.h"
+#include "sosi/sosi_types.h"
+#include "sosi/sosi_element_index.h"
+#include "sosi/sosi_element_search.h"
+#include "sosi/sosi_header_context.h"
+#include "sosi/sosi_north_east.h"
+#include "arrow/feature_table.h"
+#include "arrow/ipc_writer.h"
+#include "parquet/parquet_writer.h"
+#include "coordinate_collection.h"
+#include "feature_fields.h"
+#include "geometry_buffer.h"
+#include "geometry_cache.h"
+#include "command_line.h"
+#include "common_types.h"
+#include "utils.h"
+#include "wkb_writer.h"
+#include "parser.h"
+
+namespace sosicon {
+
+    //! Feature taken over from the parser by ConverterSosi2parquet, waiting to be encoded
+    struct ParquetBatchFeature {
+        Wkt mGeometryType;              //!< Geometry type, or wkt_unknown if not valid
+        fgb::Properties mProperties;    //!< Attribute values, UTF-8, by column index
+        GeometryBuffer mGeom;           //!< Point, curve, or outer ring of surface
+        GeometryBuffer mHoles;          //!< Surface holes, one part per ring
+        fgb::NodeItem mBox;             //!< Bounding box of the geometry
+    };
+
+    /*!
+        \addtogroup converters
+        @{
+    */
+    //! SOSI to GeoParquet and Arrow IPC converter
+    /*!
+        If command-line parameter -2parquet or -2arrow is specified, this converter will
+        handle the output generation. Produces one GeoParquet file (-2parquet) or one Arrow
+        IPC file (-2arrow) holding all features of the SOSI source(s), with WKB geometry, a
+        bbox column for bounding box filtering, and one typed column per attribute.
+
+        The source files are parsed in streaming mode. As for -2fgb, the features are taken
+        over from the parser into a batch, which is encoded by the worker threads given by
+        -j when full. The encoded features are spooled by arrow::FeatureTable until the
+        column types are known at the end.
+     */
+    class ConverterSosi2parquet : public ConverterSosiBatch<ParquetBatchFeature, WkbWriter> {
+
+        //! EPSG code of the output coordinates
+        /*!
+            Given by -srid, or else by the first source file. The source files that follow
+            are transformed to the same grid.
+         */
+        int mSrid;
+
+        //! Output table, created with the first feature
+        arrow::FeatureTable* mTable;
+
+        //! Output file path
+        std::string mFileName;
+
+        //! Number of features without valid geometry
+        int mSkipped;
+
+        //! Take over feature from the parser
+        /*!
+            Assembles the geometry and extracts the attributes into the next free batch
+            entry. Features without a valid geometry are skipped.
+            \sa sosicon::ConverterSosiBatch::takeFeature()
+        */
+        virtual void takeFeature( ISosiElement* feature );
+
+        //! Encode one feature as a table row
+        /*!
+            \sa sosicon::ConverterSosiBatch::encodeFeature()
+        */
+        virtual void encodeFeature( WkbWriter& wkb, const ParquetBatchFeature& f, size_t index, std::string& out ) const;
+
+        //! Append one encoded feature to the table
+        /*!
+            \sa sosicon::ConverterSosiBatch::writeFeature()
+        */
+        virtual void writeFeature( const ParquetBatchFeature& f, const char* data, size_t size );
+
+        //! Output grid requested for the source file in process
+        /*!
+            mSrid, that is -srid, or the grid of the first source file.
+            \sa sosicon::ConverterSosiStream::targetSrid()
+         */
+        virtual int targetSrid();
+
+        //! Header context of a source file is set up
+        /*!
+            Takes the output grid from the first source file, unless given by -srid. Source
+            files that cannot be transformed to the output grid are skipped.
+            \sa sosicon::ConverterSosiStream::onHeader()
+         */
+        virtual bool onHeader();
+
+    public:
+
+        //! Constructor
+        ConverterSosi2parquet() :
+            mSrid( 0 ),
+            mTable( 0 ),
+            mSkipped( 0 ) { };
+
+        //! Destructor
+        virtual ~ConverterSosi2parquet() { delete mTable; };
+
+        //! Start conversion
+        /*!
+            Implementation details in sosicon::IConverter::run()
+            \sa sosicon::IConverter::run()
+         */
+        virtual void run( bool* cancel = 0x00 );
+
+    }; // class ConverterSosi2parquet
+   /*! @} end group converters */
+
+}; // namespace sosicon
+
+#endif
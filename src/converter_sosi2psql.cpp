@@ -77,14 +77,14 @@ buildCreateStatement( Wkt wktGeom,
         for( itrFields = f->begin(); itrFields != f->end(); itrFields++ ) {
            std::string field = itrFields->first;
            std::string::size_type len = itrFields->second.length();
-           bool isNumeric = itrFields->second.isNumeric();
+           int intSize = integerSize( itrFields->second );
            if( field != geomField ) {
-               if( isNumeric && len < 10 ) {
+               if( intSize == 4 ) {
                    ss << ","
                       << field
                       << " INTEGER";
                }
-               else if( isNumeric && len < 19 ) {
+               else if( intSize == 8 ) {
                    ss << ","
                       << field
                       << " BIGINT";
@@ -123,43 +123,44 @@ buildCreateStatement( Wkt wktGeom,
     return ss.str();
 }
 
-std::string sosicon::ConverterSosi2psql::
-buildInsertStatements( std::string dbSchema,
+void sosicon::ConverterSosi2psql::
+writeInsertStatements( std::ostream& os,
+                       std::string dbSchema,
                        std::string dbTable ) {
 
-    std::string sql;
-    sql  = buildInsertStatement( wkt_point,
-                                 dbSchema,
-                                 dbTable );
+    writeInsertStatement( os,
+                          wkt_point,
+                          dbSchema,
+                          dbTable );
 
-    sql += buildInsertStatement( wkt_linestring,
-                                 dbSchema,
-                                 dbTable );
+    writeInsertStatement( os,
+                          wkt_linestring,
+                          dbSchema,
+                          dbTable );
 
-    sql += buildInsertStatement( wkt_polygon,
-                                 dbSchema,
-                                 dbTable );
-    return sql;
+    writeInsertStatement( os,
+                          wkt_polygon,
+                          dbSchema,
+                          dbTable );
 }
 
-std::string sosicon::ConverterSosi2psql::
-buildInsertStatement( Wkt wktGeom,
+void sosicon::ConverterSosi2psql::
+writeInsertStatement( std::ostream& os,
+                      Wkt wktGeom,
                       std::string dbSchema,
                       std::string dbTable ) {
 
-    std::string sqlComposite;
     std::string geometryType = utils::wktToStr( wktGeom );
 
-    if( !geometryType.empty() && mRowsListCollection[ wktGeom ]->size() > 0 ) {
+    if( !geometryType.empty() && mRowSpoolCollection[ wktGeom ]->size() > 0 ) {
 
         std::string sqlInsert;
         std::string sqlValues;
 
-        RowsList::iterator itrRows;
         FieldsList::iterator itrFields;
 
         FieldsList* f = mFieldsListCollection[ wktGeom ];
-        RowsList* r = mRowsListCollection[ wktGeom ];
+        RowSpool* r = mRowSpoolCollection[ wktGeom ];
 
         std::string geomField = dbTable + "_geom";
         std::string geomName = utils::toLower( geometryType );
@@ -181,26 +182,26 @@ buildInsertStatement( Wkt wktGeom,
         }
         sqlInsert += ") VALUES\n";
         int rowCount = 0;
-        RowsList::size_type len = r->size();
+        size_t len = r->size();
+        std::map<std::string,std::string> row;
         sosicon::logstream << "    > Processing 0 of " << len << sosicon::flush;
-        for( itrRows = r->begin(); itrRows != r->end(); itrRows++ ) {
-            std::map<std::string,std::string>* row = *itrRows;
-            if( !sqlValues.empty() && ++rowCount % 50000 == 0 ) {
-                sqlValues = sqlValues.substr( 0, sqlValues.length() - 2 );
-                sqlValues += ";\n";
-                sqlComposite += ( sqlInsert + sqlValues );
-                sqlValues.clear();
+        r->rewind();
+        while( r->read( row ) ) {
+            if( rowCount % 50000 == 0 ) {
+                // Start new statement every 50 000 rows
+                os << ( rowCount > 0 ? ";\n" : "" ) << sqlInsert;
+            }
+            else {
+                os << ",\n";
             }
-            if( rowCount % 1000 == 0 ) {
+            if( ++rowCount % 1000 == 0 ) {
                 sosicon::logstream << "\r    > Processing " << rowCount << " of " << len << sosicon::flush;
             }
-            sqlValues += "(";
+            sqlValues = "(";
             for( itrFields = f->begin(); itrFields != f->end(); itrFields++ ) {
                 std::string key = itrFields->first;
-                if( row->find( key ) == row->end() ) {
-                    ( *row )[ key ] = "";
-                }
-                std::string val = utils::trim( ( *row )[ key ] );
+                std::map<std::string,std::string>::iterator itrRow = row.find( key );
+                std::string val = itrRow == row.end() ? "" : utils::trim( itrRow->second );
                 if( val.empty() ) {
                     sqlValues += itrFields->second.isNumeric() ? "NULL," : "'',";
                 }
@@ -215,14 +216,197 @@ buildInsertStatement( Wkt wktGeom,
                 }
             }
             sqlValues.erase( sqlValues.size() - 1 );
-            sqlValues += "),\n";
+            sqlValues += ")";
+            os << sqlValues;
         }
+        os << ";\n";
         sosicon::logstream << "\r    > " << rowCount << " " << geomName << "s processed               \n" << sosicon::flush;
-        sqlValues.erase( sqlValues.size() - 2 );
-        sqlValues += ";\n";
-        sqlComposite += ( sqlInsert + sqlValues );
+        if( r->failed() ) {
+            sosicon::logstream << "    > " << dbSchema << "." << dbTable << "_" << geomName << " could not be written\n";
+            mFailedTables++;
+        }
+    }
+}
+
+void sosicon::ConverterSosi2psql::
+writeCopyStatements( std::ostream& os,
+                     std::string fileName,
+                     std::string sridDest,
+                     std::string dbSchema,
+                     std::string dbTable ) {
+
+    writeCopyStatement( os, wkt_point, fileName, sridDest, dbSchema, dbTable );
+    writeCopyStatement( os, wkt_linestring, fileName, sridDest, dbSchema, dbTable );
+    writeCopyStatement( os, wkt_polygon, fileName, sridDest, dbSchema, dbTable );
+}
+
+void sosicon::ConverterSosi2psql::
+writeCopyStatement( std::ostream& os,
+                    Wkt wktGeom,
+                    std::string fileName,
+                    std::string sridDest,
+                    std::string dbSchema,
+                    std::string dbTable ) {
+
+    std::string geometryType = utils::wktToStr( wktGeom );
+
+    if( geometryType.empty() || mRowSpoolCollection[ wktGeom ]->size() == 0 ) {
+        return;
+    }
+
+    FieldsList* f = mFieldsListCollection[ wktGeom ];
+    RowSpool* r = mRowSpoolCollection[ wktGeom ];
+
+    std::string geomField = dbTable + "_geom";
+    std::string geomName = utils::toLower( geometryType );
+    std::string target = dbSchema + "." + dbTable + "_" + geomName;
+    std::string staging = dbTable + "_" + geomName + "_copy";
+    std::string copyTarget = mCopyTransform ? staging : target;
+
+    std::string columns, selection;
+    for( FieldsList::iterator itrFields = f->begin(); itrFields != f->end(); itrFields++ ) {
+        std::string sep = columns.empty() ? "" : ",";
+        columns += sep + itrFields->first;
+        if( itrFields->first == geomField ) {
+            selection += sep + "ST_Transform(" + geomField + "," + sridDest + ")";
+        }
+        else {
+            selection += sep + itrFields->first;
+        }
+    }
+
+    if( mCopyTransform ) {
+        os << "CREATE TEMP TABLE " << staging << " (LIKE " << target << ");\n"
+           << "ALTER TABLE " << staging << " ALTER COLUMN " << geomField << " TYPE geometry;\n";
+    }
+
+    std::ofstream bin;
+    std::ostream* data = &os;
+    if( mCmd->mCopyBinary ) {
+        std::string dir, tit, ext;
+        utils::getPathInfo( fileName, dir, tit, ext );
+        std::string binFileName = dir + tit + "_" + geomName + ".pgcopy";
+        bin.open( binFileName.c_str(), std::ios::out | std::ios::trunc | std::ios::binary );
+        data = &bin;
+        // Signature, flags field and header extension length
+        static const char header[ 19 ] = { 'P', 'G', 'C', 'O', 'P', 'Y', '\n', '\377', '\r', '\n', '\0', 0, 0, 0, 0, 0, 0, 0, 0 };
+        bin.write( header, sizeof( header ) );
+        os << "\\copy " << copyTarget << " (" << columns << ") FROM '" << binFileName << "' WITH (FORMAT binary)\n";
+    }
+    else {
+        os << "COPY " << copyTarget << " (" << columns << ") FROM STDIN;\n";
+    }
+
+    int rowCount = 0;
+    size_t len = r->size();
+    std::map<std::string,std::string> row;
+    sosicon::logstream << "    > Processing 0 of " << len << sosicon::flush;
+    r->rewind();
+    while( r->read( row ) ) {
+        if( ++rowCount % 1000 == 0 ) {
+            sosicon::logstream << "\r    > Processing " << rowCount << " of " << len << sosicon::flush;
+        }
+        *data << buildCopyRow( row, f );
+    }
+    sosicon::logstream << "\r    > " << rowCount << " " << geomName << "s processed               \n" << sosicon::flush;
+
+    bool failed = r->failed();
+    if( mCmd->mCopyBinary ) {
+        static const char trailer[ 2 ] = { '\377', '\377' };
+        bin.write( trailer, sizeof( trailer ) );
+        bin.close();
+        failed = failed || !bin;
     }
-    return sqlComposite;
+    else {
+        os << "\\.\n";
+    }
+    if( failed ) {
+        sosicon::logstream << "    > " << target << " could not be written\n";
+        mFailedTables++;
+    }
+
+    if( mCopyTransform ) {
+        os << "INSERT INTO " << target << " (" << columns << ") SELECT " << selection << " FROM " << staging << ";\n"
+           << "DROP TABLE " << staging << ";\n";
+    }
+}
+
+std::string sosicon::ConverterSosi2psql::
+buildCopyRow( std::map<std::string,std::string>& row, FieldsList* f ) {
+
+    bool binary = mCmd->mCopyBinary;
+    std::string res;
+    char buf[ 8 ];
+
+    if( binary ) {
+        byteOrder::toBigEndian( static_cast<uint16_t>( f->size() ), buf );
+        res.append( buf, 2 );
+    }
+
+    for( FieldsList::iterator itrFields = f->begin(); itrFields != f->end(); itrFields++ ) {
+
+        const std::string& key = itrFields->first;
+        std::map<std::string,std::string>::iterator itrRow = row.find( key );
+        bool isGeom = key == mGeomField;
+        std::string val;
+        if( itrRow != row.end() ) {
+            // Binary geometries must not be trimmed
+            val = isGeom ? itrRow->second : utils::copyNormalize( itrRow->second, !binary );
+        }
+        int intSize = isGeom ? 0 : integerSize( itrFields->second );
+        bool isNull = val.empty() && ( isGeom || intSize > 0 );
+
+        if( !binary ) {
+            if( itrFields != f->begin() ) {
+                res += '\t';
+            }
+            res += isNull ? "\\N" : val;
+        }
+        else if( isNull ) {
+            byteOrder::toBigEndian( static_cast<int32_t>( -1 ), buf );
+            res.append( buf, 4 );
+        }
+        else if( intSize > 0 ) {
+            long long n = atoll( val.c_str() );
+            byteOrder::toBigEndian( static_cast<int32_t>( intSize ), buf );
+            res.append( buf, 4 );
+            if( intSize == 4 ) {
+                byteOrder::toBigEndian( static_cast<int32_t>( n ), buf );
+            }
+            else {
+                byteOrder::toBigEndian( static_cast<int64_t>( n ), buf );
+            }
+            res.append( buf, intSize );
+        }
+        else {
+            byteOrder::toBigEndian( static_cast<int32_t>( val.size() ), buf );
+            res.append( buf, 4 );
+            res += val;
+        }
+    }
+
+    if( !binary ) {
+        res += '\n';
+    }
+    return res;
+}
+
+std::string sosicon::ConverterSosi2psql::
+copyGeometry( WkbWriter& wkb ) {
+    return mCmd->mCopyBinary ? wkb.data() : wkb.hex();
+}
+
+int sosicon::ConverterSosi2psql::
+integerSize( Field& field ) {
+    std::string::size_type len = field.length();
+    bool isNumeric = field.isNumeric();
+    if( isNumeric && len < 10 ) {
+        return 4;
+    }
+    if( isNumeric && len < 19 ) {
+        return 8;
+    }
+    return 0;
 }
 
 void sosicon::ConverterSosi2psql::
@@ -236,15 +420,8 @@ cleanup() {
 void sosicon::ConverterSosi2psql::
 cleanup( Wkt wktGeom ) {
 
-    RowsList* r = mRowsListCollection[ wktGeom ];
-    RowsList::iterator i;
-
-    for( i = r->begin(); i != r->end(); i++ ) {
-        delete *i;
-    }
-
-    delete mRowsListCollection[ wktGeom ];
-    mRowsListCollection[ wktGeom ] = 0;
+    delete mRowSpoolCollection[ wktGeom ];
+    mRowSpoolCollection[ wktGeom ] = 0;
 
     delete mFieldsListCollection[ wktGeom ];
     mFieldsListCollection[ wktGeom ] = 0;
@@ -325,231 +502,359 @@ getSrid( ISosiElement* sosiTree ) {
     return srid;
 }
 
+std::string sosicon::ConverterSosi2psql::
+geometryFromText( std::string wkt, std::string sridSource, std::string sridDest ) {
+    std::string geom = "ST_GeomFromText('" + wkt + "'," + sridSource + ")";
+    return sridSource == sridDest ? geom : "ST_Transform(" + geom + "," + sridDest + ")";
+}
+
 void sosicon::ConverterSosi2psql::
-insertPoint( ISosiElement* point,
-             std::string sridSource,
-             std::string sridDest,
-             std::string geomField ) {
+insertPoint( ISosiElement* point, SourceFile& src) {
 
     sosi::SosiElementSearch srcNe = sosi::SosiElementSearch( sosi::sosi_element_ne );
 
     if( point->getChild( srcNe ) ) {
 
-        sosi::SosiNorthEast ne = sosi::SosiNorthEast( srcNe.element() );
-        ICoordinate* coord = ne.front();
+        sosi::SosiNorthEast ne( srcNe.element(), src.mHeader );
+        const GeometryBuffer& coord = ne.getCoordinates();
         std::stringstream ss;
 
         std::map<std::string,std::string>* row = 0;
 
         row = new std::map<std::string,std::string>();
 
-        ss.precision( 5 );
-        ss  << std::fixed
-            << "ST_Transform(ST_GeomFromText('POINT("
-            << coord->getE()
-            << " "
-            << coord->getN()
-            << ")',"
-            << sridSource
-            << "),"
-            << sridDest
-            << ")";
-
-        std::string data = ss.str();
+        std::string data;
+        if( mCmd->mCopy ) {
+            WkbWriter wkb( atoi( src.mSridSource.c_str() ) );
+            wkb.writeHeader( wkt_point );
+            wkb.writeCoordinate( coord.x( 0 ), coord.y( 0 ) );
+            data = copyGeometry( wkb );
+        }
+        else {
+            ss.precision( src.mPrecision );
+            ss  << std::fixed
+                << "POINT("
+                << coord.x( 0 )
+                << " "
+                << coord.y( 0 )
+                << ")";
+            data = geometryFromText( ss.str(), src.mSridSource, mSridDest );
+        }
 
-        ( *row )[ geomField ] = data;
+        ( *row )[ mGeomField ] = data;
 
-        FieldsList& hdr = ( *mFieldsListCollection[ wkt_point ] );
-        hdr[ geomField ].expand( data );
+        FieldsList& hdr = ( *src.mFieldsListCollection[ wkt_point ] );
+        hdr[ mGeomField ].expand( data );
 
         extractData( point, hdr, row );
 
         if( mCmd->mInsertStatements ) {
-            mRowsListCollection[ wkt_point ]->push_back( row );
+            src.mRowSpoolCollection[ wkt_point ]->write( *row );
         }
+        delete row;
     }
 }
 
 void sosicon::ConverterSosi2psql::
-insertLineString( ISosiElement* lineString,
-                  std::string sridSource,
-                  std::string sridDest,
-                  std::string geomField ) {
+insertLineString( ISosiElement* lineString, SourceFile& src) {
 
-    CoordinateCollection cc;
+    CoordinateCollection cc( src.mHeader, &src.mGeometryCache );
     cc.discoverCoords( lineString );
 
-    std::vector<ICoordinate*> theGeom = cc.getGeom();
-    std::stringstream ssGeomCoord;
+    const GeometryBuffer& theGeom = cc.getGeom();
+    std::string data;
 
-    ssGeomCoord.precision( 5 );
-    ssGeomCoord << std::fixed;
-
-    for( std::vector<ICoordinate*>::iterator i = theGeom.begin(); i != theGeom.end(); i++ ) {
-        ICoordinate* c = *i;
-        ssGeomCoord << c->getE()
-                    << " "
-                    << c->getN()
-                    << ",";
+    if( mCmd->mCopy ) {
+        WkbWriter wkb( atoi( src.mSridSource.c_str() ) );
+        wkb.writeHeader( wkt_linestring );
+        wkb.writePoints( theGeom );
+        data = copyGeometry( wkb );
     }
+    else {
+        std::stringstream ssGeomCoord;
 
-    std::string geom = ssGeomCoord.str();
-    geom.erase( geom.size() - 1 );
+        ssGeomCoord.precision( src.mPrecision );
+        ssGeomCoord << std::fixed;
 
-    std::stringstream ss;
-    ss << "ST_Transform(ST_GeomFromText('LINESTRING("
-       << geom
-       << ")',"
-       << sridSource
-       << "),"
-       << sridDest
-       << ")";
+        for( size_t i = 0; i < theGeom.size(); i++ ) {
+            ssGeomCoord << theGeom.x( i )
+                        << " "
+                        << theGeom.y( i )
+                        << ",";
+        }
+
+        std::string geom = ssGeomCoord.str();
+        geom.erase( geom.size() - 1 );
 
-    std::string data = ss.str();
+        data = geometryFromText( "LINESTRING(" + geom + ")", src.mSridSource, mSridDest );
+    }
 
     std::map<std::string,std::string>* row = 0;
 
     row = new std::map<std::string,std::string>();
-    ( *row )[ geomField ] = data;
+    ( *row )[ mGeomField ] = data;
 
-    FieldsList& hdr = ( *mFieldsListCollection[ wkt_linestring ] );
-    hdr[ geomField ].expand( data );
+    FieldsList& hdr = ( *src.mFieldsListCollection[ wkt_linestring ] );
+    hdr[ mGeomField ].expand( data );
 
     extractData( lineString, hdr, row );
 
     if( mCmd->mInsertStatements ) {
-        mRowsListCollection[ wkt_linestring ]->push_back( row );
+        src.mRowSpoolCollection[ wkt_linestring ]->write( *row );
     }
+    delete row;
 }
 
 void sosicon::ConverterSosi2psql::
-insertPolygon( ISosiElement* polygon,
-               std::string sridSource,
-               std::string sridDest,
-               std::string geomField ) {
+insertPolygon( ISosiElement* polygon, SourceFile& src) {
 
-    CoordinateCollection cc;
+    CoordinateCollection cc( src.mHeader, &src.mGeometryCache );
     cc.discoverCoords( polygon );
 
-    std::vector<ICoordinate*> theGeom = cc.getGeom();
-    std::vector<ICoordinate*> theHoles = cc.getHoles();
-    std::vector<int> holeSizes = cc.getHoleSizes();
-    std::stringstream ssGeomCoord;
-
-    ssGeomCoord.precision( 5 );
-    ssGeomCoord << std::fixed
-                << "(";
-
-    for( std::vector<ICoordinate*>::iterator i = theGeom.begin(); i != theGeom.end(); i++ ) {
-        ICoordinate* c = *i;
-        ssGeomCoord << c->getE()
-                    << " "
-                    << c->getN()
-                    << ",";
-    }
-
-    std::string geom = ssGeomCoord.str();
-    geom.erase( geom.size() - 1 );
-    geom += ")";
-
-    std::stringstream ssHolesCoord;
-    ssHolesCoord.precision( 5 );
-    ssHolesCoord << std::fixed;
-
-    int offset = 0;
-    ICoordinate* first = 0, * last = 0;
-    for( std::vector<int>::iterator i = holeSizes.begin(); i != holeSizes.end(); i++ ) {
-        ssHolesCoord << ",(";
-        for( int j = 0; j < *i; j++ ) {
-            ICoordinate* c = theHoles[ offset++ ];
-            if( j == 0 ) {
-                first = c;
-            }
-            else {
-                ssHolesCoord << ",";
-                last = c;
-            }
-            ssHolesCoord << c->getE()
-                         << " "
-                         << c->getN();
-        }
-        if( !first->equals( last ) ) {
+    const GeometryBuffer& theGeom = cc.getGeom();
+    const GeometryBuffer& theHoles = cc.getHoles();
+    std::string data;
+
+    if( mCmd->mCopy ) {
+        WkbWriter wkb( atoi( src.mSridSource.c_str() ) );
+        wkb.writeHeader( wkt_polygon );
+        wkb.writeCount( 1 + theHoles.numParts() );
+        wkb.writePoints( theGeom );
+        for( size_t k = 0; k < theHoles.numParts(); k++ ) {
+            size_t begin = theHoles.partBegin( k );
+            size_t end = theHoles.partEnd( k );
             // Close polygon if open
-            ssHolesCoord << ","
-                         << first->getE()
-                         << " "
-                         << first->getN();
+            wkb.writePoints( theHoles, begin, end, begin != end && !theHoles.equals( begin, end - 1 ) );
         }
-        ssHolesCoord << ")";
+        data = copyGeometry( wkb );
     }
-    geom += ssHolesCoord.str();
+    else {
+        std::stringstream ssGeomCoord;
 
-    std::stringstream ss;
-    ss << "ST_Transform(ST_GeomFromText('POLYGON("
-       << geom
-       << ")',"
-       << sridSource
-       << "),"
-       << sridDest
-       << ")";
+        ssGeomCoord.precision( src.mPrecision );
+        ssGeomCoord << std::fixed
+                    << "(";
 
-    std::string data = ss.str();
+        for( size_t i = 0; i < theGeom.size(); i++ ) {
+            ssGeomCoord << theGeom.x( i )
+                        << " "
+                        << theGeom.y( i )
+                        << ",";
+        }
+
+        std::string geom = ssGeomCoord.str();
+        geom.erase( geom.size() - 1 );
+        geom += ")";
+
+        std::stringstream ssHolesCoord;
+        ssHolesCoord.precision( src.mPrecision );
+        ssHolesCoord << std::fixed;
+
+        for( size_t k = 0; k < theHoles.numParts(); k++ ) {
+            size_t begin = theHoles.partBegin( k );
+            size_t end = theHoles.partEnd( k );
+            ssHolesCoord << ",(";
+            for( size_t i = begin; i < end; i++ ) {
+                if( i > begin ) {
+                    ssHolesCoord << ",";
+                }
+                ssHolesCoord << theHoles.x( i )
+                             << " "
+                             << theHoles.y( i );
+            }
+            if( begin != end && !theHoles.equals( begin, end - 1 ) ) {
+                // Close polygon if open
+                ssHolesCoord << ","
+                             << theHoles.x( begin )
+                             << " "
+                             << theHoles.y( begin );
+            }
+            ssHolesCoord << ")";
+        }
+        geom += ssHolesCoord.str();
+
+        data = geometryFromText( "POLYGON(" + geom + ")", src.mSridSource, mSridDest );
+    }
 
     std::map<std::string,std::string>* row = 0;
     row = new std::map<std::string,std::string>();
-    ( *row )[ geomField ] = data;
+    ( *row )[ mGeomField ] = data;
 
-    FieldsList& hdr = ( *mFieldsListCollection[ wkt_polygon ] );
-    hdr[ geomField ].expand( data );
+    FieldsList& hdr = ( *src.mFieldsListCollection[ wkt_polygon ] );
+    hdr[ mGeomField ].expand( data );
 
     extractData( polygon, hdr, row );
 
     if( mCmd->mInsertStatements ) {
-        mRowsListCollection[ wkt_polygon ]->push_back( row );
+        src.mRowSpoolCollection[ wkt_polygon ]->write( *row );
     }
+    delete row;
 }
 
 void sosicon::ConverterSosi2psql::
-makePsql( ISosiElement* sosiTree,
-          std::string sridDest,
-          std::string,
-          std::string dbTable ) {
+insertFeature( ISosiElement* feature, SourceFile& src ) {
+    if( objTypeExcluded( feature ) ) {
+        return;
+    }
+    switch( feature->getType() ) {
+        case sosi::sosi_element_point:
+        case sosi::sosi_element_text:
+            insertPoint( feature, src );
+            break;
+        case sosi::sosi_element_curve:
+            insertLineString( feature, src );
+            break;
+        case sosi::sosi_element_surface:
+            insertPolygon( feature, src );
+            break;
+        default:
+            break;
+    }
+}
 
-    std::string sridSource = getSrid( sosiTree );
-    std::string geomField = dbTable + "_geom";
-    sosi::SosiTranslationTable ttbl;
+bool sosicon::ConverterSosi2psql::
+objTypeExcluded( ISosiElement* element )
+{
+    std::vector<std::string>& ot = mCmd->mObjTypes;
+    return ot.size() > 0 && std::find( ot.begin(), ot.end(), utils::toLower( element->getObjType() ) ) == ot.end();
+}
+
+sosicon::ConverterSosi2psql::SourceFile::
+SourceFile( ConverterSosi2psql* converter, std::string spoolBase ) :
+    mConverter( converter ), mPrecision( 5 ), mOwnSpools( !spoolBase.empty() ) {
+
+    mFieldsListCollection[ wkt_point ] = new FieldsList();
+    mFieldsListCollection[ wkt_linestring ] = new FieldsList();
+    mFieldsListCollection[ wkt_polygon ] = new FieldsList();
 
-    std::vector<sosi::ElementType> pointTypes;
-    pointTypes.push_back( sosi::sosi_element_point );
-    pointTypes.push_back( sosi::sosi_element_text );
-    sosi::SosiElementSearch srcPoint = sosi::SosiElementSearch( pointTypes );
-    while( sosiTree->getChild( srcPoint ) ) {
-        if( objTypeExcluded( srcPoint ) ) continue;
-        insertPoint( srcPoint.element(), sridSource, sridDest, geomField );
+    if( mOwnSpools ) {
+        mRowSpoolCollection[ wkt_point ] = new RowSpool( spoolBase + ".point.spool" );
+        mRowSpoolCollection[ wkt_linestring ] = new RowSpool( spoolBase + ".linestring.spool" );
+        mRowSpoolCollection[ wkt_polygon ] = new RowSpool( spoolBase + ".polygon.spool" );
     }
+    else {
+        mRowSpoolCollection = converter->mRowSpoolCollection;
+    }
+}
 
-    std::vector<sosi::ElementType> lineStringTypes;
-    lineStringTypes.push_back( sosi::sosi_element_curve );
-    sosi::SosiElementSearch srcLineString = sosi::SosiElementSearch( lineStringTypes );
-    while( sosiTree->getChild( srcLineString ) ) {
-        if( objTypeExcluded( srcLineString ) ) continue;
-        insertLineString( srcLineString.element(), sridSource, sridDest, geomField );
+sosicon::ConverterSosi2psql::SourceFile::
+~SourceFile() {
+    for( FieldsListCollection::iterator i = mFieldsListCollection.begin(); i != mFieldsListCollection.end(); i++ ) {
+        delete i->second;
     }
+    if( mOwnSpools ) {
+        for( RowSpoolCollection::iterator i = mRowSpoolCollection.begin(); i != mRowSpoolCollection.end(); i++ ) {
+            delete i->second;
+        }
+    }
+}
 
-    std::vector<sosi::ElementType> polygonTypes;
-    polygonTypes.push_back( sosi::sosi_element_surface );
-    sosi::SosiElementSearch srcPolygon = sosi::SosiElementSearch( polygonTypes );
-    while( sosiTree->getChild( srcPolygon ) ) {
-        if( objTypeExcluded( srcPolygon ) ) continue;
-        insertPolygon( srcPolygon.element(), sridSource, sridDest, geomField );
+void sosicon::ConverterSosi2psql::SourceFile::
+onEvent( FeatureEvent& e, EventDispatcher<FeatureEvent>& ) {
+    if( e.mReleased ) {
+        std::string serial = e.mFeature->getSerial();
+        long long key;
+        if( sosi::SosiElementIndex::parseSerial( serial.data(), serial.data() + serial.size(), key ) ) {
+            mGeometryCache.erase( key );
+        }
+        return;
+    }
+    if( mSridSource.empty() ) {
+        mConverter->initSourceFile( *this, e.mFeature->getRoot() );
     }
+    mConverter->insertFeature( e.mFeature, *this );
 }
 
-bool sosicon::ConverterSosi2psql::
-objTypeExcluded( sosi::SosiElementSearch& src )
-{
-    std::vector<std::string>& ot = mCmd->mObjTypes;
-    return ot.size() > 0 && std::find( ot.begin(), ot.end(), utils::toLower( src.element()->getObjType() ) ) == ot.end();
+void sosicon::ConverterSosi2psql::
+initSourceFile( SourceFile& src, ISosiElement* root ) {
+    src.mHeader = sosi::HeaderContext( root, atoi( mSridDest.c_str() ) );
+    src.mSridSource = getSrid( root );
+    if( src.mHeader.getSrid() == atoi( mSridDest.c_str() ) ) {
+        // Coordinates are transformed while read, no ST_Transform needed
+        src.mSridSource = mSridDest;
+    }
+    src.mPrecision = Projection( atoi( src.mSridSource.c_str() ) ).isGeographic() ? 9 : 5;
+}
+
+void sosicon::ConverterSosi2psql::
+convertFile( size_t index, bool concurrent ) {
+    const std::string& sourceFile = mCmd->mSourceFiles[ index ];
+    if( !utils::fileExists( sourceFile ) ) {
+        sosicon::logstream << sourceFile << " not found\n";
+        return;
+    }
+    sosicon::logstream << "Reading " << sourceFile << "\n";
+    std::stringstream spoolBase;
+    if( concurrent ) {
+        spoolBase << mOutputFileName << "." << index;
+    }
+    SourceFile* src = new SourceFile( this, spoolBase.str() );
+    mSourceFiles[ index ] = src;
+    Parser p;
+    MappedFile mf;
+    mf.open( sourceFile );
+    p.streamFeatures( src, mf.begin(), mf.end() );
+    const char* blkBegin = 0;
+    const char* blkEnd = 0;
+    int n = 0;
+    if( mCmd->mCache && p.loadCache( sourceFile, mf.begin(), mf.end(), n, mCmd->mCacheHash ) ) {
+        sosicon::logstream << "Loaded from " << SosiCache::cacheFileName( sourceFile ) << "\n";
+    }
+    else if( mCmd->mThreads > 1 && !concurrent ) {
+        sosicon::logstream << "Parsing with " << mCmd->mThreads << " threads...";
+        n = p.parseParallel( mf.begin(), mf.end(), mCmd->mThreads );
+    }
+    else {
+        while( mf.getBlock( blkBegin, blkEnd ) ) {
+            n += p.ragelParseSosi( blkBegin, blkEnd );
+            if( !concurrent ) {
+                sosicon::logstream << "\rParsing line " << n;
+            }
+        }
+    }
+    p.complete();
+    p.commitCache( n );
+
+    mf.close();
+    sosicon::logstream << "\r" << n << " lines parsed        \n";
+    if( src->mSridSource.empty() ) {
+        getSrid( p.getRootElement() );
+    }
+    if( src->mOwnSpools ) {
+        // Release the file handles until the spools are merged
+        for( RowSpoolCollection::iterator i = src->mRowSpoolCollection.begin(); i != src->mRowSpoolCollection.end(); i++ ) {
+            i->second->close();
+        }
+    }
+}
+
+void sosicon::ConverterSosi2psql::
+commitFile( size_t index ) {
+    SourceFile* src = mSourceFiles[ index ];
+    if( !src ) {
+        return;
+    }
+    for( FieldsListCollection::iterator i = src->mFieldsListCollection.begin(); i != src->mFieldsListCollection.end(); i++ ) {
+        FieldsList& hdr = *mFieldsListCollection[ i->first ];
+        for( FieldsList::iterator f = i->second->begin(); f != i->second->end(); f++ ) {
+            hdr[ f->first ].merge( f->second );
+        }
+    }
+    if( src->mOwnSpools ) {
+        for( RowSpoolCollection::iterator i = src->mRowSpoolCollection.begin(); i != src->mRowSpoolCollection.end(); i++ ) {
+            mRowSpoolCollection[ i->first ]->append( *i->second );
+        }
+    }
+    if( !src->mSridSource.empty() ) {
+        if( mEncoding == sosi::sosi_charset_undetermined ) {
+            mEncoding = src->mHeader.getEncoding();
+        }
+        if( src->mSridSource != mSridDest ) {
+            mCopyTransform = true;
+        }
+    }
+    delete src;
+    mSourceFiles[ index ] = 0;
 }
 
 void sosicon::ConverterSosi2psql::
@@ -559,66 +864,50 @@ run( bool* ) {
     mFieldsListCollection[ wkt_linestring ] = new FieldsList();
     mFieldsListCollection[ wkt_polygon ] = new FieldsList();
 
-    mRowsListCollection[ wkt_point ] = new RowsList();
-    mRowsListCollection[ wkt_linestring ] = new RowsList();
-    mRowsListCollection[ wkt_polygon ] = new RowsList();
+    std::string defaultOutputFile = mCmd->mOutputFile.empty() ? "postgis_dump.sql" : mCmd->mOutputFile;
+    mOutputFileName = utils::nonExistingFilename( defaultOutputFile );
+
+    mRowSpoolCollection[ wkt_point ] = new RowSpool( mOutputFileName + ".point.spool" );
+    mRowSpoolCollection[ wkt_linestring ] = new RowSpool( mOutputFileName + ".linestring.spool" );
+    mRowSpoolCollection[ wkt_polygon ] = new RowSpool( mOutputFileName + ".polygon.spool" );
 
-    std::string sridDest = mCmd->mSrid.empty() ? "4326" : mCmd->mSrid;
+    mSridDest = mCmd->mSrid.empty() ? "4326" : mCmd->mSrid;
+    mCopyTransform = false;
+    mFailedTables = 0;
+    mEncoding = sosi::sosi_charset_undetermined;
 
     std::string dbSchema = mCmd->mDbSchema.empty() ? "sosicon" : utils::toLower( mCmd->mDbSchema );
     std::string dbTable = mCmd->mDbTable.empty() ? "object" : utils::toLower( mCmd->mDbTable );
-    std::string geomField = dbTable + "_geom";
+    mGeomField = dbTable + "_geom";
 
-    ( *mFieldsListCollection[ wkt_point ] )[ geomField ] = Field();
-    ( *mFieldsListCollection[ wkt_linestring ] )[ geomField ] = Field();
-    ( *mFieldsListCollection[ wkt_polygon ] )[ geomField ] = Field();
+    ( *mFieldsListCollection[ wkt_point ] )[ mGeomField ] = Field();
+    ( *mFieldsListCollection[ wkt_linestring ] )[ mGeomField ] = Field();
+    ( *mFieldsListCollection[ wkt_polygon ] )[ mGeomField ] = Field();
 
-    for( std::vector<std::string>::iterator f = mCmd->mSourceFiles.begin(); f != mCmd->mSourceFiles.end(); f++ ) {
-        mCurrentSourcefile = *f;
-        if( !utils::fileExists( mCurrentSourcefile ) ) {
-            sosicon::logstream << mCurrentSourcefile << " not found\n";
-        }
-        else {
-            sosicon::logstream << "Reading " << mCurrentSourcefile << "\n";
-            Parser p;
-            char ln[ 1024 ];
-            std::ifstream ifs( mCurrentSourcefile.c_str() );
-            int n = 0;
-            while( !ifs.eof() ) {
-                if( ++n % 100 == 0 ) {
-                    sosicon::logstream << "\rParsing line " << n;
-                }
-               memset( ln, 0x00, sizeof ln );
-                ifs.getline( ln, sizeof ln );
-                p.ragelParseSosiLine( ln );
-            }
-            p.complete();
+    FileBatch batch( mCmd->mSourceFiles, mCmd->mThreads );
+    mSourceFiles.assign( batch.size(), 0 );
+    batch.run( [ this, &batch ]( size_t i ) { convertFile( i, batch.concurrent() ); },
+               [ this ]( size_t i ) { commitFile( i ); } );
 
-            ifs.close();
-            sosicon::logstream << "\r" << n << " lines parsed        \n";
-            sosicon::logstream << "Building postGIS export...\n";
-            ISosiElement* root = p.getRootElement();
-            makePsql( root, sridDest, dbSchema, dbTable );
-        }
-    }
-    writePsql( sridDest, dbSchema, dbTable );
+    bool written = writePsql( mSridDest, dbSchema, dbTable );
     cleanup();
+    if( !written ) {
+        throw std::runtime_error( "Conversion failed, " + mOutputFileName + " could not be written" );
+    }
     sosicon::logstream << "Done!\n";
 }
 
-void sosicon::ConverterSosi2psql::
+bool sosicon::ConverterSosi2psql::
 writePsql( std::string sridDest,
            std::string dbSchema,
            std::string dbTable ) {
 
     std::ofstream fs;
-    std::string defaultOutputFile = mCmd->mOutputFile.empty() ? "postgis_dump.sql" : mCmd->mOutputFile;
-    std::string fileName = utils::nonExistingFilename( defaultOutputFile );
+    std::string fileName = mOutputFileName;
     sosicon::logstream << "    > Converting SOSI data to SQL...\n";
     fs.open( fileName.c_str(), std::ios::out | std::ios::trunc );
     fs.precision( 0 );
-    const sosi::SosiCharsetSingleton* cs = sosi::SosiCharsetSingleton::getInstance();
-    const sosi::Charset sosiCharset = cs->getEncoding();
+    const sosi::Charset sosiCharset = mEncoding;
     const std::string encoding = utils::sosiEncodingToPsqlEncoding( sosiCharset );
     if( sosiCharset != sosi::Charset::sosi_charset_utf8 ) {
       fs << "SET NAMES '" << encoding << "';\n";
@@ -641,9 +930,20 @@ writePsql( std::string sridDest,
            << "END\n"
            << "$$ LANGUAGE plpgsql;\n";
     }
-    fs <<  ( mCmd->mCreateStatements ? buildCreateStatements( sridDest, dbSchema, dbTable ) : "" )
-       <<  ( mCmd->mInsertStatements ? buildInsertStatements( dbSchema, dbTable ) : "" )
-       << "SET NAMES 'UTF8';\n";
+    fs <<  ( mCmd->mCreateStatements ? buildCreateStatements( sridDest, dbSchema, dbTable ) : "" );
+    if( mCmd->mInsertStatements && mCmd->mCopy ) {
+        writeCopyStatements( fs, fileName, sridDest, dbSchema, dbTable );
+    }
+    else if( mCmd->mInsertStatements ) {
+        writeInsertStatements( fs, dbSchema, dbTable );
+    }
+    fs << "SET NAMES 'UTF8';\n";
     fs.close();
+    if( mFailedTables > 0 || !fs ) {
+        std::remove( fileName.c_str() );
+        sosicon::logstream << "    > " << fileName << " could not be written\n";
+        return false;
+    }
     sosicon::logstream << "    > " << fileName << " written\n";
+    return true;
 }
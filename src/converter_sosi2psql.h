@@ -23,8 +23,11 @@
 #include "logger.h"
 #include <fstream>
 #include <sstream>
+#include <stdexcept>
 #include <vector>
 #include <climits>
+#include <limits>
+#include <algorithm>
 #include <cmath>
 #include <map>
 #include "utils.h"
@@ -33,9 +36,15 @@
 #include "sosi/sosi_types.h"
 #include "sosi/sosi_translation_table.h"
 #include "coordinate_collection.h"
+#include "geometry_cache.h"
+#include "wkb_writer.h"
+#include "row_spool.h"
+#include "projection.h"
+#include "sosi/sosi_header_context.h"
 #include "sosi/sosi_north_east.h"
 #include "command_line.h"
 #include "common_types.h"
+#include "file_batch.h"
 #include "parser.h"
 
 namespace sosicon {
@@ -48,6 +57,13 @@ namespace sosicon {
     /*!
         If command-line parameter -2psql is specified, this converter will handle the output
         generation. Produces a PostgreSQL/PostGIS dump file from the SOSI source(s).
+        The source files are parsed in streaming mode. Extracted rows are spooled to one
+        temporary file per geometry, so that only the table header statistics are held in
+        memory. The spooled rows are rendered once the final table layout is known.
+
+        With -j and more than one source file, the files are converted at the same time,
+        each into spool files of its own, which are appended to the shared spools in source
+        file order (see sosicon::FileBatch).
      */
     class ConverterSosi2psql : public IConverter {
 
@@ -71,6 +87,7 @@ namespace sosicon {
             Field() {
                 mIsNumeric = true;
                 mMaxLength = 0;
+                mMinLength = std::numeric_limits<std::string::size_type>::max();
             }
             Field( std::string& str ) {
                 mIsNumeric = true;
@@ -87,54 +104,219 @@ namespace sosicon {
                 }
                 return mMaxLength;
             }
+            void merge( const Field& other ) {
+                mMinLength = std::min( mMinLength, other.mMinLength );
+                mMaxLength = std::max( mMaxLength, other.mMaxLength );
+                mIsNumeric = mIsNumeric && other.mIsNumeric;
+            }
         };
 
         typedef std::map< std::string,Field > FieldsList;
         typedef std::map< Wkt, FieldsList* > FieldsListCollection;
-        typedef std::vector< std::map< std::string,std::string >* > RowsList;
-        typedef std::map< Wkt, RowsList* > RowsListCollection;
+        typedef std::map< Wkt, RowSpool* > RowSpoolCollection;
+
+        //! Source file in process
+        /*!
+            Holds the state of one source file, so that several files may be converted at
+            the same time. Receives the features of the file from the parser, and collects
+            the field statistics and the converted rows, until they are merged into the
+            tables of the converter by commitFile().
+         */
+        class SourceFile : public FeatureEventDispatcher::Listener {
+
+            //! Converter receiving the features
+            ConverterSosi2psql* mConverter;
+
+        public:
+
+            //! Header context of the file
+            sosi::HeaderContext mHeader;
+
+            //! Spatial reference grid ID for the coordinates, set by the first feature
+            std::string mSridSource;
+
+            //! Number of decimals in WKT coordinates (more for geographic coordinates)
+            int mPrecision;
+
+            //! Decoded curves referred to by surfaces not yet converted
+            GeometryCache mGeometryCache;
+
+            //! Collection of fields, one item for each geometry type
+            FieldsListCollection mFieldsListCollection;
+
+            //! Collection of spooled rows, one item for each geometry type
+            RowSpoolCollection mRowSpoolCollection;
+
+            //! True if the spools belong to the file, false if they are the converter's
+            bool mOwnSpools;
+
+            //! Constructor
+            /*!
+                \param converter Converter receiving the features.
+                \param spoolBase Base name of the spool files of the source file. If empty,
+                       rows are written directly to the spools of the converter, which is
+                       only correct if the files are converted one by one.
+             */
+            SourceFile( ConverterSosi2psql* converter, std::string spoolBase );
+
+            //! Destructor
+            /*!
+                Removes the spool files of the source file.
+             */
+            virtual ~SourceFile();
+
+            //! Receive feature from parser
+            /*!
+                Called by the parser for each feature in the source file, and for each
+                surface REF target when it is no longer needed.
+                \sa sosicon::Parser::streamFeatures()
+             */
+            virtual void onEvent( FeatureEvent& e, EventDispatcher<FeatureEvent>& d );
+
+        }; // class SourceFile
 
         //! Command line wrapper
         CommandLine* mCmd;
 
-        //! Souce file currently in process
-        std::string mCurrentSourcefile;
+        //! Source files in process, or converted but not yet committed
+        std::vector<SourceFile*> mSourceFiles;
 
         //! Collection of fields, one item for each geometry type
         FieldsListCollection mFieldsListCollection;
 
-        //! Collection of rows, one item for each geometry type
-        RowsListCollection mRowsListCollection;
+        //! Collection of spooled rows, one item for each geometry type
+        RowSpoolCollection mRowSpoolCollection;
 
-        //! Build SQL insert statements for all geometries
+        //! Name of the SQL output file
+        std::string mOutputFileName;
+
+        //! Character set of the first source file, given to PostgreSQL by SET NAMES
+        sosi::Charset mEncoding;
+
+        //! Spatial reference grid ID for the target file
+        std::string mSridDest;
+
+        //! Name of the geometry field within the recordset
+        std::string mGeomField;
+
+        //! True if any source file has another SRID than the target (-copy only)
+        /*!
+            COPY cannot call ST_Transform, so the rows are then copied into a temporary
+            table and reprojected in one statement when moved to the destination table.
+        */
+        bool mCopyTransform;
+
+        //! Number of tables whose rows could not all be spooled or written
+        int mFailedTables;
+
+        //! Integer column size for field
         /*!
-            This function calls sosicon::ConverterSosi2psql::buildInsertStatement
+            Numeric fields are stored as INTEGER or BIGINT columns, depending on the field
+            length. Other fields are stored as character columns.
+            \param field The field to inspect.
+            \return 4 (INTEGER), 8 (BIGINT) or 0 (character column).
+        */
+        int integerSize( Field& field );
+
+        //! Write SQL insert statements for all geometries
+        /*!
+            This function calls sosicon::ConverterSosi2psql::writeInsertStatement
             for each of the WKT geometries types to export.
             \param dbSchema String representing the name of the database schema.
             \param dbTable String representing the base name of the database table.
                            The name of the geometry for that table will be prepended
                            to the base name.
-            \see sosicon::ConverterSosi2psql::buildInsertStatement()
-            \return The SQL insertion script content.
+            \see sosicon::ConverterSosi2psql::writeInsertStatement()
         */
-        std::string buildInsertStatements( std::string dbSchema,
-                                           std::string dbTable );
+        void writeInsertStatements( std::ostream& os,
+                                    std::string dbSchema,
+                                    std::string dbTable );
 
-        //! Build SQL insert statement for one geometry
+        //! Write SQL insert statement for one geometry
         /*!
-            Creates the SQL statements required to insert the data for one WKT
-            geometry.
+            Reads back the spooled rows for one WKT geometry and writes the SQL
+            statements required to insert them.
+            \param os The SQL output file.
             \param wktGeom WKT geometry type for current insertion script.
             \param dbSchema String representing the name of the database schema.
             \param dbTable String representing the base name of the database table.
                            The name of the geometry for that table will be prepended
                            to the base name.
-            \see sosicon::ConverterSosi2psql::buildInsertStatements()
-            \return The SQL insertion script content.
+            \see sosicon::ConverterSosi2psql::writeInsertStatements()
         */
-        std::string buildInsertStatement( Wkt wktGeom,
-                                          std::string dbSchema,
-                                          std::string dbTable );
+        void writeInsertStatement( std::ostream& os,
+                                   Wkt wktGeom,
+                                   std::string dbSchema,
+                                   std::string dbTable );
+
+        //! Write COPY data for all geometries
+        /*!
+            This function calls sosicon::ConverterSosi2psql::writeCopyStatement
+            for each of the WKT geometries types to export.
+            \param os The SQL output file.
+            \param fileName Name of the SQL output file. Binary COPY files are named after it.
+            \param sridDest Spatial reference grid ID for the target tables.
+            \param dbSchema String representing the name of the database schema.
+            \param dbTable String representing the base name of the database table.
+                           The name of the geometry for that table will be prepended
+                           to the base name.
+            \see sosicon::ConverterSosi2psql::writeCopyStatement()
+        */
+        void writeCopyStatements( std::ostream& os,
+                                  std::string fileName,
+                                  std::string sridDest,
+                                  std::string dbSchema,
+                                  std::string dbTable );
+
+        //! Write COPY data for one geometry
+        /*!
+            Writes a COPY ... FROM STDIN block with the rows for one WKT geometry, or,
+            with -binary, writes the rows to a binary COPY file and a \\copy command
+            loading it.
+            \param os The SQL output file.
+            \param wktGeom WKT geometry type for current table.
+            \param fileName Name of the SQL output file. Binary COPY files are named after it.
+            \param sridDest Spatial reference grid ID for the target tables.
+            \param dbSchema String representing the name of the database schema.
+            \param dbTable String representing the base name of the database table.
+                           The name of the geometry for that table will be prepended
+                           to the base name.
+            \see sosicon::ConverterSosi2psql::writeCopyStatements()
+        */
+        void writeCopyStatement( std::ostream& os,
+                                 Wkt wktGeom,
+                                 std::string fileName,
+                                 std::string sridDest,
+                                 std::string dbSchema,
+                                 std::string dbTable );
+
+        //! Build COPY data row
+        /*!
+            Creates a tab-separated text COPY row, or a binary COPY tuple if -binary is
+            specified.
+            \param row The record set (table row).
+            \param f The fields list (table header).
+            \return The row, ready to be written to the COPY data stream.
+        */
+        std::string buildCopyRow( std::map<std::string,std::string>& row, FieldsList* f );
+
+        //! Get COPY representation of geometry
+        /*!
+            \param wkb The geometry, serialized as EWKB.
+            \return Hex encoded EWKB for text COPY, or raw EWKB for binary COPY.
+        */
+        std::string copyGeometry( WkbWriter& wkb );
+
+        //! Get SQL expression for WKT geometry
+        /*!
+            Coordinates already in the target grid are inserted as is. Others are
+            reprojected by the server, using ST_Transform.
+            \param wkt The geometry, as well-known text.
+            \param sridSource Spatial reference grid ID for the coordinates.
+            \param sridDest Spatial reference grid ID for the target table.
+            \return The SQL expression.
+        */
+        std::string geometryFromText( std::string wkt, std::string sridSource, std::string sridDest );
 
         //! Build SQL create statements for all geometries
         /*!
@@ -216,15 +398,9 @@ namespace sosicon {
             \see sosicon::ConverterSosi2psql::insertPoint()
             \see sosicon::ConverterSosi2psql::insertPolygon()
             \param lineString SOSI geometry element (typically "KURVE").
-            \param sridSource Spatial reference grid ID for the source file.
-            \param sridDest Spatial reference grid ID for the target file.
-            \param geomField The name of the field within the recordset
-                             representing the geometry data.
+            \param src Source file of the element.
         */
-        void insertLineString( ISosiElement* lineString,
-                               std::string sridSource,
-                               std::string sridDest,
-                               std::string geomField );
+        void insertLineString( ISosiElement* lineString, SourceFile& src );
 
         //! Convert single point geomery (sosi PUNKT) to SQL export data
         /*!
@@ -233,15 +409,9 @@ namespace sosicon {
             \see sosicon::ConverterSosi2psql::insertLineString()
             \see sosicon::ConverterSosi2psql::insertPolygon()
             \param point SOSI geometry element (typically "PUNKT" or "TEKST").
-            \param sridSource Spatial reference grid ID for the source file.
-            \param sridDest Spatial reference grid ID for the target file.
-            \param geomField The name of the field within the recordset
-                             representing the geometry data.
+            \param src Source file of the element.
         */
-        void insertPoint( ISosiElement* point,
-                          std::string sridSource,
-                          std::string sridDest,
-                          std::string geomField );
+        void insertPoint( ISosiElement* point, SourceFile& src );
 
         //! Convert polygons (sosi FLATE) to SQL export data
         /*!
@@ -250,44 +420,56 @@ namespace sosicon {
             \see sosicon::ConverterSosi2psql::insertLineString()
             \see sosicon::ConverterSosi2psql::insertPoint()
             \param point SOSI geometry element (typically "FLATE").
-            \param sridSource Spatial reference grid ID for the source file.
-            \param sridDest Spatial reference grid ID for the target file.
-            \param geomField The name of the field within the recordset
-                             representing the geometry data.
+            \param src Source file of the element.
         */
-        void insertPolygon( ISosiElement* polygon,
-                            std::string sridSource,
-                            std::string sridDest,
-                            std::string geomField );
+        void insertPolygon( ISosiElement* polygon, SourceFile& src );
 
-        //! Make SQL dump from SOSI tree
+        //! Convert feature to SQL export data
         /*!
-            Iterates the SOSI tree once for each geometry to be exported, extracting
-            relevant elements and passing them on to one of the insertion routines.
-            \param sosiTree Pointer to the root SOSI element.
-            \param sridDest Spatial reference grid ID for the target file.
-            \param dbSchema String representing the name of the database schema.
-            \param dbTable String representing the base name of the database table.
-                           The name of the geometry for that table will be prepended
-                           to the base name.
+            Passes the feature on to one of the insertion routines, according to its
+            geometry type. Features of other types, and features filtered out by the -t
+            parameter, are ignored.
+            \param feature Top-level SOSI element.
+            \param src Source file of the feature.
             \see sosicon::ConverterSosi2psql::insertPoint()
             \see sosicon::ConverterSosi2psql::insertLineString()
             \see sosicon::ConverterSosi2psql::insertPolygon()
         */
-        void makePsql( ISosiElement* sosiTree,
-                       std::string sridDest,
-                       std::string dbSchema,
-                       std::string dbTable );
+        void insertFeature( ISosiElement* feature, SourceFile& src );
+
+        //! Prepare source file for its first feature
+        /*!
+            Reads the header of the source file, and decides whether its coordinates are
+            transformed while read or by the database server.
+            \param src Source file.
+            \param root Root element of the source file.
+         */
+        void initSourceFile( SourceFile& src, ISosiElement* root );
+
+        //! Convert one source file
+        /*!
+            \param index Position of the file among the source files.
+            \param concurrent True if other files are converted at the same time. The file
+                   is then parsed on the calling thread only, into spool files of its own.
+         */
+        void convertFile( size_t index, bool concurrent );
+
+        //! Merge converted source file into the tables of the converter
+        /*!
+            Called for each source file in turn, in source file order.
+            \param index Position of the file among the source files.
+         */
+        void commitFile( size_t index );
 
         //! Test if current element is filtered out by -t parameter
         /*!
             If the user uses the -t parameter to specify which OBJTYPE elements to
             include in the export, this function tests if current element is opted
             out of the export.
-            \param src SOSI element serch result to test.
+            \param element SOSI element to test.
             \return True if current element should be excluded from the export file.
         */
-        bool objTypeExcluded( sosi::SosiElementSearch& src );
+        bool objTypeExcluded( ISosiElement* element );
 
         //! Write SQL content
         /*!
@@ -298,8 +480,10 @@ namespace sosicon {
             \param dbTable String representing the base name of the database table.
                            The name of the geometry for that table will be prepended
                            to the base name.
+            \return False if rows were lost or the file could not be written. The
+                    incomplete file is then removed.
         */
-        void writePsql( std::string sridDest,
+        bool writePsql( std::string sridDest,
                         std::string dbSchema,
                         std::string dbTable );
 
@@ -309,7 +493,7 @@ namespace sosicon {
     public:
 
         //! Constructor
-        ConverterSosi2psql() : mCmd( 0 ) { }
+        ConverterSosi2psql() : mCmd( 0 ), mEncoding( sosi::sosi_charset_undetermined ), mCopyTransform( false ), mFailedTables( 0 ) { }
         
         //! Initialize converter
         /*!
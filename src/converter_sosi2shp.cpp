@@ -18,39 +18,66 @@
 #include "converter_sosi2shp.h"
 
 void sosicon::ConverterSosi2shp::
-makeShp( ISosiElement* sosiTree, bool* cancel ) {
+makeShp( ISosiElement* sosiTree, size_t index, bool concurrent, bool* cancel ) {
 
     sosi::SosiTranslationTable ttbl;
+    sosi::HeaderContext header( sosiTree, atoi( mCmd->mSrid.c_str() ) );
+    GeometryCache cache;
+
+    sosi::ElementType geometries[ 4 ] = {
+        sosi::sosi_element_text,
+        sosi::sosi_element_point,
+        sosi::sosi_element_curve,
+        sosi::sosi_element_surface };
 
     std::map<std::string,int> objTypes;
+    ShapefileMap layers;
+    std::vector<ISosiElement*> untyped[ 4 ];
+    std::vector<std::string>& ot = mCmd->mObjTypes;
+    std::vector<std::string>& gt = mCmd->mGeomTypes;
+    std::vector<StagedLayer>* staged = concurrent ? &mStagedLayers[ index ] : 0;
 
-    sosi::SosiElementSearch src;
+    sosicon::logstream << "Processing OBJTYPE";
 
-    while( sosiTree->getChild( src ) ) {
+    // Single pass over all features, sending each one to the shapefile of its OBJTYPE and
+    // geometry. Features without OBJTYPE are only exported if the file has no OBJTYPEs at all,
+    // which is not known until the end.
+    sosi::SosiElementSearch src;
+    while( sosiTree->getChild( src ) && !( cancel && *cancel ) ) {
         ISosiElement* sosi = src.element();
         std::string objType = sosi->getObjType();
         if( !objType.empty() ) {
-            if( objTypes.find( objType ) == objTypes.end() ) {
-                objTypes[ objType ] = 1;
-            }
-            else {
-                objTypes[ objType ]++;
+            objTypes[ objType ]++;
+        }
+        int j = 0;
+        while( j < 4 && geometries[ j ] != sosi->getType() ) {
+            j++;
+        }
+        if( j == 4 ) {
+            continue;
+        }
+        if( objType.empty() ) {
+            untyped[ j ].push_back( sosi );
+            continue;
+        }
+        if( ( ot.size() > 0 && std::find( ot.begin(), ot.end(), objType ) == ot.end() ) ||
+            ( gt.size() > 0 && std::find( gt.begin(), gt.end(), ttbl.sosiTypeToName( geometries[ j ] ) ) == gt.end() ) )
+        {
+            continue;
+        }
+        shape::Shapefile*& f = layers[ std::make_pair( objType, j ) ];
+        if( !f ) {
+            f = new shape::Shapefile( makeLayerPath( index, concurrent, objType + "_" + ttbl.sosiTypeToName( geometries[ j ] ) ), header, &cache );
+            if( !mCmd->mFilterSosiId.empty() ) {
+                f->filterSosiId( mCmd->mFilterSosiId );
             }
         }
+        f->insert( sosi );
     }
 
-    sosicon::logstream << "Processing OBJTYPE";
-
-    sosi::ElementType geometries[ 4 ] = {
-        sosi::sosi_element_text,
-        sosi::sosi_element_point,
-        sosi::sosi_element_curve,
-        sosi::sosi_element_surface };
-
     if( objTypes.size() > 0 ) {
-        for( std::map<std::string,int>::iterator i = objTypes.begin(); i != objTypes.end(); i++ ) {
+        for( std::map<std::string,int>::iterator i = objTypes.begin(); i != objTypes.end() && !( cancel && *cancel ); i++ ) {
 
-            std::vector<std::string>& ot = mCmd->mObjTypes;
             if( ot.size() > 0 && std::find( ot.begin(), ot.end(), i->first ) == ot.end() )
             {
                 continue;
@@ -59,83 +86,146 @@ makeShp( ISosiElement* sosiTree, bool* cancel ) {
             std::string objTypeName = i->first;
             sosicon::logstream << "\rProcessing OBJTYPE " << objTypeName << "\n";
 
-            for( unsigned int j = 0; j < sizeof geometries; j++ ) {
-
-                if( cancel && *cancel ) {
-                    return;
-                }
-
-                sosi::ElementType geometry = geometries[ j ];
-                shape::Shapefile f;
-                if( !mCmd->mFilterSosiId.empty() ) {
-                    f.filterSosiId( mCmd->mFilterSosiId );
-                }
-
-                std::string geometryName = ttbl.sosiTypeToName( geometry );
-
-                std::vector<std::string>& gt = mCmd->mGeomTypes;
-                if( gt.size() > 0 && std::find( gt.begin(), gt.end(), geometryName ) == gt.end() )
-                {
-                    continue;
-                }
-
-                std::string basePath = makeBasePath( objTypeName + "_" + geometryName );
-
-                int count = f.build( sosiTree, i->first, geometry );
-
-                if( count > 0 ) {
-                    sosicon::logstream << "  (" << count << " elements of type " << geometryName << ")\n";
-                    writeFile<IShapefileShpPart>( f, basePath, "shp" );
-                    writeFile<IShapefileShxPart>( f, basePath, "shx" );
-                    writeFile<IShapefileDbfPart>( f, basePath, "dbf" );
-                    writeFile<IShapefilePrjPart>( f, basePath, "prj" );
+            for( int j = 0; j < 4 && !( cancel && *cancel ); j++ ) {
+                ShapefileMap::iterator layer = layers.find( std::make_pair( objTypeName, j ) );
+                if( layer != layers.end() ) {
+                    writeShp( *layer->second, sosiTree, geometries[ j ], staged, objTypeName + "_" + ttbl.sosiTypeToName( geometries[ j ] ) );
                 }
             }
         }
-        sosicon::logstream << "\rProcessing OBJTYPEs done\n";
+        if( !( cancel && *cancel ) ) {
+            sosicon::logstream << "\rProcessing OBJTYPEs done\n";
+        }
     }
     else {
 
         sosicon::logstream << "\rProcessing GEOMETRIES \n";
 
-        for( int j = 0; j < 4; j++ ) {
-
-            if( cancel && *cancel ) {
-                return;
+        for( int j = 0; j < 4 && !( cancel && *cancel ); j++ ) {
+            if( untyped[ j ].empty() ) {
+                continue;
             }
+            std::string layerName = ttbl.sosiTypeToName( geometries[ j ] );
+            shape::Shapefile f( makeLayerPath( index, concurrent, layerName ), header, &cache );
+            for( std::vector<ISosiElement*>::iterator i = untyped[ j ].begin(); i != untyped[ j ].end(); i++ ) {
+                f.insert( *i );
+            }
+            writeShp( f, sosiTree, geometries[ j ], staged, layerName );
+        }
+    }
+
+    for( ShapefileMap::iterator i = layers.begin(); i != layers.end(); i++ ) {
+        delete i->second;
+    }
+}
+
+void sosicon::ConverterSosi2shp::
+writeShp( shape::Shapefile& f,
+          ISosiElement* sosiTree,
+          sosi::ElementType geometry,
+          std::vector<StagedLayer>* staged,
+          const std::string& layerName ) {
+    int count = f.complete( sosiTree );
+    if( count < 0 ) {
+        sosicon::logstream << "    > " << f.getBasePath() << " could not be written\n";
+        mFailedLayers++;
+    }
+    else if( count > 0 ) {
+        sosi::SosiTranslationTable ttbl;
+        std::string basePath = f.getBasePath();
+        sosicon::logstream << "  (" << count << " elements of type " << ttbl.sosiTypeToName( geometry ) << ")\n";
+        writeFile<IShapefilePrjPart>( f, basePath, "prj" );
+        if( staged ) {
+            StagedLayer layer = { basePath, layerName };
+            staged->push_back( layer );
+        }
+        else {
+            logLayer( basePath );
+        }
+    }
+}
 
-            shape::Shapefile f;
-            sosi::ElementType geometry = geometries[ j ];
-            std::string geometryName = ttbl.sosiTypeToName( geometry );
-            std::string basePath = makeBasePath( geometryName );
+void sosicon::ConverterSosi2shp::
+logLayer( const std::string& basePath ) {
+    sosicon::logstream << "    > " << basePath << ".shp written\n";
+    sosicon::logstream << "    > " << basePath << ".shx written\n";
+    sosicon::logstream << "    > " << basePath << ".dbf written\n";
+    sosicon::logstream << "    > " << basePath << ".prj written\n";
+}
 
-            int count = f.build( sosiTree, "", geometry );
+std::string sosicon::ConverterSosi2shp::
+makeLayerPath( size_t index, bool concurrent, const std::string& layerName ) {
+    if( !concurrent ) {
+        return makeBasePath( mCandidatePaths[ index ], layerName );
+    }
+    std::string dir, tit, ext;
+    utils::getPathInfo( mCandidatePaths[ index ], dir, tit, ext );
+    std::stringstream ss;
+    ss << dir << tit << ".part" << index << "_" << layerName;
+    return ss.str();
+}
 
-            if( count > 0 ) {
-                sosicon::logstream << "  (" << count << " elements of type " << geometryName << ")\n";
-                writeFile<IShapefileShpPart>( f, basePath, "shp" );
-                writeFile<IShapefileShxPart>( f, basePath, "shx" );
-                writeFile<IShapefileDbfPart>( f, basePath, "dbf" );
-                writeFile<IShapefilePrjPart>( f, basePath, "prj" );
+void sosicon::ConverterSosi2shp::
+commitLayers( size_t index ) {
+    const char* extensions[ 4 ] = { ".shp", ".shx", ".dbf", ".prj" };
+    std::vector<StagedLayer>& staged = mStagedLayers[ index ];
+    for( std::vector<StagedLayer>::iterator i = staged.begin(); i != staged.end(); i++ ) {
+        std::string basePath = makeBasePath( mCandidatePaths[ index ], i->layerName );
+        bool renamed = true;
+        for( int k = 0; k < 4; k++ ) {
+            std::string from = i->stagingPath + extensions[ k ];
+            std::string to = basePath + extensions[ k ];
+            if( renamed && std::rename( from.c_str(), to.c_str() ) != 0 ) {
+                renamed = false;
             }
+            if( !renamed ) {
+                std::remove( from.c_str() );
+                std::remove( to.c_str() );
+            }
+        }
+        if( renamed ) {
+            logLayer( basePath );
+        }
+        else {
+            sosicon::logstream << "    > " << basePath << " could not be written\n";
+            mFailedLayers++;
         }
     }
+    staged.clear();
+}
+
+void sosicon::ConverterSosi2shp::
+discardLayers() {
+    const char* extensions[ 4 ] = { ".shp", ".shx", ".dbf", ".prj" };
+    for( size_t i = 0; i < mStagedLayers.size(); i++ ) {
+        for( std::vector<StagedLayer>::iterator j = mStagedLayers[ i ].begin(); j != mStagedLayers[ i ].end(); j++ ) {
+            for( int k = 0; k < 4; k++ ) {
+                std::remove( ( j->stagingPath + extensions[ k ] ).c_str() );
+            }
+        }
+        mStagedLayers[ i ].clear();
+    }
 }
 
 std::string sosicon::ConverterSosi2shp::
-makeBasePath( std::string objTypeName ) {
+makeCandidatePath( const std::string& sourceFile ) {
     std::string candidatePath, dir, tit, ext;
     if( !mCmd->mOutputFile.empty() ) {
         candidatePath = mCmd->mOutputFile;
     }
     else if( !mCmd->mDestinationDirectory.empty() ) {
-        utils::getPathInfo( mCurrentSourcefile, dir, tit, ext );
+        utils::getPathInfo( sourceFile, dir, tit, ext );
         candidatePath = utils::stripTrailingSlash( mCmd->mDestinationDirectory ) + "/" + tit + ext;
     }
     else {
-        candidatePath = mCurrentSourcefile;
+        candidatePath = sourceFile;
     }
-    dir.clear();
+    return candidatePath;
+}
+
+std::string sosicon::ConverterSosi2shp::
+makeBasePath( const std::string& candidatePath, std::string objTypeName ) {
+    std::string basePath, dir, tit, ext;
     utils::getPathInfo( candidatePath, dir, tit, ext );
     std::string subdir = dir + tit;
     char separator;
@@ -149,61 +239,97 @@ makeBasePath( std::string objTypeName ) {
 #endif
         }
         separator = '/';
-        candidatePath = subdir + separator + objTypeName;
+        basePath = subdir + separator + objTypeName;
     }
     else {
         separator = '_';
-        candidatePath = dir + tit + separator + objTypeName;
+        basePath = dir + tit + separator + objTypeName;
     }
     int sequence = 0;
 
-    while( utils::fileExists( candidatePath + ".shp" ) ||
-           utils::fileExists( candidatePath + ".shx" ) ||
-           utils::fileExists( candidatePath + ".dbf" ) ||
-           utils::fileExists( candidatePath + ".prj" ) )
+    while( utils::fileExists( basePath + ".shp" ) ||
+           utils::fileExists( basePath + ".shx" ) ||
+           utils::fileExists( basePath + ".dbf" ) ||
+           utils::fileExists( basePath + ".prj" ) )
     {
         std::stringstream ss;
         ss << subdir << separator << objTypeName << "_" << std::setw( 2 ) << std::setfill( '0' ) << ++sequence;
-        candidatePath = ss.str();
+        basePath = ss.str();
     }
 
-    return candidatePath;
+    return basePath;
 }
 
 void sosicon::ConverterSosi2shp::
-run( bool* cancel ) {
+convertFile( size_t index, bool concurrent, bool* cancel ) {
     bool userAborted = false;
-    for( std::vector<std::string>::iterator f = mCmd->mSourceFiles.begin(); f != mCmd->mSourceFiles.end() && !( cancel && *cancel ); f++ ) {
-        mCurrentSourcefile = *f;
-        if( !utils::fileExists( mCurrentSourcefile ) ) {
-            sosicon::logstream << mCurrentSourcefile << " not found!\n";
+    const std::string& sourceFile = mCmd->mSourceFiles[ index ];
+    if( !utils::fileExists( sourceFile ) ) {
+        sosicon::logstream << sourceFile << " not found!\n";
+    }
+    else {
+        sosicon::logstream << "Reading " << sourceFile << "\n";
+        Parser p;
+        MappedFile mf;
+        mf.open( sourceFile );
+        const char* blkBegin = 0;
+        const char* blkEnd = 0;
+        int n = 0;
+        if( mCmd->mCache && p.loadCache( sourceFile, mf.begin(), mf.end(), n, mCmd->mCacheHash ) ) {
+            sosicon::logstream << "Loaded from " << SosiCache::cacheFileName( sourceFile ) << "\n";
+        }
+        else if( mCmd->mThreads > 1 && !concurrent ) {
+            sosicon::logstream << "Parsing with " << mCmd->mThreads << " threads...";
+            n = p.parseParallel( mf.begin(), mf.end(), mCmd->mThreads );
         }
         else {
-            sosicon::logstream << "Reading " << mCurrentSourcefile << "\n";
-            Parser p;
-            char ln[ 1024 ];
-            std::ifstream ifs( ( mCurrentSourcefile ).c_str() );
-            int n = 0;
-            while( !ifs.eof() ) {
-                if( ++n % 100 == 0 ) {
-                    if( cancel && *cancel ) {
-                        userAborted = true;
-                        break;
-                    }
+            while( mf.getBlock( blkBegin, blkEnd ) ) {
+                if( cancel && *cancel ) {
+                    userAborted = true;
+                    break;
+                }
+                n += p.ragelParseSosi( blkBegin, blkEnd );
+                if( !concurrent ) {
                     sosicon::logstream << "\rParsing line " << n;
                 }
-                memset( ln, 0x00, sizeof ln );
-                ifs.getline( ln, sizeof ln );
-                p.ragelParseSosiLine( ln );
-            }
-            p.complete();
-            ifs.close();
-            if( !userAborted ) {
-                sosicon::logstream << "\r" << n << " lines parsed        \n";
-                sosicon::logstream << "Building shape file...\n";
-                ISosiElement* root = p.getRootElement();
-                makeShp( root, cancel );
             }
         }
+        p.complete();
+        if( !userAborted ) {
+            p.commitCache( n );
+        }
+        mf.close();
+        if( !userAborted ) {
+            sosicon::logstream << "\r" << n << " lines parsed        \n";
+            sosicon::logstream << "Building shape file...\n";
+            ISosiElement* root = p.getRootElement();
+            makeShp( root, index, concurrent, cancel );
+        }
+    }
+}
+
+void sosicon::ConverterSosi2shp::
+run( bool* cancel ) {
+    FileBatch batch( mCmd->mSourceFiles, mCmd->mThreads );
+    mCandidatePaths.clear();
+    mStagedLayers.assign( batch.size(), std::vector<StagedLayer>() );
+    mFailedLayers = 0;
+    for( size_t i = 0; i < batch.size(); i++ ) {
+        mCandidatePaths.push_back( makeCandidatePath( batch.at( i ) ) );
+    }
+    try {
+        batch.run( [ & ]( size_t i ) { convertFile( i, batch.concurrent(), cancel ); },
+                   [ & ]( size_t i ) { commitLayers( i ); },
+                   cancel );
+    }
+    catch( ... ) {
+        discardLayers();
+        throw;
+    }
+    discardLayers();
+    if( mFailedLayers > 0 ) {
+        std::stringstream ss;
+        ss << "Conversion failed, " << mFailedLayers << " shapefile(s) could not be written";
+        throw std::runtime_error( ss.str() );
     }
 }
@@ -20,13 +20,18 @@
 
 #include "logger.h"
 #include <iomanip>
+#include <atomic>
+#include <cstdio>
 #include <fstream>
 #include <vector>
+#include <map>
 #include <sstream>
+#include <stdexcept>
 #include <string>
 #include "interface/i_converter.h"
 #include "interface/i_sosi_element.h"
 #include "command_line.h"
+#include "file_batch.h"
 #include "parser.h"
 #include "utils.h"
 #include "shape/shapefile.h"
@@ -48,6 +53,10 @@ namespace sosicon {
         arguments are currently interpreted:
         - -2shp: sosicon::ConverterSosi2shp Shapefile conversion
         - -2tsv: sosicon::ConverterSosi2tsv TSV file conversion
+        - -2geojson: sosicon::ConverterSosi2geojson GeoJSON conversion
+        - -2fgb: sosicon::ConverterSosi2fgb FlatGeobuf conversion
+        - -2gpkg: sosicon::ConverterSosi2gpkg GeoPackage conversion
+        - -2parquet, -2arrow: sosicon::ConverterSosi2parquet GeoParquet and Arrow IPC conversion
         - -2xml: sosicon::ConverterSosi2xml Shape file conversion
         - -stat: sosicon::ConverterSosiStat SOSI statistics (printout)
         @{
@@ -61,22 +70,16 @@ namespace sosicon {
 
         //! Save specific shapefile part
         /*!
-            The shapefile format consists of several files. Use corresponding interface to cast
-            a instance of IShapefile to the correct file part for writing. The shapefile parts
-            interfaces are:
+            The shapefile format consists of several files. The shp, shx and dbf files are
+            written by the Shapefile instance itself, while the remaining parts are written
+            through their interfaces:
 
-            - IShapefileShpPart
-            - IShapefileShxPart
-            - IShapefileDbfPart
             - IShapefilePrjPart
 
             \param shp Reference to the source ShapeFile instance.
             \param basePath Path and file title for the file to be written, without extension.
             \param extension additional file extensions to be appended before the main extension,
                    which is one of the following:
-                   - shp (shapefile part)
-                   - shx (index part)
-                   - dbf (attributes part)
                    - prj (projection part)
         */
         template<typename T>
@@ -86,35 +89,132 @@ namespace sosicon {
             fs.open( fileName.c_str(), std::ios::out | std::ios::trunc | std::ios::binary );
             fs << *( static_cast<T*>( &shp ) );
             fs.close();
-            std::cout << "    > " << fileName << " written\n";
         }
 
+        //! Shapefile written under a temporary name, waiting for its final name
+        struct StagedLayer {
+            std::string stagingPath; //!< Temporary base path, without extension
+            std::string layerName;   //!< OBJTYPE and geometry of the shapefile
+        };
+
         //! Command line wrapper
         CommandLine* mCmd;
 
-        //! Souce file currently in process
-        std::string mCurrentSourcefile;
+        //! Output path candidate for each source file
+        /*!
+            The base of the output file names, before OBJTYPE and geometry are added. See
+            makeCandidatePath().
+         */
+        std::vector<std::string> mCandidatePaths;
 
-        void makeShp( ISosiElement* sosiTree, bool* cancel );
+        //! Number of shapefiles that could not be written, by all source files
+        std::atomic<int> mFailedLayers;
 
-        //! Make base file path for destination files
+        //! Shapefiles of each source file not yet given their final names
+        /*!
+            When several files are converted at the same time, the final names of their
+            shapefiles depend on the files already written by the files before them. Each
+            file then writes its shapefiles under temporary names, which are renamed in source
+            file order by commitLayers(). The result is the same as when the files are
+            converted one by one.
+         */
+        std::vector< std::vector<StagedLayer> > mStagedLayers;
+
+        //! Shapefiles being built, by OBJTYPE and geometry (index into makeShp's geometry list)
+        typedef std::map<std::pair<std::string, int>, shape::Shapefile*> ShapefileMap;
+
+        //! Convert SOSI tree to shapefiles
+        /*!
+            Creates one shapefile per combination of OBJTYPE and geometry type found in the SOSI
+            tree, or one per geometry type if the file has no OBJTYPEs. The tree is traversed
+            once, each feature being appended to the files of its shapefile, which are completed
+            at the end.
+            \param sosiTree Root SOSI element.
+            \param index Position of the source file among the source files.
+            \param concurrent True if other files are converted at the same time. The
+                   shapefiles are then written under temporary names, see mStagedLayers.
+            \param cancel Pointer to cancel flag, set by the caller to abort the conversion.
+         */
+        void makeShp( ISosiElement* sosiTree, size_t index, bool concurrent, bool* cancel );
+
+        //! Make base path of shapefile being built
+        /*!
+            \param index Position of the source file among the source files.
+            \param concurrent True if other files are converted at the same time.
+            \param layerName OBJTYPE and geometry of the shapefile.
+            \return Final base path from makeBasePath(), or a temporary one if concurrent.
+         */
+        std::string makeLayerPath( size_t index, bool concurrent, const std::string& layerName );
+
+        //! Give the staged shapefiles of a source file their final names
+        /*!
+            \param index Position of the source file among the source files.
+         */
+        void commitLayers( size_t index );
+
+        //! Remove the staged shapefiles that were never given their final names
+        void discardLayers();
+
+        //! Log the files of a completed shapefile
+        /*!
+            \param basePath Base path of the shapefile, without extension.
+         */
+        void logLayer( const std::string& basePath );
+
+        //! Convert one source file
+        /*!
+            \param index Position of the file among the source files.
+            \param concurrent True if other files are converted at the same time. The file
+                   is then parsed on the calling thread only.
+            \param cancel Pointer to cancel flag, set by the caller to abort the conversion.
+         */
+        void convertFile( size_t index, bool concurrent, bool* cancel );
+
+        //! Complete shapefile on disk
+        /*!
+            Writes file headers, attributes and projection. Does nothing if the shapefile is empty.
+            A shapefile that could not be written is counted in mFailedLayers, and gets no
+            projection file.
+            \param f Shapefile with all elements inserted.
+            \param sosiTree Root SOSI element.
+            \param geometry SOSI geometry type of the shapefile.
+            \param staged Staged shapefiles of the source file, to which the shapefile is
+                   added if written under a temporary name, or 0.
+            \param layerName OBJTYPE and geometry of the shapefile.
+         */
+        void writeShp( shape::Shapefile& f,
+                       ISosiElement* sosiTree,
+                       sosi::ElementType geometry,
+                       std::vector<StagedLayer>* staged,
+                       const std::string& layerName );
+
+        //! Make output path candidate for source file
         /*!
             If the user specified an output file name, it will be used as a candidate for a
             base name to create shp, shx and dbf files for the shape export. Otherwise, the
-            name of the first source file will be used by default.
+            name of the source file will be used, in the destination directory if one is
+            given.
+            \param sourceFile Path of the source file.
+            \return Output path candidate.
+        */
+        std::string makeCandidatePath( const std::string& sourceFile );
 
+        //! Make base file path for destination files
+        /*!
             This function checks if there are any name collisions, incrementing a postfixed number
             to the base name until a unique name is found.
 
+            \param candidatePath Output path candidate of the source file.
+            \param objTypeName OBJTYPE and geometry of the shapefile.
             \return Modified, unique destination base name with directory (if provided), without
                     file name extension.
         */
-        std::string makeBasePath( std::string objTypeName );
+        std::string makeBasePath( const std::string& candidatePath, std::string objTypeName );
 
     public:
 
         //! Constructor
-        ConverterSosi2shp() : mCmd( 0 ) { }
+        ConverterSosi2shp() : mCmd( 0 ), mFailedLayers( 0 ) { }
 
         //! Destructor
         virtual ~ConverterSosi2shp() { }
@@ -17,7 +17,201 @@
  */
 #include "converter_sosi2tsv.h"
 
+int sosicon::ConverterSosi2tsv::
+targetSrid() {
+    return mScanning ? 0 : ConverterSosiStream::targetSrid();
+}
+
+bool sosicon::ConverterSosi2tsv::
+onHeader() {
+    mPrecision = Projection( mHeader.getSrid() ).isGeographic() ? 9 : 5;
+    return true;
+}
+
+void sosicon::ConverterSosi2tsv::
+onFeature( ISosiElement* feature ) {
+    if( mScanning ) {
+        scanFields( feature );
+        return;
+    }
+    writeFeature( feature );
+}
+
+void sosicon::ConverterSosi2tsv::
+scanFields( ISosiElement* parent ) {
+    mRow.clear();
+    featureFields::extract( parent, mRow );
+    for( std::map<std::string,std::string>::iterator i = mRow.begin(); i != mRow.end(); i++ ) {
+        mFieldNames.insert( i->first );
+    }
+}
+
+void sosicon::ConverterSosi2tsv::
+appendCoordinate( std::string& str, double x, double y ) {
+    utils::appendFixed( str, x, mPrecision );
+    str += ' ';
+    utils::appendFixed( str, y, mPrecision );
+}
+
+void sosicon::ConverterSosi2tsv::
+appendCoordinates( std::string& str, const GeometryBuffer& coords, size_t begin, size_t end ) {
+    for( size_t i = begin; i < end; i++ ) {
+        if( i > begin ) {
+            str += ',';
+        }
+        appendCoordinate( str, coords.x( i ), coords.y( i ) );
+    }
+}
+
+bool sosicon::ConverterSosi2tsv::
+buildGeometry( ISosiElement* feature, std::string& geom ) {
+
+    CoordinateCollection cc( mHeader, &mGeometryCache );
+    Wkt wktGeom = cc.extractGeometry( feature, mGeom, mHoles );
+    if( wktGeom == wkt_unknown ) {
+        return false;
+    }
+
+    if( mGeomFormat == geom_wkb ) {
+        WkbWriter wkb;
+        wkb.writeHeader( wktGeom );
+        if( wktGeom == wkt_point ) {
+            wkb.writeCoordinate( mGeom.x( 0 ), mGeom.y( 0 ) );
+        }
+        else if( wktGeom == wkt_linestring ) {
+            wkb.writePoints( mGeom );
+        }
+        else {
+            wkb.writeCount( 1 + mHoles.numParts() );
+            wkb.writePoints( mGeom );
+            for( size_t k = 0; k < mHoles.numParts(); k++ ) {
+                wkb.writePoints( mHoles, mHoles.partBegin( k ), mHoles.partEnd( k ) );
+            }
+        }
+        geom += wkb.hex();
+        return true;
+    }
+
+    if( wktGeom == wkt_point ) {
+        geom += "POINT(";
+        appendCoordinate( geom, mGeom.x( 0 ), mGeom.y( 0 ) );
+        geom += ')';
+    }
+    else if( wktGeom == wkt_linestring ) {
+        geom += "LINESTRING(";
+        appendCoordinates( geom, mGeom, 0, mGeom.size() );
+        geom += ')';
+    }
+    else {
+        // Outer ring first, then holes
+        geom += "POLYGON((";
+        appendCoordinates( geom, mGeom, 0, mGeom.size() );
+        geom += ')';
+        for( size_t k = 0; k < mHoles.numParts(); k++ ) {
+            geom += ",(";
+            appendCoordinates( geom, mHoles, mHoles.partBegin( k ), mHoles.partEnd( k ) );
+            geom += ')';
+        }
+        geom += ')';
+    }
+    return true;
+}
+
+void sosicon::ConverterSosi2tsv::
+writeFeature( ISosiElement* feature ) {
+
+    mRow.clear();
+    featureFields::extract( feature, mRow );
+
+    mLine.clear();
+    for( std::vector<std::string>::size_type n = 0; n < mColumns.size(); n++ ) {
+        if( n > 0 ) {
+            mLine += '\t';
+        }
+        std::map<std::string,std::string>::iterator i = mRow.find( mColumns[ n ] );
+        if( i != mRow.end() ) {
+            mLine += utils::copyNormalize( i->second );
+        }
+    }
+    if( mGeomFormat != geom_none ) {
+        if( !mColumns.empty() ) {
+            mLine += '\t';
+        }
+        buildGeometry( feature, mLine );
+    }
+    mLine += '\n';
+    mOutput.write( mLine.data(), mLine.size() );
+    mRowCount++;
+}
+
+void sosicon::ConverterSosi2tsv::
+writeHeader() {
+    mLine.clear();
+    for( std::vector<std::string>::size_type n = 0; n < mColumns.size(); n++ ) {
+        if( n > 0 ) {
+            mLine += '\t';
+        }
+        mLine += mColumns[ n ];
+    }
+    if( mGeomFormat != geom_none ) {
+        if( !mColumns.empty() ) {
+            mLine += '\t';
+        }
+        mLine += "geom";
+    }
+    mLine += '\n';
+    mOutput.write( mLine.data(), mLine.size() );
+}
+
 void sosicon::ConverterSosi2tsv::
 run( bool* ) {
 
+    if( mCmd->mGeomFormat.empty() || mCmd->mGeomFormat == "wkt" ) {
+        mGeomFormat = geom_wkt;
+    }
+    else if( mCmd->mGeomFormat == "wkb" ) {
+        mGeomFormat = geom_wkb;
+    }
+    else if( mCmd->mGeomFormat == "none" ) {
+        mGeomFormat = geom_none;
+    }
+    else {
+        sosicon::logstream << "Unknown geometry format " << mCmd->mGeomFormat << ", expected wkt, wkb or none\n";
+        return;
+    }
+
+    if( !mCmd->mFieldSelection.empty() ) {
+        for( std::vector<std::string>::iterator f = mCmd->mFieldSelection.begin(); f != mCmd->mFieldSelection.end(); f++ ) {
+            mColumns.push_back( utils::toFieldname( *f ) );
+        }
+    }
+    else {
+        // Fix the column set before any row is written
+        mScanning = true;
+        for( std::vector<std::string>::iterator f = mCmd->mSourceFiles.begin(); f != mCmd->mSourceFiles.end(); f++ ) {
+            parseFile( *f, "Scanning" );
+        }
+        mScanning = false;
+        mColumns.assign( mFieldNames.begin(), mFieldNames.end() );
+    }
+
+    std::string defaultOutputFile = mCmd->mOutputFile.empty() ? "sosicon.tsv" : mCmd->mOutputFile;
+    std::string outputFileName = utils::nonExistingFilename( defaultOutputFile );
+    mOutput.open( outputFileName.c_str(), std::ios::out | std::ios::trunc | std::ios::binary );
+    if( !mOutput ) {
+        sosicon::logstream << "Could not write " << outputFileName << "\n";
+        return;
+    }
+
+    if( mCmd->mIncludeHeader ) {
+        writeHeader();
+    }
+    for( std::vector<std::string>::iterator f = mCmd->mSourceFiles.begin(); f != mCmd->mSourceFiles.end(); f++ ) {
+        parseFile( *f );
+    }
+    mOutput.close();
+    mGeometryCache.clear();
+
+    sosicon::logstream << mRowCount << " rows written to " << outputFileName << "\n";
+    sosicon::logstream << "Done!\n";
 }
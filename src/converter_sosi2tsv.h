@@ -18,11 +18,29 @@
 #ifndef __CONVERTER_SOSI2TSV_H__
 #define __CONVERTER_SOSI2TSV_H__
 
+#include "logger.h"
 #include <iostream>
 #include <fstream>
+#include <algorithm>
 #include <vector>
+#include <map>
+#include <set>
+#include "utils.h"
+#include "converter_sosi_stream.h"
 #include "interface/i_converter.h"
+#include "interface/i_sosi_element.h"
+#include "sosi/sosi_types.h"
+#include "sosi/sosi_element_index.h"
+#include "sosi/sosi_element_search.h"
+#include "sosi/sosi_header_context.h"
+#include "sosi/sosi_north_east.h"
+#include "coordinate_collection.h"
+#include "feature_fields.h"
+#include "geometry_cache.h"
+#include "wkb_writer.h"
+#include "projection.h"
 #include "command_line.h"
+#include "common_types.h"
 #include "parser.h"
 
 namespace sosicon {
@@ -34,26 +52,112 @@ namespace sosicon {
     //! SOSI to TSV converter
     /*!
         If command-line parameter -2tsv is specified, this converter will handle the output
-        generation. Produces a TSV file (tab separated values) SOSI source.
+        generation. Produces a TSV file (tab separated values) SOSI source, with one row for
+        each point, curve and surface, and the geometry as WKT, hex encoded WKB or not at all
+        in the last column (-geom).
+
+        The source files are parsed in streaming mode, and each row is written as soon as its
+        feature is complete. The columns must therefore be known in advance: they are either
+        given by -f, or collected from all source files by a pre-scan before the rows are
+        written.
      */
-    class ConverterSosi2tsv : public IConverter {
+    class ConverterSosi2tsv : public ConverterSosiStream {
 
-        //! Command line wrapper
-        CommandLine* mCmd;
+        //! Geometry column encoding
+        enum GeomFormat {
+            geom_none,                  //!< No geometry column
+            geom_wkt,                   //!< Well-known text
+            geom_wkb                    //!< Hex encoded well-known binary
+        };
 
-        //! Destructor
-        virtual ~ConverterSosi2tsv() { };
+        //! Geometry column encoding
+        GeomFormat mGeomFormat;
 
-    public:
-        //! Constructor
-        ConverterSosi2tsv() : mCmd( 0 ) { };
-        
-        //! Initialize converter
+        //! Attribute columns, in output order
+        std::vector<std::string> mColumns;
+
+        //! Attribute field names found by the pre-scan
+        std::set<std::string> mFieldNames;
+
+        //! True while pre-scanning for field names, false while writing rows
+        bool mScanning;
+
+        //! Target file
+        std::ofstream mOutput;
+
+        //! Number of decimals in WKT coordinates (more for geographic coordinates)
+        int mPrecision;
+
+        //! Attribute values of the feature in process, by field name
+        std::map<std::string,std::string> mRow;
+
+        //! Work buffers of the geometry being written
+        GeometryBuffer mGeom;
+        GeometryBuffer mHoles;
+
+        //! Row being built, reused for every feature
+        std::string mLine;
+
+        //! Number of rows written
+        int mRowCount;
+
+        //! Collect the field names of a feature (pre-scan)
+        void scanFields( ISosiElement* parent );
+
+        //! Append WKT coordinate pair
+        void appendCoordinate( std::string& str, double x, double y );
+
+        //! Append comma separated WKT coordinate pairs of vertices [begin, end)
+        void appendCoordinates( std::string& str, const GeometryBuffer& coords, size_t begin, size_t end );
+
+        //! Build the geometry column of a feature
         /*!
-            Implementation details in sosicon::IConverter::init()
-            \sa sosicon::IConverter::init()
+            \param feature Point, curve or surface element.
+            \param geom The geometry, as WKT or hex encoded WKB, is appended to this string.
+            \return false if the feature has no valid geometry.
+            \sa sosicon::CoordinateCollection::extractGeometry()
+        */
+        bool buildGeometry( ISosiElement* feature, std::string& geom );
+
+        //! Write the row of one feature
+        void writeFeature( ISosiElement* feature );
+
+        //! Write the column header line (-h)
+        void writeHeader();
+
+        //! Output grid requested for the source file in process
+        /*!
+            No grid during the pre-scan, so that transformations are only reported once.
+            \sa sosicon::ConverterSosiStream::targetSrid()
          */
-        virtual void init( CommandLine* cmd ) { mCmd = cmd; };
+        virtual int targetSrid();
+
+        //! Header context of a source file is set up
+        /*!
+            Sets up the coordinate precision for the grid of the source file.
+            \sa sosicon::ConverterSosiStream::onHeader()
+         */
+        virtual bool onHeader();
+
+        //! Receive feature from parser
+        /*!
+            Collects the field names of the feature during the pre-scan, and writes its row
+            otherwise.
+            \sa sosicon::ConverterSosiStream::onFeature()
+         */
+        virtual void onFeature( ISosiElement* feature );
+
+    public:
+
+        //! Constructor
+        ConverterSosi2tsv() :
+            mGeomFormat( geom_wkt ),
+            mScanning( false ),
+            mPrecision( 5 ),
+            mRowCount( 0 ) { };
+
+        //! Destructor
+        virtual ~ConverterSosi2tsv() { };
 
         //! Start conversion
         /*!
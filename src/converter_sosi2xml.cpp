@@ -17,26 +17,195 @@
  */
 #include "converter_sosi2xml.h"
 
+bool sosicon::ConverterSosi2xml::
+onHeader() {
+    int srid = mHeader.getSrid();
+    mGeographic = Projection( srid ).isGeographic();
+    mPrecision = mGeographic ? 9 : 5;
+    mSrsName.clear();
+    if( srid > 0 ) {
+        std::stringstream ss;
+        ss << "http://www.opengis.net/def/crs/EPSG/0/" << srid;
+        mSrsName = ss.str();
+    }
+    return true;
+}
+
 void sosicon::ConverterSosi2xml::
-makeXML( ISosiElement* ) {
+onFeature( ISosiElement* feature ) {
+    writeFeature( feature );
+    flush( false );
+}
 
+bool sosicon::ConverterSosi2xml::
+isXmlName( const std::string& name ) {
+    bool utf8 = mHeader.getEncoding() == sosi::sosi_charset_utf8;
+    for( std::string::size_type i = 0; i < name.size(); i++ ) {
+        unsigned char c = static_cast<unsigned char>( name[ i ] );
+        bool letter = ( c >= 'A' && c <= 'Z' ) || ( c >= 'a' && c <= 'z' ) || c == '_' ||
+                      ( utf8 ? c >= 0x80 : c >= 0xc0 && c != 0xd7 && c != 0xf7 );
+        bool other = ( c >= '0' && c <= '9' ) || c == '-' || c == '.';
+        if( !letter && ( i == 0 || !other ) ) {
+            return false;
+        }
+    }
+    return !name.empty();
 }
 
 void sosicon::ConverterSosi2xml::
-run( bool* ) {
-    for( std::vector<std::string>::iterator f = mCmd->mSourceFiles.begin(); f != mCmd->mSourceFiles.end(); f++ ) {
-        Parser p;
-        char ln[ 1024 ];
-        std::ifstream ifs( ( *f ).c_str() );
-        while( !ifs.eof() ) {
-            memset( ln, 0x00, sizeof ln );
-            ifs.getline( ln, sizeof ln );
-            p.ragelParseSosiLine( ln );
+appendText( const std::string& str ) {
+    bool utf8 = mHeader.getEncoding() == sosi::sosi_charset_utf8;
+    const std::string& text = utf8 ? str : mHeader.toIso8859_1( str );
+    for( std::string::size_type i = 0; i < text.size(); i++ ) {
+        unsigned char c = static_cast<unsigned char>( text[ i ] );
+        switch( c ) {
+            case '&':
+                mBuffer += "&amp;";
+                break;
+            case '<':
+                mBuffer += "&lt;";
+                break;
+            case '>':
+                mBuffer += "&gt;";
+                break;
+            case '"':
+                mBuffer += "&quot;";
+                break;
+            default:
+                if( c < 0x20 && c != '\t' && c != '\n' && c != '\r' ) {
+                    // Not allowed in XML 1.0
+                }
+                else if( c < 0x80 || utf8 ) {
+                    mBuffer += static_cast<char>( c );
+                }
+                else {
+                    // ISO8859-1 to UTF-8
+                    mBuffer += static_cast<char>( 0xc0 | ( c >> 6 ) );
+                    mBuffer += static_cast<char>( 0x80 | ( c & 0x3f ) );
+                }
         }
-        p.complete();
-        ifs.close();
-        ISosiElement* root = p.getRootElement();
-        makeXML( root );
     }
 }
 
+void sosicon::ConverterSosi2xml::
+appendPosList( const GeometryBuffer& coords, size_t begin, size_t end ) {
+    for( size_t i = begin; i < end; i++ ) {
+        if( i > begin ) {
+            mBuffer += ' ';
+        }
+        utils::appendFixed( mBuffer, mGeographic ? coords.y( i ) : coords.x( i ), mPrecision );
+        mBuffer += ' ';
+        utils::appendFixed( mBuffer, mGeographic ? coords.x( i ) : coords.y( i ), mPrecision );
+    }
+}
+
+void sosicon::ConverterSosi2xml::
+appendGeometry( ISosiElement* feature, const std::string& id ) {
+
+    std::string attributes = " gml:id=\"" + id + ".g\"";
+    if( !mSrsName.empty() ) {
+        attributes += " srsName=\"" + mSrsName + "\"";
+    }
+    attributes += " srsDimension=\"2\"";
+
+    CoordinateCollection cc( mHeader, &mGeometryCache );
+    switch( cc.extractGeometry( feature, mGeom, mHoles ) ) {
+        case wkt_point:
+            mBuffer += "<sosi:geometri><gml:Point" + attributes + "><gml:pos>";
+            appendPosList( mGeom, 0, 1 );
+            mBuffer += "</gml:pos></gml:Point></sosi:geometri>";
+            break;
+        case wkt_linestring:
+            mBuffer += "<sosi:geometri><gml:LineString" + attributes + "><gml:posList>";
+            appendPosList( mGeom, 0, mGeom.size() );
+            mBuffer += "</gml:posList></gml:LineString></sosi:geometri>";
+            break;
+        case wkt_polygon:
+            mBuffer += "<sosi:geometri><gml:Polygon" + attributes + ">";
+            mBuffer += "<gml:exterior><gml:LinearRing><gml:posList>";
+            appendPosList( mGeom, 0, mGeom.size() );
+            mBuffer += "</gml:posList></gml:LinearRing></gml:exterior>";
+            for( size_t k = 0; k < mHoles.numParts(); k++ ) {
+                mBuffer += "<gml:interior><gml:LinearRing><gml:posList>";
+                appendPosList( mHoles, mHoles.partBegin( k ), mHoles.partEnd( k ) );
+                mBuffer += "</gml:posList></gml:LinearRing></gml:interior>";
+            }
+            mBuffer += "</gml:Polygon></sosi:geometri>";
+            break;
+        default:
+            break;
+    }
+}
+
+void sosicon::ConverterSosi2xml::
+writeFeature( ISosiElement* feature ) {
+
+    std::stringstream ss;
+    ss << "f" << ++mFeatureCount;
+    std::string id = ss.str();
+
+    std::string objType = utils::copyNormalize( feature->getObjType(), false );
+    if( !isXmlName( objType ) ) {
+        objType = "Feature";
+    }
+
+    mBuffer += "<gml:featureMember><sosi:";
+    appendText( objType );
+    mBuffer += " gml:id=\"" + id + "\">";
+
+    mRow.clear();
+    featureFields::extract( feature, mRow );
+    for( std::map<std::string,std::string>::iterator i = mRow.begin(); i != mRow.end(); i++ ) {
+        // Field names are lower case ASCII, see utils::toFieldname()
+        bool validName = !i->first.empty() && !( i->first[ 0 ] >= '0' && i->first[ 0 ] <= '9' );
+        std::string name = validName ? i->first : "_" + i->first;
+        mBuffer += "<sosi:" + name + ">";
+        appendText( utils::copyNormalize( i->second, false ) );
+        mBuffer += "</sosi:" + name + ">";
+    }
+
+    appendGeometry( feature, id );
+
+    mBuffer += "</sosi:";
+    appendText( objType );
+    mBuffer += "></gml:featureMember>\n";
+}
+
+void sosicon::ConverterSosi2xml::
+flush( bool force ) {
+    if( force || mBuffer.size() >= BUFFER_SIZE ) {
+        mOutput.write( mBuffer.data(), mBuffer.size() );
+        mBuffer.clear();
+    }
+}
+
+void sosicon::ConverterSosi2xml::
+run( bool* ) {
+
+    std::string defaultOutputFile = mCmd->mOutputFile.empty() ? "sosicon.gml" : mCmd->mOutputFile;
+    std::string outputFileName = utils::nonExistingFilename( defaultOutputFile );
+    mOutput.open( outputFileName.c_str(), std::ios::out | std::ios::trunc | std::ios::binary );
+    if( !mOutput ) {
+        sosicon::logstream << "Could not write " << outputFileName << "\n";
+        return;
+    }
+
+    mBuffer.reserve( BUFFER_SIZE + BUFFER_SIZE / 4 );
+    mBuffer += "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
+    mBuffer += "<sosi:FeatureCollection"
+               " xmlns:sosi=\"http://sosicon.espenandersen.no/gml\""
+               " xmlns:gml=\"http://www.opengis.net/gml/3.2\""
+               " gml:id=\"sosicon\">\n";
+
+    for( std::vector<std::string>::iterator f = mCmd->mSourceFiles.begin(); f != mCmd->mSourceFiles.end(); f++ ) {
+        parseFile( *f );
+    }
+
+    mBuffer += "</sosi:FeatureCollection>\n";
+    flush( true );
+    mOutput.close();
+    mGeometryCache.clear();
+
+    sosicon::logstream << mFeatureCount << " features written to " << outputFileName << "\n";
+    sosicon::logstream << "Done!\n";
+}
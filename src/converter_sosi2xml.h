@@ -18,11 +18,24 @@
 #ifndef __CONVERTER_SOSI2XML_H__
 #define __CONVERTER_SOSI2XML_H__
 
+#include "logger.h"
 #include <iostream>
 #include <fstream>
+#include <algorithm>
 #include <vector>
+#include <map>
+#include "converter_sosi_stream.h"
 #include "interface/i_converter.h"
 #include "interface/i_sosi_element.h"
+#include "sosi/sosi_types.h"
+#include "sosi/sosi_element_index.h"
+#include "sosi/sosi_element_search.h"
+#include "sosi/sosi_header_context.h"
+#include "sosi/sosi_north_east.h"
+#include "coordinate_collection.h"
+#include "feature_fields.h"
+#include "geometry_cache.h"
+#include "projection.h"
 #include "command_line.h"
 #include "utils.h"
 #include "parser.h"
@@ -33,33 +46,103 @@ namespace sosicon {
         \addtogroup converters
         @{
     */
-    //! SOSI to ESRI Shape converter
+    //! SOSI to GML converter
     /*!
         If command-line parameter -2xml is specified, this converter will handle the output
-        generation. Produces an ESRI Shape-file from SOSI source.
+        generation. Produces a GML 3.2 feature collection from the SOSI source(s), with one
+        gml:featureMember for each point, curve and surface. The feature element is named
+        after the OBJTYPE, the data fields become child elements, and the geometry is given
+        in the geometri element.
+
+        The source files are parsed in streaming mode, and each feature is written as soon
+        as it has been parsed and its references resolved. No document tree is built: the
+        XML text is appended to a pre-sized buffer, which is written to the file in large
+        blocks. Text is written as UTF-8.
      */
-    class ConverterSosi2xml : public IConverter {
+    class ConverterSosi2xml : public ConverterSosiStream {
+
+        //! Size of the output buffer, written to file when full
+        static const std::string::size_type BUFFER_SIZE = 4 * 1024 * 1024;
+
+        //! Target file
+        std::ofstream mOutput;
+
+        //! XML text not yet written to mOutput
+        std::string mBuffer;
+
+        //! Number of decimals in coordinates (more for geographic coordinates)
+        int mPrecision;
+
+        //! True if coordinates are geographic, written latitude first as defined by EPSG
+        bool mGeographic;
+
+        //! srsName attribute of the geometries, empty if the grid is unknown
+        std::string mSrsName;
+
+        //! Work buffers of the geometry being written
+        GeometryBuffer mGeom;
+        GeometryBuffer mHoles;
+
+        //! Data fields of the feature in process, by field name
+        std::map<std::string,std::string> mRow;
+
+        //! Number of features written, used for gml:id
+        int mFeatureCount;
+
+        //! Write buffered text to file
+        /*!
+            \param force If false, the buffer is only written when it exceeds BUFFER_SIZE.
+        */
+        void flush( bool force );
+
+        //! Append character data
+        /*!
+            Converts the string from the character set of the source file to UTF-8 and
+            escapes XML markup characters. Control characters not allowed in XML are dropped.
+        */
+        void appendText( const std::string& str );
+
+        //! Append coordinate list of gml:pos or gml:posList
+        void appendPosList( const GeometryBuffer& coords, size_t begin, size_t end );
 
-        //! Command line wrapper
-        CommandLine* mCmd;
+        //! Append geometry property of a feature
+        /*!
+            \param feature Point, curve or surface element.
+            \param id gml:id of the feature.
+        */
+        void appendGeometry( ISosiElement* feature, const std::string& id );
 
-        void makeXML( ISosiElement* parent );
+        //! Write one feature as gml:featureMember
+        void writeFeature( ISosiElement* feature );
+
+        //! Header context of a source file is set up
+        /*!
+            Sets up precision and srsName for the grid of the source file.
+            \sa sosicon::ConverterSosiStream::onHeader()
+         */
+        virtual bool onHeader();
+
+        //! Receive feature from parser
+        /*!
+            Writes the feature to the output buffer.
+            \sa sosicon::ConverterSosiStream::onFeature()
+         */
+        virtual void onFeature( ISosiElement* feature );
+
+        //! Check if OBJTYPE can be used as element name
+        bool isXmlName( const std::string& name );
 
     public:
 
         //! Constructor
-        ConverterSosi2xml() : mCmd( 0 ) { };
+        ConverterSosi2xml() :
+            mPrecision( 5 ),
+            mGeographic( false ),
+            mFeatureCount( 0 ) { };
 
         //! Destructor
         virtual ~ConverterSosi2xml() { };
 
-        //! Initialize converter
-        /*!
-            Implementation details in sosicon::IConverter::init()
-            \sa sosicon::IConverter::init()
-         */
-        virtual void init( CommandLine* cmd ) { mCmd = cmd; };
-
         //! Start conversion
         /*!
             Implementation details in sosicon::IConverter::run()
@@ -78,24 +78,33 @@ run( bool* ) {
     for( std::vector<std::string>::iterator f = mCmd->mSourceFiles.begin(); f != mCmd->mSourceFiles.end(); f++ ) {
         sosicon::logstream << "\nGenerating statistics for " << *f << "\n";
         Parser p;
-        char ln[ 1024 ];
-        std::ifstream ifs( ( *f ).c_str() );
+        MappedFile mf;
+        mf.open( *f );
+        p.streamFeatures( this, mf.begin(), mf.end() );
+        const char* blkBegin = 0;
+        const char* blkEnd = 0;
         int c = 0;
-        while( !ifs.eof() ) {
-            c++;
-            if( mCmd->mIsTtyOut && ( c % 100 ) == 0 ) {
-                sosicon::logstream << "\rParsing " << c << " lines...";
+        if( mCmd->mCache && p.loadCache( *f, mf.begin(), mf.end(), c, mCmd->mCacheHash ) ) {
+            // Elements are dispatched while loading
+        }
+        else if( mCmd->mThreads > 1 ) {
+            c = p.parseParallel( mf.begin(), mf.end(), mCmd->mThreads );
+        }
+        else {
+            while( mf.getBlock( blkBegin, blkEnd ) ) {
+                c += p.ragelParseSosi( blkBegin, blkEnd );
+                if( mCmd->mIsTtyOut ) {
+                    sosicon::logstream << "\rParsing " << c << " lines...";
+                }
             }
-            memset( ln, 0x00, sizeof ln );
-            ifs.getline( ln, sizeof ln );
-            p.ragelParseSosiLine( ln );
         }
         sosicon::logstream << "\n" << c << " lines in file   \n\n";
         p.complete();
-        ifs.close();
+        p.commitCache( c );
+        mf.close();
 
         ISosiElement* root = p.getRootElement();
-        makeStat( root );
+        mGeoTypes[ root->getName() ]++;
 
         sosi::SosiElementSearch srcHead( sosi::sosi_element_head );
         if( root->getChild( srcHead ) ) {
@@ -49,7 +49,7 @@ namespace sosicon {
         If command-line parameter -stat is specified, this converter will handle the output
         generation. Produces an ESRI Shape-file from SOSI source.
      */
-    class ConverterSosiStat : public IConverter {
+    class ConverterSosiStat : public IConverter, public FeatureEventDispatcher::Listener {
 
         //! Command line wrapper
         CommandLine* mCmd;
@@ -94,6 +94,14 @@ namespace sosicon {
          */
         virtual void run( bool* cancel = 0x00 );
 
+        //! Receive feature from parser
+        /*!
+            Counts the elements of each feature as the source file is parsed in streaming
+            mode.
+            \sa sosicon::Parser::streamFeatures()
+         */
+        virtual void onEvent( FeatureEvent& e, EventDispatcher<FeatureEvent>& ) { if( !e.mReleased ) { makeStat( e.mFeature ); } };
+
     }; // class ConverterSosistat
    /*! @} end group converters */
     
@@ -0,0 +1,119 @@
+/*
+ *  This file is part of the command-line tool sosicon.
+ *  Copyright (C) 2014  Espen Andersen, Norwegian Broadcast Corporation (NRK)
+ *
+ *  This is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "converter_sosi_stream.h"
+
+void sosicon::ConverterSosiStream::
+onEvent( FeatureEvent& e, EventDispatcher<FeatureEvent>& ) {
+    ISosiElement* feature = e.mFeature;
+    if( e.mReleased ) {
+        std::string serial = feature->getSerial();
+        long long key;
+        if( sosi::SosiElementIndex::parseSerial( serial.data(), serial.data() + serial.size(), key ) ) {
+            mGeometryCache.erase( key );
+        }
+        return;
+    }
+    switch( feature->getType() ) {
+        case sosi::sosi_element_point:
+        case sosi::sosi_element_text:
+        case sosi::sosi_element_curve:
+        case sosi::sosi_element_surface:
+            break;
+        default:
+            return;
+    }
+    if( objTypeExcluded( feature ) ) {
+        return;
+    }
+    if( !mHeaderValid ) {
+        mHeader = sosi::HeaderContext( feature->getRoot(), targetSrid() );
+        mHeaderValid = true;
+        mFileAccepted = onHeader();
+    }
+    if( mFileAccepted ) {
+        onFeature( feature );
+    }
+}
+
+bool sosicon::ConverterSosiStream::
+objTypeExcluded( ISosiElement* element ) {
+    std::vector<std::string>& ot = mCmd->mObjTypes;
+    return ot.size() > 0 && std::find( ot.begin(), ot.end(), utils::toLower( element->getObjType() ) ) == ot.end();
+}
+
+bool sosicon::ConverterSosiStream::
+checkTransformation() {
+    if( !mHeader.transformUnavailable() ) {
+        return true;
+    }
+    sosicon::logstream << "Error: " << mSourceFile << " skipped, its coordinates cannot be given in EPSG:"
+                       << mHeader.getTargetSrid() << "\n";
+    mFailedFiles++;
+    return false;
+}
+
+void sosicon::ConverterSosiStream::
+checkFailures() {
+    if( mFailedFiles > 0 ) {
+        std::stringstream ss;
+        ss << "Conversion failed, " << mFailedFiles << " source file(s) skipped";
+        throw std::runtime_error( ss.str() );
+    }
+}
+
+int sosicon::ConverterSosiStream::
+targetSrid() {
+    return atoi( mCmd->mSrid.c_str() );
+}
+
+void sosicon::ConverterSosiStream::
+parseFile( const std::string& sourceFile, const char* action ) {
+    if( !utils::fileExists( sourceFile ) ) {
+        sosicon::logstream << sourceFile << " not found\n";
+        return;
+    }
+    sosicon::logstream << action << " " << sourceFile << "\n";
+    mSourceFile = sourceFile;
+    mHeaderValid = false;
+    mFileAccepted = true;
+    mGeometryCache.clear();
+    Parser p;
+    MappedFile mf;
+    mf.open( sourceFile );
+    p.streamFeatures( this, mf.begin(), mf.end() );
+    const char* blkBegin = 0;
+    const char* blkEnd = 0;
+    int n = 0;
+    if( mCmd->mCache && p.loadCache( sourceFile, mf.begin(), mf.end(), n, mCmd->mCacheHash ) ) {
+        sosicon::logstream << "Loaded from " << SosiCache::cacheFileName( sourceFile ) << "\n";
+    }
+    else if( mCmd->mThreads > 1 ) {
+        sosicon::logstream << "Parsing with " << mCmd->mThreads << " threads...";
+        n = p.parseParallel( mf.begin(), mf.end(), mCmd->mThreads );
+    }
+    else {
+        while( mf.getBlock( blkBegin, blkEnd ) ) {
+            n += p.ragelParseSosi( blkBegin, blkEnd );
+            sosicon::logstream << "\rParsing line " << n;
+        }
+    }
+    p.complete();
+    p.commitCache( n );
+    mf.close();
+    sosicon::logstream << "\r" << n << " lines parsed        \n";
+}
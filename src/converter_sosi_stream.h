@@ -0,0 +1,326 @@
+/*
+ *  This file is part of the command-line tool sosicon.
+ *  Copyright (C) 2014  Espen Andersen, Norwegian Broadcast Corporation (NRK)
+ *
+ *  This is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __CONVERTER_SOSI_STREAM_H__
+#define __CONVERTER_SOSI_STREAM_H__
+
+#include "logger.h"
+#include <algorithm>
+#include <exception>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include "interface/i_converter.h"
+#include "interface/i_sosi_element.h"
+#include "sosi/sosi_types.h"
+#include "sosi/sosi_element_index.h"
+#include "sosi/sosi_header_context.h"
+#include "geometry_cache.h"
+#include "command_line.h"
+#include "utils.h"
+#include "parser.h"
+
+namespace sosicon {
+
+    /*!
+        \addtogroup converters
+        @{
+    */
+    //! Base class of the streaming converters
+    /*!
+        \author Espen Andersen
+        \copyright GNU General Public License
+
+        Parses the source files in streaming mode (sosicon::Parser::streamFeatures()), using
+        the cache (-cache) or parallel parsing (-j) if requested. Geometry cached for features
+        released by the parser is freed, features other than points, texts, curves and
+        surfaces or excluded by -t are ignored, and the header context is set up on the first
+        remaining feature of each source file. The features are then passed on to
+        onFeature().
+     */
+    class ConverterSosiStream : public IConverter, public FeatureEventDispatcher::Listener {
+
+    protected:
+
+        //! Command line wrapper
+        CommandLine* mCmd;
+
+        //! Header context of the source file in process
+        sosi::HeaderContext mHeader;
+
+        //! True when mHeader is set up for the source file in process
+        bool mHeaderValid;
+
+        //! False if onHeader() has rejected the source file in process
+        bool mFileAccepted;
+
+        //! Path of the source file in process
+        std::string mSourceFile;
+
+        //! Number of source files skipped because of errors
+        int mFailedFiles;
+
+        //! Decoded curves referred to by surfaces not yet taken over
+        GeometryCache mGeometryCache;
+
+        //! Parse one source file, dispatching its features to onFeature()
+        /*!
+            \param sourceFile The SOSI file.
+            \param action Verb logged in front of the file name.
+        */
+        void parseFile( const std::string& sourceFile, const char* action = "Reading" );
+
+        //! Check if objtype is excluded by -t
+        bool objTypeExcluded( ISosiElement* element );
+
+        //! Check that the source file in process can be written in the requested grid
+        /*!
+            For converters that label their output with a single grid. If the grid requested
+            by targetSrid() cannot be produced, an error is logged and the file is counted
+            in mFailedFiles.
+            \return false if the coordinates would be left in the source grid.
+        */
+        bool checkTransformation();
+
+        //! Fail the conversion if any source file has been skipped
+        /*!
+            Call when the output is complete.
+            \throw std::runtime_error if mFailedFiles is not 0.
+        */
+        void checkFailures();
+
+        //! Output grid requested for the source file in process
+        /*!
+            \return EPSG code passed to the header context, or 0 to keep the source grid.
+                    Defaults to -srid.
+        */
+        virtual int targetSrid();
+
+        //! Header context of a source file is set up
+        /*!
+            Called with mHeader set up, before the first feature of each source file is passed
+            to onFeature().
+            \return false to skip the features of the source file.
+        */
+        virtual bool onHeader() { return true; }
+
+        //! Receive feature from parser
+        /*!
+            \param feature Point, text, curve or surface, not excluded by -t.
+        */
+        virtual void onFeature( ISosiElement* feature ) = 0;
+
+    public:
+
+        //! Constructor
+        ConverterSosiStream() :
+            mCmd( 0 ),
+            mHeaderValid( false ),
+            mFileAccepted( true ),
+            mFailedFiles( 0 ) { };
+
+        //! Destructor
+        virtual ~ConverterSosiStream() { };
+
+        //! Initialize converter
+        /*!
+            Implementation details in sosicon::IConverter::init()
+            \sa sosicon::IConverter::init()
+         */
+        virtual void init( CommandLine* cmd ) { mCmd = cmd; };
+
+        //! Receive event from parser
+        /*!
+            Frees the cached geometry of released features, and filters the features passed
+            on to onFeature().
+            \sa sosicon::Parser::streamFeatures()
+         */
+        virtual void onEvent( FeatureEvent& e, EventDispatcher<FeatureEvent>& d );
+
+    }; // class ConverterSosiStream
+
+    //! Encoder state of the batch converters that need none
+    struct NoBatchEncoder { };
+
+    //! Base class of the streaming converters that encode features in batches
+    /*!
+        \author Espen Andersen
+        \copyright GNU General Public License
+
+        The features passed on by ConverterSosiStream are taken over into a batch by
+        takeFeature(), so that they outlive the parser. When the batch is full, it is split
+        into contiguous shares, one for each worker thread given by -j, and each thread
+        encodes its share by encodeFeature() into a buffer of its own. The encoded features
+        are then handed to writeFeature() in feature order.
+
+        \tparam F Feature taken over from the parser.
+        \tparam E Encoder state, one default-constructed instance for each worker thread.
+     */
+    template<typename F, typename E>
+    class ConverterSosiBatch : public ConverterSosiStream {
+
+        //! Features waiting to be encoded
+        std::vector<F> mBatch;
+
+        //! Number of features in mBatch
+        size_t mBatchCount;
+
+        //! Encoded features of each worker thread
+        std::vector<std::string> mChunks;
+
+        //! Size of each encoded feature in mBatch
+        std::vector<size_t> mSizes;
+
+    protected:
+
+        //! Number of features encoded at a time
+        static const size_t BATCH_SIZE = 8192;
+
+        //! Next free batch entry
+        /*!
+            Entries are reused from batch to batch, so containers in the feature keep their
+            capacity. The entry is only added to the batch by commitFeature().
+         */
+        F& nextFeature() {
+            if( mBatch.size() <= mBatchCount ) {
+                mBatch.resize( mBatchCount + 1 );
+            }
+            return mBatch[ mBatchCount ];
+        }
+
+        //! Add the entry returned by nextFeature() to the batch
+        void commitFeature() { mBatchCount++; }
+
+        //! Encode and write the features of the batch
+        void flushBatch() {
+            const size_t count = mBatchCount;
+            if( count == 0 ) {
+                return;
+            }
+            size_t threads = static_cast<size_t>( std::max( 1, mCmd->mThreads ) );
+            threads = std::min( threads, ( count + 255 ) / 256 );
+            mChunks.resize( std::max( mChunks.size(), threads ) );
+            mSizes.resize( count );
+
+            // Contiguous shares, so that the chunks are in feature order
+            const size_t share = ( count + threads - 1 ) / threads;
+            std::vector<std::exception_ptr> errors( threads );
+            std::vector<std::thread> workers;
+            for( size_t t = 0; t < threads; t++ ) {
+                auto encode = [ this, t, share, count, &errors ]() {
+                    try {
+                        E encoder;
+                        std::string& out = mChunks[ t ];
+                        out.clear();
+                        for( size_t i = t * share; i < std::min( count, ( t + 1 ) * share ); i++ ) {
+                            size_t begin = out.size();
+                            encodeFeature( encoder, mBatch[ i ], i, out );
+                            mSizes[ i ] = out.size() - begin;
+                        }
+                    }
+                    catch( ... ) {
+                        errors[ t ] = std::current_exception();
+                    }
+                };
+                if( threads > 1 ) {
+                    workers.push_back( std::thread( encode ) );
+                }
+                else {
+                    encode();
+                }
+            }
+            for( std::vector<std::thread>::iterator w = workers.begin(); w != workers.end(); w++ ) {
+                w->join();
+            }
+            for( size_t t = 0; t < threads; t++ ) {
+                if( errors[ t ] ) {
+                    std::rethrow_exception( errors[ t ] );
+                }
+            }
+
+            for( size_t t = 0; t < threads; t++ ) {
+                const char* p = mChunks[ t ].data();
+                for( size_t i = t * share; i < std::min( count, ( t + 1 ) * share ); i++ ) {
+                    writeFeature( mBatch[ i ], p, mSizes[ i ] );
+                    p += mSizes[ i ];
+                }
+            }
+            mBatchCount = 0;
+        }
+
+        //! Write the remaining features and free the batch
+        void completeBatch() {
+            flushBatch();
+            mBatch.clear();
+            mChunks.clear();
+            mSizes.clear();
+        }
+
+        //! Take over feature from the parser
+        /*!
+            Fills in the entry returned by nextFeature(), and calls commitFeature() unless
+            the feature is skipped.
+        */
+        virtual void takeFeature( ISosiElement* feature ) = 0;
+
+        //! Encode one feature
+        /*!
+            Called on the worker threads, so this must only read the converter state.
+            \param encoder Encoder state of the calling thread.
+            \param f The feature.
+            \param index Position of the feature in the batch.
+            \param out The encoded feature is appended to this string.
+        */
+        virtual void encodeFeature( E& encoder, const F& f, size_t index, std::string& out ) const = 0;
+
+        //! Write one encoded feature
+        /*!
+            Called in feature order, on the calling thread.
+            \param f The feature.
+            \param data Encoded feature.
+            \param size Size of the encoded feature in bytes.
+        */
+        virtual void writeFeature( const F& f, const char* data, size_t size ) = 0;
+
+        //! Receive feature from parser
+        /*!
+            Adds the feature to the batch, and encodes the batch when full.
+            \sa sosicon::ConverterSosiStream::onFeature()
+         */
+        virtual void onFeature( ISosiElement* feature ) {
+            takeFeature( feature );
+            if( mBatchCount == BATCH_SIZE ) {
+                flushBatch();
+            }
+        }
+
+    public:
+
+        //! Constructor
+        ConverterSosiBatch() : mBatchCount( 0 ) { };
+
+        //! Destructor
+        virtual ~ConverterSosiBatch() { };
+
+    }; // class ConverterSosiBatch
+   /*! @} end group converters */
+
+}; // namespace sosicon
+
+#endif
@@ -17,69 +17,6 @@
  */
 #include "coordinate_collection.h"
 
-bool sosicon::
-getNext( ICoordinate*& coord, sosi::NorthEastList& list, sosi::NorthEastList::iterator& i ) {
-    if( 0 == coord ) {
-        i = list.begin();
-    }
-    if( i == list.end() ) {
-        return false;
-    }
-    if( false == ( *i )->getNext( coord ) ) {
-        i++;
-        coord = 0;
-        if( i != list.end() ) {
-            return false;
-        }
-        else {
-            ( *i )->getNext( coord );
-        }
-    }
-    return true;
-}
-
-bool sosicon::
-getNextOffset( int& offset, std::vector<int>& offsets, std::vector<int>::iterator& iterator ) {
-    if( -1 == offset ) {
-        iterator = offsets.begin();
-    }
-    if( iterator == offsets.end() ) {
-        return false;
-    }
-    offset = *iterator;
-    iterator++;
-    return true;
-}
-
-bool sosicon::
-isCounterClockwise( std::vector<ICoordinate*>::iterator& begin, std::vector<ICoordinate*>::iterator& end ) {
-    return !isClockwise( begin, end );
-}
-
-bool sosicon::
-isClockwise( std::vector<ICoordinate*>::iterator& begin, std::vector<ICoordinate*>::iterator& end ) {
-    double edgeSum = 0.0;
-    ICoordinate* v1 = 0, * v2 = 0;
-    for( std::vector<ICoordinate*>::iterator i = begin; i != end; i++ ) {
-        v1 = *i;
-        v2 = *( ( i + 1 != end ) ? i + 1 : begin );
-        edgeSum += ( v2->getE() - v1->getE() ) * ( v2->getN() + v1->getN() );
-    }
-    return edgeSum > 0;
-}
-
-void sosicon::
-neListToCoordList( sosi::NorthEastList& neList, std::vector<ICoordinate*>& coordList ) {
-    coordList.clear();
-    for( sosi::NorthEastList::iterator i = neList.begin(); i != neList.end(); i++ ) {
-        sosi::SosiNorthEast* ne = *i;
-        ICoordinate* c = 0;
-        while( ne->getNext( c ) ) {
-            coordList.push_back( c );
-        }
-    }
-}
-
 sosicon::CoordinateCollection::
 ~CoordinateCollection() {
     free();
@@ -87,8 +24,8 @@ sosicon::CoordinateCollection::
 
 void sosicon::CoordinateCollection::
 free() {
-    sosi::deleteNorthEasts( mGeom );
-    sosi::deleteNorthEasts( mHoles );
+    mGeom.clear();
+    mHoles.clear();
 }
 
 void sosicon::CoordinateCollection::
@@ -98,58 +35,42 @@ discoverCoords( ISosiElement* e ) {
             {
                 sosi::SosiElementSearch srcRef( sosi::sosi_element_ref );
                 ISosiElement* rawRefElement = 0;
+                GeometryBuffer decoded;
                 while( e->getChild( srcRef ) ) {
                     rawRefElement = srcRef.element();
                     sosi::SosiRefList refList( rawRefElement );
                     sosi::GeometryRef* geometry = 0;
                     while( refList.getNextGeometry( geometry ) ) {
                         bool isHole = ( *geometry )[ 0 ]->subtract;
-                        int numPoints = 0;
-                        sosi::NorthEastList tmpNEList;
+                        RingBuilder ring( isHole ? mHoles : mGeom );
                         for( sosi::GeometryRef::iterator i = geometry->begin(); i != geometry->end(); i++ ) {
                             sosi::ReferenceData* refData = *i;
                             ISosiElement* referencedElement = rawRefElement->find( refData->serial );
                             if( referencedElement ) {
-
-                                extractPath( referencedElement,
-                                             refData->reverse,
-                                             numPoints,
-                                             isHole? mHoles : mGeom ); // target&
-
+                                ring.append( extractPath( referencedElement, refData->serial, decoded ), refData->reverse );
                             }
                         }
-
-                        if( isHole ) {
-                            mHoleSizes.insert( mHoleSizes.begin(), numPoints );
-                            mNumPointsHoles += numPoints;
-                            mNumPartsHoles++;
-                        }
-                        else {
-                            mGeomSizes.insert( mGeomSizes.begin(), numPoints );
-                            mNumPointsGeom += numPoints;
-                            mNumPartsGeom++;
-                        }
-
+                        ring.close();
+                        // Outer rings clockwise, holes counter-clockwise
+                        ring.orient( !isHole );
+                        ring.expandBoundingBox( mXmin, mYmin, mXmax, mYmax );
                     }
                 }
+                mGeomNormalized = true;
+                mHolesNormalized = true;
             }
             break;
         case sosi::sosi_element_text:
         case sosi::sosi_element_point:
         case sosi::sosi_element_curve:
             {
-                mNumPartsGeom = 1;
-                mNumPartsHoles = 0;
-                int numPoints = 0;
+                mGeom.beginPart();
                 sosi::SosiElementSearch srcNe( sosi::sosi_element_ne );
                 while( e->getChild( srcNe ) ) {
-                    sosi::SosiNorthEast* ne = new sosi::SosiNorthEast( srcNe.element() );
-                    mGeom.push_back( ne );
-                    numPoints += ne->getNumPoints();
-                    ne->expandBoundingBox( mXmin, mYmin, mXmax, mYmax );
+                    sosi::SosiNorthEast ne( srcNe.element(), *mHeader );
+                    mGeom.append( ne.getCoordinates() );
+                    ne.expandBoundingBox( mXmin, mYmin, mXmax, mYmax );
                 }
-                mGeomSizes.push_back( numPoints );
-                mNumPointsGeom = numPoints;
             }
             break;
         default:
@@ -157,74 +78,101 @@ discoverCoords( ISosiElement* e ) {
     }
 }
 
-void sosicon::CoordinateCollection::
-extractPath( ISosiElement* referencedElement,
-             bool reverse,
-             int& numPoints,
-             sosi::NorthEastList& target ) {
-
-    sosi::SosiElementSearch  src( sosi::sosi_element_ne );
-    std::string obj = referencedElement->getObjType();
-    sosi::NorthEastList tmpLst;
-
-    while( referencedElement->getChild( src ) ) {
-        sosi::SosiNorthEast* ne = new sosi::SosiNorthEast( src.element() );
-        if( reverse ) {
-            ne->reverse();
-            if( tmpLst.size() == 0 ) {
-                tmpLst.push_back( ne );
+sosicon::Wkt sosicon::CoordinateCollection::
+extractGeometry( ISosiElement* sosi, GeometryBuffer& geom, GeometryBuffer& holes ) {
+    geom.clear();
+    holes.clear();
+    switch( sosi->getType() ) {
+        case sosi::sosi_element_point:
+        case sosi::sosi_element_text:
+            {
+                sosi::SosiElementSearch srcNe( sosi::sosi_element_ne );
+                if( !sosi->getChild( srcNe ) ) {
+                    return wkt_unknown;
+                }
+                sosi::SosiNorthEast ne( srcNe.element(), *mHeader );
+                const GeometryBuffer& coord = ne.getCoordinates();
+                if( coord.empty() ) {
+                    return wkt_unknown;
+                }
+                geom.append( coord.y( 0 ), coord.x( 0 ) );
+                mXmin = mXmax = coord.x( 0 );
+                mYmin = mYmax = coord.y( 0 );
+                return wkt_point;
             }
-            else {
-                tmpLst.insert( tmpLst.begin(), ne );
+        case sosi::sosi_element_curve:
+        case sosi::sosi_element_surface:
+            {
+                bool surface = sosi->getType() == sosi::sosi_element_surface;
+                discoverCoords( sosi );
+                // Only surface rings are oriented; curves keep their digitised direction
+                const GeometryBuffer& coords = surface ? getGeom() : mGeom;
+                if( coords.size() < ( surface ? 4u : 2u ) ) {
+                    return wkt_unknown;
+                }
+                geom.append( coords );
+                if( !surface ) {
+                    return wkt_linestring;
+                }
+                const GeometryBuffer& theHoles = getHoles();
+                for( size_t k = 0; k < theHoles.numParts(); k++ ) {
+                    if( theHoles.partSize( k ) >= 4 ) {
+                        holes.beginPart();
+                        for( size_t i = theHoles.partBegin( k ); i < theHoles.partEnd( k ); i++ ) {
+                            holes.append( theHoles.y( i ), theHoles.x( i ) );
+                        }
+                    }
+                }
+                return wkt_polygon;
             }
+        default:
+            return wkt_unknown;
+    }
+}
+
+const sosicon::GeometryBuffer& sosicon::CoordinateCollection::
+extractPath( ISosiElement* referencedElement,
+             const std::string& serial,
+             GeometryBuffer& decoded ) {
+
+    long long key = 0;
+    bool cacheable = mCache && sosi::SosiElementIndex::parseSerial( serial.data(), serial.data() + serial.size(), key );
+    const GeometryBuffer* path = cacheable ? mCache->find( key ) : 0;
+
+    if( !path ) {
+        decoded.clear();
+        sosi::SosiElementSearch src( sosi::sosi_element_ne );
+        while( referencedElement->getChild( src ) ) {
+            sosi::SosiNorthEast ne( src.element(), *mHeader );
+            decoded.append( ne.getCoordinates() );
         }
-        else {
-            tmpLst.push_back( ne );
-        }
-        numPoints += ne->getNumPoints();
-        ne->expandBoundingBox( mXmin, mYmin, mXmax, mYmax );
+        path = cacheable ? &mCache->insert( key, decoded ) : &decoded;
     }
-    target.insert( target.begin(), tmpLst.begin(), tmpLst.end() );
+    return *path;
 }
 
-std::vector<sosicon::ICoordinate*>& sosicon::CoordinateCollection::
+const sosicon::GeometryBuffer& sosicon::CoordinateCollection::
 getGeom() {
-
-    neListToCoordList( mGeom, mGeomNormalized );
-    if( mGeomNormalized.size() > 1 ) {
-        std::vector<ICoordinate*>::iterator i0 = mGeomNormalized.begin();
-        std::vector<ICoordinate*>::iterator i1 = mGeomNormalized.end();
-        if( isCounterClockwise( i0, i1 ) ) {
-            std::reverse( mGeomNormalized.begin(), mGeomNormalized.end() );
+    if( !mGeomNormalized ) {
+        if( mGeom.size() > 1 && !mGeom.isClockwise( 0, mGeom.size() ) ) {
+            mGeom.reverse();
         }
+        mGeomNormalized = true;
     }
-    return mGeomNormalized;
+    return mGeom;
 }
 
-std::vector<sosicon::ICoordinate*>& sosicon::CoordinateCollection::
+const sosicon::GeometryBuffer& sosicon::CoordinateCollection::
 getHoles() {
-
-    neListToCoordList( mHoles, mHolesNormalized );
-    if( mHolesNormalized.size() > 1 ) {
-        std::vector<ICoordinate*>::size_type p0 = 0;
-        std::vector<ICoordinate*>::size_type p1 = 0;
-        for( std::vector<int>::iterator i = mHoleSizes.begin(); i != mHoleSizes.end(); i++ ) {
-            int size = *i;
-            p1 += size;
-            if( size > 1 ) {
-                std::vector<ICoordinate*>::iterator i0 = mHolesNormalized.begin() + p0;
-                std::vector<ICoordinate*>::iterator i1 = p1 < mHolesNormalized.size() ? mHolesNormalized.begin() + p1 : mHolesNormalized.end();
-                if( isClockwise( i0, i1 ) ) {
-                    std::reverse( i0, i1 );
-                }
+    if( !mHolesNormalized ) {
+        for( size_t k = 0; k < mHoles.numParts(); k++ ) {
+            size_t begin = mHoles.partBegin( k );
+            size_t end = mHoles.partEnd( k );
+            if( end - begin > 1 && mHoles.isClockwise( begin, end ) ) {
+                mHoles.reverse( begin, end );
             }
-            p0 += size;
         }
+        mHolesNormalized = true;
     }
-    return mHolesNormalized;
-}
-
-bool sosicon::CoordinateCollection::
-getNextInGeom( ICoordinate*& coord ) {
-    return getNext( coord, mGeom, mGeomIndex );
+    return mHoles;
 }
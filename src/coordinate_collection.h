@@ -18,81 +18,49 @@
 #ifndef __COORDINATE_COLLECTION_H__
 #define __COORDINATE_COLLECTION_H__
 
-#include <algorithm>
-#include <limits>
 #include <vector>
 #include "logger.h"
 #include "common_types.h"
 #include "sosi/sosi_types.h"
+#include "sosi/sosi_element_index.h"
 #include "sosi/sosi_element_search.h"
+#include "sosi/sosi_header_context.h"
 #include "sosi/sosi_ref_list.h"
 #include "sosi/sosi_north_east.h"
-#include "interface/i_coordinate.h"
+#include "geometry_buffer.h"
+#include "geometry_cache.h"
+#include "ring_builder.h"
 #include "interface/i_sosi_element.h"
 
 namespace sosicon {
 
-    typedef std::vector<ICoordinate*> CoordinateList;
-
-    //! Get next coordinate in list
-    bool getNext( ICoordinate*& coord, sosi::NorthEastList& list, sosi::NorthEastList::iterator& i );
-    
-    //! Get next offset in part offsets list
-    bool getNextOffset( int& offset, std::vector<int>& offsets, std::vector<int>::iterator& iterator );
-
-    //! Analyzes polygon direction
-    /*!
-        Checks a series of coordinates to see if they are ordered in a clockwise manner.
-        \param begin Iterator to the first item to be analyzed.
-        \param end Iterator to the end item, one item past the last one to be analyzed.
-        \return true if the coordinates are ordered clockwise.
-    */
-    bool isClockwise( std::vector<ICoordinate*>::iterator& begin, std::vector<ICoordinate*>::iterator& end );
-
-    //! Analyzes polygon direction
-    /*!
-        Checks a series of coordinates to see if they are ordered in a counter-clockwise manner.
-        \param begin Iterator to the first item to be analyzed.
-        \param end Iterator to the end item, one item past the last one to be analyzed.
-        \return true if the coordinates are ordered counter-clockwise.
-    */
-    bool isCounterClockwise( std::vector<ICoordinate*>::iterator& begin, std::vector<ICoordinate*>::iterator& end );
-
-    //! Extracts single coordinates from list of North-East elements
-    /*!
-        Converts a vector of NE elements to a vector of coordinates.
-
-        \param neList The source vector.
-        \param coordList The destination vector.
-    */
-    void neListToCoordList( sosi::NorthEastList& neList, std::vector<ICoordinate*>& coordList );
-
     //! Coordinate container
     /*!
         \author Espen Andersen
         \copyright GNU General Public License
 
-        Stores a collection of geographical positions.
+        Stores a collection of geographical positions. The outer geometry and the holes of
+        a polygon are held in one GeometryBuffer each, with one part per ring. Rings are
+        assembled from their referenced curves by RingBuilder, in the order given by the
+        REF element.
      */
     class CoordinateCollection {
 
-        //! Stores collection of pointers to coordinates for geometries
-        sosi::NorthEastList mGeom;
-        std::vector<ICoordinate*> mGeomNormalized;
-
-        sosi::NorthEastList mHoles;
-        std::vector<ICoordinate*> mHolesNormalized;
+        //! Outer geometry, one part per curve or ring
+        GeometryBuffer mGeom;
 
-        int mNumPartsGeom;
-        int mNumPartsHoles;
+        //! Polygon holes, one part per ring
+        GeometryBuffer mHoles;
 
-        int mNumPointsGeom;
-        int mNumPointsHoles;
+        //! True when mGeom and mHoles have been oriented by getGeom() and getHoles()
+        bool mGeomNormalized;
+        bool mHolesNormalized;
 
-        std::vector<int> mGeomSizes;
-        std::vector<int> mHoleSizes;
+        //! Header context of the SOSI file the coordinates are read from
+        const sosi::HeaderContext* mHeader;
 
-        sosi::NorthEastList::iterator mGeomIndex;
+        //! Decoded curves of the SOSI file, or 0 to decode each reference anew
+        GeometryCache* mCache;
 
         double mXmin;
         double mYmin;
@@ -100,10 +68,18 @@ namespace sosicon {
         double mYmax;
 
         //! Get coordinate values from SOSI element
-        void extractPath( ISosiElement* referencedElement,
-                          bool reverse,
-                          int& numPoints,
-                          sosi::NorthEastList& target );
+        /*!
+            Returns the coordinates of all N elements of referencedElement, in file order.
+            The coordinates are taken from the geometry cache if the curve has been
+            decoded before.
+            \param referencedElement Curve referred to by a polygon.
+            \param serial Serial number of referencedElement, as given in the reference.
+            \param decoded Buffer receiving the coordinates if they are not cached.
+            \return The coordinates of the curve.
+        */
+        const GeometryBuffer& extractPath( ISosiElement* referencedElement,
+                                           const std::string& serial,
+                                           GeometryBuffer& decoded );
 
     public:
 
@@ -111,11 +87,16 @@ namespace sosicon {
         virtual ~CoordinateCollection();
 
         //! Constructor
-        CoordinateCollection() :
-            mNumPartsGeom( 0 ),
-            mNumPartsHoles( 0 ),
-            mNumPointsGeom( 0 ),
-            mNumPointsHoles( 0 ),
+        /*!
+            \param header Header context of the SOSI file the coordinates are read from.
+            \param cache Decoded curves of the SOSI file, shared by all collections built
+                   from the file, or 0 if curves shall not be cached.
+        */
+        CoordinateCollection( const sosi::HeaderContext& header, GeometryCache* cache = 0 ) :
+            mGeomNormalized( false ),
+            mHolesNormalized( false ),
+            mHeader( &header ),
+            mCache( cache ),
             mXmin( +9999999999 ),
             mYmin( +9999999999 ),
             mXmax( -9999999999 ),
@@ -135,27 +116,30 @@ namespace sosicon {
         */
         void discoverCoords( ISosiElement* sosi );
 
-        //! Retrieve next coordinate in collection
+        //! Extracts the geometry of a feature as written by the converters
         /*!
-            Iterates through the coordinate list until it reaches the end,
-            passing a pointer to the next element to the coord reference. 
-            Tne value of coord must be zero on the first pass in order to
-            start the iteration on the first ISosiElement.
-            \return The function returns true if there are more coordinates in
-                    the collection, or false if the last coordinate is
-                    encoutered.
+            Applies the conventions shared by the output formats: Only the first coordinate
+            of a point is used. A curve must have at least two vertices. The outer parts of
+            a surface make up one ring (clockwise), which must have at least four vertices,
+            and holes (counter-clockwise) with fewer than four vertices are dropped.
+            The bounding box of the geometry is given by getXmin() etc. afterwards.
+            \param sosi Point, text, curve or surface element. The collection must be empty.
+            \param geom Receives the point, the curve, or the outer ring of the surface.
+            \param holes Receives the holes of the surface, one part per ring.
+            \return wkt_point, wkt_linestring or wkt_polygon, or wkt_unknown if the feature
+                    has no valid geometry.
         */
-        bool getNextInGeom( ICoordinate*& coord );
+        Wkt extractGeometry( ISosiElement* sosi, GeometryBuffer& geom, GeometryBuffer& holes );
 
-        std::vector<ICoordinate*>& getGeom();
-        std::vector<int>& getGeomSizes() { return mGeomSizes; };
-        int getNumPointsGeom() { return mNumPointsGeom; };
-        int getNumPartsGeom() { return mNumPartsGeom; };
+        //! Outer geometry, ordered clockwise
+        const GeometryBuffer& getGeom();
+        int getNumPointsGeom() { return static_cast<int>( mGeom.size() ); };
+        int getNumPartsGeom() { return static_cast<int>( mGeom.numParts() ); };
 
-        std::vector<ICoordinate*>& getHoles();
-        std::vector<int>& getHoleSizes() { return mHoleSizes; };
-        int getNumPointsHoles() { return mNumPointsHoles; };
-        int getNumPartsHoles() { return mNumPartsHoles; };
+        //! Polygon holes, each ring ordered counter-clockwise
+        const GeometryBuffer& getHoles();
+        int getNumPointsHoles() { return static_cast<int>( mHoles.size() ); };
+        int getNumPartsHoles() { return static_cast<int>( mHoles.numParts() ); };
 
         double getXmin() { return mXmin == +9999999999 ? 0 : mXmin; };
 
@@ -31,6 +31,22 @@ get( sosicon::IConverter* &converter, sosicon::CommandLine* cmd ) {
         converter = new ConverterSosi2tsv();
         converter->init( cmd );
     }
+    else if( cmd->mCommand == "-2geojson" ) {
+        converter = new ConverterSosi2geojson();
+        converter->init( cmd );
+    }
+    else if( cmd->mCommand == "-2fgb" ) {
+        converter = new ConverterSosi2fgb();
+        converter->init( cmd );
+    }
+    else if( cmd->mCommand == "-2gpkg" ) {
+        converter = new ConverterSosi2gpkg();
+        converter->init( cmd );
+    }
+    else if( cmd->mCommand == "-2parquet" || cmd->mCommand == "-2arrow" ) {
+        converter = new ConverterSosi2parquet();
+        converter->init( cmd );
+    }
     else if( cmd->mCommand == "-2psql" ) {
         converter = new ConverterSosi2psql();
         converter->init( cmd );
@@ -22,6 +22,10 @@
 #include "converter_sosi2shp.h"
 #include "converter_sosi2xml.h"
 #include "converter_sosi2tsv.h"
+#include "converter_sosi2geojson.h"
+#include "converter_sosi2fgb.h"
+#include "converter_sosi2gpkg.h"
+#include "converter_sosi2parquet.h"
 #include "converter_sosi2psql.h"
 #include "converter_sosi2mysql.h"
 #include "converter_sosi_stat.h"
@@ -0,0 +1,58 @@
+/*
+ *  This file is part of the command-line tool sosicon.
+ *  Copyright (C) 2014  Espen Andersen, Norwegian Broadcast Corporation (NRK)
+ *
+ *  This is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __FEATURE_EVENT_H__
+#define __FEATURE_EVENT_H__
+
+#include <algorithm>
+#include "event_dispatcher.h"
+#include "interface/i_sosi_element.h"
+
+namespace sosicon {
+
+    //! Feature event
+    /*!
+        \author Espen Andersen
+        \copyright GNU General Public License
+
+        Dispatched by the parser in streaming mode each time a top-level SOSI element (feature)
+        has been completely parsed. The feature subtree is only valid for the duration of the
+        event, since the parser frees it afterwards unless it is needed later for resolving
+        REF elements.
+
+        A feature retained for resolving REF elements is announced once more, with mReleased
+        set, when the last feature referring to it has been dispatched and it is about to be
+        freed. Listeners caching data derived from REF targets may then drop it.
+    */
+    class FeatureEvent {
+
+    public:
+        FeatureEvent( ISosiElement* feature, bool released = false )
+            : mFeature( feature ), mReleased( released ) { }
+
+        ISosiElement* mFeature;
+
+        //! True if the feature has been dispatched before, and is about to be freed
+        bool mReleased;
+
+    }; // class FeatureEvent
+
+    class FeatureEventDispatcher : public EventDispatcher<FeatureEvent> { };
+
+} // namespace sosicon
+
+#endif
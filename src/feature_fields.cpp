@@ -0,0 +1,53 @@
+/*
+ *  This file is part of the command-line tool sosicon.
+ *  Copyright (C) 2014  Espen Andersen, Norwegian Broadcast Corporation (NRK)
+ *
+ *  This is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "feature_fields.h"
+
+void sosicon::featureFields::
+extract( ISosiElement* parent, std::map<std::string,std::string>& fields ) {
+
+    sosi::SosiElementSearch srcData;
+    while( parent->getChild( srcData ) ) {
+
+        ISosiElement* dataElement = srcData.element();
+        switch( dataElement->getType() ) {
+            case sosi::sosi_element_ne:
+            case sosi::sosi_element_neh:
+            case sosi::sosi_element_ref:
+                // Part of the geometry
+                continue;
+            default:
+                break;
+        }
+
+        extract( dataElement, fields );
+
+        std::string data = dataElement->getData();
+        if( data.empty() ) {
+            continue;
+        }
+
+        std::string fieldName = utils::toFieldname( dataElement->getName() );
+        std::map<std::string,std::string>::iterator i = fields.find( fieldName );
+        if( i == fields.end() ) {
+            fields[ fieldName ] = data;
+        }
+        else {
+            i->second.append( "|" + data );
+        }
+    }
+}
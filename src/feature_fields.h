@@ -0,0 +1,52 @@
+/*
+ *  This file is part of the command-line tool sosicon.
+ *  Copyright (C) 2014  Espen Andersen, Norwegian Broadcast Corporation (NRK)
+ *
+ *  This is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __FEATURE_FIELDS_H__
+#define __FEATURE_FIELDS_H__
+
+#include <map>
+#include <string>
+#include "interface/i_sosi_element.h"
+#include "sosi/sosi_types.h"
+#include "sosi/sosi_element_search.h"
+#include "utils.h"
+
+namespace sosicon {
+
+    //! Feature attribute extraction
+    /*!
+        Collects the data fields of a SOSI feature for the streaming converters, walking the
+        child elements the same way as ConverterSosi2psql::extractData(): nested elements are
+        flattened, field names are made by utils::toFieldname(), and repeated fields are
+        joined by '|'. The coordinate and reference elements are left out, since the
+        converters write them as the geometry.
+     */
+    namespace featureFields {
+
+        //! Fetch element data fields recursively
+        /*!
+            The values are given as in the source file, in its character set.
+            \param parent The SOSI (sub)tree to be traversed.
+            \param fields Receives the field values by field name.
+        */
+        void extract( ISosiElement* parent, std::map<std::string,std::string>& fields );
+
+    }; // namespace featureFields
+
+}; // namespace sosicon
+
+#endif
@@ -0,0 +1,125 @@
+/*
+ *  This file is part of the command-line tool sosicon.
+ *  Copyright (C) 2014  Espen Andersen, Norwegian Broadcast Corporation (NRK)
+ *
+ *  This is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "flat_buffer_writer.h"
+
+void sosicon::fgb::FlatBufferWriter::
+clear() {
+    mBuffer.assign( 4, '\0' );
+    for( int i = 0; i < MAX_FIELDS; i++ ) {
+        mFieldSize[ i ] = 0;
+    }
+    mFieldCount = 0;
+}
+
+void sosicon::fgb::FlatBufferWriter::
+pad( size_t alignment, size_t offset ) {
+    size_t rest = ( mBuffer.size() + offset ) % alignment;
+    if( rest > 0 ) {
+        mBuffer.append( alignment - rest, '\0' );
+    }
+}
+
+void sosicon::fgb::FlatBufferWriter::
+addField( int id, size_t size ) {
+    mFieldSize[ id ] = size;
+    mFieldCount = std::max( mFieldCount, id + 1 );
+}
+
+sosicon::fgb::FlatBufferWriter::Table sosicon::fgb::FlatBufferWriter::
+writeTable() {
+
+    // Largest fields first, so that each field is aligned to its size once the
+    // table start is aligned
+    Table t;
+    uint16_t tableSize = 4;
+    bool wide = false;
+    for( size_t size = 8; size > 0; size /= 2 ) {
+        for( int id = 0; id < mFieldCount; id++ ) {
+            if( mFieldSize[ id ] == size ) {
+                t.mOffset[ id ] = tableSize;
+                tableSize = static_cast<uint16_t>( tableSize + size );
+                wide = wide || size == 8;
+            }
+        }
+    }
+
+    pad( 2 );
+    size_t vtable = mBuffer.size();
+    append( static_cast<uint16_t>( 4 + 2 * mFieldCount ) );
+    append( tableSize );
+    for( int id = 0; id < mFieldCount; id++ ) {
+        append( static_cast<uint16_t>( mFieldSize[ id ] > 0 ? t.mOffset[ id ] : 0 ) );
+    }
+
+    // The first field follows the 4 byte vtable offset
+    pad( wide ? 8 : 4, wide ? 4 : 0 );
+    t.mPos = mBuffer.size();
+    append( static_cast<int32_t>( t.mPos - vtable ) );
+    mBuffer.append( tableSize - 4, '\0' );
+
+    for( int id = 0; id < mFieldCount; id++ ) {
+        if( mFieldSize[ id ] == 0 ) {
+            t.mOffset[ id ] = 0;
+        }
+        mFieldSize[ id ] = 0;
+    }
+    mFieldCount = 0;
+    return t;
+}
+
+void sosicon::fgb::FlatBufferWriter::
+setOffsetAt( size_t pos, size_t target ) {
+    byteOrder::toLittleEndian( static_cast<uint32_t>( target - pos ), &mBuffer[ pos ] );
+}
+
+size_t sosicon::fgb::FlatBufferWriter::
+writeString( const std::string& str ) {
+    pad( 4 );
+    size_t pos = mBuffer.size();
+    append( static_cast<uint32_t>( str.size() ) );
+    mBuffer += str;
+    mBuffer += '\0';
+    return pos;
+}
+
+size_t sosicon::fgb::FlatBufferWriter::
+writeBytes( const std::string& bytes ) {
+    pad( 4 );
+    size_t pos = mBuffer.size();
+    append( static_cast<uint32_t>( bytes.size() ) );
+    mBuffer += bytes;
+    return pos;
+}
+
+size_t sosicon::fgb::FlatBufferWriter::
+writeStructs( const std::string& bytes, size_t count, size_t alignment ) {
+    pad( std::max( alignment, static_cast<size_t>( 4 ) ), 4 );
+    size_t pos = mBuffer.size();
+    append( static_cast<uint32_t>( count ) );
+    mBuffer += bytes;
+    return pos;
+}
+
+size_t sosicon::fgb::FlatBufferWriter::
+writeOffsetVector( size_t count ) {
+    pad( 4 );
+    size_t pos = mBuffer.size();
+    append( static_cast<uint32_t>( count ) );
+    mBuffer.append( 4 * count, '\0' );
+    return pos;
+}
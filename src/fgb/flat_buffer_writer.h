@@ -0,0 +1,174 @@
+/*
+ *  This file is part of the command-line tool sosicon.
+ *  Copyright (C) 2014  Espen Andersen, Norwegian Broadcast Corporation (NRK)
+ *
+ *  This is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __FLAT_BUFFER_WRITER_H__
+#define __FLAT_BUFFER_WRITER_H__
+
+#include <stdint.h>
+#include <algorithm>
+#include <string>
+#include "../byte_order.h"
+
+namespace sosicon {
+
+    namespace fgb {
+
+        //! FlatBuffers serializer
+        /*!
+            \author Espen Andersen
+            \copyright GNU General Public License
+
+            Minimal FlatBuffers builder for the small, fixed schemas of FlatGeobuf and of the
+            Arrow IPC metadata (see arrow::IpcWriter). Unlike the reference implementation,
+            the buffer is built front to back: the root offset is followed by the root table,
+            and each table is followed by the strings, vectors and tables it refers to. The
+            caller declares the fields present in a table with addField(), writes the table
+            with writeTable(), and fills in the scalars and the offsets of the referred
+            objects as they are written.
+         */
+        class FlatBufferWriter {
+
+        public:
+
+            //! Highest number of fields in a table
+            static const int MAX_FIELDS = 16;
+
+            //! Position and field layout of a table written by writeTable()
+            struct Table {
+                size_t mPos;                        //!< Position of the table in the buffer
+                uint16_t mOffset[ MAX_FIELDS ];     //!< Position of each field relative to the table, 0 if absent
+            };
+
+        private:
+
+            //! Serialized buffer
+            std::string mBuffer;
+
+            //! Size of each field declared for the next table, 0 if absent
+            size_t mFieldSize[ MAX_FIELDS ];
+
+            //! Highest field id declared for the next table, plus one
+            int mFieldCount;
+
+            //! Pad with zeros until ( buffer size + offset ) is a multiple of alignment
+            void pad( size_t alignment, size_t offset = 0 );
+
+            //! Append scalar in little endian byte order
+            template<typename T>
+            void append( T value ) {
+                char buf[ sizeof( T ) ];
+                byteOrder::toLittleEndian( value, buf );
+                mBuffer.append( buf, sizeof( T ) );
+            }
+
+        public:
+
+            //! Constructor
+            FlatBufferWriter() { clear(); }
+
+            //! Start new buffer
+            /*!
+                Discards the buffer content and reserves room for the root offset.
+             */
+            void clear();
+
+            //! Declare field of the next table
+            /*!
+                \param id Field id, as given by the order of the fields in the schema.
+                \param size Size of the field value: 1, 2, 4 or 8 for scalars, 4 for offsets.
+             */
+            void addField( int id, size_t size );
+
+            //! Write table with the declared fields
+            /*!
+                Writes the vtable and the table, with all declared fields set to zero, and
+                clears the declarations for the next table.
+                \return Layout of the table.
+             */
+            Table writeTable();
+
+            //! Set scalar field of 2, 4 or 8 bytes
+            template<typename T>
+            void setScalar( const Table& t, int id, T value ) {
+                byteOrder::toLittleEndian( value, &mBuffer[ t.mPos + t.mOffset[ id ] ] );
+            }
+
+            //! Set byte or bool field
+            void setByte( const Table& t, int id, uint8_t value ) { mBuffer[ t.mPos + t.mOffset[ id ] ] = static_cast<char>( value ); }
+
+            //! Point offset field of table to object written later
+            void setOffset( const Table& t, int id, size_t target ) { setOffsetAt( t.mPos + t.mOffset[ id ], target ); }
+
+            //! Point offset at given position to object written later
+            void setOffsetAt( size_t pos, size_t target );
+
+            //! Point root offset to table
+            void setRoot( const Table& t ) { setOffsetAt( 0, t.mPos ); }
+
+            //! Write string
+            /*!
+                \return Position of the string, to be passed to setOffset().
+             */
+            size_t writeString( const std::string& str );
+
+            //! Write vector of scalars
+            /*!
+                \return Position of the vector, to be passed to setOffset().
+             */
+            template<typename T>
+            size_t writeVector( const T* data, size_t count ) {
+                pad( sizeof( T ) > 4 ? sizeof( T ) : 4, 4 );
+                size_t pos = mBuffer.size();
+                append( static_cast<uint32_t>( count ) );
+                mBuffer.resize( pos + 4 + count * sizeof( T ) );
+                byteOrder::toLittleEndian( data, count, &mBuffer[ pos + 4 ] );
+                return pos;
+            }
+
+            //! Write vector of bytes
+            /*!
+                \return Position of the vector, to be passed to setOffset().
+             */
+            size_t writeBytes( const std::string& bytes );
+
+            //! Write vector of structs
+            /*!
+                \param bytes The structs, serialized little endian.
+                \param count Number of structs.
+                \param alignment Alignment of the struct, given by its largest member.
+                \return Position of the vector, to be passed to setOffset().
+             */
+            size_t writeStructs( const std::string& bytes, size_t count, size_t alignment );
+
+            //! Write vector of offsets, for a vector of tables
+            /*!
+                The offsets are set with setOffsetAt() as the tables are written. Offset i
+                is found at the returned position + 4 + 4 * i.
+                \return Position of the vector, to be passed to setOffset().
+             */
+            size_t writeOffsetVector( size_t count );
+
+            //! Serialized buffer
+            const std::string& data() const { return mBuffer; }
+
+        }; // class FlatBufferWriter
+
+    }; // namespace fgb
+
+}; // namespace sosicon
+
+#endif
@@ -0,0 +1,226 @@
+/*
+ *  This file is part of the command-line tool sosicon.
+ *  Copyright (C) 2014  Espen Andersen, Norwegian Broadcast Corporation (NRK)
+ *
+ *  This is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "flatgeobuf.h"
+
+sosicon::fgb::Flatgeobuf::
+Flatgeobuf( const std::string& fileName, const std::string& name, GeometryType geometryType, int srid ) :
+    mFileName( fileName ),
+    mSpoolName( fileName + ".spool" ),
+    mName( name ),
+    mGeometryType( geometryType ),
+    mSrid( srid ),
+    mSpoolSize( 0 ) {
+    mSpool.open( mSpoolName.c_str(), std::ios::out | std::ios::trunc | std::ios::binary );
+    mExtent.minX = mExtent.minY = +9999999999;
+    mExtent.maxX = mExtent.maxY = -9999999999;
+    mExtent.offset = 0;
+}
+
+sosicon::fgb::Flatgeobuf::
+~Flatgeobuf() {
+    if( mSpool.is_open() ) {
+        mSpool.close();
+    }
+    std::remove( mSpoolName.c_str() );
+}
+
+uint16_t sosicon::fgb::Flatgeobuf::
+columnIndex( const std::string& name ) {
+    std::map<std::string, uint16_t>::iterator i = mColumnIndex.find( name );
+    if( i != mColumnIndex.end() ) {
+        return i->second;
+    }
+    uint16_t index = static_cast<uint16_t>( mColumns.size() );
+    mColumns.push_back( name );
+    mColumnIndex[ name ] = index;
+    return index;
+}
+
+void sosicon::fgb::Flatgeobuf::
+encodeFeature( FlatBufferWriter& fb, GeometryType geometryType,
+               const GeometryBuffer& geom, const GeometryBuffer& holes,
+               const Properties& properties, std::string& out ) {
+
+    // Column index, value length and UTF-8 value of each attribute
+    std::string props;
+    char buf[ 6 ];
+    for( Properties::const_iterator i = properties.begin(); i != properties.end(); i++ ) {
+        byteOrder::toLittleEndian( i->first, buf );
+        byteOrder::toLittleEndian( static_cast<uint32_t>( i->second.size() ), buf + 2 );
+        props.append( buf, 6 );
+        props += i->second;
+    }
+
+    fb.clear();
+    fb.addField( feature_geometry, 4 );
+    if( !props.empty() ) {
+        fb.addField( feature_properties, 4 );
+    }
+    FlatBufferWriter::Table feature = fb.writeTable();
+    fb.setRoot( feature );
+
+    bool polygon = geometryType == geometry_type_polygon;
+    fb.addField( geometry_xy, 4 );
+    fb.addField( geometry_type, 1 );
+    if( polygon ) {
+        fb.addField( geometry_ends, 4 );
+    }
+    FlatBufferWriter::Table geometry = fb.writeTable();
+    fb.setOffset( feature, feature_geometry, geometry.mPos );
+    fb.setByte( geometry, geometry_type, static_cast<uint8_t>( geometryType ) );
+
+    // Interleaved coordinates, holes after the outer ring
+    size_t count = geometryType == geometry_type_point ? 1 : geom.size();
+    std::vector<double> xy;
+    xy.reserve( 2 * ( count + holes.size() ) );
+    for( size_t i = 0; i < count; i++ ) {
+        xy.push_back( geom.x( i ) );
+        xy.push_back( geom.y( i ) );
+    }
+    if( polygon ) {
+        std::vector<uint32_t> ends;
+        ends.push_back( static_cast<uint32_t>( count ) );
+        for( size_t k = 0; k < holes.numParts(); k++ ) {
+            for( size_t i = holes.partBegin( k ); i < holes.partEnd( k ); i++ ) {
+                xy.push_back( holes.x( i ) );
+                xy.push_back( holes.y( i ) );
+            }
+            ends.push_back( static_cast<uint32_t>( xy.size() / 2 ) );
+        }
+        fb.setOffset( geometry, geometry_ends, fb.writeVector( &ends[ 0 ], ends.size() ) );
+    }
+    fb.setOffset( geometry, geometry_xy, fb.writeVector( &xy[ 0 ], xy.size() ) );
+
+    if( !props.empty() ) {
+        fb.setOffset( feature, feature_properties, fb.writeBytes( props ) );
+    }
+
+    const std::string& data = fb.data();
+    byteOrder::toLittleEndian( static_cast<uint32_t>( data.size() ), buf );
+    out.append( buf, 4 );
+    out += data;
+}
+
+void sosicon::fgb::Flatgeobuf::
+append( const char* data, size_t size, const NodeItem& box ) {
+    mSpool.write( data, size );
+    NodeItem item = box;
+    item.offset = mSpoolSize;
+    mItems.push_back( item );
+    mExtent.expand( box );
+    mSpoolSize += size;
+}
+
+void sosicon::fgb::Flatgeobuf::
+buildHeader( std::string& header, uint16_t nodeSize ) {
+
+    FlatBufferWriter fb;
+    fb.addField( header_name, 4 );
+    fb.addField( header_envelope, 4 );
+    fb.addField( header_geometry_type, 1 );
+    if( !mColumns.empty() ) {
+        fb.addField( header_columns, 4 );
+    }
+    fb.addField( header_features_count, 8 );
+    fb.addField( header_index_node_size, 2 );
+    if( mSrid > 0 ) {
+        fb.addField( header_crs, 4 );
+    }
+    FlatBufferWriter::Table t = fb.writeTable();
+    fb.setRoot( t );
+    fb.setByte( t, header_geometry_type, static_cast<uint8_t>( mGeometryType ) );
+    fb.setScalar( t, header_features_count, static_cast<uint64_t>( mItems.size() ) );
+    fb.setScalar( t, header_index_node_size, nodeSize );
+
+    fb.setOffset( t, header_name, fb.writeString( mName ) );
+    const double envelope[ 4 ] = { mExtent.minX, mExtent.minY, mExtent.maxX, mExtent.maxY };
+    fb.setOffset( t, header_envelope, fb.writeVector( envelope, 4 ) );
+
+    if( !mColumns.empty() ) {
+        size_t vec = fb.writeOffsetVector( mColumns.size() );
+        fb.setOffset( t, header_columns, vec );
+        for( size_t i = 0; i < mColumns.size(); i++ ) {
+            fb.addField( column_name, 4 );
+            fb.addField( column_type, 1 );
+            FlatBufferWriter::Table col = fb.writeTable();
+            fb.setOffsetAt( vec + 4 + 4 * i, col.mPos );
+            fb.setByte( col, column_type, column_type_string );
+            fb.setOffset( col, column_name, fb.writeString( mColumns[ i ] ) );
+        }
+    }
+
+    if( mSrid > 0 ) {
+        fb.addField( crs_org, 4 );
+        fb.addField( crs_code, 4 );
+        FlatBufferWriter::Table crs = fb.writeTable();
+        fb.setOffset( t, header_crs, crs.mPos );
+        fb.setScalar( crs, crs_code, static_cast<int32_t>( mSrid ) );
+        fb.setOffset( crs, crs_org, fb.writeString( "EPSG" ) );
+    }
+
+    const std::string& data = fb.data();
+    char buf[ 4 ];
+    byteOrder::toLittleEndian( static_cast<uint32_t>( data.size() ), buf );
+    header.assign( buf, 4 );
+    header += data;
+}
+
+bool sosicon::fgb::Flatgeobuf::
+complete( uint16_t nodeSize ) {
+
+    mSpool.close();
+    if( mItems.empty() ) {
+        return true;
+    }
+
+    // Index order; the leaf offsets are turned from spool positions into
+    // positions within the feature section of the output file
+    PackedRTree::hilbertSort( mItems, mExtent );
+    MappedFile spool;
+    spool.open( mSpoolName );
+    const unsigned char* base = reinterpret_cast<const unsigned char*>( spool.begin() );
+    std::vector<uint64_t> spoolOffsets( mItems.size() );
+    uint64_t offset = 0;
+    for( size_t i = 0; i < mItems.size(); i++ ) {
+        const unsigned char* p = base + mItems[ i ].offset;
+        uint32_t size = p[ 0 ] | ( p[ 1 ] << 8 ) | ( p[ 2 ] << 16 ) | ( static_cast<uint32_t>( p[ 3 ] ) << 24 );
+        spoolOffsets[ i ] = mItems[ i ].offset;
+        mItems[ i ].offset = offset;
+        offset += 4 + size;
+    }
+    PackedRTree tree( mItems, nodeSize );
+
+    std::ofstream fs( mFileName.c_str(), std::ios::out | std::ios::trunc | std::ios::binary );
+    if( !fs ) {
+        sosicon::logstream << "Could not write " << mFileName << "\n";
+        return false;
+    }
+    static const char magic[ 8 ] = { 0x66, 0x67, 0x62, 0x03, 0x66, 0x67, 0x62, 0x00 };
+    fs.write( magic, sizeof( magic ) );
+    std::string header;
+    buildHeader( header, nodeSize );
+    fs.write( header.data(), header.size() );
+    tree.write( fs );
+    for( size_t i = 0; i < mItems.size(); i++ ) {
+        uint64_t end = i + 1 < mItems.size() ? mItems[ i + 1 ].offset : offset;
+        fs.write( spool.begin() + spoolOffsets[ i ], end - mItems[ i ].offset );
+    }
+    fs.close();
+    spool.close();
+    return true;
+}
@@ -0,0 +1,136 @@
+/*
+ *  This file is part of the command-line tool sosicon.
+ *  Copyright (C) 2014  Espen Andersen, Norwegian Broadcast Corporation (NRK)
+ *
+ *  This is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __FLATGEOBUF_H__
+#define __FLATGEOBUF_H__
+
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+#include "flatgeobuf_types.h"
+#include "flat_buffer_writer.h"
+#include "packed_rtree.h"
+#include "../logger.h"
+#include "../byte_order.h"
+#include "../geometry_buffer.h"
+#include "../mapped_file.h"
+
+namespace sosicon {
+
+    //! FlatGeobuf
+    namespace fgb {
+
+        //! Attribute values of a feature, by column index
+        typedef std::vector< std::pair<uint16_t, std::string> > Properties;
+
+        //! FlatGeobuf file
+        /*!
+            \author Espen Andersen
+            \copyright GNU General Public License
+
+            One FlatGeobuf layer, holding features of one geometry type. The file header
+            comes first in a FlatGeobuf file, followed by the spatial index and then the
+            features in index order. Neither is known until all features have been seen,
+            so the encoded features are appended to a spool file next to the output file,
+            while only the bounding box and spool position of each feature are kept in
+            memory. complete() sorts the boxes along a Hilbert curve, writes the header and
+            the packed R-tree, and copies the features from the spool in the same order.
+        */
+        class Flatgeobuf {
+
+            std::string mFileName;          //!< Output file path
+            std::string mSpoolName;         //!< Spool file path
+            std::string mName;              //!< Layer name
+            GeometryType mGeometryType;     //!< Geometry type of all features
+            int mSrid;                      //!< EPSG code of the coordinates, or 0 if unknown
+            std::ofstream mSpool;           //!< Encoded features, in the order appended
+            uint64_t mSpoolSize;            //!< Number of bytes written to mSpool
+            std::vector<NodeItem> mItems;   //!< Bounding box and spool position of each feature
+            NodeItem mExtent;               //!< Bounding box of all features
+
+            std::vector<std::string> mColumns;                  //!< Column names, by column index
+            std::map<std::string, uint16_t> mColumnIndex;       //!< Column index by name
+
+            //! Encode file header
+            void buildHeader( std::string& header, uint16_t nodeSize );
+
+        public:
+
+            //! Constructor
+            /*!
+                \param fileName Output file path. The spool file gets the extension .spool added.
+                \param name Layer name, stored in the header.
+                \param geometryType Geometry type of all features.
+                \param srid EPSG code of the coordinates, or 0 if unknown.
+             */
+            Flatgeobuf( const std::string& fileName, const std::string& name, GeometryType geometryType, int srid );
+
+            //! Destructor
+            /*!
+                Removes the spool file.
+             */
+            ~Flatgeobuf();
+
+            //! Encode feature
+            /*!
+                Appends the feature as a size-prefixed Feature buffer. Safe to call from
+                several threads, each with its own FlatBufferWriter.
+                \param fb Work buffer.
+                \param geometryType Geometry type of the feature.
+                \param geom Point, linestring or outer ring of polygon.
+                \param holes Holes of polygon, one part per ring.
+                \param properties Attribute values, by column index.
+                \param out The encoded feature is appended to this string.
+             */
+            static void encodeFeature( FlatBufferWriter& fb, GeometryType geometryType,
+                                       const GeometryBuffer& geom, const GeometryBuffer& holes,
+                                       const Properties& properties, std::string& out );
+
+            //! Get column index of attribute, adding the column if it is new
+            uint16_t columnIndex( const std::string& name );
+
+            //! Append encoded feature
+            /*!
+                \param data Size-prefixed Feature buffer, as built by encodeFeature().
+                \param size Number of bytes, including the size prefix.
+                \param box Bounding box of the feature geometry.
+             */
+            void append( const char* data, size_t size, const NodeItem& box );
+
+            //! Number of features appended
+            size_t size() const { return mItems.size(); }
+
+            //! Output file path
+            const std::string& fileName() const { return mFileName; }
+
+            //! Write the FlatGeobuf file
+            /*!
+                \param nodeSize Maximum number of children of each R-tree node.
+                \return False if the output file could not be written.
+             */
+            bool complete( uint16_t nodeSize );
+
+        }; // class Flatgeobuf
+
+    }; // namespace fgb
+
+}; // namespace sosicon
+
+#endif
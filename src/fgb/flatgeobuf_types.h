@@ -0,0 +1,130 @@
+/*
+ *  This file is part of the command-line tool sosicon.
+ *  Copyright (C) 2014  Espen Andersen, Norwegian Broadcast Corporation (NRK)
+ *
+ *  This is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __FLATGEOBUF_TYPES_H__
+#define __FLATGEOBUF_TYPES_H__
+
+#include <stdint.h>
+#include <algorithm>
+
+namespace sosicon {
+
+    namespace fgb {
+
+        //! Geometry types
+        /*!
+            The numeric values are in accordance with the FlatGeobuf schema (header.fbs).
+         */
+        enum GeometryType {
+            geometry_type_unknown         = 0,
+            geometry_type_point           = 1,
+            geometry_type_lineString      = 2,
+            geometry_type_polygon         = 3,
+            geometry_type_multiPoint      = 4,
+            geometry_type_multiLineString = 5,
+            geometry_type_multiPolygon    = 6
+        };
+
+        //! Attribute column types
+        /*!
+            The numeric values are in accordance with the FlatGeobuf schema (header.fbs).
+            SOSI fields are exported as strings.
+         */
+        enum ColumnType {
+            column_type_byte     =  0,
+            column_type_int      =  5,
+            column_type_long     =  7,
+            column_type_double   = 10,
+            column_type_string   = 11,
+            column_type_json     = 12,
+            column_type_dateTime = 13,
+            column_type_binary   = 14
+        };
+
+        //! Field ids of table Header
+        enum HeaderField {
+            header_name            =  0,
+            header_envelope        =  1,
+            header_geometry_type   =  2,
+            header_has_z           =  3,
+            header_has_m           =  4,
+            header_has_t           =  5,
+            header_has_tm          =  6,
+            header_columns         =  7,
+            header_features_count  =  8,
+            header_index_node_size =  9,
+            header_crs             = 10,
+            header_title           = 11,
+            header_description     = 12,
+            header_metadata        = 13
+        };
+
+        //! Field ids of table Column
+        enum ColumnField {
+            column_name = 0,
+            column_type = 1
+        };
+
+        //! Field ids of table Crs
+        enum CrsField {
+            crs_org  = 0,
+            crs_code = 1
+        };
+
+        //! Field ids of table Feature
+        enum FeatureField {
+            feature_geometry   = 0,
+            feature_properties = 1
+        };
+
+        //! Field ids of table Geometry
+        enum GeometryField {
+            geometry_ends = 0,
+            geometry_xy   = 1,
+            geometry_type = 6
+        };
+
+        //! Node of the packed R-tree
+        /*!
+            Bounding box of a feature (leaf node) or of a group of nodes. The offset of a leaf
+            node is the byte offset of the feature within the feature section; for other
+            nodes it is the index of the first child node.
+         */
+        struct NodeItem {
+            double minX;
+            double minY;
+            double maxX;
+            double maxY;
+            uint64_t offset;
+
+            //! Expand box to contain other box
+            void expand( const NodeItem& other ) {
+                minX = std::min( minX, other.minX );
+                minY = std::min( minY, other.minY );
+                maxX = std::max( maxX, other.maxX );
+                maxY = std::max( maxY, other.maxY );
+            }
+        };
+
+        //! Size of a serialized NodeItem
+        const size_t NODE_ITEM_SIZE = 40;
+
+    }; // namespace fgb
+
+}; // namespace sosicon
+
+#endif
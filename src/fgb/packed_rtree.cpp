@@ -0,0 +1,163 @@
+/*
+ *  This file is part of the command-line tool sosicon.
+ *  Copyright (C) 2014  Espen Andersen, Norwegian Broadcast Corporation (NRK)
+ *
+ *  This is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "packed_rtree.h"
+
+uint32_t sosicon::fgb::PackedRTree::
+hilbert( uint32_t x, uint32_t y ) {
+
+    // Branch-free computation of the Hilbert index of a 16 bit grid, processing the
+    // bits of both coordinates in parallel
+    uint32_t a = x ^ y;
+    uint32_t b = 0xFFFF ^ a;
+    uint32_t c = 0xFFFF ^ ( x | y );
+    uint32_t d = x & ( y ^ 0xFFFF );
+
+    uint32_t A = a | ( b >> 1 );
+    uint32_t B = ( a >> 1 ) ^ a;
+    uint32_t C = ( ( c >> 1 ) ^ ( b & ( d >> 1 ) ) ) ^ c;
+    uint32_t D = ( ( a & ( c >> 1 ) ) ^ ( d >> 1 ) ) ^ d;
+
+    a = A; b = B; c = C; d = D;
+    A = ( ( a & ( a >> 2 ) ) ^ ( b & ( b >> 2 ) ) );
+    B = ( ( a & ( b >> 2 ) ) ^ ( b & ( ( a ^ b ) >> 2 ) ) );
+    C ^= ( ( a & ( c >> 2 ) ) ^ ( b & ( d >> 2 ) ) );
+    D ^= ( ( b & ( c >> 2 ) ) ^ ( ( a ^ b ) & ( d >> 2 ) ) );
+
+    a = A; b = B; c = C; d = D;
+    A = ( ( a & ( a >> 4 ) ) ^ ( b & ( b >> 4 ) ) );
+    B = ( ( a & ( b >> 4 ) ) ^ ( b & ( ( a ^ b ) >> 4 ) ) );
+    C ^= ( ( a & ( c >> 4 ) ) ^ ( b & ( d >> 4 ) ) );
+    D ^= ( ( b & ( c >> 4 ) ) ^ ( ( a ^ b ) & ( d >> 4 ) ) );
+
+    a = A; b = B; c = C; d = D;
+    C ^= ( ( a & ( c >> 8 ) ) ^ ( b & ( d >> 8 ) ) );
+    D ^= ( ( b & ( c >> 8 ) ) ^ ( ( a ^ b ) & ( d >> 8 ) ) );
+
+    a = C ^ ( C >> 1 );
+    b = D ^ ( D >> 1 );
+
+    uint32_t i0 = x ^ y;
+    uint32_t i1 = b | ( 0xFFFF ^ ( i0 | a ) );
+
+    i0 = ( i0 | ( i0 << 8 ) ) & 0x00FF00FF;
+    i0 = ( i0 | ( i0 << 4 ) ) & 0x0F0F0F0F;
+    i0 = ( i0 | ( i0 << 2 ) ) & 0x33333333;
+    i0 = ( i0 | ( i0 << 1 ) ) & 0x55555555;
+
+    i1 = ( i1 | ( i1 << 8 ) ) & 0x00FF00FF;
+    i1 = ( i1 | ( i1 << 4 ) ) & 0x0F0F0F0F;
+    i1 = ( i1 | ( i1 << 2 ) ) & 0x33333333;
+    i1 = ( i1 | ( i1 << 1 ) ) & 0x55555555;
+
+    return ( i1 << 1 ) | i0;
+}
+
+void sosicon::fgb::PackedRTree::
+hilbertSort( std::vector<NodeItem>& items, const NodeItem& extent ) {
+    const double hilbertMax = 0xFFFF;
+    const double width = extent.maxX - extent.minX;
+    const double height = extent.maxY - extent.minY;
+
+    // The index of each item is computed once, rather than in each comparison
+    std::vector< std::pair<uint32_t, size_t> > keys( items.size() );
+    for( size_t i = 0; i < items.size(); i++ ) {
+        const NodeItem& r = items[ i ];
+        uint32_t x = 0;
+        uint32_t y = 0;
+        if( width > 0.0 ) {
+            x = static_cast<uint32_t>( std::floor( hilbertMax * ( ( r.minX + r.maxX ) / 2 - extent.minX ) / width ) );
+        }
+        if( height > 0.0 ) {
+            y = static_cast<uint32_t>( std::floor( hilbertMax * ( ( r.minY + r.maxY ) / 2 - extent.minY ) / height ) );
+        }
+        keys[ i ] = std::make_pair( hilbert( x, y ), i );
+    }
+    std::sort( keys.begin(), keys.end() );
+
+    std::vector<NodeItem> sorted( items.size() );
+    for( size_t i = 0; i < keys.size(); i++ ) {
+        sorted[ i ] = items[ keys[ i ].second ];
+    }
+    items.swap( sorted );
+}
+
+uint64_t sosicon::fgb::PackedRTree::
+numNodes( uint64_t numItems, uint16_t nodeSize ) {
+    uint64_t n = numItems;
+    uint64_t count = n;
+    do {
+        n = ( n + nodeSize - 1 ) / nodeSize;
+        count += n;
+    } while( n != 1 );
+    return count;
+}
+
+sosicon::fgb::PackedRTree::
+PackedRTree( const std::vector<NodeItem>& items, uint16_t nodeSize ) {
+
+    // Number of nodes of each level, leaves first
+    std::vector<uint64_t> levelNumNodes;
+    uint64_t n = items.size();
+    levelNumNodes.push_back( n );
+    do {
+        n = ( n + nodeSize - 1 ) / nodeSize;
+        levelNumNodes.push_back( n );
+    } while( n != 1 );
+
+    // Start of each level in the node array, which has the root first
+    std::vector<uint64_t> levelBegin( levelNumNodes.size() );
+    uint64_t end = numNodes( items.size(), nodeSize );
+    for( size_t level = 0; level < levelNumNodes.size(); level++ ) {
+        end -= levelNumNodes[ level ];
+        levelBegin[ level ] = end;
+    }
+
+    mNodes.resize( static_cast<size_t>( numNodes( items.size(), nodeSize ) ) );
+    std::copy( items.begin(), items.end(), mNodes.begin() + static_cast<size_t>( levelBegin[ 0 ] ) );
+
+    // Each parent node refers to its first child by node index
+    for( size_t level = 0; level + 1 < levelNumNodes.size(); level++ ) {
+        uint64_t pos = levelBegin[ level ];
+        uint64_t levelEnd = pos + levelNumNodes[ level ];
+        uint64_t parent = levelBegin[ level + 1 ];
+        while( pos < levelEnd ) {
+            NodeItem node = mNodes[ static_cast<size_t>( pos ) ];
+            node.offset = pos;
+            for( uint64_t j = 1; j < nodeSize && pos + j < levelEnd; j++ ) {
+                node.expand( mNodes[ static_cast<size_t>( pos + j ) ] );
+            }
+            pos = std::min( pos + nodeSize, levelEnd );
+            mNodes[ static_cast<size_t>( parent++ ) ] = node;
+        }
+    }
+}
+
+void sosicon::fgb::PackedRTree::
+write( std::ostream& os ) const {
+    std::vector<char> buf( mNodes.size() * NODE_ITEM_SIZE );
+    char* p = buf.empty() ? 0 : &buf[ 0 ];
+    for( std::vector<NodeItem>::const_iterator i = mNodes.begin(); i != mNodes.end(); i++ ) {
+        byteOrder::toLittleEndian( i->minX, p );
+        byteOrder::toLittleEndian( i->minY, p + 8 );
+        byteOrder::toLittleEndian( i->maxX, p + 16 );
+        byteOrder::toLittleEndian( i->maxY, p + 24 );
+        byteOrder::toLittleEndian( i->offset, p + 32 );
+        p += NODE_ITEM_SIZE;
+    }
+    os.write( buf.empty() ? 0 : &buf[ 0 ], buf.size() );
+}
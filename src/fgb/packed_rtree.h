@@ -0,0 +1,92 @@
+/*
+ *  This file is part of the command-line tool sosicon.
+ *  Copyright (C) 2014  Espen Andersen, Norwegian Broadcast Corporation (NRK)
+ *
+ *  This is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __PACKED_RTREE_H__
+#define __PACKED_RTREE_H__
+
+#include <stdint.h>
+#include <algorithm>
+#include <cmath>
+#include <ostream>
+#include <utility>
+#include <vector>
+#include "flatgeobuf_types.h"
+#include "../byte_order.h"
+
+namespace sosicon {
+
+    namespace fgb {
+
+        //! Packed Hilbert R-tree
+        /*!
+            \author Espen Andersen
+            \copyright GNU General Public License
+
+            Static spatial index of FlatGeobuf files. The features are sorted along a Hilbert
+            curve by the centre of their bounding boxes, and the sorted boxes make up the
+            leaf level of the tree. Each level above is built by grouping nodeSize
+            consecutive nodes of the level below, until one root node remains. The nodes
+            are stored root first, with the leaf level last, in the layout expected by
+            FlatGeobuf readers.
+         */
+        class PackedRTree {
+
+            //! Nodes of all levels, root first
+            std::vector<NodeItem> mNodes;
+
+        public:
+
+            //! Hilbert curve index of grid cell
+            /*!
+                \param x Cell column, 0 to 65535.
+                \param y Cell row, 0 to 65535.
+                \return Position of the cell along the curve.
+             */
+            static uint32_t hilbert( uint32_t x, uint32_t y );
+
+            //! Sort boxes by the Hilbert index of their centres
+            /*!
+                \param items Boxes to sort.
+                \param extent Box containing all items, mapped to the 65536 x 65536 grid.
+             */
+            static void hilbertSort( std::vector<NodeItem>& items, const NodeItem& extent );
+
+            //! Number of nodes of the tree
+            /*!
+                \param numItems Number of leaf nodes.
+                \param nodeSize Maximum number of children of each node.
+             */
+            static uint64_t numNodes( uint64_t numItems, uint16_t nodeSize );
+
+            //! Constructor
+            /*!
+                Builds all levels of the tree in one pass.
+                \param items Leaf boxes in Hilbert order, with the byte offsets of the features.
+                \param nodeSize Maximum number of children of each node, at least 2.
+             */
+            PackedRTree( const std::vector<NodeItem>& items, uint16_t nodeSize );
+
+            //! Write all nodes, little endian
+            void write( std::ostream& os ) const;
+
+        }; // class PackedRTree
+
+    }; // namespace fgb
+
+}; // namespace sosicon
+
+#endif
@@ -0,0 +1,102 @@
+/*
+ *  This file is part of the command-line tool sosicon.
+ *  Copyright (C) 2014  Espen Andersen, Norwegian Broadcast Corporation (NRK)
+ *
+ *  This is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "file_batch.h"
+
+sosicon::FileBatch::
+FileBatch( const std::vector<std::string>& files, int threads ) : mFiles( files ) {
+    mThreads = std::max( 1, std::min( threads, static_cast<int>( mFiles.size() ) ) );
+}
+
+void sosicon::FileBatch::
+run( Job convert, Job commit, bool* cancel ) {
+
+    const size_t n = mFiles.size();
+
+    if( !concurrent() ) {
+        for( size_t i = 0; i < n && !( cancel && *cancel ); i++ ) {
+            convert( i );
+            commit( i );
+        }
+        return;
+    }
+
+    // Largest files first. Missing files sort last, and are reported by the job.
+    std::vector< std::pair<long long, size_t> > order;
+    for( size_t i = 0; i < n; i++ ) {
+        long long size = -1, mtime = 0;
+        utils::fileStatus( mFiles[ i ], size, mtime );
+        order.push_back( std::make_pair( -size, i ) );
+    }
+    std::sort( order.begin(), order.end() );
+
+    std::atomic<size_t> next( 0 );
+    std::mutex commitMutex;
+    std::vector<bool> done( n, false );
+    std::vector<std::exception_ptr> errors( n );
+    size_t committed = 0;
+    size_t completed = 0;
+
+    // Batch position of the first file that failed. Like in a sequential run, the files
+    // after it are neither converted nor committed.
+    std::atomic<size_t> failed( n );
+
+    std::vector<std::thread> workers;
+    for( int t = 0; t < mThreads; t++ ) {
+        workers.push_back( std::thread( [ & ]() {
+            for( size_t k = next++; k < n; k = next++ ) {
+                size_t i = order[ k ].second;
+                if( !( cancel && *cancel ) && i < failed ) {
+                    try {
+                        convert( i );
+                    }
+                    catch( ... ) {
+                        errors[ i ] = std::current_exception();
+                    }
+                }
+                std::lock_guard<std::mutex> lock( commitMutex );
+                done[ i ] = true;
+                completed++;
+                if( errors[ i ] ) {
+                    failed = std::min( failed.load(), i );
+                }
+                else if( !( cancel && *cancel ) && i < failed ) {
+                    sosicon::logstream << "[" << static_cast<int>( completed ) << "/" << static_cast<int>( n ) << "] "
+                                       << mFiles[ i ] << " converted\n";
+                }
+                while( committed < failed && done[ committed ] ) {
+                    if( !( cancel && *cancel ) ) {
+                        try {
+                            commit( committed );
+                        }
+                        catch( ... ) {
+                            errors[ committed ] = std::current_exception();
+                            failed = committed;
+                        }
+                    }
+                    committed++;
+                }
+            }
+        } ) );
+    }
+    for( std::vector<std::thread>::iterator i = workers.begin(); i != workers.end(); i++ ) {
+        i->join();
+    }
+    if( failed < n ) {
+        std::rethrow_exception( errors[ failed ] );
+    }
+}
@@ -0,0 +1,107 @@
+/*
+ *  This file is part of the command-line tool sosicon.
+ *  Copyright (C) 2014  Espen Andersen, Norwegian Broadcast Corporation (NRK)
+ *
+ *  This is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __FILE_BATCH_H__
+#define __FILE_BATCH_H__
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "logger.h"
+#include "utils.h"
+
+namespace sosicon {
+
+    //! Batch of source files
+    /*!
+        \author Espen Andersen
+        \copyright GNU General Public License
+
+        Runs a conversion job for each source file of a batch, on a pool of worker threads
+        (command-line parameter -j). Each worker takes the largest file not yet started, so
+        that the big files are not left until the end, when they would keep a single worker
+        busy while the others are idle.
+
+        The results of the jobs are handed over to the converter in source file order,
+        whatever the order in which the jobs complete, so that the output is the same as
+        when the files are converted one by one. With one worker, or one file, the files
+        are simply converted in the given order, on the calling thread.
+     */
+    class FileBatch {
+
+        //! Source files, in the order given
+        std::vector<std::string> mFiles;
+
+        //! Number of worker threads
+        int mThreads;
+
+    public:
+
+        //! Job for one source file
+        /*!
+            \param index Position of the file in the batch, counting from 0.
+         */
+        typedef std::function<void( size_t index )> Job;
+
+        //! Constructor
+        /*!
+            \param files Source files.
+            \param threads Maximum number of worker threads.
+         */
+        FileBatch( const std::vector<std::string>& files, int threads );
+
+        //! True if files are converted by several threads at the same time
+        /*!
+            Converters should then parse each file on its worker thread only, and leave
+            out progress output that is updated in place.
+         */
+        bool concurrent() const { return mThreads > 1; }
+
+        //! Source file at position in batch
+        const std::string& at( size_t index ) const { return mFiles[ index ]; }
+
+        //! Number of files in batch
+        size_t size() const { return mFiles.size(); }
+
+        //! Convert all files
+        /*!
+            \param convert Conversion of one file, called on a worker thread. Jobs for
+                   different files may run at the same time, so the job must only modify
+                   state belonging to its own file.
+            \param commit Called once the file and all files before it in the batch are
+                   converted, one file at a time, in batch order. This is where the result
+                   of a job is merged into the shared output.
+            \param cancel Pointer to cancel flag. Files not yet started when the flag is set
+                   are skipped.
+
+            An exception thrown by a job is caught on its worker thread. The files after it
+            in the batch are then skipped, and once all workers have finished, the exception
+            of the first failed file is thrown again on the calling thread, as if the files
+            had been converted one by one.
+         */
+        void run( Job convert, Job commit, bool* cancel = 0 );
+
+    }; // class FileBatch
+
+}; // namespace sosicon
+
+#endif
@@ -0,0 +1,126 @@
+/*
+ *  This file is part of the command-line tool sosicon.
+ *  Copyright (C) 2014  Espen Andersen, Norwegian Broadcast Corporation (NRK)
+ *
+ *  This is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "geometry_buffer.h"
+
+void sosicon::GeometryBuffer::
+reserve( size_t count ) {
+    mX.reserve( count );
+    mY.reserve( count );
+    if( !mZ.empty() ) {
+        mZ.reserve( count );
+    }
+}
+
+void sosicon::GeometryBuffer::
+append( double n, double e, double h ) {
+    if( mZ.empty() && h != 0.0 ) {
+        mZ.reserve( mX.capacity() );
+        mZ.resize( mX.size(), 0.0 );
+    }
+    mX.push_back( e );
+    mY.push_back( n );
+    if( !mZ.empty() ) {
+        mZ.push_back( h );
+    }
+}
+
+void sosicon::GeometryBuffer::
+append( const GeometryBuffer& src, bool reverse ) {
+    size_t begin = mX.size();
+    if( src.hasZ() && mZ.empty() ) {
+        mZ.resize( begin, 0.0 );
+    }
+    mX.insert( mX.end(), src.mX.begin(), src.mX.end() );
+    mY.insert( mY.end(), src.mY.begin(), src.mY.end() );
+    if( src.hasZ() ) {
+        mZ.insert( mZ.end(), src.mZ.begin(), src.mZ.end() );
+    }
+    else if( !mZ.empty() ) {
+        mZ.resize( mX.size(), 0.0 );
+    }
+    if( reverse ) {
+        this->reverse( begin, mX.size() );
+    }
+}
+
+void sosicon::GeometryBuffer::
+reverse( size_t begin, size_t end ) {
+    std::reverse( mX.begin() + begin, mX.begin() + end );
+    std::reverse( mY.begin() + begin, mY.begin() + end );
+    if( !mZ.empty() ) {
+        std::reverse( mZ.begin() + begin, mZ.begin() + end );
+    }
+}
+
+void sosicon::GeometryBuffer::
+scale( int divisor, int offsetN, int offsetE ) {
+    const size_t count = mX.size();
+    const double d = divisor;
+    const double dn = offsetN;
+    const double de = offsetE;
+    double* x = mX.data();
+    double* y = mY.data();
+    for( size_t i = 0; i < count; i++ ) {
+        x[ i ] = x[ i ] / d + de;
+        y[ i ] = y[ i ] / d + dn;
+    }
+}
+
+void sosicon::GeometryBuffer::
+transform( const Transformation& transformation ) {
+    if( transformation.active() && !mX.empty() ) {
+        transformation.apply( mY.data(), mX.data(), mX.size() );
+    }
+}
+
+bool sosicon::GeometryBuffer::
+isClockwise( size_t begin, size_t end ) const {
+    double edgeSum = 0.0;
+    for( size_t i = begin; i < end; i++ ) {
+        size_t j = i + 1 != end ? i + 1 : begin;
+        edgeSum += ( mX[ j ] - mX[ i ] ) * ( mY[ j ] + mY[ i ] );
+    }
+    return edgeSum > 0;
+}
+
+void sosicon::GeometryBuffer::
+expandBoundingBox( double& minX, double& minY, double& maxX, double& maxY ) const {
+    const size_t count = mX.size();
+    for( size_t i = 0; i < count; i++ ) {
+        minX = std::min( minX, mX[ i ] );
+        minY = std::min( minY, mY[ i ] );
+        maxX = std::max( maxX, mX[ i ] );
+        maxY = std::max( maxY, mY[ i ] );
+    }
+}
+
+void sosicon::GeometryBuffer::
+clear() {
+    mX.clear();
+    mY.clear();
+    mZ.clear();
+    mParts.clear();
+}
+
+void sosicon::GeometryBuffer::
+swap( GeometryBuffer& other ) {
+    mX.swap( other.mX );
+    mY.swap( other.mY );
+    mZ.swap( other.mZ );
+    mParts.swap( other.mParts );
+}
@@ -0,0 +1,152 @@
+/*
+ *  This file is part of the command-line tool sosicon.
+ *  Copyright (C) 2014  Espen Andersen, Norwegian Broadcast Corporation (NRK)
+ *
+ *  This is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __GEOMETRY_BUFFER_H__
+#define __GEOMETRY_BUFFER_H__
+
+#include <algorithm>
+#include <vector>
+#include "projection.h"
+
+namespace sosicon {
+
+    //! Geometry vertex storage
+    /*!
+        \author Espen Andersen
+        \copyright GNU General Public License
+
+        Stores the vertices of a geometry in contiguous arrays, one for east (x), one for
+        north (y) and, only if heights are given, one for the height (z). Multipart
+        geometries keep the offset of the first vertex of each part, so that a polygon with
+        holes, or a multi-curve, is held in one buffer.
+     */
+    class GeometryBuffer {
+
+        //! East coordinates
+        std::vector<double> mX;
+
+        //! North coordinates
+        std::vector<double> mY;
+
+        //! Heights, empty if no vertex has a height
+        std::vector<double> mZ;
+
+        //! Offset of the first vertex of each part
+        std::vector<size_t> mParts;
+
+    public:
+
+        //! Number of vertices
+        size_t size() const { return mX.size(); }
+
+        //! True if there are no vertices
+        bool empty() const { return mX.empty(); }
+
+        //! True if heights are stored
+        bool hasZ() const { return !mZ.empty(); }
+
+        //! East coordinate of vertex i
+        double x( size_t i ) const { return mX[ i ]; }
+
+        //! North coordinate of vertex i
+        double y( size_t i ) const { return mY[ i ]; }
+
+        //! Height of vertex i, or 0 if no heights are stored
+        double z( size_t i ) const { return mZ.empty() ? 0.0 : mZ[ i ]; }
+
+        //! Check if two vertices have the same position
+        bool equals( size_t i, size_t j ) const { return mX[ i ] == mX[ j ] && mY[ i ] == mY[ j ]; }
+
+        //! Reserve space for count vertices
+        void reserve( size_t count );
+
+        //! Append vertex
+        void append( double n, double e ) {
+            mX.push_back( e );
+            mY.push_back( n );
+            if( !mZ.empty() ) {
+                mZ.push_back( 0.0 );
+            }
+        }
+
+        //! Append vertex with height
+        void append( double n, double e, double h );
+
+        //! Append all vertices of another buffer, optionally in reverse order
+        /*!
+            The parts of src are not copied.
+            \param src Source vertices.
+            \param reverse If true, the vertices are appended last to first.
+         */
+        void append( const GeometryBuffer& src, bool reverse = false );
+
+        //! Start new part at the current end of the buffer
+        void beginPart() { mParts.push_back( mX.size() ); }
+
+        //! Number of parts
+        size_t numParts() const { return mParts.size(); }
+
+        //! Offset of the first vertex of part k
+        size_t partBegin( size_t k ) const { return mParts[ k ]; }
+
+        //! Offset one past the last vertex of part k
+        size_t partEnd( size_t k ) const { return k + 1 < mParts.size() ? mParts[ k + 1 ] : mX.size(); }
+
+        //! Number of vertices in part k
+        size_t partSize( size_t k ) const { return partEnd( k ) - partBegin( k ); }
+
+        //! Reverse the order of vertices in [begin, end)
+        void reverse( size_t begin, size_t end );
+
+        //! Reverse the order of all vertices, leaving the part offsets as they are
+        void reverse() { reverse( 0, mX.size() ); }
+
+        //! Scale and shift coordinates
+        /*!
+            Applies the SOSI unit and origo in one pass over the coordinate arrays:
+            n = n / divisor + offsetN, e = e / divisor + offsetE.
+            \param divisor Unit divisor (1 / ENHET).
+            \param offsetN North origo.
+            \param offsetE East origo.
+         */
+        void scale( int divisor, int offsetN, int offsetE );
+
+        //! Transform coordinates to another grid
+        void transform( const Transformation& transformation );
+
+        //! Analyzes ring direction
+        /*!
+            Checks the vertices in [begin, end) to see if they are ordered in a clockwise
+            manner.
+            \return true if the vertices are ordered clockwise.
+         */
+        bool isClockwise( size_t begin, size_t end ) const;
+
+        //! Expand bounding box to include all vertices
+        void expandBoundingBox( double& minX, double& minY, double& maxX, double& maxY ) const;
+
+        //! Remove all vertices and parts
+        void clear();
+
+        //! Exchange content with another buffer
+        void swap( GeometryBuffer& other );
+
+    }; // class GeometryBuffer
+
+}; // namespace sosicon
+
+#endif
@@ -15,33 +15,17 @@
  *  You should have received a copy of the GNU General Public License
  *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
-#ifndef __I_SHAPEFILE_DBF_PART_H__
-#define __I_SHAPEFILE_DBF_PART_H__
-
-#include <iostream>
-#include "i_binary_streamable.h"
-
-namespace sosicon {
-
-    /*!
-        \addtogroup interfaces Interfaces
-        @{
-    */
-    //! Interface: ShapefileDbfPart
-    /*!
-        \author Espen Andersen
-        \copyright GNU General Public License
-    */
-    class IShapefileDbfPart : public IBinaryStreamable {
-
-    public:
-
-        virtual void writeBinary( std::ostream &os ) { writeDbf( os );  }
-
-        virtual void writeDbf( std::ostream &os ) = 0;
-
-    };
-   /*! @} end group interfaces */
-}; // namespace sosicon
-
-#endif
+#include "geometry_cache.h"
+
+const sosicon::GeometryBuffer* sosicon::GeometryCache::
+find( long long serial ) const {
+    std::unordered_map<long long, GeometryBuffer>::const_iterator i = mCurves.find( serial );
+    return i == mCurves.end() ? 0 : &i->second;
+}
+
+const sosicon::GeometryBuffer& sosicon::GeometryCache::
+insert( long long serial, GeometryBuffer& geometry ) {
+    GeometryBuffer& cached = mCurves[ serial ];
+    cached.swap( geometry );
+    return cached;
+}
@@ -0,0 +1,73 @@
+/*
+ *  This file is part of the command-line tool sosicon.
+ *  Copyright (C) 2014  Espen Andersen, Norwegian Broadcast Corporation (NRK)
+ *
+ *  This is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __GEOMETRY_CACHE_H__
+#define __GEOMETRY_CACHE_H__
+
+#include <unordered_map>
+#include "geometry_buffer.h"
+
+namespace sosicon {
+
+    //! Decoded curve geometries of one SOSI file
+    /*!
+        \author Espen Andersen
+        \copyright GNU General Public License
+
+        Holds the coordinates of the curves referred to by surfaces (REF elements), keyed by
+        serial number, once unit, origo and grid transformation have been applied. A curve
+        shared by two surfaces, as is the rule in area coverage datasets, is thus decoded once.
+        The cache belongs to one source file, since the serial numbers and the header context
+        are only valid within the file.
+     */
+    class GeometryCache {
+
+        //! Decoded curves by serial number
+        std::unordered_map<long long, GeometryBuffer> mCurves;
+
+    public:
+
+        //! Look up curve
+        /*!
+            \param serial Serial number of the curve.
+            \return The coordinates of the curve, or 0 if not in the cache.
+         */
+        const GeometryBuffer* find( long long serial ) const;
+
+        //! Add curve
+        /*!
+            The coordinates are moved into the cache.
+            \param serial Serial number of the curve.
+            \param geometry Coordinates of the curve, in file order.
+            \return The cached coordinates.
+         */
+        const GeometryBuffer& insert( long long serial, GeometryBuffer& geometry );
+
+        //! Remove curve, when no more surfaces refer to it
+        void erase( long long serial ) { mCurves.erase( serial ); }
+
+        //! Remove all curves
+        void clear() { mCurves.clear(); }
+
+        //! Number of curves in cache
+        size_t size() const { return mCurves.size(); }
+
+    }; // class GeometryCache
+
+}; // namespace sosicon
+
+#endif
@@ -0,0 +1,382 @@
+/*
+ *  This file is part of the command-line tool sosicon.
+ *  Copyright (C) 2014  Espen Andersen, Norwegian Broadcast Corporation (NRK)
+ *
+ *  This is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "geopackage.h"
+
+namespace {
+
+    //! Quote SQL identifier
+    std::string quoteName( const std::string& name ) {
+        std::string res = "\"";
+        for( std::string::size_type i = 0; i < name.size(); i++ ) {
+            res += name[ i ];
+            if( name[ i ] == '"' ) {
+                res += '"';
+            }
+        }
+        return res + "\"";
+    }
+
+    //! Quote SQL string literal
+    std::string quoteText( const std::string& text ) {
+        std::string res = "'";
+        for( std::string::size_type i = 0; i < text.size(); i++ ) {
+            res += text[ i ];
+            if( text[ i ] == '\'' ) {
+                res += '\'';
+            }
+        }
+        return res + "'";
+    }
+
+    //! GeoPackage geometry type name
+    const char* geometryTypeName( sosicon::Wkt type ) {
+        switch( type ) {
+            case sosicon::wkt_point:
+                return "POINT";
+            case sosicon::wkt_linestring:
+                return "LINESTRING";
+            case sosicon::wkt_polygon:
+                return "POLYGON";
+            default:
+                return "GEOMETRY";
+        }
+    }
+
+};
+
+sosicon::gpkg::Geopackage::
+~Geopackage() {
+    for( std::vector<Layer*>::iterator i = mLayerOrder.begin(); i != mLayerOrder.end(); i++ ) {
+        sqlite3_finalize( ( *i )->mInsert );
+        delete *i;
+    }
+    if( mDb ) {
+        sqlite3_close( mDb );
+    }
+}
+
+void sosicon::gpkg::Geopackage::
+logError( const std::string& context ) {
+    sosicon::logstream << "SQLite error in " << context << ": " << ( mDb ? sqlite3_errmsg( mDb ) : "out of memory" ) << "\n";
+}
+
+bool sosicon::gpkg::Geopackage::
+exec( const std::string& sql ) {
+    char* msg = 0;
+    if( sqlite3_exec( mDb, sql.c_str(), 0, 0, &msg ) != SQLITE_OK ) {
+        sosicon::logstream << "SQLite error: " << ( msg ? msg : "unknown" ) << "\n";
+        sqlite3_free( msg );
+        return false;
+    }
+    return true;
+}
+
+bool sosicon::gpkg::Geopackage::
+create( const std::string& fileName ) {
+
+    std::remove( fileName.c_str() );
+    if( sqlite3_open( fileName.c_str(), &mDb ) != SQLITE_OK ) {
+        logError( fileName );
+        return false;
+    }
+
+    // Bulk load settings. The application id and version identify the file
+    // as a GeoPackage 1.2.
+    return exec( "PRAGMA application_id = 1196444487;"
+                 "PRAGMA user_version = 10200;"
+                 "PRAGMA journal_mode = OFF;"
+                 "PRAGMA synchronous = OFF;"
+                 "PRAGMA locking_mode = EXCLUSIVE;"
+                 "PRAGMA temp_store = MEMORY;"
+                 "PRAGMA cache_size = -65536;" ) &&
+           exec( "CREATE TABLE gpkg_spatial_ref_sys ("
+                 "srs_name TEXT NOT NULL,"
+                 "srs_id INTEGER NOT NULL PRIMARY KEY,"
+                 "organization TEXT NOT NULL,"
+                 "organization_coordsys_id INTEGER NOT NULL,"
+                 "definition TEXT NOT NULL,"
+                 "description TEXT);"
+                 "CREATE TABLE gpkg_contents ("
+                 "table_name TEXT NOT NULL PRIMARY KEY,"
+                 "data_type TEXT NOT NULL,"
+                 "identifier TEXT UNIQUE,"
+                 "description TEXT DEFAULT '',"
+                 "last_change DATETIME NOT NULL DEFAULT (strftime('%Y-%m-%dT%H:%M:%fZ','now')),"
+                 "min_x DOUBLE, min_y DOUBLE, max_x DOUBLE, max_y DOUBLE,"
+                 "srs_id INTEGER,"
+                 "CONSTRAINT fk_gc_r_srs_id FOREIGN KEY (srs_id) REFERENCES gpkg_spatial_ref_sys(srs_id));"
+                 "CREATE TABLE gpkg_geometry_columns ("
+                 "table_name TEXT NOT NULL,"
+                 "column_name TEXT NOT NULL,"
+                 "geometry_type_name TEXT NOT NULL,"
+                 "srs_id INTEGER NOT NULL,"
+                 "z TINYINT NOT NULL,"
+                 "m TINYINT NOT NULL,"
+                 "CONSTRAINT pk_geom_cols PRIMARY KEY (table_name, column_name),"
+                 "CONSTRAINT uk_gc_table_name UNIQUE (table_name),"
+                 "CONSTRAINT fk_gc_tn FOREIGN KEY (table_name) REFERENCES gpkg_contents(table_name),"
+                 "CONSTRAINT fk_gc_srs FOREIGN KEY (srs_id) REFERENCES gpkg_spatial_ref_sys (srs_id));"
+                 "CREATE TABLE gpkg_extensions ("
+                 "table_name TEXT,"
+                 "column_name TEXT,"
+                 "extension_name TEXT NOT NULL,"
+                 "definition TEXT NOT NULL,"
+                 "scope TEXT NOT NULL,"
+                 "CONSTRAINT ge_tce UNIQUE (table_name, column_name, extension_name));"
+                 "INSERT INTO gpkg_spatial_ref_sys VALUES ('Undefined cartesian SRS', -1, 'NONE', -1, 'undefined', "
+                 "'undefined cartesian coordinate reference system');"
+                 "INSERT INTO gpkg_spatial_ref_sys VALUES ('Undefined geographic SRS', 0, 'NONE', 0, 'undefined', "
+                 "'undefined geographic coordinate reference system');"
+                 "INSERT INTO gpkg_spatial_ref_sys VALUES ('WGS 84 geodetic', 4326, 'EPSG', 4326, "
+                 "'GEOGCS[\"WGS 84\",DATUM[\"WGS_1984\",SPHEROID[\"WGS 84\",6378137,298.257223563,AUTHORITY[\"EPSG\",\"7030\"]],"
+                 "AUTHORITY[\"EPSG\",\"6326\"]],PRIMEM[\"Greenwich\",0,AUTHORITY[\"EPSG\",\"8901\"]],"
+                 "UNIT[\"degree\",0.0174532925199433,AUTHORITY[\"EPSG\",\"9122\"]],AUTHORITY[\"EPSG\",\"4326\"]]', "
+                 "'longitude/latitude coordinates in decimal degrees on the WGS 84 spheroid');"
+                 "BEGIN;" );
+}
+
+bool sosicon::gpkg::Geopackage::
+setSrs( int srid, const std::string& name, const std::string& definition ) {
+    if( srid <= 0 ) {
+        mSrid = -1;
+        return true;
+    }
+    mSrid = srid;
+    std::stringstream sql;
+    sql << "INSERT OR IGNORE INTO gpkg_spatial_ref_sys VALUES (" << quoteText( name.empty() ? "EPSG:" + std::to_string( srid ) : name )
+        << ", " << srid << ", 'EPSG', " << srid << ", " << quoteText( definition.empty() ? "undefined" : definition ) << ", NULL);";
+    return exec( sql.str() );
+}
+
+bool sosicon::gpkg::Geopackage::
+prepareInsert( Layer* layer ) {
+    sqlite3_finalize( layer->mInsert );
+    layer->mInsert = 0;
+    std::string sql = "INSERT INTO " + quoteName( layer->mTable ) + " (\"geom\"";
+    std::string values = "?";
+    for( std::vector<std::string>::iterator i = layer->mColumns.begin(); i != layer->mColumns.end(); i++ ) {
+        sql += "," + quoteName( *i );
+        values += ",?";
+    }
+    sql += ") VALUES (" + values + ")";
+    if( sqlite3_prepare_v2( mDb, sql.c_str(), -1, &layer->mInsert, 0 ) != SQLITE_OK ) {
+        logError( layer->mTable );
+        return false;
+    }
+    return true;
+}
+
+bool sosicon::gpkg::Geopackage::
+addColumn( Layer* layer, const std::string& name ) {
+    // Adding a column only changes the schema, the existing rows are not rewritten
+    sqlite3_finalize( layer->mInsert );
+    layer->mInsert = 0;
+    if( !exec( "ALTER TABLE " + quoteName( layer->mTable ) + " ADD COLUMN " + quoteName( name ) + " TEXT" ) ) {
+        return false;
+    }
+    layer->mColumnIndex[ name ] = static_cast<int>( layer->mColumns.size() );
+    layer->mColumns.push_back( name );
+    return true;
+}
+
+sosicon::gpkg::Geopackage::Layer* sosicon::gpkg::Geopackage::
+getLayer( const std::string& table, Wkt geometryType ) {
+    std::map<std::string, Layer*>::iterator i = mLayers.find( table );
+    if( i != mLayers.end() ) {
+        return i->second;
+    }
+    std::stringstream sql;
+    sql << "CREATE TABLE " << quoteName( table ) << " (\"fid\" INTEGER PRIMARY KEY AUTOINCREMENT NOT NULL, \"geom\" "
+        << geometryTypeName( geometryType ) << ");"
+        << "INSERT INTO gpkg_contents (table_name, data_type, identifier, srs_id) VALUES ("
+        << quoteText( table ) << ", 'features', " << quoteText( table ) << ", " << mSrid << ");"
+        << "INSERT INTO gpkg_geometry_columns VALUES (" << quoteText( table ) << ", 'geom', '"
+        << geometryTypeName( geometryType ) << "', " << mSrid << ", 0, 0);";
+    if( !exec( sql.str() ) ) {
+        return 0;
+    }
+    Layer* layer = new Layer();
+    layer->mTable = table;
+    layer->mGeometryType = geometryType;
+    layer->mInsert = 0;
+    layer->mRows = 0;
+    layer->mExtent.minX = layer->mExtent.minY = +9999999999;
+    layer->mExtent.maxX = layer->mExtent.maxY = -9999999999;
+    layer->mExtent.offset = 0;
+    mLayers[ table ] = layer;
+    mLayerOrder.push_back( layer );
+    return layer;
+}
+
+void sosicon::gpkg::Geopackage::
+buildGeometry( Layer* layer, const GeometryBuffer& geom, const GeometryBuffer& holes, const fgb::NodeItem& box ) {
+
+    // GeoPackage binary header: magic, version, flags (little endian, with
+    // envelope [minx, maxx, miny, maxy] except for points) and srs_id
+    bool envelope = layer->mGeometryType != wkt_point;
+    char header[ 40 ] = { 'G', 'P', 0, static_cast<char>( envelope ? 0x03 : 0x01 ) };
+    byteOrder::toLittleEndian( static_cast<int32_t>( mSrid ), &header[ 4 ] );
+    mBlob.assign( header, 8 );
+    if( envelope ) {
+        const double env[ 4 ] = { box.minX, box.maxX, box.minY, box.maxY };
+        byteOrder::toLittleEndian( env, 4, &header[ 8 ] );
+        mBlob.append( &header[ 8 ], 32 );
+    }
+
+    mWkb.clear();
+    mWkb.writeHeader( layer->mGeometryType );
+    switch( layer->mGeometryType ) {
+        case wkt_point:
+            mWkb.writeCoordinate( geom.x( 0 ), geom.y( 0 ) );
+            break;
+        case wkt_linestring:
+            mWkb.writePoints( geom );
+            break;
+        case wkt_polygon:
+            mWkb.writeCount( 1 + holes.numParts() );
+            mWkb.writePoints( geom );
+            for( size_t k = 0; k < holes.numParts(); k++ ) {
+                mWkb.writePoints( holes, holes.partBegin( k ), holes.partEnd( k ) );
+            }
+            break;
+        default:
+            break;
+    }
+    mBlob += mWkb.data();
+}
+
+bool sosicon::gpkg::Geopackage::
+insert( const std::string& table, Wkt geometryType,
+        const GeometryBuffer& geom, const GeometryBuffer& holes,
+        const fgb::NodeItem& box, const Fields& fields ) {
+
+    Layer* layer = getLayer( table, geometryType );
+    if( !layer ) {
+        return false;
+    }
+    for( Fields::const_iterator f = fields.begin(); f != fields.end(); f++ ) {
+        if( layer->mColumnIndex.find( f->first ) == layer->mColumnIndex.end() && !addColumn( layer, f->first ) ) {
+            return false;
+        }
+    }
+    if( !layer->mInsert && !prepareInsert( layer ) ) {
+        return false;
+    }
+
+    sqlite3_stmt* stmt = layer->mInsert;
+    buildGeometry( layer, geom, holes, box );
+    sqlite3_bind_blob( stmt, 1, mBlob.data(), static_cast<int>( mBlob.size() ), SQLITE_STATIC );
+    for( Fields::const_iterator f = fields.begin(); f != fields.end(); f++ ) {
+        sqlite3_bind_text( stmt, layer->mColumnIndex[ f->first ] + 2, f->second.data(), static_cast<int>( f->second.size() ), SQLITE_STATIC );
+    }
+    int rc = sqlite3_step( stmt );
+    sqlite3_reset( stmt );
+    sqlite3_clear_bindings( stmt );
+    if( rc != SQLITE_DONE ) {
+        logError( table );
+        return false;
+    }
+
+    fgb::NodeItem item = box;
+    item.offset = static_cast<uint64_t>( sqlite3_last_insert_rowid( mDb ) );
+    layer->mBoxes.push_back( item );
+    layer->mExtent.expand( box );
+    layer->mRows++;
+
+    if( ++mRowsInTransaction == TRANSACTION_SIZE ) {
+        mRowsInTransaction = 0;
+        return exec( "COMMIT; BEGIN;" );
+    }
+    return true;
+}
+
+bool sosicon::gpkg::Geopackage::
+buildSpatialIndex( Layer* layer ) {
+
+    const std::string t = layer->mTable;
+    const std::string rtreeName = "rtree_" + t + "_geom";
+    const std::string rtree = quoteName( rtreeName );
+    const std::string trigger = rtreeName + "_";
+    const std::string table = quoteName( t );
+    if( !exec( "CREATE VIRTUAL TABLE " + rtree + " USING rtree(id, minx, maxx, miny, maxy)" ) ) {
+        return false;
+    }
+
+    // Neighbouring features end up in the same R-tree nodes when packed in Hilbert order
+    fgb::PackedRTree::hilbertSort( layer->mBoxes, layer->mExtent );
+    if( !RTreeLoader::load( mDb, rtreeName, layer->mBoxes ) ) {
+        return false;
+    }
+    std::vector<fgb::NodeItem>().swap( layer->mBoxes );
+
+    // Triggers of the gpkg_rtree_index extension, which maintain the index when
+    // the table is edited later
+    const std::string newBox = "NEW.fid, ST_MinX(NEW.geom), ST_MaxX(NEW.geom), ST_MinY(NEW.geom), ST_MaxY(NEW.geom)";
+    std::stringstream sql;
+    sql << "CREATE TRIGGER " << quoteName( trigger + "insert" ) << " AFTER INSERT ON " << table
+        << " WHEN (new.geom NOT NULL AND NOT ST_IsEmpty(NEW.geom))"
+        << " BEGIN INSERT OR REPLACE INTO " << rtree << " VALUES (" << newBox << "); END;"
+        << "CREATE TRIGGER " << quoteName( trigger + "update1" ) << " AFTER UPDATE OF geom ON " << table
+        << " WHEN OLD.fid = NEW.fid AND (NEW.geom NOTNULL AND NOT ST_IsEmpty(NEW.geom))"
+        << " BEGIN INSERT OR REPLACE INTO " << rtree << " VALUES (" << newBox << "); END;"
+        << "CREATE TRIGGER " << quoteName( trigger + "update2" ) << " AFTER UPDATE OF geom ON " << table
+        << " WHEN OLD.fid = NEW.fid AND (NEW.geom ISNULL OR ST_IsEmpty(NEW.geom))"
+        << " BEGIN DELETE FROM " << rtree << " WHERE id = OLD.fid; END;"
+        << "CREATE TRIGGER " << quoteName( trigger + "update3" ) << " AFTER UPDATE ON " << table
+        << " WHEN OLD.fid != NEW.fid AND (NEW.geom NOTNULL AND NOT ST_IsEmpty(NEW.geom))"
+        << " BEGIN DELETE FROM " << rtree << " WHERE id = OLD.fid;"
+        << " INSERT OR REPLACE INTO " << rtree << " VALUES (" << newBox << "); END;"
+        << "CREATE TRIGGER " << quoteName( trigger + "update4" ) << " AFTER UPDATE ON " << table
+        << " WHEN OLD.fid != NEW.fid AND (NEW.geom ISNULL OR ST_IsEmpty(NEW.geom))"
+        << " BEGIN DELETE FROM " << rtree << " WHERE id IN (OLD.fid, NEW.fid); END;"
+        << "CREATE TRIGGER " << quoteName( trigger + "delete" ) << " AFTER DELETE ON " << table
+        << " WHEN old.geom NOT NULL"
+        << " BEGIN DELETE FROM " << rtree << " WHERE id = OLD.fid; END;"
+        << "INSERT INTO gpkg_extensions VALUES (" << quoteText( t ) << ", 'geom', 'gpkg_rtree_index', "
+        << "'http://www.geopackage.org/spec120/#extension_rtree', 'write-only');";
+    return exec( sql.str() );
+}
+
+bool sosicon::gpkg::Geopackage::
+complete() {
+    bool ok = true;
+    for( std::vector<Layer*>::iterator i = mLayerOrder.begin(); ok && i != mLayerOrder.end(); i++ ) {
+        Layer* layer = *i;
+        sqlite3_finalize( layer->mInsert );
+        layer->mInsert = 0;
+        std::stringstream sql;
+        sql.precision( 17 );
+        sql << "UPDATE gpkg_contents SET min_x = " << layer->mExtent.minX << ", min_y = " << layer->mExtent.minY
+            << ", max_x = " << layer->mExtent.maxX << ", max_y = " << layer->mExtent.maxY
+            << " WHERE table_name = " << quoteText( layer->mTable );
+        ok = exec( sql.str() ) && buildSpatialIndex( layer );
+    }
+    ok = ok && exec( "COMMIT" );
+    sqlite3_close( mDb );
+    mDb = 0;
+    return ok;
+}
+
+size_t sosicon::gpkg::Geopackage::
+numRows() const {
+    size_t n = 0;
+    for( std::vector<Layer*>::const_iterator i = mLayerOrder.begin(); i != mLayerOrder.end(); i++ ) {
+        n += ( *i )->mRows;
+    }
+    return n;
+}
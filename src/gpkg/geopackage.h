@@ -0,0 +1,167 @@
+/*
+ *  This file is part of the command-line tool sosicon.
+ *  Copyright (C) 2014  Espen Andersen, Norwegian Broadcast Corporation (NRK)
+ *
+ *  This is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __GEOPACKAGE_H__
+#define __GEOPACKAGE_H__
+
+#include <sqlite3.h>
+#include <cstdio>
+#include <map>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+#include "../logger.h"
+#include "../common_types.h"
+#include "../geometry_buffer.h"
+#include "../wkb_writer.h"
+#include "../fgb/flatgeobuf_types.h"
+#include "../fgb/packed_rtree.h"
+#include "rtree_loader.h"
+
+namespace sosicon {
+
+    //! OGC GeoPackage
+    namespace gpkg {
+
+        //! Attribute values of a feature, UTF-8, by field name
+        typedef std::vector< std::pair<std::string, std::string> > Fields;
+
+        //! GeoPackage file
+        /*!
+            \author Espen Andersen
+            \copyright GNU General Public License
+
+            Writes features to an OGC GeoPackage (SQLite database) in bulk. The file is
+            written with journaling and synchronous writes turned off, which is safe since
+            an aborted conversion leaves no file worth keeping, and rows are inserted with
+            one prepared statement per table in large transactions. Columns are added to
+            the tables as new fields are seen.
+
+            Each table gets an R-tree spatial index (gpkg_rtree_index extension). The
+            bounding boxes are collected while the rows are inserted, and the index is
+            bulk loaded by complete() after all rows are in (see RTreeLoader). The triggers that
+            keep the index up to date for later edits are created last, so that they do
+            not fire during the bulk load.
+        */
+        class Geopackage {
+
+            //! Number of rows inserted per transaction
+            static const int TRANSACTION_SIZE = 250000;
+
+            //! Feature table
+            struct Layer {
+                std::string mTable;                         //!< Table name
+                Wkt mGeometryType;                          //!< Geometry type of all rows
+                std::vector<std::string> mColumns;          //!< Attribute column names, in table order
+                std::map<std::string, int> mColumnIndex;    //!< Column position by name
+                sqlite3_stmt* mInsert;                      //!< Insert statement for the current columns
+                size_t mRows;                               //!< Number of rows inserted
+                std::vector<fgb::NodeItem> mBoxes;          //!< Bounding box of each row, by fid
+                fgb::NodeItem mExtent;                      //!< Bounding box of all rows
+            };
+
+            sqlite3* mDb;                                   //!< Database connection
+            int mSrid;                                      //!< Spatial reference system of all tables
+            int mRowsInTransaction;                         //!< Rows inserted since last commit
+            std::map<std::string, Layer*> mLayers;          //!< Feature tables by name
+            std::vector<Layer*> mLayerOrder;                //!< Feature tables in order of creation
+            WkbWriter mWkb;                                 //!< Work buffer for geometry
+            std::string mBlob;                              //!< Work buffer for GeoPackage geometry
+
+            //! Execute SQL statement(s), logging any error
+            bool exec( const std::string& sql );
+
+            //! Log error message of last failed SQLite call
+            void logError( const std::string& context );
+
+            //! Prepare insert statement for the current columns of the table
+            bool prepareInsert( Layer* layer );
+
+            //! Add attribute column to table
+            bool addColumn( Layer* layer, const std::string& name );
+
+            //! Build GeoPackage binary geometry in mBlob
+            void buildGeometry( Layer* layer, const GeometryBuffer& geom, const GeometryBuffer& holes,
+                                const fgb::NodeItem& box );
+
+            //! Create, fill and maintain spatial index of table
+            bool buildSpatialIndex( Layer* layer );
+
+            //! Get or create feature table
+            Layer* getLayer( const std::string& table, Wkt geometryType );
+
+        public:
+
+            //! Constructor
+            Geopackage() : mDb( 0 ), mSrid( -1 ), mRowsInTransaction( 0 ) { }
+
+            //! Destructor
+            /*!
+                Closes the database. Rows not committed by complete() are lost.
+             */
+            ~Geopackage();
+
+            //! Create GeoPackage file
+            /*!
+                Creates the GeoPackage system tables and starts the first transaction.
+                \param fileName Output file path. An existing file is overwritten.
+                \return False on failure, which is logged.
+             */
+            bool create( const std::string& fileName );
+
+            //! Set spatial reference system of the tables to be created
+            /*!
+                \param srid EPSG code, or 0 if unknown.
+                \param name Display name of the reference system.
+                \param definition WKT definition of the reference system.
+             */
+            bool setSrs( int srid, const std::string& name, const std::string& definition );
+
+            //! True once setSrs() has succeeded
+            bool hasSrs() const { return mSrid >= 0; }
+
+            //! Insert feature
+            /*!
+                \param table Name of the table to insert into, created on first use.
+                \param geometryType Geometry type of the table.
+                \param geom Point, linestring or outer ring of polygon.
+                \param holes Holes of polygon, one part per ring.
+                \param box Bounding box of the geometry.
+                \param fields Attribute values, UTF-8.
+                \return False on failure, which is logged.
+             */
+            bool insert( const std::string& table, Wkt geometryType,
+                         const GeometryBuffer& geom, const GeometryBuffer& holes,
+                         const fgb::NodeItem& box, const Fields& fields );
+
+            //! Build spatial indexes, update table extents, commit and close
+            bool complete();
+
+            //! Number of feature tables
+            size_t numTables() const { return mLayerOrder.size(); }
+
+            //! Number of rows in all tables
+            size_t numRows() const;
+
+        }; // class Geopackage
+
+    }; // namespace gpkg
+
+}; // namespace sosicon
+
+#endif
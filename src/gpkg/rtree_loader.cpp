@@ -0,0 +1,192 @@
+/*
+ *  This file is part of the command-line tool sosicon.
+ *  Copyright (C) 2014  Espen Andersen, Norwegian Broadcast Corporation (NRK)
+ *
+ *  This is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "rtree_loader.h"
+
+namespace {
+
+    //! Quote SQL identifier
+    std::string quoteName( const std::string& name ) {
+        std::string res = "\"";
+        for( std::string::size_type i = 0; i < name.size(); i++ ) {
+            res += name[ i ];
+            if( name[ i ] == '"' ) {
+                res += '"';
+            }
+        }
+        return res + "\"";
+    }
+
+};
+
+float sosicon::gpkg::RTreeLoader::
+roundDown( double value ) {
+    float f = static_cast<float>( value );
+    return f > value ? std::nextafter( f, -std::numeric_limits<float>::infinity() ) : f;
+}
+
+float sosicon::gpkg::RTreeLoader::
+roundUp( double value ) {
+    float f = static_cast<float>( value );
+    return f < value ? std::nextafter( f, std::numeric_limits<float>::infinity() ) : f;
+}
+
+bool sosicon::gpkg::RTreeLoader::
+load( sqlite3* db, const std::string& rtree, const std::vector<fgb::NodeItem>& items ) {
+    if( items.empty() ) {
+        return true;
+    }
+    if( pack( db, rtree, items ) && check( db, rtree ) ) {
+        return true;
+    }
+    sosicon::logstream << "R-tree " << rtree << " could not be packed, inserting rows instead\n";
+    return insert( db, rtree, items );
+}
+
+bool sosicon::gpkg::RTreeLoader::
+check( sqlite3* db, const std::string& rtree ) {
+    sqlite3_stmt* stmt = 0;
+    bool ok = sqlite3_prepare_v2( db, "SELECT rtreecheck(?)", -1, &stmt, 0 ) == SQLITE_OK;
+    if( ok ) {
+        sqlite3_bind_text( stmt, 1, rtree.c_str(), -1, SQLITE_TRANSIENT );
+        ok = sqlite3_step( stmt ) == SQLITE_ROW;
+        const unsigned char* res = ok ? sqlite3_column_text( stmt, 0 ) : 0;
+        ok = res && std::string( reinterpret_cast<const char*>( res ) ) == "ok";
+    }
+    sqlite3_finalize( stmt );
+    return ok;
+}
+
+bool sosicon::gpkg::RTreeLoader::
+insert( sqlite3* db, const std::string& rtree, const std::vector<fgb::NodeItem>& items ) {
+    const std::string name = quoteName( rtree );
+    std::string sql = "DROP TABLE " + name + "; CREATE VIRTUAL TABLE " + name + " USING rtree(id, minx, maxx, miny, maxy)";
+    bool ok = sqlite3_exec( db, sql.c_str(), 0, 0, 0 ) == SQLITE_OK;
+
+    // The R-tree module rounds the coordinates outwards to its 32 bit floats
+    sqlite3_stmt* stmt = 0;
+    sql = "INSERT INTO " + name + " (id, minx, maxx, miny, maxy) VALUES (?,?,?,?,?)";
+    ok = ok && sqlite3_prepare_v2( db, sql.c_str(), -1, &stmt, 0 ) == SQLITE_OK;
+    for( std::vector<fgb::NodeItem>::const_iterator i = items.begin(); ok && i != items.end(); i++ ) {
+        sqlite3_bind_int64( stmt, 1, static_cast<sqlite3_int64>( i->offset ) );
+        sqlite3_bind_double( stmt, 2, i->minX );
+        sqlite3_bind_double( stmt, 3, i->maxX );
+        sqlite3_bind_double( stmt, 4, i->minY );
+        sqlite3_bind_double( stmt, 5, i->maxY );
+        ok = sqlite3_step( stmt ) == SQLITE_DONE;
+        sqlite3_reset( stmt );
+    }
+    if( !ok ) {
+        sosicon::logstream << "SQLite error in " << rtree << ": " << sqlite3_errmsg( db ) << "\n";
+    }
+    sqlite3_finalize( stmt );
+    return ok;
+}
+
+bool sosicon::gpkg::RTreeLoader::
+pack( sqlite3* db, const std::string& rtree, const std::vector<fgb::NodeItem>& items ) {
+
+    // The node size is given by the empty root node, created with the table
+    sqlite3_stmt* stmt = 0;
+    int nodeSize = 0;
+    std::string sql = "SELECT length(data) FROM " + quoteName( rtree + "_node" ) + " WHERE nodeno = 1";
+    if( sqlite3_prepare_v2( db, sql.c_str(), -1, &stmt, 0 ) == SQLITE_OK && sqlite3_step( stmt ) == SQLITE_ROW ) {
+        nodeSize = sqlite3_column_int( stmt, 0 );
+    }
+    sqlite3_finalize( stmt );
+    const size_t maxCells = nodeSize > 4 ? static_cast<size_t>( nodeSize - 4 ) / CELL_SIZE : 0;
+    if( maxCells < 2 ) {
+        return false;
+    }
+
+    std::vector<Cell> level( items.size() );
+    for( size_t i = 0; i < items.size(); i++ ) {
+        Cell& c = level[ i ];
+        c.mId = static_cast<sqlite3_int64>( items[ i ].offset );
+        c.mBox[ 0 ] = roundDown( items[ i ].minX );
+        c.mBox[ 1 ] = roundUp( items[ i ].maxX );
+        c.mBox[ 2 ] = roundDown( items[ i ].minY );
+        c.mBox[ 3 ] = roundUp( items[ i ].maxY );
+    }
+
+    sqlite3_stmt* insertNode = 0;
+    sqlite3_stmt* insertRowid = 0;
+    sqlite3_stmt* insertParent = 0;
+    bool ok = sqlite3_prepare_v2( db, ( "INSERT OR REPLACE INTO " + quoteName( rtree + "_node" ) + " VALUES (?,?)" ).c_str(), -1, &insertNode, 0 ) == SQLITE_OK &&
+              sqlite3_prepare_v2( db, ( "INSERT INTO " + quoteName( rtree + "_rowid" ) + " (rowid, nodeno) VALUES (?,?)" ).c_str(), -1, &insertRowid, 0 ) == SQLITE_OK &&
+              sqlite3_prepare_v2( db, ( "INSERT INTO " + quoteName( rtree + "_parent" ) + " VALUES (?,?)" ).c_str(), -1, &insertParent, 0 ) == SQLITE_OK;
+
+    // Nodes are numbered bottom-up from 2, except the root, which is always node 1.
+    // The cells are spread evenly over the nodes of each level, so that no node is
+    // less than half full.
+    std::string data( nodeSize, '\0' );
+    std::vector<Cell> parents;
+    std::vector<sqlite3_int64> children;
+    sqlite3_int64 nextNode = 2;
+    uint16_t depth = 0;
+    bool leaf = true;
+    while( ok ) {
+        const bool root = level.size() <= maxCells;
+        const size_t numNodes = ( level.size() + maxCells - 1 ) / maxCells;
+        parents.clear();
+        for( size_t n = 0; ok && n < numNodes; n++ ) {
+            const size_t begin = level.size() * n / numNodes;
+            const size_t end = level.size() * ( n + 1 ) / numNodes;
+            const sqlite3_int64 nodeNo = root ? 1 : nextNode++;
+            Cell parent;
+            parent.mId = nodeNo;
+            parent.mBox[ 0 ] = parent.mBox[ 2 ] = std::numeric_limits<float>::max();
+            parent.mBox[ 1 ] = parent.mBox[ 3 ] = -std::numeric_limits<float>::max();
+
+            std::fill( data.begin(), data.end(), '\0' );
+            byteOrder::toBigEndian( static_cast<uint16_t>( root ? depth : 0 ), &data[ 0 ] );
+            byteOrder::toBigEndian( static_cast<uint16_t>( end - begin ), &data[ 2 ] );
+            char* p = &data[ 4 ];
+            for( size_t i = begin; i < end; i++, p += CELL_SIZE ) {
+                const Cell& c = level[ i ];
+                byteOrder::toBigEndian( static_cast<int64_t>( c.mId ), p );
+                byteOrder::toBigEndian( c.mBox, 4, p + 8 );
+                parent.mBox[ 0 ] = std::min( parent.mBox[ 0 ], c.mBox[ 0 ] );
+                parent.mBox[ 1 ] = std::max( parent.mBox[ 1 ], c.mBox[ 1 ] );
+                parent.mBox[ 2 ] = std::min( parent.mBox[ 2 ], c.mBox[ 2 ] );
+                parent.mBox[ 3 ] = std::max( parent.mBox[ 3 ], c.mBox[ 3 ] );
+
+                // Leaf cells are looked up by row id, child nodes by node number
+                sqlite3_stmt* link = leaf ? insertRowid : insertParent;
+                sqlite3_bind_int64( link, 1, c.mId );
+                sqlite3_bind_int64( link, 2, nodeNo );
+                ok = ok && sqlite3_step( link ) == SQLITE_DONE;
+                sqlite3_reset( link );
+            }
+            sqlite3_bind_int64( insertNode, 1, nodeNo );
+            sqlite3_bind_blob( insertNode, 2, data.data(), nodeSize, SQLITE_STATIC );
+            ok = ok && sqlite3_step( insertNode ) == SQLITE_DONE;
+            sqlite3_reset( insertNode );
+            parents.push_back( parent );
+        }
+        if( root ) {
+            break;
+        }
+        level.swap( parents );
+        leaf = false;
+        depth++;
+    }
+    sqlite3_finalize( insertNode );
+    sqlite3_finalize( insertRowid );
+    sqlite3_finalize( insertParent );
+    return ok;
+}
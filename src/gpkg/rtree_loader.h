@@ -0,0 +1,109 @@
+/*
+ *  This file is part of the command-line tool sosicon.
+ *  Copyright (C) 2014  Espen Andersen, Norwegian Broadcast Corporation (NRK)
+ *
+ *  This is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __RTREE_LOADER_H__
+#define __RTREE_LOADER_H__
+
+#include <sqlite3.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <string>
+#include <vector>
+#include "../logger.h"
+#include "../byte_order.h"
+#include "../fgb/flatgeobuf_types.h"
+
+namespace sosicon {
+
+    namespace gpkg {
+
+        //! Bulk loader of SQLite R-tree
+        /*!
+            \author Espen Andersen
+            \copyright GNU General Public License
+
+            Fills an empty SQLite R-tree virtual table in one pass, instead of inserting one
+            row at a time through the virtual table. The boxes are packed bottom-up into full
+            nodes, in the order given (Hilbert order from fgb::PackedRTree::hilbertSort() gives
+            nodes of neighbouring features), and the nodes are written straight to the shadow
+            tables of the R-tree (<name>_node, <name>_rowid and <name>_parent), in the node
+            format of the SQLite R-tree module. The result is a valid R-tree, which SQLite
+            maintains as usual from then on.
+
+            As the shadow tables are internal to SQLite, the tree is verified with
+            rtreecheck() after loading. If the check fails, or is not available, the R-tree
+            is created anew and filled through the R-tree module, one row at a time in the
+            same order.
+
+            Only 2D trees with 32 bit floating point coordinates, the SQLite default, are
+            supported.
+        */
+        class RTreeLoader {
+
+            //! Bytes per node cell: 64 bit id and four 32 bit coordinates
+            static const int CELL_SIZE = 24;
+
+            //! Node cell
+            struct Cell {
+                sqlite3_int64 mId;                          //!< Row id of leaf cell, or child node number
+                float mBox[ 4 ];                            //!< minx, maxx, miny, maxy
+            };
+
+            //! Largest float not above value
+            static float roundDown( double value );
+
+            //! Smallest float not below value
+            static float roundUp( double value );
+
+            //! Write the nodes of the packed R-tree to the shadow tables
+            /*!
+                \return False on failure.
+             */
+            static bool pack( sqlite3* db, const std::string& rtree, const std::vector<fgb::NodeItem>& items );
+
+            //! Verify the R-tree with rtreecheck()
+            /*!
+                \return False if the tree is not valid, or rtreecheck() is not available.
+             */
+            static bool check( sqlite3* db, const std::string& rtree );
+
+            //! Create the R-tree anew and insert the boxes one at a time
+            /*!
+                \return False on failure, which is logged.
+             */
+            static bool insert( sqlite3* db, const std::string& rtree, const std::vector<fgb::NodeItem>& items );
+
+        public:
+
+            //! Fill R-tree
+            /*!
+                \param db Database connection.
+                \param rtree Name of the R-tree virtual table, created with five columns
+                             (id, minx, maxx, miny, maxy) and still empty.
+                \param items Boxes to index, with the row ids in NodeItem::offset.
+                \return False on failure, which is logged.
+             */
+            static bool load( sqlite3* db, const std::string& rtree, const std::vector<fgb::NodeItem>& items );
+
+        }; // class RTreeLoader
+
+    }; // namespace gpkg
+
+}; // namespace sosicon
+
+#endif
@@ -0,0 +1,74 @@
+/*
+ *  This file is part of the command-line tool sosicon.
+ *  Copyright (C) 2014  Espen Andersen, Norwegian Broadcast Corporation (NRK)
+ *
+ *  This is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __I_BATCH_WRITER_H__
+#define __I_BATCH_WRITER_H__
+
+#include <string>
+#include <vector>
+#include "../arrow/record_batch.h"
+
+namespace sosicon {
+
+    /*!
+        \addtogroup interfaces
+        @{
+    */
+    //! Interface: Columnar file writer
+    /*!
+        \author Espen Andersen
+        \copyright GNU General Public License
+
+        Writes a table, given as Arrow record batches, to a columnar file format. The schema
+        and the dictionaries of dictionary encoded columns are given up front.
+    */
+    class IBatchWriter {
+
+    public:
+
+        //! Destructor
+        virtual ~IBatchWriter() { }
+
+        //! Create file
+        /*!
+            \param fileName Output file path.
+            \param schema Table layout. Must stay valid until close().
+            \param dictionaries Values of each dictionary, UTF-8, by dictionary id. Must stay
+                   valid until close().
+            \return False if the file could not be created.
+         */
+        virtual bool open( const std::string& fileName,
+                           const arrow::Schema& schema,
+                           const std::vector<arrow::Array>& dictionaries ) = 0;
+
+        //! Write rows
+        /*!
+            \param batch One array per schema field.
+            \return False on write failure.
+         */
+        virtual bool write( const arrow::RecordBatch& batch ) = 0;
+
+        //! Complete and close file
+        /*!
+            \return False on write failure.
+         */
+        virtual bool close() = 0;
+    };
+    /*! @} end group interfaces */
+};
+
+#endif
@@ -18,9 +18,7 @@
 #ifndef __I_SHAPEFILE_H__
 #define __I_SHAPEFILE_H__
 
-#include "i_shapefile_shp_part.h"
-#include "i_shapefile_shx_part.h"
-#include "i_shapefile_dbf_part.h"
+#include <string>
 #include "i_shapefile_prj_part.h"
 #include "i_sosi_element.h"
 #include "../sosi/sosi_types.h"
@@ -36,26 +34,37 @@ namespace sosicon {
         \author Espen Andersen
         \copyright GNU General Public License
     */
-    class IShapefile : public IShapefileShpPart,
-                       public IShapefileShxPart,
-                       public IShapefileDbfPart,
-                       public IShapefilePrjPart {
+    class IShapefile : public IShapefilePrjPart {
 
         public:
             
             virtual ~IShapefile() {}
 
-            //! Build shapefile from SOSI data
+            //! Add SOSI element to shapefile
             /*!
-                \param sosiTree Root SOSI element. The first-level children of this element
-                       will be examined and exported if they are compatible.
-                \param selection SOSI OBJTYPE scheduled for shapefile conversion.
-                \param geomType SOSI element type scheduled for shapefile conversion.
-                       Since a shapefile may contain only one geometry type at a time,
-                       one must select what element type to extract from the SOSI file.
-                \return Number of elements exported.
+                Converts the element and appends it to the shapefile on disk. Since a shapefile may
+                contain only one geometry type at a time, all elements inserted must be of the
+                same type. Elements without a shapefile equivalent, or not selected by
+                filterSosiId(), are ignored.
+                \param sosi First-level SOSI element (feature) to be exported.
              */
-            virtual int build( ISosiElement* sosiTree, std::string selection, sosi::ElementType geomType ) = 0;
+            virtual void insert( ISosiElement* sosi ) = 0;
+
+            //! Complete shapefile
+            /*!
+                Writes file headers and attribute table and closes the shp, shx and dbf files
+                when all elements have been inserted. If any of the files could not be
+                written, the incomplete files are removed.
+                \param sosiTree Root SOSI element, from which the file header is read.
+                \return Number of elements exported, or -1 if the files could not be written.
+             */
+            virtual int complete( ISosiElement* sosiTree ) = 0;
+
+            //! Get output file path
+            /*!
+                \return Path of the shapefile, without extension.
+             */
+            virtual std::string getBasePath() = 0;
 
             //! Set IDs for seleced element export
             /*!
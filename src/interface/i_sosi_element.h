@@ -38,8 +38,8 @@ namespace sosicon {
         \copyright GNU General Public License
 
        Represents the generic form of a SOSI element. All SOSI elements must implement this
-       interface. It provides functionality for setting and retrieveing field values. The parser
-       writes field values to current SOSI element through this interface.
+       interface. It provides functionality for retrieveing field values. The parser stores the
+       elements in a sosicon::sosi::SosiElementTable, where their values cannot be altered.
        
        \sa sosicon::Parser::parseSosiLine()
        
@@ -54,16 +54,16 @@ namespace sosicon {
         //! Destructor
         virtual ~ISosiElement(){ };
 
-        virtual std::vector<ISosiElement*>& children() = 0;
-		
-		virtual void addChild( ISosiElement* child ) = 0;
-
         virtual std::string getName() = 0;
 
+        virtual std::string getRawName() = 0;
+
         virtual bool getChild( sosi::SosiElementSearch& src ) = 0;
 
         virtual std::string getData() = 0;
 
+        virtual sosi::NorthEastSpan coordinates() = 0;
+
         virtual int getLevel() = 0;
 
         virtual sosi::ElementType getType() = 0;
@@ -74,8 +74,6 @@ namespace sosicon {
 
         virtual std::string getSerial() = 0;
 
-        virtual void deleteChildren() = 0;
-
         virtual void dump( int indent = 0 ) = 0;
 
         virtual ISosiElement* find( std::string ref ) = 0;
@@ -16,37 +16,54 @@
  *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include "logger.h"
-#include "sosi/sosi_charset_singleton.h"
 
 sosicon::Logger sosicon::logstream;
 
+void
+sosicon::Logger::flushPending()
+{
+    std::map<std::thread::id, Pending>::iterator i = mPending.find( std::this_thread::get_id() );
+    if( i != mPending.end() ) {
+        std::cout << i->second.out;
+        if( i->second.msg.str().empty() ) {
+            mPending.erase( i );
+        }
+        else {
+            i->second.out.clear();
+        }
+    }
+}
+
 sosicon::Logger&
 sosicon::Logger::operator << ( std::string v )
 {
-    static bool updateable = false;
-    std::cout << v.c_str();
+    std::lock_guard<std::mutex> lock( mMutex );
+    Pending& p = pending();
+    p.out += v;
     if( v.find( "\r", 0 ) != std::string::npos ) {
-        std::string msgStr = sosicon::utils::purgeCrLf( sosicon::utils::trim( sosi::SosiCharsetSingleton::getInstance()->toIso8859_1( mMsgStream.str() ) ) );
+        std::string msgStr = sosicon::utils::purgeCrLf( sosicon::utils::trim( p.msg.str() ) );
         if( !msgStr.empty() ) {
-            LogEvent e( sosicon::utils::purgeCrLf( mMsgStream.str() ), updateable );
-            updateable = true;
-            mMsgStream.str( std::string() );
-            mMsgStream << sosicon::utils::purgeCrLf( v );
+            LogEvent e( sosicon::utils::purgeCrLf( p.msg.str() ), p.updateable );
+            p.updateable = true;
+            p.msg.str( std::string() );
+            p.msg << sosicon::utils::purgeCrLf( v );
             mLogEventDispatcher.EventDispatcher<LogEvent>::Dispatch( e );
         }
+        flushPending();
     }
     else if( v.find( "\n", 0 ) != std::string::npos ) {
-        mMsgStream << v;
-        updateable = false;
-        std::string msgStr = sosicon::utils::purgeCrLf( sosicon::utils::trim( sosi::SosiCharsetSingleton::getInstance()->toIso8859_1( mMsgStream.str() ) ) );
+        p.msg << v;
+        p.updateable = false;
+        std::string msgStr = sosicon::utils::purgeCrLf( sosicon::utils::trim( p.msg.str() ) );
         if( !msgStr.empty() ) {
-            LogEvent e( msgStr, updateable );
+            LogEvent e( msgStr, p.updateable );
             mLogEventDispatcher.EventDispatcher<LogEvent>::Dispatch( e );
         }
-        mMsgStream.str( std::string() );
+        p.msg.str( std::string() );
+        flushPending();
     }
     else {
-        mMsgStream << v;
+        p.msg << v;
     }
     return *this;
 }
@@ -54,25 +71,19 @@ sosicon::Logger::operator << ( std::string v )
 sosicon::Logger&
 sosicon::Logger::operator << ( std::string::size_type v )
 {
-    mMsgStream << v;
-    std::cout << v;
-    return *this;
+    return append( v );
 }
 
 sosicon::Logger&
 sosicon::Logger::operator << ( int v )
 {
-    mMsgStream << v;
-    std::cout << v;
-    return *this;
+    return append( v );
 }
 
 sosicon::Logger&
 sosicon::Logger::operator << ( long v )
 {
-    mMsgStream << v;
-    std::cout << v;
-    return *this;
+    return append( v );
 }
 
 sosicon::Logger&
@@ -82,8 +93,16 @@ sosicon::Logger::operator << ( sosicon::Logger& ( *func ) ( sosicon::Logger& ) )
 }
 
 sosicon::Logger&
-sosicon::flush( sosicon::Logger& l )
+sosicon::Logger::flush()
 {
+    std::lock_guard<std::mutex> lock( mMutex );
+    flushPending();
     std::cout << std::flush;
-    return l;
+    return *this;
+}
+
+sosicon::Logger&
+sosicon::flush( sosicon::Logger& l )
+{
+    return l.flush();
 }
@@ -23,8 +23,11 @@
 #include "event_dispatcher.h"
 #include <iostream>
 #include <algorithm>
+#include <map>
+#include <mutex>
 #include <sstream>
 #include <string>
+#include <thread>
 
 namespace sosicon {
 
@@ -34,11 +37,46 @@ namespace sosicon {
         \copyright GNU General Public License
 
         User output logger. Redirects to stdin, or a dedicated ILogReceiver implementation.
+
+        The logger may be used from several threads at the same time. Output is collected
+        per thread, and passed on one complete line (ended by a line feed or carriage return)
+        at a time, so that lines from different threads are not mixed.
     */
     class Logger {
 
+        //! Output of one thread, not yet passed on
+        struct Pending {
+            std::string out;       //!< Text not yet written to stdout
+            std::stringstream msg; //!< Message not yet dispatched as LogEvent
+            bool updateable;       //!< True if last event dispatched may be replaced by the next
+            Pending() : updateable( false ) { }
+        };
+
         LogEventDispatcher mLogEventDispatcher;
-        std::stringstream mMsgStream;
+
+        //! Pending output, by thread
+        std::map<std::thread::id, Pending> mPending;
+
+        //! Serializes access to mPending, stdout and the listeners
+        std::mutex mMutex;
+
+        //! Get pending output of calling thread. Call with mMutex locked.
+        Pending& pending() { return mPending[ std::this_thread::get_id() ]; }
+
+        //! Write pending output of calling thread, and forget it. Call with mMutex locked.
+        void flushPending();
+
+        //! Append number. Numbers never complete a line.
+        template<typename T>
+        Logger& append( T v ) {
+            std::lock_guard<std::mutex> lock( mMutex );
+            Pending& p = pending();
+            std::stringstream ss;
+            ss << v;
+            p.out += ss.str();
+            p.msg << v;
+            return *this;
+        }
 
     public:
 
@@ -48,6 +86,9 @@ namespace sosicon {
         Logger& operator << ( std::string::size_type v );
         Logger& operator << ( Logger& ( *func ) ( Logger& ) );
 
+        //! Write pending output of calling thread to stdout, even if the line is not complete
+        Logger& flush();
+
         void addEventListener( LogEventDispatcher::Listener *listener ) { mLogEventDispatcher.addEventListener( listener ); }
         void removeEventListener( LogEventDispatcher::Listener *listener ) { mLogEventDispatcher.removeEventListener( listener ); }
     };
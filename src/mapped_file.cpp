@@ -0,0 +1,141 @@
+/*
+ *  This file is part of the command-line tool sosicon.
+ *  Copyright (C) 2014  Espen Andersen, Norwegian Broadcast Corporation (NRK)
+ *
+ *  This is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "mapped_file.h"
+#include <fstream>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+sosicon::MappedFile::
+MappedFile() {
+    mData = 0;
+    mSize = 0;
+    mCursor = 0;
+    mMapped = false;
+#ifdef _WIN32
+    mFileHandle = INVALID_HANDLE_VALUE;
+    mMappingHandle = 0;
+#endif
+}
+
+sosicon::MappedFile::
+~MappedFile() {
+    close();
+}
+
+bool sosicon::MappedFile::
+open( std::string fileName ) {
+
+    close();
+
+#ifdef _WIN32
+
+    HANDLE file = CreateFileA( fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, 0,
+                               OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, 0 );
+    if( file == INVALID_HANDLE_VALUE ) {
+        return false;
+    }
+    LARGE_INTEGER fileSize;
+    if( GetFileSizeEx( file, &fileSize ) && fileSize.QuadPart > 0 ) {
+        HANDLE mapping = CreateFileMappingA( file, 0, PAGE_READONLY, 0, 0, 0 );
+        if( mapping ) {
+            void* view = MapViewOfFile( mapping, FILE_MAP_READ, 0, 0, 0 );
+            if( view ) {
+                mFileHandle = file;
+                mMappingHandle = mapping;
+                mData = static_cast<const char*>( view );
+                mSize = static_cast<size_t>( fileSize.QuadPart );
+                mCursor = mData;
+                mMapped = true;
+                return true;
+            }
+            CloseHandle( mapping );
+        }
+    }
+    CloseHandle( file );
+
+#else
+
+    int fd = ::open( fileName.c_str(), O_RDONLY );
+    if( fd < 0 ) {
+        return false;
+    }
+    struct stat st;
+    if( fstat( fd, &st ) == 0 && S_ISREG( st.st_mode ) && st.st_size > 0 ) {
+        void* addr = mmap( 0, static_cast<size_t>( st.st_size ), PROT_READ, MAP_PRIVATE, fd, 0 );
+        if( addr != MAP_FAILED ) {
+            ::close( fd );
+            madvise( addr, static_cast<size_t>( st.st_size ), MADV_SEQUENTIAL );
+            mData = static_cast<const char*>( addr );
+            mSize = static_cast<size_t>( st.st_size );
+            mCursor = mData;
+            mMapped = true;
+            return true;
+        }
+    }
+    ::close( fd );
+
+#endif
+
+    return readFallback( fileName );
+}
+
+void sosicon::MappedFile::
+close() {
+    if( mMapped ) {
+#ifdef _WIN32
+        UnmapViewOfFile( mData );
+        CloseHandle( mMappingHandle );
+        CloseHandle( mFileHandle );
+        mMappingHandle = 0;
+        mFileHandle = INVALID_HANDLE_VALUE;
+#else
+        munmap( const_cast<char*>( mData ), mSize );
+#endif
+    }
+    std::vector<char>().swap( mFallback );
+    mData = 0;
+    mSize = 0;
+    mCursor = 0;
+    mMapped = false;
+}
+
+bool sosicon::MappedFile::
+readFallback( std::string fileName ) {
+    std::ifstream ifs( fileName.c_str(), std::ios::in | std::ios::binary );
+    if( !ifs.is_open() ) {
+        return false;
+    }
+    char buf[ 65536 ];
+    while( ifs.read( buf, sizeof buf ) || ifs.gcount() > 0 ) {
+        mFallback.insert( mFallback.end(), buf, buf + ifs.gcount() );
+    }
+    mData = mFallback.empty() ? 0 : &mFallback[ 0 ];
+    mSize = mFallback.size();
+    mCursor = mData;
+    return true;
+}
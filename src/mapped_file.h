@@ -0,0 +1,156 @@
+/*
+ *  This file is part of the command-line tool sosicon.
+ *  Copyright (C) 2014  Espen Andersen, Norwegian Broadcast Corporation (NRK)
+ *
+ *  This is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __MAPPED_FILE_H__
+#define __MAPPED_FILE_H__
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace sosicon {
+
+    //! Memory-mapped input file
+    /*!
+        \author Espen Andersen
+        \copyright GNU General Public License
+
+        Read-only view of a SOSI source file. The file is mapped into memory in its entirety,
+        so the parser may walk the raw bytes without copying them into intermediate line
+        buffers. Lines are handed out as [begin, end) pointer ranges into the mapping. If the
+        file cannot be mapped (empty file, special file), its content is read into an internal
+        buffer instead, and the same interface applies.
+     */
+    class MappedFile {
+
+        //! Start of file content
+        const char* mData;
+
+        //! Number of bytes in file
+        size_t mSize;
+
+        //! Read position of getLine() and getBlock()
+        const char* mCursor;
+
+        //! True if mData points to a memory mapping (as opposed to mFallback)
+        bool mMapped;
+
+        //! Fallback storage when mapping is not possible
+        std::vector<char> mFallback;
+
+#ifdef _WIN32
+        //! Windows file handle
+        void* mFileHandle;
+
+        //! Windows file mapping handle
+        void* mMappingHandle;
+#endif
+
+        //! Read file through regular stream i/o into mFallback
+        bool readFallback( std::string fileName );
+
+        //! No copying of mapped files
+        MappedFile( const MappedFile& );
+
+        //! No copying of mapped files
+        MappedFile& operator=( const MappedFile& );
+
+    public:
+
+        //! Constructor
+        MappedFile();
+
+        //! Destructor
+        /*!
+            Unmaps the file, if still open.
+         */
+        ~MappedFile();
+
+        //! Map file
+        /*!
+            \param fileName Path to the file.
+            \return False if the file could not be opened.
+         */
+        bool open( std::string fileName );
+
+        //! Unmap file
+        void close();
+
+        //! Get pointer to first byte of file content
+        const char* begin() const { return mData; };
+
+        //! Get pointer to one past the last byte of file content
+        const char* end() const { return mData + mSize; };
+
+        //! Get file size in bytes
+        size_t size() const { return mSize; };
+
+        //! Get next line
+        /*!
+            Iterates the file line by line. The range returned includes the line terminator,
+            except for a last line that is not terminated.
+            \param lineBegin Receives pointer to the first byte of the line.
+            \param lineEnd Receives pointer to one past the last byte of the line.
+            \return False when there are no more lines.
+         */
+        bool getLine( const char*& lineBegin, const char*& lineEnd ) {
+            const char* fileEnd = end();
+            if( mCursor >= fileEnd ) {
+                return false;
+            }
+            lineBegin = mCursor;
+            const char* nl = static_cast<const char*>( memchr( mCursor, '\n', fileEnd - mCursor ) );
+            lineEnd = nl ? nl + 1 : fileEnd;
+            mCursor = lineEnd;
+            return true;
+        };
+
+        //! Get next block of whole lines
+        /*!
+            Iterates the file in blocks of approximately blockSize bytes, extending each block
+            to the end of the line it would otherwise split. Consumers who process the file
+            block by block may report progress or check for cancellation between blocks.
+            \param blockBegin Receives pointer to the first byte of the block.
+            \param blockEnd Receives pointer to one past the last byte of the block.
+            \param blockSize Preferred block size in bytes.
+            \return False when there are no more blocks.
+         */
+        bool getBlock( const char*& blockBegin, const char*& blockEnd, size_t blockSize = 1048576 ) {
+            const char* fileEnd = end();
+            if( mCursor >= fileEnd ) {
+                return false;
+            }
+            blockBegin = mCursor;
+            if( static_cast<size_t>( fileEnd - mCursor ) <= blockSize ) {
+                blockEnd = fileEnd;
+            }
+            else {
+                const char* split = mCursor + blockSize;
+                const char* nl = static_cast<const char*>( memchr( split, '\n', fileEnd - split ) );
+                blockEnd = nl ? nl + 1 : fileEnd;
+            }
+            mCursor = blockEnd;
+            return true;
+        };
+
+        //! Restart iteration from the beginning of the file
+        void rewind() { mCursor = mData; };
+
+    };
+};
+
+#endif
@@ -0,0 +1,168 @@
+/*
+ *  This file is part of the command-line tool sosicon.
+ *  Copyright (C) 2014  Espen Andersen, Norwegian Broadcast Corporation (NRK)
+ *
+ *  This is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __PARQUET_TYPES_H__
+#define __PARQUET_TYPES_H__
+
+namespace sosicon {
+
+    //! Apache Parquet file format
+    namespace parquet {
+
+        //! Physical types
+        /*!
+            The numeric values of this and the following enums are in accordance with the
+            Parquet Thrift definition (parquet.thrift).
+         */
+        enum PhysicalType {
+            physical_type_int32      = 1,
+            physical_type_int64      = 2,
+            physical_type_double     = 5,
+            physical_type_byte_array = 6
+        };
+
+        //! Value encodings
+        enum Encoding {
+            encoding_plain          = 0,
+            encoding_rle            = 3,
+            encoding_rle_dictionary = 8
+        };
+
+        //! Compression codecs
+        enum CompressionCodec {
+            compression_codec_uncompressed = 0,
+            compression_codec_snappy       = 1
+        };
+
+        //! Page types
+        enum PageType {
+            page_type_data_page       = 0,
+            page_type_dictionary_page = 2
+        };
+
+        //! Repetition of schema elements
+        enum Repetition {
+            repetition_required = 0,
+            repetition_optional = 1
+        };
+
+        //! Legacy logical type annotations
+        enum ConvertedType {
+            converted_type_utf8 = 0,
+            converted_type_date = 6
+        };
+
+        //! Members of union LogicalType
+        enum LogicalType {
+            logical_type_string = 1,
+            logical_type_date   = 6
+        };
+
+        //! Field ids of struct PageHeader
+        enum PageHeaderField {
+            page_header_type                   = 1,
+            page_header_uncompressed_page_size = 2,
+            page_header_compressed_page_size   = 3,
+            page_header_data_page_header       = 5,
+            page_header_dictionary_page_header = 7
+        };
+
+        //! Field ids of struct DataPageHeader
+        enum DataPageHeaderField {
+            data_page_header_num_values                = 1,
+            data_page_header_encoding                  = 2,
+            data_page_header_definition_level_encoding = 3,
+            data_page_header_repetition_level_encoding = 4
+        };
+
+        //! Field ids of struct DictionaryPageHeader
+        enum DictionaryPageHeaderField {
+            dictionary_page_header_num_values = 1,
+            dictionary_page_header_encoding   = 2
+        };
+
+        //! Field ids of struct Statistics
+        enum StatisticsField {
+            statistics_null_count = 3,
+            statistics_max_value  = 5,
+            statistics_min_value  = 6
+        };
+
+        //! Field ids of struct ColumnMetaData
+        enum ColumnMetaDataField {
+            column_meta_data_type                    =  1,
+            column_meta_data_encodings               =  2,
+            column_meta_data_path_in_schema          =  3,
+            column_meta_data_codec                   =  4,
+            column_meta_data_num_values              =  5,
+            column_meta_data_total_uncompressed_size =  6,
+            column_meta_data_total_compressed_size   =  7,
+            column_meta_data_data_page_offset        =  9,
+            column_meta_data_dictionary_page_offset  = 11,
+            column_meta_data_statistics              = 12
+        };
+
+        //! Field ids of struct ColumnChunk
+        enum ColumnChunkField {
+            column_chunk_file_offset = 2,
+            column_chunk_meta_data   = 3
+        };
+
+        //! Field ids of struct RowGroup
+        enum RowGroupField {
+            row_group_columns               = 1,
+            row_group_total_byte_size       = 2,
+            row_group_num_rows              = 3,
+            row_group_file_offset           = 5,
+            row_group_total_compressed_size = 6
+        };
+
+        //! Field ids of struct SchemaElement
+        enum SchemaElementField {
+            schema_element_type            =  1,
+            schema_element_repetition_type =  3,
+            schema_element_name            =  4,
+            schema_element_num_children    =  5,
+            schema_element_converted_type  =  6,
+            schema_element_logical_type    = 10
+        };
+
+        //! Field ids of struct KeyValue
+        enum KeyValueField {
+            key_value_key   = 1,
+            key_value_value = 2
+        };
+
+        //! Field ids of struct FileMetaData
+        enum FileMetaDataField {
+            file_meta_data_version            = 1,
+            file_meta_data_schema             = 2,
+            file_meta_data_num_rows           = 3,
+            file_meta_data_row_groups         = 4,
+            file_meta_data_key_value_metadata = 5,
+            file_meta_data_created_by         = 6,
+            file_meta_data_column_orders      = 7
+        };
+
+        //! Member TYPE_ORDER of union ColumnOrder
+        const short COLUMN_ORDER_TYPE_ORDER = 1;
+
+    }; // namespace parquet
+
+}; // namespace sosicon
+
+#endif
@@ -0,0 +1,510 @@
+/*
+ *  This file is part of the command-line tool sosicon.
+ *  Copyright (C) 2014  Espen Andersen, Norwegian Broadcast Corporation (NRK)
+ *
+ *  This is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <unordered_map>
+#include "parquet_writer.h"
+
+namespace {
+
+    //! Magic bytes at start and end of file
+    const char MAGIC[ 4 ] = { 'P', 'A', 'R', '1' };
+
+    //! Non-null value, as plain encoded bytes (without length prefix)
+    typedef std::pair<const char*, size_t> Value;
+
+    void appendVarint( std::string& out, uint64_t value ) {
+        while( value >= 0x80 ) {
+            out += static_cast<char>( ( value & 0x7F ) | 0x80 );
+            value >>= 7;
+        }
+        out += static_cast<char>( value );
+    }
+
+    void appendUint32( std::string& out, uint32_t value ) {
+        char buf[ 4 ];
+        sosicon::byteOrder::toLittleEndian( value, buf );
+        out.append( buf, 4 );
+    }
+
+    //! Bit-pack literal values in groups of eight
+    void flushLiteral( std::vector<uint32_t>& literal, int bitWidth, std::string& out ) {
+        if( literal.empty() ) {
+            return;
+        }
+        size_t groups = ( literal.size() + 7 ) / 8;
+        literal.resize( groups * 8, 0 );
+        appendVarint( out, ( groups << 1 ) | 1 );
+        uint64_t acc = 0;
+        int bits = 0;
+        for( std::vector<uint32_t>::iterator v = literal.begin(); v != literal.end(); v++ ) {
+            acc |= static_cast<uint64_t>( *v ) << bits;
+            bits += bitWidth;
+            while( bits >= 8 ) {
+                out += static_cast<char>( acc & 0xFF );
+                acc >>= 8;
+                bits -= 8;
+            }
+        }
+        literal.clear();
+    }
+
+    //! RLE / bit-packing hybrid encoding
+    /*!
+        Runs of eight or more equal values are run length encoded, the rest bit-packed.
+     */
+    void encodeHybrid( const std::vector<uint32_t>& values, int bitWidth, std::string& out ) {
+        std::vector<uint32_t> literal;
+        size_t n = values.size();
+        size_t i = 0;
+        while( i < n ) {
+            size_t run = 1;
+            while( i + run < n && values[ i + run ] == values[ i ] ) {
+                run++;
+            }
+            if( run >= 8 ) {
+                flushLiteral( literal, bitWidth, out );
+                appendVarint( out, run << 1 );
+                for( int b = 0; b < bitWidth; b += 8 ) {
+                    out += static_cast<char>( ( values[ i ] >> b ) & 0xFF );
+                }
+                i += run;
+            }
+            else {
+                size_t end = std::min( n, i + 8 );
+                literal.insert( literal.end(), values.begin() + i, values.begin() + end );
+                i = end;
+            }
+        }
+        flushLiteral( literal, bitWidth, out );
+    }
+
+    //! Order of plain encoded values
+    bool lessThan( sosicon::arrow::ColumnType type, const Value& a, const Value& b ) {
+        using namespace sosicon::arrow;
+        switch( type ) {
+            case column_type_int64:
+                return Array::load<int64_t>( a.first ) < Array::load<int64_t>( b.first );
+            case column_type_date32:
+                return Array::load<int32_t>( a.first ) < Array::load<int32_t>( b.first );
+            case column_type_float64:
+                return Array::load<double>( a.first ) < Array::load<double>( b.first );
+            default:
+                return std::lexicographical_compare( reinterpret_cast<const unsigned char*>( a.first ),
+                                                     reinterpret_cast<const unsigned char*>( a.first ) + a.second,
+                                                     reinterpret_cast<const unsigned char*>( b.first ),
+                                                     reinterpret_cast<const unsigned char*>( b.first ) + b.second );
+        }
+    }
+
+    //! Append plain encoded value
+    void appendPlain( sosicon::parquet::PhysicalType type, const Value& v, std::string& out ) {
+        if( sosicon::parquet::physical_type_byte_array == type ) {
+            appendUint32( out, static_cast<uint32_t>( v.second ) );
+        }
+        out.append( v.first, v.second );
+    }
+
+    //! Write page header
+    void pageHeader( sosicon::parquet::PageType type, size_t uncompressedSize, size_t compressedSize,
+                     int64_t numValues, int encoding, std::string& out ) {
+        using namespace sosicon::parquet;
+        ThriftWriter tw;
+        tw.fieldI32( page_header_type, type );
+        tw.fieldI32( page_header_uncompressed_page_size, static_cast<int32_t>( uncompressedSize ) );
+        tw.fieldI32( page_header_compressed_page_size, static_cast<int32_t>( compressedSize ) );
+        if( page_type_data_page == type ) {
+            tw.fieldStruct( page_header_data_page_header );
+            tw.fieldI32( data_page_header_num_values, static_cast<int32_t>( numValues ) );
+            tw.fieldI32( data_page_header_encoding, encoding );
+            tw.fieldI32( data_page_header_definition_level_encoding, encoding_rle );
+            tw.fieldI32( data_page_header_repetition_level_encoding, encoding_rle );
+        }
+        else {
+            tw.fieldStruct( page_header_dictionary_page_header );
+            tw.fieldI32( dictionary_page_header_num_values, static_cast<int32_t>( numValues ) );
+            tw.fieldI32( dictionary_page_header_encoding, encoding );
+        }
+        tw.structEnd();
+        tw.structEnd();
+        out += tw.data();
+    }
+
+    //! Longest min or max value kept in statistics
+    const size_t MAX_STATISTICS_SIZE = 64;
+
+};
+
+sosicon::parquet::PhysicalType sosicon::parquet::ParquetWriter::
+physicalType( const arrow::Field& field ) {
+    switch( field.mType ) {
+        case arrow::column_type_int64:
+            return physical_type_int64;
+        case arrow::column_type_float64:
+            return physical_type_double;
+        case arrow::column_type_date32:
+            return physical_type_int32;
+        default:
+            return physical_type_byte_array;
+    }
+}
+
+void sosicon::parquet::ParquetWriter::
+encodeChunk( const Leaf& leaf, const arrow::Array& array, Chunk& chunk ) const {
+    const arrow::Field& field = *leaf.mField;
+    const arrow::Array* dictionary = field.mDictionary >= 0 ? &( *mDictionaries )[ field.mDictionary ] : 0;
+    PhysicalType type = physicalType( field );
+    size_t width = field.mType == arrow::column_type_date32 ? 4 : 8;
+
+    // Non-null values and definition levels
+    std::vector<Value> values;
+    std::vector<uint32_t> levels;
+    values.reserve( static_cast<size_t>( array.mLength ) );
+    if( field.mNullable ) {
+        levels.reserve( static_cast<size_t>( array.mLength ) );
+    }
+    for( int64_t i = 0; i < array.mLength; i++ ) {
+        bool valid = array.isValid( i );
+        if( field.mNullable ) {
+            levels.push_back( valid ? 1 : 0 );
+        }
+        if( !valid ) {
+            continue;
+        }
+        Value v;
+        if( dictionary ) {
+            v.first = dictionary->bytes( array.value<int32_t>( i ), v.second );
+        }
+        else if( physical_type_byte_array == type ) {
+            v.first = array.bytes( i, v.second );
+        }
+        else {
+            v.first = &array.mValues[ static_cast<size_t>( i ) * width ];
+            v.second = width;
+        }
+        values.push_back( v );
+    }
+
+    chunk.mNumValues = array.mLength;
+    chunk.mNullCount = array.mLength - static_cast<int64_t>( values.size() );
+
+    // Statistics
+    chunk.mHasMinMax = false;
+    if( field.mType != arrow::column_type_binary && !values.empty() ) {
+        Value lo = values[ 0 ];
+        Value hi = values[ 0 ];
+        for( std::vector<Value>::iterator v = values.begin(); v != values.end(); v++ ) {
+            if( lessThan( field.mType, *v, lo ) ) {
+                lo = *v;
+            }
+            if( lessThan( field.mType, hi, *v ) ) {
+                hi = *v;
+            }
+        }
+        if( lo.second <= MAX_STATISTICS_SIZE && hi.second <= MAX_STATISTICS_SIZE ) {
+            chunk.mHasMinMax = true;
+            chunk.mMin.assign( lo.first, lo.second );
+            chunk.mMax.assign( hi.first, hi.second );
+        }
+    }
+
+    // Dictionary, in first-seen order, if values repeat
+    std::vector<uint32_t> indices;
+    std::vector<Value> distinct;
+    chunk.mDictionary = false;
+    if( field.mType != arrow::column_type_binary && field.mType != arrow::column_type_float64 && !values.empty() ) {
+        std::unordered_map<std::string, uint32_t> lookup;
+        indices.reserve( values.size() );
+        for( std::vector<Value>::iterator v = values.begin(); v != values.end(); v++ ) {
+            std::pair<std::unordered_map<std::string, uint32_t>::iterator, bool> ins =
+                lookup.insert( std::make_pair( std::string( v->first, v->second ), static_cast<uint32_t>( distinct.size() ) ) );
+            if( ins.second ) {
+                distinct.push_back( *v );
+            }
+            indices.push_back( ins.first->second );
+        }
+        chunk.mDictionary = distinct.size() * 2 <= values.size();
+    }
+
+    // Page bodies: dictionary values, then definition levels and values
+    std::string dictionaryPage;
+    std::string body;
+    if( chunk.mDictionary ) {
+        for( std::vector<Value>::iterator v = distinct.begin(); v != distinct.end(); v++ ) {
+            appendPlain( type, *v, dictionaryPage );
+        }
+    }
+    if( field.mNullable ) {
+        std::string encoded;
+        encodeHybrid( levels, 1, encoded );
+        appendUint32( body, static_cast<uint32_t>( encoded.size() ) );
+        body += encoded;
+    }
+    if( chunk.mDictionary ) {
+        int bitWidth = 1;
+        while( ( static_cast<size_t>( 1 ) << bitWidth ) < distinct.size() ) {
+            bitWidth++;
+        }
+        body += static_cast<char>( bitWidth );
+        encodeHybrid( indices, bitWidth, body );
+    }
+    else {
+        for( std::vector<Value>::iterator v = values.begin(); v != values.end(); v++ ) {
+            appendPlain( type, *v, body );
+        }
+    }
+
+    // All pages of a chunk share the codec, which is only used if it pays off
+    std::string packed[ 2 ];
+    if( chunk.mDictionary ) {
+        snappy::compress( dictionaryPage.data(), dictionaryPage.size(), packed[ 0 ] );
+    }
+    snappy::compress( body.data(), body.size(), packed[ 1 ] );
+    size_t rawSize = dictionaryPage.size() + body.size();
+    chunk.mCompressed = ( packed[ 0 ].size() + packed[ 1 ].size() ) * 8 < rawSize * 7;
+
+    std::string& out = chunk.mData;
+    out.clear();
+    size_t headers = 0;
+    if( chunk.mDictionary ) {
+        const std::string& page = chunk.mCompressed ? packed[ 0 ] : dictionaryPage;
+        pageHeader( page_type_dictionary_page, dictionaryPage.size(), page.size(),
+                    static_cast<int64_t>( distinct.size() ), encoding_plain, out );
+        headers = out.size();
+        out += page;
+    }
+    chunk.mDataPageOffset = static_cast<int64_t>( out.size() );
+    const std::string& page = chunk.mCompressed ? packed[ 1 ] : body;
+    pageHeader( page_type_data_page, body.size(), page.size(), array.mLength,
+                chunk.mDictionary ? encoding_rle_dictionary : encoding_plain, out );
+    headers += out.size() - chunk.mDataPageOffset;
+    out += page;
+    chunk.mSize = static_cast<int64_t>( out.size() );
+    chunk.mUncompressedSize = static_cast<int64_t>( headers + rawSize );
+}
+
+void sosicon::parquet::ParquetWriter::
+writeBytes( const char* data, size_t size ) {
+    mFile.write( data, size );
+    mPosition += static_cast<int64_t>( size );
+}
+
+bool sosicon::parquet::ParquetWriter::
+open( const std::string& fileName, const arrow::Schema& schema, const std::vector<arrow::Array>& dictionaries ) {
+    mFile.open( fileName.c_str(), std::ios::out | std::ios::trunc | std::ios::binary );
+    if( !mFile.is_open() ) {
+        sosicon::logstream << "Unable to create " << fileName << "\n";
+        return false;
+    }
+    mSchema = &schema;
+    mDictionaries = &dictionaries;
+    mPosition = 0;
+    mLeaves.clear();
+    mRowGroups.clear();
+    for( size_t c = 0; c < schema.mFields.size(); c++ ) {
+        const arrow::Field& field = schema.mFields[ c ];
+        Leaf leaf;
+        leaf.mColumn = c;
+        if( field.mType == arrow::column_type_struct ) {
+            for( size_t k = 0; k < field.mChildren.size(); k++ ) {
+                leaf.mField = &field.mChildren[ k ];
+                leaf.mChild = static_cast<int>( k );
+                leaf.mPath.assign( 1, field.mName );
+                leaf.mPath.push_back( field.mChildren[ k ].mName );
+                mLeaves.push_back( leaf );
+            }
+        }
+        else {
+            leaf.mField = &field;
+            leaf.mChild = -1;
+            leaf.mPath.assign( 1, field.mName );
+            mLeaves.push_back( leaf );
+        }
+    }
+    writeBytes( MAGIC, 4 );
+    return mFile.good();
+}
+
+bool sosicon::parquet::ParquetWriter::
+write( const arrow::RecordBatch& batch ) {
+    mRowGroups.push_back( RowGroup() );
+    RowGroup& rowGroup = mRowGroups.back();
+    rowGroup.mNumRows = batch.mLength;
+    rowGroup.mChunks.resize( mLeaves.size() );
+
+    // Column chunks are encoded in parallel, and written in schema order
+    std::atomic<size_t> next( 0 );
+    auto encode = [ this, &batch, &rowGroup, &next ]() {
+        for( size_t i = next++; i < mLeaves.size(); i = next++ ) {
+            const Leaf& leaf = mLeaves[ i ];
+            const arrow::Array& column = batch.mColumns[ leaf.mColumn ];
+            encodeChunk( leaf, leaf.mChild < 0 ? column : column.mChildren[ leaf.mChild ], rowGroup.mChunks[ i ] );
+        }
+    };
+    size_t threads = std::min( static_cast<size_t>( std::max( 1, mThreads ) ), mLeaves.size() );
+    std::vector<std::thread> workers;
+    for( size_t t = 1; t < threads; t++ ) {
+        workers.push_back( std::thread( encode ) );
+    }
+    encode();
+    for( std::vector<std::thread>::iterator w = workers.begin(); w != workers.end(); w++ ) {
+        w->join();
+    }
+
+    for( std::vector<Chunk>::iterator c = rowGroup.mChunks.begin(); c != rowGroup.mChunks.end(); c++ ) {
+        c->mOffset = mPosition;
+        writeBytes( c->mData.data(), c->mData.size() );
+        std::string().swap( c->mData );
+    }
+    return mFile.good();
+}
+
+void sosicon::parquet::ParquetWriter::
+writeSchemaElement( ThriftWriter& tw, const arrow::Field& field ) const {
+    tw.structBegin();
+    if( field.mType != arrow::column_type_struct ) {
+        tw.fieldI32( schema_element_type, physicalType( field ) );
+    }
+    tw.fieldI32( schema_element_repetition_type, field.mNullable ? repetition_optional : repetition_required );
+    tw.fieldBinary( schema_element_name, field.mName );
+    if( field.mType == arrow::column_type_struct ) {
+        tw.fieldI32( schema_element_num_children, static_cast<int32_t>( field.mChildren.size() ) );
+    }
+    else if( field.mType == arrow::column_type_utf8 || field.mType == arrow::column_type_date32 ) {
+        bool date = field.mType == arrow::column_type_date32;
+        tw.fieldI32( schema_element_converted_type, date ? converted_type_date : converted_type_utf8 );
+        tw.fieldStruct( schema_element_logical_type );
+        tw.fieldStruct( date ? logical_type_date : logical_type_string );
+        tw.structEnd();
+        tw.structEnd();
+    }
+    tw.structEnd();
+    for( std::vector<arrow::Field>::const_iterator c = field.mChildren.begin(); c != field.mChildren.end(); c++ ) {
+        writeSchemaElement( tw, *c );
+    }
+}
+
+void sosicon::parquet::ParquetWriter::
+writeColumnChunk( ThriftWriter& tw, const Leaf& leaf, const Chunk& chunk ) const {
+    tw.structBegin();
+    tw.fieldI64( column_chunk_file_offset, chunk.mOffset );
+    tw.fieldStruct( column_chunk_meta_data );
+    tw.fieldI32( column_meta_data_type, physicalType( *leaf.mField ) );
+    tw.fieldList( column_meta_data_encodings, ThriftWriter::type_i32, chunk.mDictionary ? 3 : 2 );
+    tw.i32( encoding_plain );
+    tw.i32( encoding_rle );
+    if( chunk.mDictionary ) {
+        tw.i32( encoding_rle_dictionary );
+    }
+    tw.fieldList( column_meta_data_path_in_schema, ThriftWriter::type_binary, leaf.mPath.size() );
+    for( std::vector<std::string>::const_iterator p = leaf.mPath.begin(); p != leaf.mPath.end(); p++ ) {
+        tw.binary( *p );
+    }
+    tw.fieldI32( column_meta_data_codec, chunk.mCompressed ? compression_codec_snappy : compression_codec_uncompressed );
+    tw.fieldI64( column_meta_data_num_values, chunk.mNumValues );
+    tw.fieldI64( column_meta_data_total_uncompressed_size, chunk.mUncompressedSize );
+    tw.fieldI64( column_meta_data_total_compressed_size, chunk.mSize );
+    tw.fieldI64( column_meta_data_data_page_offset, chunk.mOffset + chunk.mDataPageOffset );
+    if( chunk.mDictionary ) {
+        tw.fieldI64( column_meta_data_dictionary_page_offset, chunk.mOffset );
+    }
+    tw.fieldStruct( column_meta_data_statistics );
+    tw.fieldI64( statistics_null_count, chunk.mNullCount );
+    if( chunk.mHasMinMax ) {
+        tw.fieldBinary( statistics_max_value, chunk.mMax );
+        tw.fieldBinary( statistics_min_value, chunk.mMin );
+    }
+    tw.structEnd();
+    tw.structEnd();
+    tw.structEnd();
+}
+
+bool sosicon::parquet::ParquetWriter::
+close() {
+    ThriftWriter tw;
+    tw.fieldI32( file_meta_data_version, 2 );
+
+    // Schema, depth first, below a root element
+    size_t elements = 1;
+    for( std::vector<arrow::Field>::const_iterator f = mSchema->mFields.begin(); f != mSchema->mFields.end(); f++ ) {
+        elements += 1 + f->mChildren.size();
+    }
+    tw.fieldList( file_meta_data_schema, ThriftWriter::type_struct, elements );
+    tw.structBegin();
+    tw.fieldBinary( schema_element_name, "schema" );
+    tw.fieldI32( schema_element_num_children, static_cast<int32_t>( mSchema->mFields.size() ) );
+    tw.structEnd();
+    for( std::vector<arrow::Field>::const_iterator f = mSchema->mFields.begin(); f != mSchema->mFields.end(); f++ ) {
+        writeSchemaElement( tw, *f );
+    }
+
+    int64_t numRows = 0;
+    for( std::vector<RowGroup>::iterator g = mRowGroups.begin(); g != mRowGroups.end(); g++ ) {
+        numRows += g->mNumRows;
+    }
+    tw.fieldI64( file_meta_data_num_rows, numRows );
+
+    tw.fieldList( file_meta_data_row_groups, ThriftWriter::type_struct, mRowGroups.size() );
+    for( std::vector<RowGroup>::iterator g = mRowGroups.begin(); g != mRowGroups.end(); g++ ) {
+        int64_t size = 0;
+        int64_t compressedSize = 0;
+        for( std::vector<Chunk>::iterator c = g->mChunks.begin(); c != g->mChunks.end(); c++ ) {
+            size += c->mUncompressedSize;
+            compressedSize += c->mSize;
+        }
+        tw.structBegin();
+        tw.fieldList( row_group_columns, ThriftWriter::type_struct, g->mChunks.size() );
+        for( size_t i = 0; i < g->mChunks.size(); i++ ) {
+            writeColumnChunk( tw, mLeaves[ i ], g->mChunks[ i ] );
+        }
+        tw.fieldI64( row_group_total_byte_size, size );
+        tw.fieldI64( row_group_num_rows, g->mNumRows );
+        tw.fieldI64( row_group_file_offset, g->mChunks.empty() ? 0 : g->mChunks[ 0 ].mOffset );
+        tw.fieldI64( row_group_total_compressed_size, compressedSize );
+        tw.structEnd();
+    }
+
+    if( !mSchema->mMetadata.empty() ) {
+        tw.fieldList( file_meta_data_key_value_metadata, ThriftWriter::type_struct, mSchema->mMetadata.size() );
+        for( arrow::KeyValues::const_iterator kv = mSchema->mMetadata.begin(); kv != mSchema->mMetadata.end(); kv++ ) {
+            tw.structBegin();
+            tw.fieldBinary( key_value_key, kv->first );
+            tw.fieldBinary( key_value_value, kv->second );
+            tw.structEnd();
+        }
+    }
+    tw.fieldBinary( file_meta_data_created_by, "sosicon" );
+
+    // Type defined sort order, so that readers trust min and max of string columns
+    tw.fieldList( file_meta_data_column_orders, ThriftWriter::type_struct, mLeaves.size() );
+    for( size_t i = 0; i < mLeaves.size(); i++ ) {
+        tw.structBegin();
+        tw.fieldStruct( COLUMN_ORDER_TYPE_ORDER );
+        tw.structEnd();
+        tw.structEnd();
+    }
+    tw.structEnd();
+
+    std::string footer = tw.data();
+    appendUint32( footer, static_cast<uint32_t>( tw.data().size() ) );
+    footer.append( MAGIC, 4 );
+    writeBytes( footer.data(), footer.size() );
+    mFile.close();
+    return !mFile.fail();
+}
@@ -0,0 +1,146 @@
+/*
+ *  This file is part of the command-line tool sosicon.
+ *  Copyright (C) 2014  Espen Andersen, Norwegian Broadcast Corporation (NRK)
+ *
+ *  This is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __PARQUET_WRITER_H__
+#define __PARQUET_WRITER_H__
+
+#include <stdint.h>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "../interface/i_batch_writer.h"
+#include "../logger.h"
+#include "parquet_types.h"
+#include "snappy.h"
+#include "thrift_writer.h"
+
+namespace sosicon {
+
+    namespace parquet {
+
+        //! Parquet file writer
+        /*!
+            \author Espen Andersen
+            \copyright GNU General Public License
+
+            Writes each record batch as one row group, with one data page per column chunk,
+            Snappy compressed unless that saves little. Struct columns become groups of required leaf columns. Columns with
+            repeating values are dictionary encoded (RLE_DICTIONARY) and the others PLAIN,
+            with definition levels for nullable columns. The column chunks of a row group are
+            encoded in parallel. Chunk statistics hold null counts and, for all but binary
+            columns, minimum and maximum values, which lets readers skip row groups by bbox.
+         */
+        class ParquetWriter : public IBatchWriter {
+
+            //! Leaf column
+            struct Leaf {
+                const arrow::Field* mField;         //!< Leaf field
+                size_t mColumn;                     //!< Index of top level column in record batch
+                int mChild;                         //!< Index of struct member, or -1
+                std::vector<std::string> mPath;     //!< Path in schema
+            };
+
+            //! Written column chunk
+            struct Chunk {
+                std::string mData;                  //!< Encoded pages, cleared when written
+                bool mDictionary;                   //!< True if dictionary encoded
+                bool mCompressed;                   //!< True if the pages are Snappy compressed
+                int64_t mNumValues;                 //!< Number of values, nulls included
+                int64_t mNullCount;                 //!< Number of nulls
+                int64_t mOffset;                    //!< File position of first page
+                int64_t mDataPageOffset;            //!< Position of data page, relative to first page
+                int64_t mSize;                      //!< Size of pages
+                int64_t mUncompressedSize;          //!< Size of pages before compression
+                bool mHasMinMax;                    //!< True if mMin and mMax are set
+                std::string mMin;                   //!< Smallest value, plain encoded
+                std::string mMax;                   //!< Largest value, plain encoded
+            };
+
+            //! Written row group
+            struct RowGroup {
+                int64_t mNumRows;                   //!< Number of rows
+                std::vector<Chunk> mChunks;         //!< One chunk per leaf column
+            };
+
+            std::ofstream mFile;                            //!< Output file
+            int64_t mPosition;                              //!< Number of bytes written
+            int mThreads;                                   //!< Maximum number of encoding threads
+            const arrow::Schema* mSchema;                   //!< Table layout
+            const std::vector<arrow::Array>* mDictionaries; //!< Dictionaries of Arrow dictionary columns
+            std::vector<Leaf> mLeaves;                      //!< Leaf columns, in schema order
+            std::vector<RowGroup> mRowGroups;               //!< Row group metadata
+
+            //! Physical type of field
+            static PhysicalType physicalType( const arrow::Field& field );
+
+            //! Encode column chunk
+            /*!
+                Thread-safe.
+                \param leaf Leaf column.
+                \param array Column values.
+                \param chunk Receives the pages and their metadata.
+             */
+            void encodeChunk( const Leaf& leaf, const arrow::Array& array, Chunk& chunk ) const;
+
+            //! Write SchemaElement structs of field and its children
+            void writeSchemaElement( ThriftWriter& tw, const arrow::Field& field ) const;
+
+            //! Write ColumnChunk struct
+            void writeColumnChunk( ThriftWriter& tw, const Leaf& leaf, const Chunk& chunk ) const;
+
+            //! Append bytes to file
+            void writeBytes( const char* data, size_t size );
+
+        public:
+
+            //! Constructor
+            /*!
+                \param threads Maximum number of threads encoding column chunks.
+             */
+            ParquetWriter( int threads = 1 ) :
+                mPosition( 0 ), mThreads( threads ), mSchema( 0 ), mDictionaries( 0 ) { }
+
+            //! Create file
+            /*!
+                Implementation details in sosicon::IBatchWriter::open()
+                \sa sosicon::IBatchWriter::open()
+             */
+            virtual bool open( const std::string& fileName,
+                               const arrow::Schema& schema,
+                               const std::vector<arrow::Array>& dictionaries );
+
+            //! Write record batch as row group
+            /*!
+                Implementation details in sosicon::IBatchWriter::write()
+                \sa sosicon::IBatchWriter::write()
+             */
+            virtual bool write( const arrow::RecordBatch& batch );
+
+            //! Write footer and close file
+            /*!
+                Implementation details in sosicon::IBatchWriter::close()
+                \sa sosicon::IBatchWriter::close()
+             */
+            virtual bool close();
+
+        }; // class ParquetWriter
+
+    }; // namespace parquet
+
+}; // namespace sosicon
+
+#endif
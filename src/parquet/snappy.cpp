@@ -0,0 +1,121 @@
+/*
+ *  This file is part of the command-line tool sosicon.
+ *  Copyright (C) 2014  Espen Andersen, Norwegian Broadcast Corporation (NRK)
+ *
+ *  This is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <vector>
+#include "snappy.h"
+
+namespace {
+
+    //! Number of bits of the match hash
+    const int HASH_BITS = 14;
+
+    //! Largest offset of a copy with 16 bit offset
+    const size_t MAX_OFFSET = 65535;
+
+    uint32_t load32( const char* p ) {
+        uint32_t v;
+        memcpy( &v, p, 4 );
+        return v;
+    }
+
+    uint32_t hash( uint32_t v ) {
+        return ( v * 0x1e35a7bd ) >> ( 32 - HASH_BITS );
+    }
+
+    void appendLiteral( const char* data, size_t size, std::string& out ) {
+        if( size == 0 ) {
+            return;
+        }
+        size_t n = size - 1;
+        if( n < 60 ) {
+            out += static_cast<char>( n << 2 );
+        }
+        else {
+            // Tag 60 to 63: length minus one follows in 1 to 4 bytes
+            int bytes = n < 0x100 ? 1 : n < 0x10000 ? 2 : n < 0x1000000 ? 3 : 4;
+            out += static_cast<char>( ( 59 + bytes ) << 2 );
+            for( int i = 0; i < bytes; i++ ) {
+                out += static_cast<char>( ( n >> ( 8 * i ) ) & 0xFF );
+            }
+        }
+        out.append( data, size );
+    }
+
+    void appendCopy( size_t offset, size_t length, std::string& out ) {
+        // Long matches are split into copies of at most 64 bytes, keeping the last
+        // one at four bytes or more so that it may use the short form
+        while( length >= 68 ) {
+            out += static_cast<char>( 2 | ( 63 << 2 ) );
+            out += static_cast<char>( offset & 0xFF );
+            out += static_cast<char>( offset >> 8 );
+            length -= 64;
+        }
+        if( length > 64 ) {
+            out += static_cast<char>( 2 | ( 59 << 2 ) );
+            out += static_cast<char>( offset & 0xFF );
+            out += static_cast<char>( offset >> 8 );
+            length -= 60;
+        }
+        if( length >= 4 && length <= 11 && offset < 2048 ) {
+            out += static_cast<char>( 1 | ( ( length - 4 ) << 2 ) | ( ( offset >> 8 ) << 5 ) );
+            out += static_cast<char>( offset & 0xFF );
+        }
+        else {
+            out += static_cast<char>( 2 | ( ( length - 1 ) << 2 ) );
+            out += static_cast<char>( offset & 0xFF );
+            out += static_cast<char>( offset >> 8 );
+        }
+    }
+
+};
+
+void sosicon::parquet::snappy::
+compress( const char* data, size_t size, std::string& out ) {
+
+    // Uncompressed length, as varint
+    for( size_t n = size; ; n >>= 7 ) {
+        if( n < 0x80 ) {
+            out += static_cast<char>( n );
+            break;
+        }
+        out += static_cast<char>( ( n & 0x7F ) | 0x80 );
+    }
+
+    std::vector<int64_t> table( static_cast<size_t>( 1 ) << HASH_BITS, -1 );
+    size_t literal = 0;
+    size_t i = 0;
+    while( i + 4 <= size ) {
+        uint32_t v = load32( data + i );
+        int64_t& entry = table[ hash( v ) ];
+        int64_t candidate = entry;
+        entry = static_cast<int64_t>( i );
+        if( candidate < 0 || i - static_cast<size_t>( candidate ) > MAX_OFFSET || load32( data + candidate ) != v ) {
+            // Skip faster through data that does not compress
+            i += 1 + ( ( i - literal ) >> 5 );
+            continue;
+        }
+        size_t length = 4;
+        while( i + length < size && data[ candidate + length ] == data[ i + length ] ) {
+            length++;
+        }
+        appendLiteral( data + literal, i - literal, out );
+        appendCopy( i - static_cast<size_t>( candidate ), length, out );
+        i += length;
+        literal = i;
+    }
+    appendLiteral( data + literal, size - literal, out );
+}
@@ -0,0 +1,52 @@
+/*
+ *  This file is part of the command-line tool sosicon.
+ *  Copyright (C) 2014  Espen Andersen, Norwegian Broadcast Corporation (NRK)
+ *
+ *  This is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __SNAPPY_H__
+#define __SNAPPY_H__
+
+#include <string>
+#include "../byte_order.h"
+
+namespace sosicon {
+
+    namespace parquet {
+
+        //! Snappy compression
+        /*!
+            Compressor for the Snappy block format, the default codec of Parquet. Matches of
+            four bytes or more are found through a hash of the next four input bytes, as in
+            the reference implementation, and written as copies with 16 bit offsets; the
+            remaining bytes are written as literals. The output is decompressed by any
+            Snappy implementation.
+         */
+        namespace snappy {
+
+            //! Compress block
+            /*!
+                \param data First byte of input.
+                \param size Number of input bytes, less than 4 GB.
+                \param out The compressed block is appended to this string.
+             */
+            void compress( const char* data, size_t size, std::string& out );
+
+        }; // namespace snappy
+
+    }; // namespace parquet
+
+}; // namespace sosicon
+
+#endif
@@ -0,0 +1,51 @@
+/*
+ *  This file is part of the command-line tool sosicon.
+ *  Copyright (C) 2014  Espen Andersen, Norwegian Broadcast Corporation (NRK)
+ *
+ *  This is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "thrift_writer.h"
+
+void sosicon::parquet::ThriftWriter::
+varint( uint64_t value ) {
+    while( value >= 0x80 ) {
+        mBuffer += static_cast<char>( ( value & 0x7F ) | 0x80 );
+        value >>= 7;
+    }
+    mBuffer += static_cast<char>( value );
+}
+
+void sosicon::parquet::ThriftWriter::
+fieldHeader( int16_t id, Type type ) {
+    int16_t& last = mLastField.back();
+    if( id > last && id - last <= 15 ) {
+        mBuffer += static_cast<char>( ( ( id - last ) << 4 ) | type );
+    }
+    else {
+        mBuffer += static_cast<char>( type );
+        zigzag( id );
+    }
+    last = id;
+}
+
+void sosicon::parquet::ThriftWriter::
+listBegin( Type elementType, size_t size ) {
+    if( size < 15 ) {
+        mBuffer += static_cast<char>( ( size << 4 ) | elementType );
+    }
+    else {
+        mBuffer += static_cast<char>( 0xF0 | elementType );
+        varint( size );
+    }
+}
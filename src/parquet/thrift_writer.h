@@ -0,0 +1,120 @@
+/*
+ *  This file is part of the command-line tool sosicon.
+ *  Copyright (C) 2014  Espen Andersen, Norwegian Broadcast Corporation (NRK)
+ *
+ *  This is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __THRIFT_WRITER_H__
+#define __THRIFT_WRITER_H__
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace sosicon {
+
+    namespace parquet {
+
+        //! Thrift compact protocol encoder
+        /*!
+            \author Espen Andersen
+            \copyright GNU General Public License
+
+            Serializes the Thrift structures of the Parquet metadata (page headers and file
+            footer). Fields are written in increasing id order within each struct, which
+            keeps the short-form field headers (id delta in the upper four bits) in use.
+         */
+        class ThriftWriter {
+
+        public:
+
+            //! Compact protocol type codes
+            enum Type {
+                type_bool_true  =  1,
+                type_bool_false =  2,
+                type_byte       =  3,
+                type_i16        =  4,
+                type_i32        =  5,
+                type_i64        =  6,
+                type_double     =  7,
+                type_binary     =  8,
+                type_list       =  9,
+                type_struct     = 12
+            };
+
+        private:
+
+            std::string mBuffer;                //!< Serialized data
+            std::vector<int16_t> mLastField;    //!< Id of last field written, per open struct
+
+            //! Write field header
+            void fieldHeader( int16_t id, Type type );
+
+            //! Write unsigned varint
+            void varint( uint64_t value );
+
+            //! Write zigzag encoded varint
+            void zigzag( int64_t value ) { varint( ( static_cast<uint64_t>( value ) << 1 ) ^ static_cast<uint64_t>( value >> 63 ) ); }
+
+        public:
+
+            //! Constructor
+            ThriftWriter() { clear(); }
+
+            //! Discard content
+            void clear() { mBuffer.clear(); mLastField.assign( 1, 0 ); }
+
+            //! Serialized data
+            const std::string& data() const { return mBuffer; }
+
+            //! Write bool field
+            void fieldBool( int16_t id, bool value ) { fieldHeader( id, value ? type_bool_true : type_bool_false ); }
+
+            //! Write i32 field
+            void fieldI32( int16_t id, int32_t value ) { fieldHeader( id, type_i32 ); zigzag( value ); }
+
+            //! Write i64 field
+            void fieldI64( int16_t id, int64_t value ) { fieldHeader( id, type_i64 ); zigzag( value ); }
+
+            //! Write binary or string field
+            void fieldBinary( int16_t id, const std::string& value ) { fieldHeader( id, type_binary ); binary( value ); }
+
+            //! Start struct field, to be ended with structEnd()
+            void fieldStruct( int16_t id ) { fieldHeader( id, type_struct ); structBegin(); }
+
+            //! Start list field, followed by size elements
+            void fieldList( int16_t id, Type elementType, size_t size ) { fieldHeader( id, type_list ); listBegin( elementType, size ); }
+
+            //! Start struct, as list element
+            void structBegin() { mLastField.push_back( 0 ); }
+
+            //! End struct
+            void structEnd() { mBuffer += '\0'; mLastField.pop_back(); }
+
+            //! Write list header, as list element
+            void listBegin( Type elementType, size_t size );
+
+            //! Write i32, as list element
+            void i32( int32_t value ) { zigzag( value ); }
+
+            //! Write binary or string, as list element
+            void binary( const std::string& value ) { varint( value.size() ); mBuffer += value; }
+
+        }; // class ThriftWriter
+
+    }; // namespace parquet
+
+}; // namespace sosicon
+
+#endif
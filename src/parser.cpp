@@ -18,51 +18,554 @@
 #include "parser.h"
 
 sosicon::Parser::
-Parser() {
-    mCurrentCharset = sosi::SosiCharsetSingleton::getInstance();
+Parser() : mElements( 0, &mElementIndex ) {
     mPendingElementLevel = 0;
-    mElementStack.push_back( new sosi::SosiElement( "ROOT", "", "", 0, 0, mElementIndex ) );
+    mPendingCoordinateDimension = 0;
+    mStreaming = false;
+    mCache = 0;
+    mLoadedCache = 0;
+    mElementStack.push_back( mElements.append( -1, 0, "ROOT", "", "", mPendingCoordinates ) );
+    mRoot = mElementStack.front();
+    mFeatureMark = mElements.mark();
+}
+
+sosicon::Parser::
+Parser( ISosiElement* ownerRoot, const sosi::SosiCharset& charset ) : mElements( ownerRoot, &mElementIndex ) {
+    mElements.setCharset( charset );
+    mPendingElementLevel = 0;
+    mPendingCoordinateDimension = 0;
+    mStreaming = false;
+    mCache = 0;
+    mLoadedCache = 0;
+    mElementStack.push_back( mElements.append( -1, 0, "ROOT", "", "", mPendingCoordinates ) );
+    mRoot = ownerRoot;
+    mFeatureMark = mElements.mark();
 }
 
 sosicon::Parser::
 ~Parser() {
-    mElementStack.front()->deleteChildren();
-    delete mElementStack.front();
+    delete mCache;
+    for( std::deque<sosi::SosiElement*>::iterator i = mDeferredFeatures.begin(); i != mDeferredFeatures.end(); i++ ) {
+        forget( *i );
+    }
+    for( std::set<sosi::SosiElement*>::iterator i = mRetainedFeatures.begin(); i != mRetainedFeatures.end(); i++ ) {
+        forget( *i );
+    }
+    delete mLoadedCache;
 }
 
 void sosicon::Parser::
 digestPendingElement() {
-    ISosiElement* previousElement = mElementStack.back();
+    if( mPendingCoordinateDimension > 0 ) {
+        decodePendingAttributes();
+    }
     if( mPendingElementLevel > 0 ) {
 
+        if( mStreaming && mPendingElementLevel == 1 ) {
+            completeCurrentFeature();
+            mFeatureMark = mElements.mark();
+        }
+
         while( mElementStack.back()->getLevel() >= mPendingElementLevel ) {
             mElementStack.pop_back();
         }
 
-        previousElement = mElementStack.back();
-
-        ISosiElement* currentElement =
-            new sosi::SosiElement(
+        sosi::SosiElement* currentElement =
+            mElements.append(
+                mElementStack.back()->getPosition(),
+                mPendingElementLevel,
                 sosicon::utils::trim( mPendingElementName ),
                 sosicon::utils::trim( mPendingElementSerial ),
                 sosicon::utils::trim( mPendingElementAttributes ),
-                mPendingElementLevel,
-                mElementStack.front(),
-                mElementIndex );
+                mPendingCoordinates );
 
         mElementStack.push_back( currentElement );
-        previousElement->addChild( currentElement );
 
-        if( mCurrentCharset->getEncoding() == sosi::sosi_charset_undetermined &&
+        if( mElements.getCharset().getEncoding() == sosi::sosi_charset_undetermined &&
             currentElement->getType() == sosi::sosi_element_charset )
         {
-            mCurrentCharset->init( currentElement );
+            mElements.setCharset( sosi::SosiCharset( currentElement ) );
         }
     }
     mPendingElementName.clear();
     mPendingElementSerial.clear();
     mPendingElementAttributes.clear();
     mPendingElementLevel = 0;
+    mPendingCoordinates.clear();
+    mPendingCoordinateDimension = 0;
+}
+
+void sosicon::Parser::
+complete() {
+    digestPendingElement();
+    if( mStreaming ) {
+        completeCurrentFeature();
+        dispatchDeferred( true );
+    }
+}
+
+void sosicon::Parser::
+streamFeatures( FeatureEventDispatcher::Listener* listener, const char* bufferBegin, const char* bufferEnd ) {
+    mStreaming = true;
+    mFeatureDispatcher.addEventListener( listener );
+
+    // Pre-scan for REF elements, including their continuation lines, to learn which elements
+    // must be retained after dispatch.
+    std::vector<long long> serials;
+    bool inRef = false;
+    for( const char* line = bufferBegin; line < bufferEnd; ) {
+        const char* nl = static_cast<const char*>( memchr( line, '\n', bufferEnd - line ) );
+        const char* lineEnd = nl ? nl : bufferEnd;
+        const char* p = line;
+        while( p < lineEnd && utils::isTrimChar( *p ) ) {
+            p++;
+        }
+        if( p < lineEnd && *p == '.' ) {
+            while( p < lineEnd && *p == '.' ) {
+                p++;
+            }
+            inRef = lineEnd - p >= 3 && memcmp( p, "REF", 3 ) == 0 &&
+                    ( lineEnd - p == 3 || utils::isTrimChar( p[ 3 ] ) );
+            p += 3;
+        }
+        if( inRef ) {
+            const char* comment = static_cast<const char*>( memchr( p, '!', lineEnd - p ) );
+            scanReferences( p, comment ? comment : lineEnd, serials );
+        }
+        line = nl ? nl + 1 : bufferEnd;
+    }
+    for( std::vector<long long>::iterator i = serials.begin(); i != serials.end(); i++ ) {
+        mRefCount[ *i ]++;
+    }
+}
+
+void sosicon::Parser::
+completeCurrentFeature() {
+    if( mElementStack.size() > 1 ) {
+        sosi::SosiElement* feature = mElementStack[ 1 ];
+        mElementStack.resize( 1 );
+        completeFeature( feature );
+        if( feature->getType() != sosi::sosi_element_head ) {
+            mElements.release( mFeatureMark );
+        }
+    }
+}
+
+void sosicon::Parser::
+completeFeature( sosi::SosiElement* feature ) {
+    if( mCache ) {
+        mCache->write( feature );
+    }
+    if( feature->getType() == sosi::sosi_element_head ) {
+        FeatureEvent e( feature );
+        mFeatureDispatcher.Dispatch( e );
+        return;
+    }
+    std::vector<long long> serials;
+    getReferences( feature, serials );
+    if( serials.empty() ) {
+        dispatchFeature( feature );
+    }
+    else {
+        mDeferredFeatures.push_back( keep( feature ) );
+    }
+    dispatchDeferred( false );
+}
+
+void sosicon::Parser::
+dispatchDeferred( bool all ) {
+    while( !mDeferredFeatures.empty() ) {
+        sosi::SosiElement* feature = mDeferredFeatures.front();
+        std::vector<long long> serials;
+        getReferences( feature, serials );
+        if( !all ) {
+            for( std::vector<long long>::iterator i = serials.begin(); i != serials.end(); i++ ) {
+                if( 0 == mElementIndex.find( *i ) ) {
+                    return;
+                }
+            }
+        }
+        mDeferredFeatures.pop_front();
+        dispatchFeature( feature );
+        for( std::vector<long long>::iterator i = serials.begin(); i != serials.end(); i++ ) {
+            std::unordered_map<long long, int>::iterator count = mRefCount.find( *i );
+            if( count == mRefCount.end() || count->second <= 0 || --count->second > 0 ) {
+                continue;
+            }
+            sosi::SosiElement* retained = static_cast<sosi::SosiElement*>( mElementIndex.find( *i ) );
+            if( retained && mRetainedFeatures.erase( retained ) > 0 ) {
+                FeatureEvent e( retained, true );
+                mFeatureDispatcher.Dispatch( e );
+                forget( retained );
+            }
+        }
+    }
+}
+
+void sosicon::Parser::
+dispatchFeature( sosi::SosiElement* feature ) {
+    FeatureEvent e( feature );
+    mFeatureDispatcher.Dispatch( e );
+    long long serial;
+    std::unordered_map<long long, int>::iterator count = mRefCount.end();
+    if( feature->getSerialNumber( serial ) ) {
+        count = mRefCount.find( serial );
+    }
+    if( count != mRefCount.end() && count->second > 0 ) {
+        mRetainedFeatures.insert( keep( feature ) );
+    }
+    else {
+        forget( feature );
+    }
+}
+
+void sosicon::Parser::
+forget( sosi::SosiElement* feature ) {
+    sosi::SosiElementTable* table = feature->getTable();
+    for( int i = feature->getPosition(); i < feature->getEnd(); i++ ) {
+        sosi::SosiElement* e = table->at( i );
+        long long serial;
+        if( e->getSerialNumber( serial ) ) {
+            mElementIndex.erase( serial, e );
+        }
+    }
+
+    // Position 0 is taken by the root element in the tables of the parsers, so a feature
+    // found there is the only one of a table set up by keep().
+    if( 0 == feature->getPosition() ) {
+        delete table;
+    }
+}
+
+sosicon::sosi::SosiElement* sosicon::Parser::
+keep( sosi::SosiElement* feature ) {
+    if( 0 == feature->getPosition() ) {
+        return feature;
+    }
+    sosi::SosiElementTable* table = new sosi::SosiElementTable( mRoot, &mElementIndex );
+    return table->appendSubtree( feature, -1 );
+}
+
+void sosicon::Parser::
+getReferences( ISosiElement* feature, std::vector<long long>& serials ) {
+    sosi::SosiElementSearch src( sosi::sosi_element_ref );
+    while( feature->getChild( src ) ) {
+        std::string data = src.element()->getData();
+        scanReferences( data.c_str(), data.c_str() + data.size(), serials );
+    }
+}
+
+void sosicon::Parser::
+scanReferences( const char* begin, const char* end, std::vector<long long>& serials ) {
+    while( begin < end ) {
+        if( *begin++ != ':' ) {
+            continue;
+        }
+        if( begin < end && *begin == '-' ) {
+            begin++;
+        }
+        const char* digits = begin;
+        while( begin < end && *begin >= '0' && *begin <= '9' ) {
+            begin++;
+        }
+        long long serial;
+        if( sosi::SosiElementIndex::parseSerial( digits, begin, serial ) ) {
+            serials.push_back( serial );
+        }
+    }
+}
+
+void sosicon::Parser::
+assignToken( std::string& target, const char* begin, const char* end ) {
+    target.clear();
+    appendToken( target, begin, end );
+}
+
+void sosicon::Parser::
+appendToken( std::string& target, const char* begin, const char* end ) {
+    if( !begin || end <= begin ) {
+        return;
+    }
+    while( begin < end && utils::isTrimChar( *begin ) ) {
+        begin++;
+    }
+    while( end > begin && utils::isTrimChar( *( end - 1 ) ) ) {
+        end--;
+    }
+    if( !memchr( begin, '\r', end - begin ) ) {
+        target.append( begin, end );
+    }
+    else {
+        for( ; begin < end; begin++ ) {
+            if( '\r' != *begin ) {
+                target += *begin;
+            }
+        }
+    }
+}
+
+const char* sosicon::Parser::
+decodeCoordinates( const char* begin, const char* end ) {
+    while( begin < end ) {
+        if( utils::isTrimChar( *begin ) ) {
+            begin++;
+            continue;
+        }
+        const char* token = begin;
+        bool negative = *begin == '-';
+        if( negative ) {
+            begin++;
+        }
+        const char* digits = begin;
+        long long value = 0;
+        while( begin < end && *begin >= '0' && *begin <= '9' ) {
+            value = value * 10 + ( *begin++ - '0' );
+        }
+        if( begin == digits ||
+            ( begin < end && !utils::isTrimChar( *begin ) && *begin != '.' && *begin != '!' ) )
+        {
+            return token;
+        }
+        mPendingCoordinates.push_back( negative ? -value : value );
+    }
+    return end;
+}
+
+const char* sosicon::Parser::
+decodeCoordinateLine( const char* lineBegin, const char* lineEnd ) {
+    decodePendingAttributes();
+    if( 0 == mPendingCoordinateDimension ) {
+        return lineBegin;
+    }
+    sosi::NorthEastArray::size_type lineStart = mPendingCoordinates.size();
+    const char* stop = decodeCoordinates( lineBegin, lineEnd );
+    if( stop == lineEnd || *stop == '!' ) {
+        return lineEnd;
+    }
+    if( *stop == '.' ) {
+        return stop;
+    }
+
+    // Not a coordinate line. Turn the values decoded so far into text, and let the line
+    // parser handle the rest of the element.
+    mPendingCoordinates.resize( lineStart );
+    mPendingCoordinateDimension = 0;
+    char buf[ 24 ];
+    for( sosi::NorthEastArray::iterator i = mPendingCoordinates.begin(); i != mPendingCoordinates.end(); i++ ) {
+        snprintf( buf, sizeof buf, i == mPendingCoordinates.begin() ? "%lld" : " %lld", *i );
+        mPendingElementAttributes += buf;
+    }
+    mPendingCoordinates.clear();
+    return lineBegin;
+}
+
+void sosicon::Parser::
+decodePendingAttributes() {
+    if( mPendingElementAttributes.empty() ) {
+        return;
+    }
+    const char* begin = mPendingElementAttributes.c_str();
+    const char* end = begin + mPendingElementAttributes.size();
+    if( decodeCoordinates( begin, end ) == end ) {
+        mPendingElementAttributes.clear();
+    }
+    else {
+        mPendingCoordinates.clear();
+        mPendingCoordinateDimension = 0;
+    }
+}
+
+const char* sosicon::Parser::
+nextTopLevelElement( const char* lineBegin, const char* bufferEnd ) {
+    while( lineBegin < bufferEnd ) {
+        if( *lineBegin == '.' && lineBegin + 1 < bufferEnd && lineBegin[ 1 ] != '.' ) {
+            return lineBegin;
+        }
+        const char* nl = static_cast<const char*>( memchr( lineBegin, '\n', bufferEnd - lineBegin ) );
+        lineBegin = nl ? nl + 1 : bufferEnd;
+    }
+    return bufferEnd;
+}
+
+void sosicon::Parser::
+adoptShard( Parser& shard ) {
+    if( !mStreaming ) {
+        mElements.appendTable( shard.mElements, 0 );
+        return;
+    }
+    mElementIndex.merge( shard.mElementIndex );
+    sosi::SosiElementTable& elements = shard.mElements;
+    for( int i = 1; i < elements.size(); i = elements.at( i )->getEnd() ) {
+        completeFeature( elements.at( i ) );
+    }
+}
+
+int sosicon::Parser::
+parseParallel( const char* bufferBegin, const char* bufferEnd, int threads ) {
+
+    // The header is parsed on this thread, so that the character set is determined before
+    // any worker starts constructing elements.
+    const char* headerEnd = nextTopLevelElement( bufferBegin, bufferEnd );
+    if( headerEnd < bufferEnd ) {
+        const char* nl = static_cast<const char*>( memchr( headerEnd, '\n', bufferEnd - headerEnd ) );
+        headerEnd = nl ? nextTopLevelElement( nl + 1, bufferEnd ) : bufferEnd;
+    }
+    int lineCount = ragelParseSosi( bufferBegin, headerEnd );
+    digestPendingElement();
+    if( mStreaming ) {
+        completeCurrentFeature();
+    }
+
+    if( threads < 2 || headerEnd == bufferEnd ||
+        mElements.getCharset().getEncoding() == sosi::sosi_charset_undetermined )
+    {
+        return lineCount + ragelParseSosi( headerEnd, bufferEnd );
+    }
+
+    // Split remaining content into shards of roughly equal size, each starting at a top-level
+    // element. Several shards per thread evens out differences in parsing cost. In streaming
+    // mode, shards are kept small and parsed one wave at a time, so that only a few shards'
+    // worth of elements are in memory at once.
+    std::vector<const char*> bounds;
+    const size_t shardCount = static_cast<size_t>( threads ) * 4;
+    size_t shardSize = ( bufferEnd - headerEnd ) / shardCount + 1;
+    if( mStreaming && shardSize > 1048576 ) {
+        shardSize = 1048576;
+    }
+    bounds.push_back( headerEnd );
+    while( bounds.back() < bufferEnd ) {
+        const char* split = bounds.back() + shardSize;
+        if( split >= bufferEnd ) {
+            bounds.push_back( bufferEnd );
+        }
+        else {
+            const char* nl = static_cast<const char*>( memchr( split, '\n', bufferEnd - split ) );
+            bounds.push_back( nl ? nextTopLevelElement( nl + 1, bufferEnd ) : bufferEnd );
+        }
+    }
+
+    const size_t n = bounds.size() - 1;
+    std::vector<Parser*> shards( n, static_cast<Parser*>( 0 ) );
+    std::vector<int> shardLines( n, 0 );
+    const size_t waveSize = mStreaming ? shardCount : n;
+
+    for( size_t first = 0; first < n; first += waveSize ) {
+        const size_t last = std::min( n, first + waveSize );
+        std::atomic<size_t> nextShard( first );
+        std::vector<std::thread> workers;
+        for( int t = 0; t < threads && first + static_cast<size_t>( t ) < last; t++ ) {
+            workers.push_back( std::thread( [ & ]() {
+                for( size_t i = nextShard++; i < last; i = nextShard++ ) {
+                    shards[ i ] = new Parser( mRoot, mElements.getCharset() );
+                    shardLines[ i ] = shards[ i ]->ragelParseSosi( bounds[ i ], bounds[ i + 1 ] );
+                    shards[ i ]->complete();
+                }
+            } ) );
+        }
+        for( std::vector<std::thread>::iterator w = workers.begin(); w != workers.end(); w++ ) {
+            w->join();
+        }
+        for( size_t i = first; i < last; i++ ) {
+            adoptShard( *shards[ i ] );
+            lineCount += shardLines[ i ];
+            delete shards[ i ];
+        }
+    }
+
+    return lineCount;
+}
+
+bool sosicon::Parser::
+loadCache( std::string sourceFile, const char* bufferBegin, const char* bufferEnd, int& lineCount, bool verifyContent ) {
+    delete mCache;
+    mCache = 0;
+    SosiCache* cache = new SosiCache( sourceFile );
+    if( cache->open( bufferBegin, bufferEnd, verifyContent ) ) {
+        if( loadImage( *cache ) ) {
+            lineCount = cache->lineCount();
+            delete mLoadedCache;
+            mLoadedCache = cache;
+            return true;
+        }
+        sosicon::logstream << SosiCache::cacheFileName( sourceFile ) << " is damaged, parsing instead\n";
+        delete cache;
+        cache = new SosiCache( sourceFile );
+    }
+    if( cache->create( bufferBegin, bufferEnd, verifyContent ) ) {
+        mCache = cache;
+    }
+    else {
+        delete cache;
+    }
+    return false;
+}
+
+bool sosicon::Parser::
+loadImage( SosiCache& cache ) {
+    const sosi::SosiElementTable::ImageRecord* records = cache.records();
+    const int n = cache.recordCount();
+    mElements.setCharset( sosi::SosiCharset( cache.charsetName() ) );
+    mElements.setHeaderSettings( cache.headerSettings() );
+
+    if( !mStreaming ) {
+        const SosiCache::IndexEntry* index = cache.index();
+        const size_t indexCount = cache.indexCount();
+        for( size_t i = 0; i < indexCount; i++ ) {
+            if( index[ i ].position < 1 || index[ i ].position > n ) {
+                return false;
+            }
+        }
+        if( n > 0 && !mElements.appendImage( records, n, 1, cache.arena(), cache.arenaSize(), 0, false ) ) {
+            return false;
+        }
+        mElementIndex.reserve( indexCount );
+        for( size_t i = 0; i < indexCount; i++ ) {
+            mElementIndex.insert( index[ i ].serial, mElements.at( static_cast<int>( index[ i ].position ) ) );
+        }
+        return true;
+    }
+
+    // Features are appended one at a time, and dispatched when the next one is appended, just
+    // as digestPendingElement() does.
+    for( int i = 0; i < n; ) {
+        const int count = records[ i ].end - ( i + 1 );
+        sosi::SosiElement* feature = 0;
+        if( count > 0 && count <= n - i ) {
+            completeCurrentFeature();
+            mFeatureMark = mElements.mark();
+            feature = mElements.appendImage( records + i, count, i + 1, cache.arena(), cache.arenaSize(), 0, true );
+        }
+        if( !feature ) {
+            if( 0 == i ) {
+                return false;
+            }
+            std::string cacheFile = cache.cacheFile();
+            std::remove( cacheFile.c_str() );
+            throw std::runtime_error( cacheFile + " is damaged and has been removed, please run again" );
+        }
+        mElementStack.push_back( feature );
+        i += count;
+    }
+    return true;
+}
+
+void sosicon::Parser::
+commitCache( int lineCount ) {
+    if( !mCache ) {
+        return;
+    }
+    if( !mStreaming ) {
+        sosi::SosiElementSearch src;
+        while( mRoot->getChild( src ) ) {
+            mCache->write( static_cast<sosi::SosiElement*>( src.element() ) );
+        }
+    }
+    sosi::HeaderContext header( mRoot );
+    if( !mCache->commit( lineCount, header.getSettings(), mElements.getCharset().getEncodingName() ) ) {
+        sosicon::logstream << "Could not write cache file\n";
+    }
+    delete mCache;
+    mCache = 0;
 }
 
 void sosicon::Parser::
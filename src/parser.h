@@ -24,10 +24,21 @@
 #include <sstream>
 #include <vector>
 #include <map>
+#include <set>
+#include <unordered_map>
+#include <deque>
+#include <thread>
+#include <atomic>
+#include <stdexcept>
 #include "utils.h"
 #include "command_line.h"
+#include "mapped_file.h"
+#include "feature_event.h"
+#include "sosi_cache.h"
 #include "sosi/sosi_element.h"
-#include "sosi/sosi_charset_singleton.h"
+#include "sosi/sosi_element_table.h"
+#include "sosi/sosi_charset.h"
+#include "sosi/sosi_header_context.h"
 #include "interface/i_sosi_element.h"
 
 namespace sosicon {
@@ -39,10 +50,10 @@ namespace sosicon {
 
         The file parser. Reads and organizes SOSI file input, preparing the data for conversion
         and output. This class wraps a Ragel-generated state machine set up to parse SOSI content
-        line-by-line. For more information about the Ragel state machine compiler, visit
+        line-by-line, directly from the input buffer. For more information about the Ragel state machine compiler, visit
         http://www.complang.org/ragel/
         
-        Specifically, the function parseSosiLine() is implemented in Ragel. The implementation
+        Specifically, the function ragelParseSosi() is implemented in Ragel. The implementation
         script is located in parser/parser_sosi_line.rl. The file parser_ragel.cpp is generated
         on the basis of parser/parser.rl during pre-build processing.
         
@@ -58,20 +69,77 @@ namespace sosicon {
             is inserted at the front of the stack. When the parser has completed, the stack should
             contain the root element only.
          */
-        std::vector<ISosiElement*> mElementStack;
+        std::vector<sosi::SosiElement*> mElementStack;
+
+        //! Root element
+        /*!
+            Root of the element tree. Normally the first element of the working stack, but when
+            the parser works on a shard of a file parsed in parallel, this is the root element of
+            the owning parser.
+         */
+        ISosiElement* mRoot;
 
         //! Index
         /*!
             Index elements by serial number. Lookup table to resolve SOSI references (REF element).
          */
-        sosi::SosiElementMap mElementIndex;
+        sosi::SosiElementIndex mElementIndex;
+
+        //! Element tree
+        /*!
+            All elements parsed, starting with the root element, in file order. In streaming
+            mode, the table holds the root, the file header and the feature being parsed only.
+         */
+        sosi::SosiElementTable mElements;
+
+        //! Table state at the beginning of the feature being parsed in streaming mode
+        /*!
+            The table is released to this state when the feature has been dispatched.
+         */
+        sosi::SosiElementTable::Mark mFeatureMark;
+
+        //! Streaming mode flag
+        /*!
+            If true, top-level elements are dispatched to the feature listeners as soon as they
+            are complete, and freed afterwards, instead of being kept in the element tree. Only
+            the file header remains in the tree.
+         */
+        bool mStreaming;
 
-        //! Current character encoding
+        //! Feature listeners in streaming mode
+        FeatureEventDispatcher mFeatureDispatcher;
+
+        //! Pending REF targets
+        /*!
+            Serial number of every element referred to by a REF element in the file, mapped to
+            the number of references not yet dispatched. Filled by a quick pre-scan of the file
+            when streaming mode is enabled. Elements listed here are retained after dispatch
+            until the last feature referring to them has been dispatched.
+         */
+        std::unordered_map<long long, int> mRefCount;
+
+        //! Features dispatched, but retained as REF targets
+        std::set<sosi::SosiElement*> mRetainedFeatures;
+
+        //! Features waiting for REF targets
+        /*!
+            Features with REF elements are dispatched when all their REF targets have been
+            parsed, or when the file is complete. They are dispatched in file order.
+         */
+        std::deque<sosi::SosiElement*> mDeferredFeatures;
+
+        //! Binary cache being written, if any
+        /*!
+            Set up by loadCache() when there is no valid cache for the file being parsed.
+         */
+        SosiCache* mCache;
+
+        //! Binary cache the elements were loaded from, if any
         /*!
-            Character encoding of current file in process. Remains undetermined until the
-            TEGNSETT head element is encountered.
+            The elements refer to the texts and coordinates of the mapped cache in place, so
+            the cache is kept open until the parser is destroyed.
          */
-        sosi::SosiCharsetSingleton* mCurrentCharset;
+        SosiCache* mLoadedCache;
 
         //! SOSI level of element currently in parser
         /*!
@@ -97,6 +165,28 @@ namespace sosicon {
          */
         std::string mPendingElementAttributes;
 
+        //! Coordinate dimension of element currently in parser
+        /*!
+            2 or 3 while the parser is inside a N or NH element whose data are plain integer
+            coordinates, otherwise 0. Continuation lines of such elements are decoded directly
+            into mPendingCoordinates instead of being collected as text.
+         */
+        int mPendingCoordinateDimension;
+
+        //! Coordinate values of element currently in parser
+        /*!
+            Intermediate storage member. Copied to the element on digestion, and then cleared
+            with its capacity kept for the next coordinate element.
+         */
+        sosi::NorthEastArray mPendingCoordinates;
+
+        //! Line copy buffer
+        /*!
+            Holds a terminated copy of the last line of the input when the file does not end
+            with a line break. All other lines are parsed directly from the input buffer.
+         */
+        std::string mLineBuffer;
+
         //! Save current SOSI element
         /*!
             The parser stores intermediate data in the mPendingElementXXX member variables. When 
@@ -105,6 +195,135 @@ namespace sosicon {
          */
         void digestPendingElement();
 
+        //! Copy token from input buffer
+        /*!
+            Assigns the text in [begin, end) to target, with leading and trailing white space
+            removed.
+         */
+        static void assignToken( std::string& target, const char* begin, const char* end );
+
+        //! Append token from input buffer
+        /*!
+            Appends the text in [begin, end) to target, with leading and trailing white space
+            removed. Carriage returns within the token are dropped.
+         */
+        static void appendToken( std::string& target, const char* begin, const char* end );
+
+        //! Decode integer values into mPendingCoordinates
+        /*!
+            Reads white-space separated integers from [begin, end).
+            \return Pointer to the first byte of the first token that is not an integer, or end.
+         */
+        const char* decodeCoordinates( const char* begin, const char* end );
+
+        //! Decode continuation line of N or NH element
+        /*!
+            Fast path for coordinate lines, bypassing the line parser. The integers of the line
+            are appended to mPendingCoordinates. Anything after a comment (!) is ignored. If the
+            line holds anything else than integers, the element falls back to collecting its data
+            as text, like any other element.
+            \param lineBegin Pointer to the first byte of the line.
+            \param lineEnd Pointer to one past the last byte of the line.
+            \return Pointer to the first byte left for the line parser: lineEnd if the line was
+                    fully decoded, the beginning of the next element on the line, or lineBegin if
+                    the element fell back to text.
+         */
+        const char* decodeCoordinateLine( const char* lineBegin, const char* lineEnd );
+
+        //! Decode data given on the N or NH element line
+        /*!
+            Moves the values in mPendingElementAttributes to mPendingCoordinates. If they are not
+            plain integers, the element falls back to text.
+         */
+        void decodePendingAttributes();
+
+        //! Find next top-level element
+        /*!
+            Scans the buffer line by line from lineBegin, looking for a line that starts a
+            top-level element (one leading dot, such as .KURVE or .FLATE).
+            \param lineBegin Pointer to the beginning of a line.
+            \param bufferEnd Pointer to one past the last byte of the buffer.
+            \return Pointer to the beginning of the top-level element line, or bufferEnd.
+         */
+        static const char* nextTopLevelElement( const char* lineBegin, const char* bufferEnd );
+
+        //! Shard constructor
+        /*!
+            Creates a parser for a section of a file parsed in parallel. The elements are built
+            under a temporary root of the shard parser, but refer to the root of the owner.
+            \param ownerRoot Root element of the parser that will adopt the parsed elements.
+            \param charset Character set of the file, given by its header.
+         */
+        Parser( ISosiElement* ownerRoot, const sosi::SosiCharset& charset );
+
+        //! Handle complete top-level element in streaming mode
+        /*!
+            The element is dispatched to the feature listeners (or deferred if it refers to
+            elements not yet parsed), and freed unless it is needed later as a REF target. The
+            file header is dispatched and kept in the element tree.
+         */
+        void completeFeature( sosi::SosiElement* feature );
+
+        //! Complete top-level element on the working stack, if any
+        void completeCurrentFeature();
+
+        //! Dispatch deferred features
+        /*!
+            \param all If false, dispatching stops at the first feature with unresolved REF
+                   targets. If true, all deferred features are dispatched.
+         */
+        void dispatchDeferred( bool all );
+
+        //! Dispatch feature to listeners and release it
+        void dispatchFeature( sosi::SosiElement* feature );
+
+        //! Free top-level element
+        /*!
+            Removes the element and its children from the serial number index. If the element
+            was copied by keep(), its table is deleted. Otherwise the element stays in its table
+            until the table is released or deleted.
+         */
+        void forget( sosi::SosiElement* feature );
+
+        //! Keep top-level element beyond the parsing of the next one
+        /*!
+            Copies the element and its children to a table of their own, unless already done.
+            \return Pointer to the copy.
+         */
+        sosi::SosiElement* keep( sosi::SosiElement* feature );
+
+        //! Get serial numbers referred to by feature
+        static void getReferences( ISosiElement* feature, std::vector<long long>& serials );
+
+        //! Extract serial numbers from REF element data
+        /*!
+            Picks the serial numbers from REF data such as ":12 :-13 (:14)".
+            \param begin Pointer to the first byte of the REF data.
+            \param end Pointer to one past the last byte of the REF data.
+            \param serials Receives the serial numbers, without sign.
+         */
+        static void scanReferences( const char* begin, const char* end, std::vector<long long>& serials );
+
+        //! Append elements of binary cache
+        /*!
+            Appends the element records of the cache to the element table, and restores the
+            serial number index, character set and header settings stored with them. In
+            streaming mode, the elements are appended and dispatched one feature at a time,
+            and the index is maintained as if they were parsed.
+            \param cache Cache opened for reading.
+            \return False if the cache is damaged, in which case no elements were loaded.
+         */
+        bool loadImage( SosiCache& cache );
+
+        //! Take over elements parsed by shard parser
+        /*!
+            Moves the shard's top-level elements to the element table of this parser in file
+            order. In streaming mode, the shard's serial number index is merged with this
+            parser's index instead, and the shard's top-level elements are passed to
+            completeFeature().
+         */
+        void adoptShard( Parser& shard );
+
     public:
 
         //! Constructor
@@ -120,7 +339,60 @@ namespace sosicon {
         ~Parser();
 
         //! Flush parsed data
-        void complete() { digestPendingElement(); };
+        /*!
+            Digests the last pending element. In streaming mode, the last feature and any
+            deferred features are dispatched.
+         */
+        void complete();
+
+        //! Enable streaming mode
+        /*!
+            Instead of building the complete element tree, the parser hands each top-level
+            element (feature) to the listener as soon as it is complete, and frees it afterwards.
+            Memory consumption is thus bounded by the size of the largest feature, plus the
+            features that are retained as REF targets for surfaces yet to be dispatched. To find
+            those, the file is pre-scanned for REF elements. The file header is kept in the tree,
+            so that getRootElement() still gives access to header information.
+
+            Features are dispatched in file order, except features with REF elements, which are
+            held back until all referenced elements have been parsed.
+
+            This function does not parse the buffer. Call ragelParseSosi() or parseParallel()
+            afterwards as usual, and complete() at the end.
+
+            \param listener Receiver of FeatureEvent for each feature.
+            \param bufferBegin Pointer to the first byte of the complete file.
+            \param bufferEnd Pointer to one past the last byte of the complete file.
+         */
+        void streamFeatures( FeatureEventDispatcher::Listener* listener, const char* bufferBegin, const char* bufferEnd );
+
+        //! Load elements from binary cache
+        /*!
+            If caching is wanted, call this function before parsing. If there is a valid cache
+            (.sosc) for the SOSI file, the elements are loaded from it, with the same result as
+            if they were parsed, and the file need not be parsed. The element records are
+            copied from the mapped cache, while their texts and coordinates are used in place.
+            Otherwise a new cache is set up, which receives the elements as the file is parsed,
+            and is written by commitCache().
+
+            \param sourceFile Path to the SOSI file.
+            \param bufferBegin Pointer to the first byte of the SOSI file.
+            \param bufferEnd Pointer to one past the last byte of the SOSI file.
+            \param lineCount Receives the number of lines in the SOSI file, if loaded from cache.
+            \param verifyContent If true, the cache is validated by a content hash of the SOSI
+                   file as well, and a new cache stores one. Otherwise the size and modification
+                   time of the SOSI file are trusted.
+            \return True if the elements were loaded from cache.
+         */
+        bool loadCache( std::string sourceFile, const char* bufferBegin, const char* bufferEnd, int& lineCount, bool verifyContent = true );
+
+        //! Write binary cache
+        /*!
+            Call after complete(), when the whole file has been parsed. Does nothing unless a
+            new cache was set up by loadCache().
+            \param lineCount Number of lines parsed.
+         */
+        void commitCache( int lineCount );
 
         //! Debug output
         void dump();
@@ -130,17 +402,40 @@ namespace sosicon {
 
         //! Main parser routine
         /*!
-            Processes one line from the SOSI file. This function is called repeatedly, consuming
-            the input file line-by-line until EOF.
+            Processes a block of SOSI file content. The block is a pointer range into the input
+            buffer (typically a MappedFile), and must start at the beginning of a line. If it
+            does not end with a line break, the last line is taken to be the last line of the
+            file. The block is parsed in place: element names, serial numbers and attributes
+            are located as spans in the input, and copied out once per element rather than
+            character by character. Pending element data is kept across calls, so a file may
+            be fed to the parser in several consecutive blocks.
+
+            \note This function is implemented in the ragel script at ragel/parser.rl, the c++
+                  file parser_ragel.cpp is merely generated from the ragel script. Thus, any
+                  changes to the implementation must be done in the ragel script, since the c++
+                  file will be automatically overwritten during the pre-build process.
 
-            \note This function is implemented in the ragel script at ragel/parser_sosi_line.rl,
-                  the c++ file parser_sosi_line.cpp is merely generated from the ragel script.
-                  Thus, any changes to the implementation must be done in the ragel script, since
-                  the c++ file will be automatically overwritten during the pre-build process.
+            \param bufferBegin Pointer to the first byte of the block.
+            \param bufferEnd Pointer to one past the last byte of the block.
+            \return Number of lines parsed.
+         */
+        int ragelParseSosi( const char* bufferBegin, const char* bufferEnd );
+
+        //! Parallel parser routine
+        /*!
+            Parses a complete SOSI file using several threads. The file header is parsed first,
+            then the rest of the file is split into shards at top-level elements. The shards are
+            parsed by separate parser instances on a pool of worker threads, and merged in file
+            order. The resulting element tree and index are identical to those produced by
+            ragelParseSosi() on the same buffer. In streaming mode, the shards are processed a
+            few at a time, and their features dispatched in file order.
 
-            \param sosiLine Current line from the SOSI input file.
+            \param bufferBegin Pointer to the first byte of the file.
+            \param bufferEnd Pointer to one past the last byte of the file.
+            \param threads Number of worker threads.
+            \return Number of lines parsed.
          */
-        void ragelParseSosiLine( std::string sosiLine );
+        int parseParallel( const char* bufferBegin, const char* bufferEnd, int threads );
         
     };
 };
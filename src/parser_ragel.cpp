@@ -135,30 +135,75 @@ static const int parseSosiLine_en_main = 7;
 
 }
 
-void sosicon::Parser::
-ragelParseSosiLine( std::string sosiLine )
+int sosicon::Parser::
+ragelParseSosi( const char* bufferBegin, const char* bufferEnd )
 {
 
-    sosiLine += "\r\n";
-
  /* Variables used by Ragel */
 
     int cs = 0;
-    const char* s = sosiLine.c_str();
-    const char* p = s;
-    const char* pe = p + sosiLine.size();
-    const char* eof = pe;
+    const char* p = 0;
+    const char* pe = 0;
+    const char* eof = 0;
 
-    std::string tmpstr;
+    const char* tokenBegin = 0;
+    const char* tokenEnd = 0;
     int tmpint = 0;
 
+    int lineCount = 0;
+    const char* lineBegin = bufferBegin;
+
+    while( lineBegin < bufferEnd ) {
+
+        // The machine is restarted on each line rather than run once over the whole buffer:
+        // - Comments (!) are skipped by letting the machine fail for the remainder of the line.
+        //   Over the whole buffer, a failure would end the buffer, so the grammar would need
+        //   explicit comment states in every element rule.
+        // - Coordinate lines of N and NH elements are decoded below without the machine,
+        //   which would otherwise have to hand control back in the middle of the buffer.
+        // - The generated parser_ragel.cpp is checked in, and the tree has Ragel binaries
+        //   for OS X and Windows only, so a new grammar cannot be generated and verified on
+        //   every platform.
+        // A restart costs a memchr and a few assignments, without allocation or copying.
+        // Element data carries over in the mPendingElementXXX members. Only an unterminated
+        // last line is copied, to give it the line break expected by the machine.
+        const char* lineEnd = static_cast<const char*>( memchr( lineBegin, '\n', bufferEnd - lineBegin ) );
+        const char* dataBegin = lineBegin;
+        lineCount++;
+
+        // Coordinate lines of N and NH elements are decoded without the machine. It only
+        // gets to see the rest of the line if another element starts on it.
+        if( mPendingCoordinateDimension > 0 ) {
+            const char* dataEnd = lineEnd ? lineEnd + 1 : bufferEnd;
+            dataBegin = decodeCoordinateLine( lineBegin, dataEnd );
+            if( dataBegin == dataEnd ) {
+                lineBegin = dataEnd;
+                continue;
+            }
+        }
+
+        if( lineEnd ) {
+            p = dataBegin;
+            pe = ++lineEnd;
+        }
+        else {
+            mLineBuffer.assign( dataBegin, bufferEnd );
+            mLineBuffer += "\r\n";
+            p = mLineBuffer.c_str();
+            pe = p + mLineBuffer.size();
+            lineEnd = bufferEnd;
+        }
+        eof = pe;
+        tokenBegin = tokenEnd = 0;
+        tmpint = 0;
+
     
-/* #line 157 "parser_ragel.cpp" */
+/* #line 194 "parser_ragel.cpp" */
 	{
 	cs = parseSosiLine_start;
 	}
 
-/* #line 162 "parser_ragel.cpp" */
+/* #line 199 "parser_ragel.cpp" */
 	{
 	int _klen;
 	unsigned int _trans;
@@ -233,72 +278,75 @@ _match:
 		switch ( *_acts++ )
 		{
 	case 0:
-/* #line 51 "ragel/parser.rl" */
+/* #line 88 "ragel/parser.rl" */
 	{
-            if( '\r' != (*p) ) {
-                tmpstr += (*p);
+            if( !tokenBegin ) {
+                tokenBegin = p;
             }
+            tokenEnd = p + 1;
         }
 	break;
 	case 1:
-/* #line 57 "ragel/parser.rl" */
+/* #line 95 "ragel/parser.rl" */
 	{
-            tmpstr.clear();
+            tokenBegin = tokenEnd = 0;
         }
 	break;
 	case 2:
-/* #line 61 "ragel/parser.rl" */
+/* #line 99 "ragel/parser.rl" */
 	{
             tmpint++;
         }
 	break;
 	case 3:
-/* #line 65 "ragel/parser.rl" */
+/* #line 103 "ragel/parser.rl" */
 	{
             tmpint = 0;
         }
 	break;
 	case 4:
-/* #line 69 "ragel/parser.rl" */
+/* #line 107 "ragel/parser.rl" */
 	{
-            mPendingElementName = sosicon::utils::trim( tmpstr );
+            assignToken( mPendingElementName, tokenBegin, tokenEnd );
+            mPendingCoordinateDimension = sosi::northEastDimension( mPendingElementName );
         }
 	break;
 	case 5:
-/* #line 73 "ragel/parser.rl" */
+/* #line 112 "ragel/parser.rl" */
 	{
-            mPendingElementAttributes = sosicon::utils::trim( tmpstr );
-            tmpstr.clear();
+            assignToken( mPendingElementAttributes, tokenBegin, tokenEnd );
+            tokenBegin = tokenEnd = 0;
         }
 	break;
 	case 6:
-/* #line 78 "ragel/parser.rl" */
+/* #line 117 "ragel/parser.rl" */
 	{
-            mPendingElementAttributes += ( " " + sosicon::utils::trim( tmpstr ) );
-            tmpstr.clear();
+            mPendingElementAttributes += ' ';
+            appendToken( mPendingElementAttributes, tokenBegin, tokenEnd );
+            tokenBegin = tokenEnd = 0;
         }
 	break;
 	case 7:
-/* #line 83 "ragel/parser.rl" */
+/* #line 123 "ragel/parser.rl" */
 	{
             mPendingElementLevel = tmpint;
-            tmpstr.clear();
+            tokenBegin = tokenEnd = 0;
         }
 	break;
 	case 8:
-/* #line 88 "ragel/parser.rl" */
+/* #line 128 "ragel/parser.rl" */
 	{
-            mPendingElementSerial = tmpstr.substr( 0, tmpstr.length() - 1 );
-            tmpstr.clear();
+            assignToken( mPendingElementSerial, tokenBegin, tokenEnd - 1 );
+            tokenBegin = tokenEnd = 0;
         }
 	break;
 	case 9:
-/* #line 93 "ragel/parser.rl" */
+/* #line 133 "ragel/parser.rl" */
 	{
             digestPendingElement();
         }
 	break;
-/* #line 302 "parser_ragel.cpp" */
+/* #line 342 "parser_ragel.cpp" */
 		}
 	}
 
@@ -315,25 +363,27 @@ _again:
 	while ( __nacts-- > 0 ) {
 		switch ( *__acts++ ) {
 	case 1:
-/* #line 57 "ragel/parser.rl" */
+/* #line 95 "ragel/parser.rl" */
 	{
-            tmpstr.clear();
+            tokenBegin = tokenEnd = 0;
         }
 	break;
 	case 4:
-/* #line 69 "ragel/parser.rl" */
+/* #line 107 "ragel/parser.rl" */
 	{
-            mPendingElementName = sosicon::utils::trim( tmpstr );
+            assignToken( mPendingElementName, tokenBegin, tokenEnd );
+            mPendingCoordinateDimension = sosi::northEastDimension( mPendingElementName );
         }
 	break;
 	case 6:
-/* #line 78 "ragel/parser.rl" */
+/* #line 117 "ragel/parser.rl" */
 	{
-            mPendingElementAttributes += ( " " + sosicon::utils::trim( tmpstr ) );
-            tmpstr.clear();
+            mPendingElementAttributes += ' ';
+            appendToken( mPendingElementAttributes, tokenBegin, tokenEnd );
+            tokenBegin = tokenEnd = 0;
         }
 	break;
-/* #line 337 "parser_ragel.cpp" */
+/* #line 379 "parser_ragel.cpp" */
 		}
 	}
 	}
@@ -341,7 +391,11 @@ _again:
 	_out: {}
 	}
 
-/* #line 118 "ragel/parser.rl" */
+/* #line 158 "ragel/parser.rl" */
+
 
+        lineBegin = lineEnd;
+    }
 
+    return lineCount;
 };
\ No newline at end of file
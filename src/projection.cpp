@@ -0,0 +1,281 @@
+/*
+ *  This file is part of the command-line tool sosicon.
+ *  Copyright (C) 2014  Espen Andersen, Norwegian Broadcast Corporation (NRK)
+ *
+ *  This is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "projection.h"
+
+namespace {
+
+    const double PI = 3.14159265358979323846;
+    const double DEG_TO_RAD = PI / 180.0;
+    const double RAD_TO_DEG = 180.0 / PI;
+
+    // Semi-major axis and flattening
+    const double GRS80_A = 6378137.0;
+    const double GRS80_F = 1.0 / 298.257222101;
+    const double WGS84_A = 6378137.0;
+    const double WGS84_F = 1.0 / 298.257223563;
+
+    //! Tangent of conformal latitude from sine and cosine of geodetic latitude
+    inline double conformalTan( double sinPhi, double cosPhi, double e ) {
+        double p = std::exp( e * std::atanh( e * sinPhi ) );
+        double sinhQ = 0.5 * ( p - 1.0 / p );
+        double coshQ = 0.5 * ( p + 1.0 / p );
+        return ( sinPhi * coshQ - sinhQ ) / cosPhi;
+    }
+
+    //! Add the Krger series to ( xi, eta ), with sign +1 (forward) or -1 (inverse)
+    inline void krugerSeries( const double* coef, int order, double sign, double& xi, double& eta ) {
+        double s1 = std::sin( 2.0 * xi );
+        double c1 = std::cos( 2.0 * xi );
+        double exp2 = std::exp( 2.0 * eta );
+        double sh1 = 0.5 * ( exp2 - 1.0 / exp2 );
+        double ch1 = 0.5 * ( exp2 + 1.0 / exp2 );
+        double s = s1, c = c1, sh = sh1, ch = ch1;
+        double dXi = 0.0, dEta = 0.0;
+        for( int j = 0; j < order; j++ ) {
+            dXi += coef[ j ] * s * ch;
+            dEta += coef[ j ] * c * sh;
+            // Angle addition for the next multiple of 2 * xi and 2 * eta
+            double sNext = s * c1 + c * s1;
+            double cNext = c * c1 - s * s1;
+            double shNext = sh * ch1 + ch * sh1;
+            double chNext = ch * ch1 + sh * sh1;
+            s = sNext;
+            c = cNext;
+            sh = shNext;
+            ch = chNext;
+        }
+        xi += sign * dXi;
+        eta += sign * dEta;
+    }
+
+}
+
+sosicon::Projection::
+Projection( int srid ) {
+    mSrid = srid;
+    mValid = true;
+    mGeographic = false;
+    mLat0Degrees = mLon0Degrees = mScaleFactor = 0.0;
+    mLon0 = mFalseEasting = mFalseNorthing = mScale = mMeridianArc0 = mEccentricity = 0.0;
+    for( int j = 0; j < ORDER; j++ ) {
+        mAlpha[ j ] = mBeta[ j ] = mDelta[ j ] = 0.0;
+    }
+    if( 4258 == srid || 4326 == srid ) {
+        // ETRS89 / WGS84 geographic
+        mGeographic = true;
+    }
+    else if( srid >= 25828 && srid <= 25838 ) {
+        // ETRS89 / UTM zone 28N - 38N
+        initTransverseMercator( GRS80_A, GRS80_F, 0.0, -183.0 + 6.0 * ( srid - 25800 ), 0.9996, 500000.0, 0.0 );
+    }
+    else if( srid >= 32601 && srid <= 32660 ) {
+        // WGS84 / UTM zone 1N - 60N
+        initTransverseMercator( WGS84_A, WGS84_F, 0.0, -183.0 + 6.0 * ( srid - 32600 ), 0.9996, 500000.0, 0.0 );
+    }
+    else if( srid >= 5105 && srid <= 5130 ) {
+        // ETRS89 / NTM zone 5 - 30
+        initTransverseMercator( GRS80_A, GRS80_F, 58.0, ( srid - 5100 ) + 0.5, 1.0, 100000.0, 1000000.0 );
+    }
+    else {
+        mValid = false;
+    }
+}
+
+void sosicon::Projection::
+initTransverseMercator( double a,
+                        double f,
+                        double lat0,
+                        double lon0,
+                        double k0,
+                        double falseEasting,
+                        double falseNorthing ) {
+
+    double n = f / ( 2.0 - f );
+    double n2 = n * n, n3 = n2 * n, n4 = n3 * n, n5 = n4 * n, n6 = n5 * n;
+
+    mEccentricity = std::sqrt( f * ( 2.0 - f ) );
+    mScale = k0 * a / ( 1.0 + n ) * ( 1.0 + n2 / 4.0 + n4 / 64.0 + n6 / 256.0 );
+    mLat0Degrees = lat0;
+    mLon0Degrees = lon0;
+    mScaleFactor = k0;
+    mLon0 = lon0 * DEG_TO_RAD;
+    mFalseEasting = falseEasting;
+    mFalseNorthing = falseNorthing;
+
+    mAlpha[ 0 ] = n / 2.0 - 2.0 * n2 / 3.0 + 5.0 * n3 / 16.0 + 41.0 * n4 / 180.0 - 127.0 * n5 / 288.0 + 7891.0 * n6 / 37800.0;
+    mAlpha[ 1 ] = 13.0 * n2 / 48.0 - 3.0 * n3 / 5.0 + 557.0 * n4 / 1440.0 + 281.0 * n5 / 630.0 - 1983433.0 * n6 / 1935360.0;
+    mAlpha[ 2 ] = 61.0 * n3 / 240.0 - 103.0 * n4 / 140.0 + 15061.0 * n5 / 26880.0 + 167603.0 * n6 / 181440.0;
+    mAlpha[ 3 ] = 49561.0 * n4 / 161280.0 - 179.0 * n5 / 168.0 + 6601661.0 * n6 / 7257600.0;
+    mAlpha[ 4 ] = 34729.0 * n5 / 80640.0 - 3418889.0 * n6 / 1995840.0;
+    mAlpha[ 5 ] = 212378941.0 * n6 / 319334400.0;
+
+    mBeta[ 0 ] = n / 2.0 - 2.0 * n2 / 3.0 + 37.0 * n3 / 96.0 - n4 / 360.0 - 81.0 * n5 / 512.0 + 96199.0 * n6 / 604800.0;
+    mBeta[ 1 ] = n2 / 48.0 + n3 / 15.0 - 437.0 * n4 / 1440.0 + 46.0 * n5 / 105.0 - 1118711.0 * n6 / 3870720.0;
+    mBeta[ 2 ] = 17.0 * n3 / 480.0 - 37.0 * n4 / 840.0 - 209.0 * n5 / 4480.0 + 5569.0 * n6 / 90720.0;
+    mBeta[ 3 ] = 4397.0 * n4 / 161280.0 - 11.0 * n5 / 504.0 - 830251.0 * n6 / 7257600.0;
+    mBeta[ 4 ] = 4583.0 * n5 / 161280.0 - 108847.0 * n6 / 3991680.0;
+    mBeta[ 5 ] = 20648693.0 * n6 / 638668800.0;
+
+    mDelta[ 0 ] = 2.0 * n - 2.0 * n2 / 3.0 - 2.0 * n3 + 116.0 * n4 / 45.0 + 26.0 * n5 / 45.0 - 2854.0 * n6 / 675.0;
+    mDelta[ 1 ] = 7.0 * n2 / 3.0 - 8.0 * n3 / 5.0 - 227.0 * n4 / 45.0 + 2704.0 * n5 / 315.0 + 2323.0 * n6 / 945.0;
+    mDelta[ 2 ] = 56.0 * n3 / 15.0 - 136.0 * n4 / 35.0 - 1262.0 * n5 / 105.0 + 73814.0 * n6 / 2835.0;
+    mDelta[ 3 ] = 4279.0 * n4 / 630.0 - 332.0 * n5 / 35.0 - 399572.0 * n6 / 14175.0;
+    mDelta[ 4 ] = 4174.0 * n5 / 315.0 - 144838.0 * n6 / 6237.0;
+    mDelta[ 5 ] = 601676.0 * n6 / 22275.0;
+
+    // Meridian arc from equator to latitude of origin
+    double xi = std::atan( conformalTan( std::sin( lat0 * DEG_TO_RAD ), std::cos( lat0 * DEG_TO_RAD ), mEccentricity ) );
+    double eta = 0.0;
+    krugerSeries( mAlpha, ORDER, 1.0, xi, eta );
+    mMeridianArc0 = mScale * xi;
+}
+
+std::string sosicon::Projection::
+projJson() const {
+    if( !mValid ) {
+        return "";
+    }
+    const bool wgs84 = 4326 == mSrid || ( mSrid >= 32601 && mSrid <= 32660 );
+    std::stringstream geo;
+    geo << "{\"type\":\"GeographicCRS\",\"name\":\"" << ( wgs84 ? "WGS 84" : "ETRS89" ) << "\","
+        << "\"datum\":{\"type\":\"GeodeticReferenceFrame\",\"name\":\""
+        << ( wgs84 ? "World Geodetic System 1984" : "European Terrestrial Reference System 1989" ) << "\","
+        << "\"ellipsoid\":{\"name\":\"" << ( wgs84 ? "WGS 84" : "GRS 1980" ) << "\",\"semi_major_axis\":6378137,"
+        << "\"inverse_flattening\":" << ( wgs84 ? "298.257223563" : "298.257222101" ) << "}},"
+        << "\"coordinate_system\":{\"subtype\":\"ellipsoidal\",\"axis\":["
+        << "{\"name\":\"Geodetic latitude\",\"abbreviation\":\"Lat\",\"direction\":\"north\",\"unit\":\"degree\"},"
+        << "{\"name\":\"Geodetic longitude\",\"abbreviation\":\"Lon\",\"direction\":\"east\",\"unit\":\"degree\"}]},"
+        << "\"id\":{\"authority\":\"EPSG\",\"code\":" << ( wgs84 ? 4326 : 4258 ) << "}}";
+    if( mGeographic ) {
+        return geo.str();
+    }
+
+    // NTM has northing as the first axis in the EPSG register
+    const bool ntm = mSrid >= 5105 && mSrid <= 5130;
+    const char* easting = "{\"name\":\"Easting\",\"abbreviation\":\"E\",\"direction\":\"east\",\"unit\":\"metre\"}";
+    const char* northing = "{\"name\":\"Northing\",\"abbreviation\":\"N\",\"direction\":\"north\",\"unit\":\"metre\"}";
+    std::stringstream zone;
+    if( ntm ) {
+        zone << "NTM zone " << mSrid - 5100;
+    }
+    else {
+        zone << "UTM zone " << ( wgs84 ? mSrid - 32600 : mSrid - 25800 ) << "N";
+    }
+    std::stringstream res;
+    res.precision( 12 );
+    res << "{\"type\":\"ProjectedCRS\",\"name\":\"" << ( wgs84 ? "WGS 84 / " : "ETRS89 / " ) << zone.str() << "\","
+        << "\"base_crs\":" << geo.str() << ","
+        << "\"conversion\":{\"name\":\"" << zone.str() << "\","
+        << "\"method\":{\"name\":\"Transverse Mercator\",\"id\":{\"authority\":\"EPSG\",\"code\":9807}},"
+        << "\"parameters\":["
+        << "{\"name\":\"Latitude of natural origin\",\"value\":" << mLat0Degrees
+        << ",\"unit\":\"degree\",\"id\":{\"authority\":\"EPSG\",\"code\":8801}},"
+        << "{\"name\":\"Longitude of natural origin\",\"value\":" << mLon0Degrees
+        << ",\"unit\":\"degree\",\"id\":{\"authority\":\"EPSG\",\"code\":8802}},"
+        << "{\"name\":\"Scale factor at natural origin\",\"value\":" << mScaleFactor
+        << ",\"unit\":\"unity\",\"id\":{\"authority\":\"EPSG\",\"code\":8805}},"
+        << "{\"name\":\"False easting\",\"value\":" << mFalseEasting
+        << ",\"unit\":\"metre\",\"id\":{\"authority\":\"EPSG\",\"code\":8806}},"
+        << "{\"name\":\"False northing\",\"value\":" << mFalseNorthing
+        << ",\"unit\":\"metre\",\"id\":{\"authority\":\"EPSG\",\"code\":8807}}]},"
+        << "\"coordinate_system\":{\"subtype\":\"Cartesian\",\"axis\":["
+        << ( ntm ? northing : easting ) << "," << ( ntm ? easting : northing ) << "]},"
+        << "\"id\":{\"authority\":\"EPSG\",\"code\":" << mSrid << "}}";
+    return res.str();
+}
+
+void sosicon::Projection::
+forward( double* n, double* e, size_t count ) const {
+    const double ecc = mEccentricity;
+    for( size_t i = 0; i < count; i++ ) {
+        double lambda = e[ i ] - mLon0;
+        double tauPrime = conformalTan( std::sin( n[ i ] ), std::cos( n[ i ] ), ecc );
+        double cosLambda = std::cos( lambda );
+        double xi = std::atan2( tauPrime, cosLambda );
+        double eta = std::asinh( std::sin( lambda ) / std::sqrt( tauPrime * tauPrime + cosLambda * cosLambda ) );
+        krugerSeries( mAlpha, ORDER, 1.0, xi, eta );
+        n[ i ] = mFalseNorthing + mScale * xi - mMeridianArc0;
+        e[ i ] = mFalseEasting + mScale * eta;
+    }
+}
+
+void sosicon::Projection::
+inverse( double* n, double* e, size_t count ) const {
+    for( size_t i = 0; i < count; i++ ) {
+        double xi = ( n[ i ] - mFalseNorthing + mMeridianArc0 ) / mScale;
+        double eta = ( e[ i ] - mFalseEasting ) / mScale;
+        krugerSeries( mBeta, ORDER, -1.0, xi, eta );
+        double expEta = std::exp( eta );
+        double sinhEta = 0.5 * ( expEta - 1.0 / expEta );
+        double coshEta = 0.5 * ( expEta + 1.0 / expEta );
+        double cosXi = std::cos( xi );
+        // Conformal latitude, then geodetic latitude by series
+        double sinChi = std::sin( xi ) / coshEta;
+        double cosChi = std::sqrt( 1.0 - sinChi * sinChi );
+        double s1 = 2.0 * sinChi * cosChi;
+        double c1 = 1.0 - 2.0 * sinChi * sinChi;
+        double s = s1, c = c1, dPhi = 0.0;
+        for( int j = 0; j < ORDER; j++ ) {
+            dPhi += mDelta[ j ] * s;
+            double sNext = s * c1 + c * s1;
+            c = c * c1 - s * s1;
+            s = sNext;
+        }
+        n[ i ] = std::atan2( sinChi, cosChi ) + dPhi;
+        e[ i ] = mLon0 + std::atan2( sinhEta, cosXi );
+    }
+}
+
+void sosicon::Transformation::
+init( int sridSource, int sridTarget ) {
+    mSridSource = sridSource;
+    mSridTarget = sridTarget;
+    mSource = Projection( sridSource );
+    mTarget = Projection( sridTarget );
+    mInitialized = true;
+}
+
+bool sosicon::Transformation::
+active() const {
+    return mSource.valid() && mTarget.valid() && mSridSource != mSridTarget;
+}
+
+void sosicon::Transformation::
+apply( double* n, double* e, size_t count ) const {
+    if( !active() ) {
+        return;
+    }
+    if( mSource.isGeographic() ) {
+        for( size_t i = 0; i < count; i++ ) {
+            n[ i ] *= DEG_TO_RAD;
+            e[ i ] *= DEG_TO_RAD;
+        }
+    }
+    else {
+        mSource.inverse( n, e, count );
+    }
+    if( mTarget.isGeographic() ) {
+        for( size_t i = 0; i < count; i++ ) {
+            n[ i ] *= RAD_TO_DEG;
+            e[ i ] *= RAD_TO_DEG;
+        }
+    }
+    else {
+        mTarget.forward( n, e, count );
+    }
+}
@@ -0,0 +1,179 @@
+/*
+ *  This file is part of the command-line tool sosicon.
+ *  Copyright (C) 2014  Espen Andersen, Norwegian Broadcast Corporation (NRK)
+ *
+ *  This is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __PROJECTION_H__
+#define __PROJECTION_H__
+
+#include <cmath>
+#include <cstddef>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace sosicon {
+
+    //! Map projection
+    /*!
+        \author Espen Andersen
+        \copyright GNU General Public License
+
+        Describes one of the grids supported by the built-in coordinate transformation:
+        geographic ETRS89/WGS84 (EPSG:4258, EPSG:4326), ETRS89 and WGS84 UTM zones
+        (EPSG:258xx, EPSG:326xx) and ETRS89 NTM zones 5-30 (EPSG:5105-5130).
+
+        The Transverse Mercator math uses the 6th order Krger series (Karney 2011), which
+        is accurate to well below a millimetre within the zones used in Norway. The kernels
+        work on contiguous coordinate arrays and contain no data-dependent branches. ETRS89
+        and WGS84 are treated as identical, as by PostGIS without a datum grid.
+     */
+    class Projection {
+
+        //! Number of terms in the Krger series
+        static const int ORDER = 6;
+
+        int mSrid;
+        bool mValid;
+        bool mGeographic;
+        double mLat0Degrees;    //!< Latitude of origin (degrees)
+        double mLon0Degrees;    //!< Central meridian (degrees)
+        double mScaleFactor;    //!< Scale factor at central meridian
+
+        double mLon0;           //!< Central meridian (radians)
+        double mFalseEasting;
+        double mFalseNorthing;
+        double mScale;          //!< Rectifying radius times scale factor (k0 * A)
+        double mMeridianArc0;   //!< Scaled meridian arc at latitude of origin
+        double mEccentricity;
+        double mAlpha[ ORDER ]; //!< Forward series coefficients
+        double mBeta[ ORDER ];  //!< Inverse series coefficients
+        double mDelta[ ORDER ]; //!< Conformal to geodetic latitude series coefficients
+
+        //! Set up Transverse Mercator parameters
+        void initTransverseMercator( double a,
+                                     double f,
+                                     double lat0,
+                                     double lon0,
+                                     double k0,
+                                     double falseEasting,
+                                     double falseNorthing );
+
+    public:
+
+        //! Constructor
+        /*!
+            \param srid EPSG code of the grid. Check valid() to see if it is supported.
+         */
+        Projection( int srid = 0 );
+
+        //! True if the grid is supported
+        bool valid() const { return mValid; }
+
+        //! True if coordinates are geographic (degrees)
+        bool isGeographic() const { return mGeographic; }
+
+        //! Describe the grid as PROJJSON
+        /*!
+            Gives the coordinate reference system definition expected by formats such as
+            GeoParquet, with the EPSG code as identifier.
+            \return PROJJSON object, or an empty string if the grid is not supported.
+         */
+        std::string projJson() const;
+
+        //! Project geographic coordinates
+        /*!
+            Converts latitude/longitude to northing/easting in place.
+            \param n Latitude (radians) on input, northing on output.
+            \param e Longitude (radians) on input, easting on output.
+            \param count Number of coordinates.
+         */
+        void forward( double* n, double* e, size_t count ) const;
+
+        //! Unproject grid coordinates
+        /*!
+            Converts northing/easting to latitude/longitude in place.
+            \param n Northing on input, latitude (radians) on output.
+            \param e Easting on input, longitude (radians) on output.
+            \param count Number of coordinates.
+         */
+        void inverse( double* n, double* e, size_t count ) const;
+
+    }; // class Projection
+
+    //! Coordinate transformation
+    /*!
+        \author Espen Andersen
+        \copyright GNU General Public License
+
+        Transforms coordinates between two grids supported by sosicon::Projection, via
+        geographic coordinates. Geographic coordinates are given in degrees, with latitude
+        as north and longitude as east.
+     */
+    class Transformation {
+
+        Projection mSource;
+        Projection mTarget;
+
+        int mSridSource;
+        int mSridTarget;
+
+        bool mInitialized;
+
+    public:
+
+        //! Constructor
+        Transformation() : mSridSource( 0 ), mSridTarget( 0 ), mInitialized( false ) { }
+
+        //! Set source and target grid
+        /*!
+            \param sridSource EPSG code of the source coordinates, or 0 if unknown.
+            \param sridTarget EPSG code of the requested output, or 0 to keep the source grid.
+         */
+        void init( int sridSource, int sridTarget );
+
+        //! True if init() has been called
+        bool initialized() const { return mInitialized; }
+
+        //! True if the coordinates will be changed by apply()
+        bool active() const;
+
+        //! True if a different output grid was requested but cannot be produced
+        /*!
+            This is the case if the source grid is unknown, or if either grid is not supported
+            by sosicon::Projection. apply() then leaves the coordinates in the source grid.
+         */
+        bool unavailable() const { return mSridTarget != 0 && mSridTarget != mSridSource && !active(); }
+
+        //! EPSG code of the requested output grid, or 0 if none
+        int getTargetSrid() const { return mSridTarget; }
+
+        //! EPSG code of the coordinates after apply(), or 0 if unknown
+        int getSrid() const { return active() ? mSridTarget : mSridSource; }
+
+        //! Transform coordinates in place
+        /*!
+            Does nothing unless active() is true.
+            \param n Northing or latitude.
+            \param e Easting or longitude.
+            \param count Number of coordinates.
+         */
+        void apply( double* n, double* e, size_t count ) const;
+
+    }; // class Transformation
+
+}; // namespace sosicon
+
+#endif
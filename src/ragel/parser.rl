@@ -29,33 +29,79 @@ namespace sosicon {
 
 }
 
-void sosicon::Parser::
-ragelParseSosiLine( std::string sosiLine )
+int sosicon::Parser::
+ragelParseSosi( const char* bufferBegin, const char* bufferEnd )
 {
 
-    sosiLine += "\r\n";
-
  /* Variables used by Ragel */
 
     int cs = 0;
-    const char* s = sosiLine.c_str();
-    const char* p = s;
-    const char* pe = p + sosiLine.size();
-    const char* eof = pe;
+    const char* p = 0;
+    const char* pe = 0;
+    const char* eof = 0;
 
-    std::string tmpstr;
+    const char* tokenBegin = 0;
+    const char* tokenEnd = 0;
     int tmpint = 0;
 
+    int lineCount = 0;
+    const char* lineBegin = bufferBegin;
+
+    while( lineBegin < bufferEnd ) {
+
+        // The machine is restarted on each line rather than run once over the whole buffer:
+        // - Comments (!) are skipped by letting the machine fail for the remainder of the line.
+        //   Over the whole buffer, a failure would end the buffer, so the grammar would need
+        //   explicit comment states in every element rule.
+        // - Coordinate lines of N and NH elements are decoded below without the machine,
+        //   which would otherwise have to hand control back in the middle of the buffer.
+        // - The generated parser_ragel.cpp is checked in, and the tree has Ragel binaries
+        //   for OS X and Windows only, so a new grammar cannot be generated and verified on
+        //   every platform.
+        // A restart costs a memchr and a few assignments, without allocation or copying.
+        // Element data carries over in the mPendingElementXXX members. Only an unterminated
+        // last line is copied, to give it the line break expected by the machine.
+        const char* lineEnd = static_cast<const char*>( memchr( lineBegin, '\n', bufferEnd - lineBegin ) );
+        const char* dataBegin = lineBegin;
+        lineCount++;
+
+        // Coordinate lines of N and NH elements are decoded without the machine. It only
+        // gets to see the rest of the line if another element starts on it.
+        if( mPendingCoordinateDimension > 0 ) {
+            const char* dataEnd = lineEnd ? lineEnd + 1 : bufferEnd;
+            dataBegin = decodeCoordinateLine( lineBegin, dataEnd );
+            if( dataBegin == dataEnd ) {
+                lineBegin = dataEnd;
+                continue;
+            }
+        }
+
+        if( lineEnd ) {
+            p = dataBegin;
+            pe = ++lineEnd;
+        }
+        else {
+            mLineBuffer.assign( dataBegin, bufferEnd );
+            mLineBuffer += "\r\n";
+            p = mLineBuffer.c_str();
+            pe = p + mLineBuffer.size();
+            lineEnd = bufferEnd;
+        }
+        eof = pe;
+        tokenBegin = tokenEnd = 0;
+        tmpint = 0;
+
     %%{
 
         action strbuild {
-            if( '\r' != fc ) {
-                tmpstr += fc;
+            if( !tokenBegin ) {
+                tokenBegin = fpc;
             }
+            tokenEnd = fpc + 1;
         }
 
         action strinit {
-            tmpstr.clear();
+            tokenBegin = tokenEnd = 0;
         }
 
         action intincr {
@@ -67,27 +113,29 @@ ragelParseSosiLine( std::string sosiLine )
         }
 
         action set_name {
-            mPendingElementName = sosicon::utils::trim( tmpstr );
+            assignToken( mPendingElementName, tokenBegin, tokenEnd );
+            mPendingCoordinateDimension = sosi::northEastDimension( mPendingElementName );
         }
 
         action set_attributes {
-            mPendingElementAttributes = sosicon::utils::trim( tmpstr );
-            tmpstr.clear();
+            assignToken( mPendingElementAttributes, tokenBegin, tokenEnd );
+            tokenBegin = tokenEnd = 0;
         }
 
         action append_attributes {
-            mPendingElementAttributes += ( " " + sosicon::utils::trim( tmpstr ) );
-            tmpstr.clear();
+            mPendingElementAttributes += ' ';
+            appendToken( mPendingElementAttributes, tokenBegin, tokenEnd );
+            tokenBegin = tokenEnd = 0;
         }
 
         action set_level {
             mPendingElementLevel = tmpint;
-            tmpstr.clear();
+            tokenBegin = tokenEnd = 0;
         }
 
         action set_serial {
-            mPendingElementSerial = tmpstr.substr( 0, tmpstr.length() - 1 );
-            tmpstr.clear();
+            assignToken( mPendingElementSerial, tokenBegin, tokenEnd - 1 );
+            tokenBegin = tokenEnd = 0;
         }
 
         action digest_element {
@@ -117,4 +165,8 @@ ragelParseSosiLine( std::string sosiLine )
 
     }%%
 
+        lineBegin = lineEnd;
+    }
+
+    return lineCount;
 };
\ No newline at end of file
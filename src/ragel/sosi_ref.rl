@@ -62,7 +62,7 @@ ragelParseSosiRef( std::string data )
                 geomRef = new GeometryRef();
                 mRefListCollection.push_back( geomRef );
             }
-            geomRef->insert( geomRef->begin(), refData );
+            geomRef->push_back( refData );
         }
 
         action build_serial {
@@ -0,0 +1,96 @@
+/*
+ *  This file is part of the command-line tool sosicon.
+ *  Copyright (C) 2014  Espen Andersen, Norwegian Broadcast Corporation (NRK)
+ *
+ *  This is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "ring_builder.h"
+
+sosicon::RingBuilder::
+RingBuilder( GeometryBuffer& target ) :
+    mTarget( &target ),
+    mBegin( target.size() ),
+    mEdgeSum( 0.0 ),
+    mXmin( +9999999999 ),
+    mYmin( +9999999999 ),
+    mXmax( -9999999999 ),
+    mYmax( -9999999999 ) {
+    mTarget->beginPart();
+}
+
+void sosicon::RingBuilder::
+add( double x, double y, double z ) {
+    size_t last = mTarget->size();
+    if( last > mBegin ) {
+        last--;
+        mEdgeSum += ( x - mTarget->x( last ) ) * ( y + mTarget->y( last ) );
+    }
+    mTarget->append( y, x, z );
+    mXmin = std::min( mXmin, x );
+    mYmin = std::min( mYmin, y );
+    mXmax = std::max( mXmax, x );
+    mYmax = std::max( mYmax, y );
+}
+
+void sosicon::RingBuilder::
+append( const GeometryBuffer& curve, bool reverse ) {
+    const size_t count = curve.size();
+    if( count == 0 ) {
+        return;
+    }
+    size_t first = reverse ? count - 1 : 0;
+    size_t i = 0;
+    if( size() > 0 ) {
+        size_t last = mTarget->size() - 1;
+        if( curve.x( first ) == mTarget->x( last ) && curve.y( first ) == mTarget->y( last ) ) {
+            // Junction shared with the previous curve
+            i = 1;
+        }
+    }
+    for( ; i < count; i++ ) {
+        size_t j = reverse ? count - 1 - i : i;
+        add( curve.x( j ), curve.y( j ), curve.z( j ) );
+    }
+}
+
+bool sosicon::RingBuilder::
+close() {
+    if( size() < 2 ) {
+        return true;
+    }
+    size_t last = mTarget->size() - 1;
+    if( mTarget->equals( mBegin, last ) ) {
+        return true;
+    }
+    add( mTarget->x( mBegin ), mTarget->y( mBegin ), mTarget->z( mBegin ) );
+    return false;
+}
+
+void sosicon::RingBuilder::
+orient( bool clockwise ) {
+    if( size() > 1 && isClockwise() != clockwise ) {
+        mTarget->reverse( mBegin, mTarget->size() );
+        mEdgeSum = -mEdgeSum;
+    }
+}
+
+void sosicon::RingBuilder::
+expandBoundingBox( double& minX, double& minY, double& maxX, double& maxY ) const {
+    if( size() > 0 ) {
+        minX = std::min( minX, mXmin );
+        minY = std::min( minY, mYmin );
+        maxX = std::max( maxX, mXmax );
+        maxY = std::max( maxY, mYmax );
+    }
+}
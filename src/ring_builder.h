@@ -0,0 +1,96 @@
+/*
+ *  This file is part of the command-line tool sosicon.
+ *  Copyright (C) 2014  Espen Andersen, Norwegian Broadcast Corporation (NRK)
+ *
+ *  This is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __RING_BUILDER_H__
+#define __RING_BUILDER_H__
+
+#include "geometry_buffer.h"
+
+namespace sosicon {
+
+    //! Polygon ring assembly
+    /*!
+        \author Espen Andersen
+        \copyright GNU General Public License
+
+        Builds one ring of a surface from the curves given in its REF list. The curves are
+        appended as a new part of the target buffer in the order they are referred to, each
+        forward or reversed, in time linear to the number of vertices. The end point a curve
+        shares with the previous one is stored once. Ring direction and bounding box are
+        computed while the vertices are appended, so the ring is not traversed again.
+     */
+    class RingBuilder {
+
+        //! Buffer receiving the ring
+        GeometryBuffer* mTarget;
+
+        //! Offset of the first vertex of the ring in mTarget
+        size_t mBegin;
+
+        //! Sum over the edges of ( x2 - x1 ) * ( y2 + y1 ), positive for clockwise rings
+        double mEdgeSum;
+
+        double mXmin;
+        double mYmin;
+        double mXmax;
+        double mYmax;
+
+        //! Append one vertex to the ring
+        void add( double x, double y, double z );
+
+    public:
+
+        //! Constructor
+        /*!
+            Starts a new part in target.
+            \param target Buffer receiving the ring.
+         */
+        RingBuilder( GeometryBuffer& target );
+
+        //! Append the vertices of a referenced curve
+        /*!
+            The first vertex of the curve, in the direction it is traversed, is skipped if it
+            equals the last vertex of the ring.
+            \param curve Coordinates of the curve, in file order.
+            \param reverse If true, the curve is traversed last to first.
+         */
+        void append( const GeometryBuffer& curve, bool reverse );
+
+        //! Close ring
+        /*!
+            Repeats the first vertex after the last one, unless the curves already met.
+            \return true if the referenced curves formed a closed ring.
+         */
+        bool close();
+
+        //! Number of vertices in the ring
+        size_t size() const { return mTarget->size() - mBegin; }
+
+        //! True if the vertices are ordered clockwise
+        bool isClockwise() const { return mEdgeSum > 0; }
+
+        //! Reverse the ring, if needed, to give it the requested direction
+        void orient( bool clockwise );
+
+        //! Expand bounding box to include the ring
+        void expandBoundingBox( double& minX, double& minY, double& maxX, double& maxY ) const;
+
+    }; // class RingBuilder
+
+}; // namespace sosicon
+
+#endif
@@ -0,0 +1,122 @@
+/*
+ *  This file is part of the command-line tool sosicon.
+ *  Copyright (C) 2014  Espen Andersen, Norwegian Broadcast Corporation (NRK)
+ *
+ *  This is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "row_spool.h"
+
+sosicon::RowSpool::
+RowSpool( std::string fileName ) {
+    mFileName = fileName;
+    mRowCount = 0;
+    mReadCount = 0;
+    mFile.open( mFileName.c_str(), std::ios::in | std::ios::out | std::ios::trunc | std::ios::binary );
+    mFailed = !mFile.is_open();
+}
+
+sosicon::RowSpool::
+~RowSpool() {
+    if( mFile.is_open() ) {
+        mFile.close();
+    }
+    std::remove( mFileName.c_str() );
+}
+
+void sosicon::RowSpool::
+writeString( const std::string& str ) {
+    unsigned int len = static_cast<unsigned int>( str.size() );
+    mFile.write( reinterpret_cast<const char*>( &len ), sizeof len );
+    mFile.write( str.data(), len );
+}
+
+bool sosicon::RowSpool::
+readString( std::string& str ) {
+    unsigned int len = 0;
+    if( !mFile.read( reinterpret_cast<char*>( &len ), sizeof len ) ) {
+        return false;
+    }
+    str.resize( len );
+    return len == 0 || mFile.read( &str[ 0 ], len );
+}
+
+void sosicon::RowSpool::
+write( const std::map<std::string,std::string>& row ) {
+    unsigned int count = static_cast<unsigned int>( row.size() );
+    mFile.write( reinterpret_cast<const char*>( &count ), sizeof count );
+    for( std::map<std::string,std::string>::const_iterator i = row.begin(); i != row.end(); i++ ) {
+        writeString( i->first );
+        writeString( i->second );
+    }
+    mRowCount++;
+    if( !mFile ) {
+        mFailed = true;
+    }
+}
+
+void sosicon::RowSpool::
+append( RowSpool& other ) {
+    if( other.mRowCount > 0 ) {
+        other.rewind();
+        mFile << other.mFile.rdbuf();
+        mRowCount += other.mRowCount;
+        if( other.mFailed || !mFile ) {
+            mFailed = true;
+        }
+    }
+}
+
+void sosicon::RowSpool::
+close() {
+    mFile.close();
+    if( !mFile ) {
+        mFailed = true;
+    }
+}
+
+void sosicon::RowSpool::
+rewind() {
+    if( !mFile.is_open() ) {
+        mFile.open( mFileName.c_str(), std::ios::in | std::ios::out | std::ios::binary );
+    }
+    mFile.flush();
+    if( !mFile ) {
+        mFailed = true;
+    }
+    mFile.clear();
+    mFile.seekg( 0 );
+    mReadCount = 0;
+}
+
+bool sosicon::RowSpool::
+read( std::map<std::string,std::string>& row ) {
+    row.clear();
+    unsigned int count = 0;
+    if( !mFile.read( reinterpret_cast<char*>( &count ), sizeof count ) ) {
+        if( mReadCount < mRowCount ) {
+            mFailed = true;
+        }
+        return false;
+    }
+    std::string name, value;
+    for( unsigned int i = 0; i < count; i++ ) {
+        if( !readString( name ) || !readString( value ) ) {
+            mFailed = true;
+            return false;
+        }
+        row[ name ] = value;
+    }
+    mReadCount++;
+    return true;
+}
@@ -0,0 +1,126 @@
+/*
+ *  This file is part of the command-line tool sosicon.
+ *  Copyright (C) 2014  Espen Andersen, Norwegian Broadcast Corporation (NRK)
+ *
+ *  This is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __ROW_SPOOL_H__
+#define __ROW_SPOOL_H__
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <string>
+
+namespace sosicon {
+
+    //! Temporary file of table rows
+    /*!
+        \author Espen Andersen
+        \copyright GNU General Public License
+
+        Holds converted rows on disk until the table structure is known, so that converters
+        only need to keep the field statistics in memory. Rows are appended while the source
+        files are parsed, and read back in the same order when the output is written. Each
+        row is stored as a field count followed by length-prefixed name/value pairs, in native
+        byte order. The file is removed when the spool is destroyed.
+     */
+    class RowSpool {
+
+        //! Path of the spool file
+        std::string mFileName;
+
+        //! Spool file, written and then read back
+        std::fstream mFile;
+
+        //! Number of rows written
+        size_t mRowCount;
+
+        //! Number of rows read since the last rewind()
+        size_t mReadCount;
+
+        //! True if the spool file could not be created, written or read back
+        bool mFailed;
+
+        //! Append length-prefixed string
+        void writeString( const std::string& str );
+
+        //! Read length-prefixed string
+        bool readString( std::string& str );
+
+    public:
+
+        //! Constructor
+        /*!
+            Creates the spool file. An existing file with the same name is overwritten.
+            If the file cannot be created, the spool is flagged as failed, see failed().
+            \param fileName Path of the spool file.
+         */
+        RowSpool( std::string fileName );
+
+        //! Destructor
+        /*!
+            Closes and removes the spool file.
+         */
+        ~RowSpool();
+
+        //! Append row
+        /*!
+            \param row Field names and values of the row.
+         */
+        void write( const std::map<std::string,std::string>& row );
+
+        //! Append all rows of other spool
+        /*!
+            The rows are copied as is, after the rows written so far.
+            \param other Spool to copy rows from. Is rewound, and read to the end.
+         */
+        void append( RowSpool& other );
+
+        //! Close spool file
+        /*!
+            Releases the file handle of a spool that is complete, but will not be read for
+            a while. The rows stay on disk, and the file is reopened by rewind().
+         */
+        void close();
+
+        //! Prepare for reading
+        /*!
+            Flushes the rows written so far and moves to the first row.
+         */
+        void rewind();
+
+        //! Read next row
+        /*!
+            \param row Receives the field names and values of the row.
+            \return False when all rows have been read, or the spool file ended early.
+         */
+        bool read( std::map<std::string,std::string>& row );
+
+        //! Number of rows written
+        size_t size() { return mRowCount; }
+
+        //! True if rows were lost
+        /*!
+            Set if the spool file could not be created or reopened, if writing to it failed,
+            for instance on a full disk, or if fewer rows could be read back than written.
+         */
+        bool failed() const { return mFailed; }
+
+    }; // class RowSpool
+
+}; // namespace sosicon
+
+#endif
@@ -38,9 +38,10 @@ getShapeEquivalent( sosi::ElementType sosiType ) {
 
 sosicon::shape::Shapefile::
 ~Shapefile() {
+    if( mFilesCreated ) {
+        removeFiles();
+    }
     delete [ ] mShpBuffer;
-    delete [ ] mShxBuffer;
-    delete [ ] mDbfBuffer;
 }
 
 void sosicon::shape::Shapefile::
@@ -51,43 +52,61 @@ adjustMasterMbr( double xMin, double yMin, double xMax, double yMax ) {
     mYmax = std::max( mYmax, yMax );
 }
 
-int sosicon::shape::Shapefile::
-build( ISosiElement* sosiTree, std::string objType, sosi::ElementType geomType ) {
-
-    int count = 0;
+void sosicon::shape::Shapefile::
+insert( ISosiElement* sosi ) {
 
-    mSosiTree = sosiTree;
+    std::vector<std::string>& f = mFilterSosiId;
+    if( f.size() > 0 && std::find( f.begin(), f.end(), sosi->getSerial() ) == f.end() ) {
+        return;
+    }
 
-    ISosiElement* sosi = 0;
-    sosi::SosiElementSearch src;
-    ShapeType shapeTypeEquivalent = shape_type_none;
+    ShapeType shapeTypeEquivalent = getShapeEquivalent( sosi->getType() );
+    if( shape_type_none == shapeTypeEquivalent ) {
+        return;
+    }
+    if( shape_type_none == mShapeType ) {
+        mShapeType = shapeTypeEquivalent;
+    }
+    else if( shapeTypeEquivalent != mShapeType ) {
+        return;
+    }
+    if( 0 == mRecordNumber ) {
+        openFiles();
+    }
 
-    std::vector<std::string>& f = mFilterSosiId;
-    while( sosiTree->getChild( src ) ) {
+    buildShpElement( sosi, shapeTypeEquivalent );
+    insertDbfRecord( sosi );
+    if( mShpFileBuffer.size() >= static_cast< size_t >( FILE_BUFFER_SIZE ) ||
+        mDbfFileBuffer.size() >= static_cast< size_t >( FILE_BUFFER_SIZE ) )
+    {
+        flushFiles();
+    }
+}
 
-        sosi = src.element();
+int sosicon::shape::Shapefile::
+complete( ISosiElement* sosiTree ) {
 
-        if(
-            ( objType.empty() || objType == sosi->getObjType() ) &&
-            ( f.size() == 0 || std::find( f.begin(), f.end(), sosi->getSerial() ) != f.end() )
-          )
-        {
+    mSosiTree = sosiTree;
 
-            if( sosi->getType() == geomType ) {
-                shapeTypeEquivalent = getShapeEquivalent( sosi->getType() );
-                buildShpElement( sosi, shapeTypeEquivalent );
-                insertDbfRecord( sosi );
-                ++count;
-            }
-        }
-    }
+    int count = mRecordNumber;
     if( count > 0 ) {
 
-        buildShpHeader( shapeTypeEquivalent );
+        flushFiles();
+
+        buildShpHeader( mShapeType );
+        writeFileHeader( ".shp", mShpHeader, sizeof( mShpHeader ) );
 
-        buildDbf(); // database (attributes table)
         buildShx(); // index
+        writeFileHeader( ".shx", mShxHeader, sizeof( mShxHeader ) );
 
+        if( !mFailed ) {
+            buildDbf(); // database (attributes table)
+        }
+        if( mFailed ) {
+            removeFiles();
+            return -1;
+        }
+        mFilesCreated = false;
     }
 
     return count;
@@ -108,30 +127,24 @@ buildShpHeader( ShapeType type ) {
     version.i = 1000;
     shapeType.i = type;
 
-    byteOrder::toBigEndian( fileCode.b,     &mShpHeader[  0 ], 4 );
-    byteOrder::toBigEndian( unused.b,       &mShpHeader[  4 ], 4 );
-    byteOrder::toBigEndian( unused.b,       &mShpHeader[  8 ], 4 );
-    byteOrder::toBigEndian( unused.b,       &mShpHeader[ 12 ], 4 );
-    byteOrder::toBigEndian( unused.b,       &mShpHeader[ 16 ], 4 );
-    byteOrder::toBigEndian( unused.b,       &mShpHeader[ 20 ], 4 );
-    byteOrder::toBigEndian( fileLength.b,   &mShpHeader[ 24 ], 4 );
-    byteOrder::toLittleEndian( version.b,   &mShpHeader[ 28 ], 4 );
-    byteOrder::toLittleEndian( shapeType.b, &mShpHeader[ 32 ], 4 );
-    byteOrder::doubleToLittleEndian( mXmin, &mShpHeader[ 36 ] );
-    byteOrder::doubleToLittleEndian( mYmin, &mShpHeader[ 44 ] );
-    byteOrder::doubleToLittleEndian( mXmax, &mShpHeader[ 52 ] );
-    byteOrder::doubleToLittleEndian( mYmax, &mShpHeader[ 60 ] );
-    byteOrder::doubleToLittleEndian( 0.0,   &mShpHeader[ 68 ] );
-    byteOrder::doubleToLittleEndian( 0.0,   &mShpHeader[ 76 ] );
-    byteOrder::doubleToLittleEndian( 0.0,   &mShpHeader[ 84 ] );
-    byteOrder::doubleToLittleEndian( 0.0,   &mShpHeader[ 92 ] );
+    byteOrder::toBigEndian( fileCode.i,     &mShpHeader[  0 ] );
+    byteOrder::toBigEndian( unused.i,       &mShpHeader[  4 ] );
+    byteOrder::toBigEndian( unused.i,       &mShpHeader[  8 ] );
+    byteOrder::toBigEndian( unused.i,       &mShpHeader[ 12 ] );
+    byteOrder::toBigEndian( unused.i,       &mShpHeader[ 16 ] );
+    byteOrder::toBigEndian( unused.i,       &mShpHeader[ 20 ] );
+    byteOrder::toBigEndian( fileLength.i,   &mShpHeader[ 24 ] );
+    byteOrder::toLittleEndian( version.i,   &mShpHeader[ 28 ] );
+    byteOrder::toLittleEndian( shapeType.i, &mShpHeader[ 32 ] );
+    const double bounds[ 8 ] = { mXmin, mYmin, mXmax, mYmax, 0.0, 0.0, 0.0, 0.0 }; // X, Y, Z and M ranges
+    byteOrder::toLittleEndian( bounds, 8,   &mShpHeader[ 36 ] );
 
 }
 
 void sosicon::shape::Shapefile::
 buildShpElement( ISosiElement* sosi, ShapeType type ) {
 
-    CoordinateCollection cc;
+    CoordinateCollection cc( *mHeader, mCache );
     cc.discoverCoords( sosi );
 
     switch( type ) {
@@ -157,62 +170,61 @@ void sosicon::shape::Shapefile::
 buildShpPoint( CoordinateCollection& cc ) {
     int byteLength = 28;
     int contentLength = 10; // In 16-bit words, record header not included
-    insertShxOffset( contentLength );
-    int pos = expandShpBuffer( byteLength );
+    int pos = reserveShpRecord( byteLength );
     buildShpRecHeaderCommonPart( pos, contentLength, shape_type_point );
     buildShpRecCoordinate( pos, cc );
+    writeShpRecord( byteLength, contentLength );
 }
 
 void sosicon::shape::Shapefile::
 buildShpPolyLine( CoordinateCollection& cc ) {
     int byteLength = 52 + ( 4 ) + ( 16 * cc.getNumPointsGeom() ) + ( 16 * cc.getNumPointsHoles() );
     int contentLength = ( byteLength / 2 ) - 4; // In 16-bit words, record header not included
-    insertShxOffset( contentLength );
-    int pos = expandShpBuffer( byteLength );
+    int pos = reserveShpRecord( byteLength );
     buildShpRecHeaderCommonPart( pos, contentLength, shape_type_polyLine );
     buildShpRecHeaderExtended( pos, cc );
     buildShpRecHeaderOffsets( pos, cc );
     buildShpRecCoordinates( pos, cc );
+    writeShpRecord( byteLength, contentLength );
 }
 
 void sosicon::shape::Shapefile::
 buildShpPolygon( CoordinateCollection& cc ) {
     int byteLength = 52 + ( 4 * cc.getNumPartsGeom() ) + ( 4 * cc.getNumPartsHoles() ) + ( 16 * cc.getNumPointsGeom() ) + ( 16 * cc.getNumPointsHoles() );
     int contentLength = ( byteLength / 2 ) - 4; // In 16-bit words, record header not included
-    insertShxOffset( contentLength );
-    int pos = expandShpBuffer( byteLength );
+    int pos = reserveShpRecord( byteLength );
     buildShpRecHeaderCommonPart( pos, contentLength, shape_type_polygon );
     buildShpRecHeaderExtended( pos, cc );
     buildShpRecHeaderOffsets( pos, cc );
     buildShpRecCoordinates( pos, cc );
+    writeShpRecord( byteLength, contentLength );
 }
 
 void sosicon::shape::Shapefile::
 buildShpRecCoordinate( int& pos, CoordinateCollection& cc ) {
-    ICoordinate* c = 0;
-    cc.getNextInGeom( c );
-    if( c ) {
-        buildShpRecCoordinate( pos, c );
+    const GeometryBuffer& theGeom = cc.getGeom();
+    if( !theGeom.empty() ) {
+        buildShpRecCoordinate( pos, theGeom.x( 0 ), theGeom.y( 0 ) );
     }
 }
 
 void sosicon::shape::Shapefile::
-buildShpRecCoordinate( int& pos, ICoordinate* c ) {
-    byteOrder::doubleToLittleEndian( c->getE(), &mShpBuffer[ pos ] );
-    byteOrder::doubleToLittleEndian( c->getN(), &mShpBuffer[ pos + 8 ] );
-    adjustMasterMbr( c->getE(), c->getN(), c->getE(), c->getN() );
+buildShpRecCoordinate( int& pos, double x, double y ) {
+    const double point[ 2 ] = { x, y };
+    byteOrder::toLittleEndian( point, 2, &mShpBuffer[ pos ] );
+    adjustMasterMbr( x, y, x, y );
     pos += 16;
 }
 
 void sosicon::shape::Shapefile::
 buildShpRecCoordinates( int& pos, CoordinateCollection& cc ) {
-    std::vector<ICoordinate*> theGeom = cc.getGeom();
-    for( std::vector<ICoordinate*>::size_type i = 0; i < theGeom.size(); i++ ) {
-        buildShpRecCoordinate( pos, theGeom[ i ] );
+    const GeometryBuffer& theGeom = cc.getGeom();
+    for( size_t i = 0; i < theGeom.size(); i++ ) {
+        buildShpRecCoordinate( pos, theGeom.x( i ), theGeom.y( i ) );
     }
-    std::vector<ICoordinate*> theHoles = cc.getHoles();
-    for( std::vector<ICoordinate*>::size_type i = 0; i < theHoles.size(); i++ ) {
-        buildShpRecCoordinate( pos, theHoles[ i ] );
+    const GeometryBuffer& theHoles = cc.getHoles();
+    for( size_t i = 0; i < theHoles.size(); i++ ) {
+        buildShpRecCoordinate( pos, theHoles.x( i ), theHoles.y( i ) );
     }
 }
 
@@ -230,12 +242,10 @@ buildShpRecHeaderExtended( int& pos, CoordinateCollection& cc ) {
     double xMax = cc.getXmax();
     double yMax = cc.getYmax();
 
-    byteOrder::doubleToLittleEndian( xMin,   &mShpBuffer[ pos ] );         // Box minX
-    byteOrder::doubleToLittleEndian( yMin,   &mShpBuffer[ pos + 8 ] );     // Box minY
-    byteOrder::doubleToLittleEndian( xMax,   &mShpBuffer[ pos + 16 ] );    // Box maxX
-    byteOrder::doubleToLittleEndian( yMax,   &mShpBuffer[ pos + 24 ] );    // Box maxY
-    byteOrder::toLittleEndian( numParts.b,   &mShpBuffer[ pos + 32 ], 4 ); // NumParts
-    byteOrder::toLittleEndian( numPoints.b,  &mShpBuffer[ pos + 36 ], 4 ); // NumPoints
+    const double box[ 4 ] = { xMin, yMin, xMax, yMax };
+    byteOrder::toLittleEndian( box, 4,       &mShpBuffer[ pos ] );      // Box minX, minY, maxX, maxY
+    byteOrder::toLittleEndian( numParts.i,   &mShpBuffer[ pos + 32 ] ); // NumParts
+    byteOrder::toLittleEndian( numPoints.i,  &mShpBuffer[ pos + 36 ] ); // NumPoints
 
     adjustMasterMbr( xMin, yMin, xMax, yMax );
 
@@ -245,21 +255,21 @@ buildShpRecHeaderExtended( int& pos, CoordinateCollection& cc ) {
 void sosicon::shape::Shapefile::
 buildShpRecHeaderOffsets( int& pos, CoordinateCollection& cc ) {
 
-    std::vector<int> geomSizes = cc.getGeomSizes();
-    std::vector<int> holeSizes = cc.getHoleSizes();
+    const GeometryBuffer& theGeom = cc.getGeom();
+    const GeometryBuffer& theHoles = cc.getHoles();
 
     Int32Field offset = { 0 };
 
-    for( std::vector<int>::size_type i = 0; i < geomSizes.size(); i++ ) {
-        byteOrder::toLittleEndian( offset.b,  &mShpBuffer[ pos ], 4 );
+    for( size_t k = 0; k < theGeom.numParts(); k++ ) {
+        offset.i = static_cast<uint32_t>( theGeom.partBegin( k ) );
+        byteOrder::toLittleEndian( offset.i,  &mShpBuffer[ pos ] );
         pos += 4;
-        offset.i += geomSizes[ i ];
     }
 
-    for( std::vector<int>::size_type i = 0; i < holeSizes.size(); i++ ) {
-        byteOrder::toLittleEndian( offset.b,  &mShpBuffer[ pos ], 4 );
+    for( size_t k = 0; k < theHoles.numParts(); k++ ) {
+        offset.i = static_cast<uint32_t>( theGeom.size() + theHoles.partBegin( k ) );
+        byteOrder::toLittleEndian( offset.i,  &mShpBuffer[ pos ] );
         pos += 4;
-        offset.i += holeSizes[ i ];
     }
 }
 
@@ -275,9 +285,9 @@ buildShpRecHeaderCommonPart( int& pos, int contentLength, ShapeType type ) {
     Int32Field recordNumber;
     recordNumber.i = ++mRecordNumber;
 
-    byteOrder::toBigEndian( recordNumber.b,  &mShpBuffer[ pos ], 4 ); // Record serial
-    byteOrder::toBigEndian( len.b, &mShpBuffer[ pos +  4 ], 4 ); // Record content length
-    byteOrder::toLittleEndian( shapeType.b,  &mShpBuffer[ pos +  8 ], 4 ); // Shape type
+    byteOrder::toBigEndian( recordNumber.i,  &mShpBuffer[ pos ] ); // Record serial
+    byteOrder::toBigEndian( len.i, &mShpBuffer[ pos +  4 ] ); // Record content length
+    byteOrder::toLittleEndian( shapeType.i,  &mShpBuffer[ pos +  8 ] ); // Shape type
 
     pos += 12;
 }
@@ -287,65 +297,70 @@ buildDbf() {
 
     int recLen;
     recLen = 1; // Deleted flag == 1 byte
-    for( DbfFieldLengths::iterator i = mDbfFieldLengths.begin(); i != mDbfFieldLengths.end(); i++ ) {
-        recLen += i->second;
+    for( DbfFields::iterator i = mDbfFields.begin(); i != mDbfFields.end(); i++ ) {
+        recLen += i->second.length;
     }
 
-    mDbfBufferSize =
+    std::string spoolName = mBasePath + ".dbf.tmp";
+    std::ifstream spool( spoolName.c_str(), std::ios::in | std::ios::binary );
 
-        /* Field description array */ ( mDbfFieldLengths.size() * 32 ) +
-        /* Terminator              */   1 +
-        /* Record structure        */ ( recLen * mDbfRecordSet.size() ) +
-        /* EOF                     */   1 ;
-
-    try {
-        mDbfBuffer = 0;
-        mDbfBuffer = new char [ mDbfBufferSize ];
-    }
-    catch( ... ) {
-        sosicon::logstream << "Memory allocation error\n";
-        throw;
-    }
+    std::ofstream os;
+    std::string fileName = mBasePath + ".dbf";
+    os.open( fileName.c_str(), std::ios::out | std::ios::trunc | std::ios::binary );
 
     // Header
     buildDbfHeader( recLen );
+    os.write( mDbfHeader, sizeof( mDbfHeader ) );
+
+    // Payload
+    buildDbfFieldDescriptor( os );
+    bool spoolComplete = buildDbfRecordSection( spool, os, recLen );
+    os.close();
+    spool.close();
+    std::remove( spoolName.c_str() );
 
-    // Payload buffer
-    int pos = 0;
-    buildDbfFieldDescriptor( pos );
-    buildDbfRecordSection( pos, recLen );
+    if( !spoolComplete ) {
+        sosicon::logstream << "Error: Could not read " << spoolName << "\n";
+        mFailed = true;
+    }
+    else if( !os ) {
+        sosicon::logstream << "Error: Could not write " << fileName << "\n";
+        mFailed = true;
+    }
 }
 
 void sosicon::shape::Shapefile::
-buildDbfFieldDescriptor( int& pos ) {
+buildDbfFieldDescriptor( std::ostream& os ) {
+
+    char descriptor[ 32 ];
 
-    for( DbfFieldLengths::iterator i = mDbfFieldLengths.begin(); i != mDbfFieldLengths.end(); i++ ) {
+    for( DbfFields::iterator i = mDbfFields.begin(); i != mDbfFields.end(); i++ ) {
 
         std::string fieldName = i->first;
         fieldName.resize( 10, ' ' );
         const char* sz = fieldName.c_str();
-        std::copy( sz, sz + 11, &mDbfBuffer[ pos ] );
-        utils::asciify( &mDbfBuffer[ pos ] );
+        std::copy( sz, sz + 11, &descriptor[ 0 ] );
+        utils::asciify( &descriptor[ 0 ] );
 
         // Field data type (char)
-        mDbfBuffer[ pos + 11 ] = 'C';
+        descriptor[ 11 ] = 'C';
 
         // Field data address (N/A)
         for( int j = 12; j < 16; j++ ) {
-            mDbfBuffer[ pos + j ] = 0x00;
+            descriptor[ j ] = 0x00;
         }
-        mDbfBuffer[ pos + 16 ] = char( i->second );
+        descriptor[ 16 ] = char( i->second.length );
 
         // Reserved or N/A
         for( int i = 17; i < 32; i++ ) {
-            mDbfBuffer[ pos + i ] = 0x00;
+            descriptor[ i ] = 0x00;
         }
 
-        pos += 32;
+        os.write( descriptor, sizeof( descriptor ) );
     }
 
     // Terminator
-    mDbfBuffer[ pos++ ] = 0x0d;
+    os.put( 0x0d );
 }
 
 void sosicon::shape::Shapefile::
@@ -355,7 +370,7 @@ buildDbfHeader( int recLen ) {
     Int16Field recordLength = { static_cast<uint16_t>( recLen ) };
     headerLength.i =
         /* Fixed header size       */   static_cast< uint16_t >( sizeof( mDbfHeader ) ) +
-        /* Field description array */ ( static_cast< uint16_t >( mDbfFieldLengths.size() ) * 32 ) +
+        /* Field description array */ ( static_cast< uint16_t >( mDbfFields.size() ) * 32 ) +
         /* Terminator              */   1;
 
     time_t rawTime;
@@ -363,16 +378,16 @@ buildDbfHeader( int recLen ) {
     time( &rawTime );
     timeInfo = localtime( &rawTime );
     Int32Field numRecords;
-    numRecords.i = static_cast< uint32_t > ( mDbfRecordSet.size() );
+    numRecords.i = static_cast< uint32_t > ( mDbfRecordCount );
 
     mDbfHeader[  0 ] = 0x03;                         // Version number
     mDbfHeader[  1 ] = char( timeInfo->tm_year );    // Year of last update
     mDbfHeader[  2 ] = char( timeInfo->tm_mon + 1 ); // Month of last update
     mDbfHeader[  3 ] = char( timeInfo->tm_mday );    // Day of last update
 
-    byteOrder::toLittleEndian( numRecords.b,    &mDbfHeader[  4 ], 4 ); // Number of records
-    byteOrder::toLittleEndian( headerLength.b,  &mDbfHeader[  8 ], 2 ); // Length of header structure
-    byteOrder::toLittleEndian( recordLength.b,  &mDbfHeader[ 10 ], 2 ); // Length of record
+    byteOrder::toLittleEndian( numRecords.i,    &mDbfHeader[  4 ] ); // Number of records
+    byteOrder::toLittleEndian( headerLength.i,  &mDbfHeader[  8 ] ); // Length of header structure
+    byteOrder::toLittleEndian( recordLength.i,  &mDbfHeader[ 10 ] ); // Length of record
 
     // Reserved or N/A
     for( int i = 12; i < 32; i++ ) {
@@ -380,118 +395,172 @@ buildDbfHeader( int recLen ) {
     }
 }
 
-void sosicon::shape::Shapefile::
-buildDbfRecordSection( int& pos, int recLen ) {
+bool sosicon::shape::Shapefile::
+buildDbfRecordSection( std::istream& spool, std::ostream& os, int recLen ) {
+
+    // Position and length of each field in the record, by field number
+    std::vector<int> fieldOffset( mDbfFields.size() );
+    std::vector<int> fieldLength( mDbfFields.size() );
+    int fldOffset = 1; // Record deleted flag
+    for( DbfFields::iterator i = mDbfFields.begin(); i != mDbfFields.end(); i++ ) {
+        fieldOffset[ i->second.id ] = fldOffset;
+        fieldLength[ i->second.id ] = i->second.length;
+        fldOffset += i->second.length;
+    }
 
-    for( DbfRecordSet::iterator i = mDbfRecordSet.begin(); i != mDbfRecordSet.end(); i++ ) {
-        char* recordBuffer = 0;
-        try {
-            recordBuffer = new char[ recLen ];
+    // Spool entries: field number, value length and value, or the end of record mark
+    std::vector<char> recordBuffer( recLen, 0x20 ); // Record deleted flag and blank fields
+    char value[ 256 ];
+    Int16Field id;
+    Int8Field valueLength;
+    int records = 0;
+    while( spool.read( id.b, sizeof( id.b ) ) ) {
+        if( DBF_END_OF_RECORD == id.i ) {
+            os.write( &recordBuffer[ 0 ], recLen );
+            std::fill( recordBuffer.begin(), recordBuffer.end(), 0x20 );
+            records++;
         }
-        catch( ... ) {
-            sosicon::logstream << "Memory allocation error\n";
+        else if( id.i < fieldOffset.size() &&
+                 spool.read( valueLength.b, sizeof( valueLength.b ) ) &&
+                 spool.read( value, valueLength.i ) )
+        {
+            char* field = &recordBuffer[ fieldOffset[ id.i ] ];
+            std::copy( value, value + valueLength.i, field );
+            std::fill( field + valueLength.i, field + fieldLength[ id.i ], ' ' );
         }
-        int fldOffset = 0;
-        recordBuffer[ fldOffset++ ] = 0x20; // Record deleted flag
-        DbfRecord& rec = *i;
-        for( DbfFieldLengths::iterator j = mDbfFieldLengths.begin(); j != mDbfFieldLengths.end(); j++ ) {
-            std::string fieldName = j->first;
-            std::string fieldValue;
-            if( rec.find( fieldName ) != rec.end() ) {
-                fieldValue = rec[ fieldName ];
-            }
-            int fieldLength = mDbfFieldLengths[ fieldName ];
-            fieldValue.resize( fieldLength, ' ' );
-            const char* sz = fieldValue.c_str();
-            std::copy( sz, sz + fieldLength, &recordBuffer[ fldOffset ] );
-            fldOffset += fieldLength;
+        else {
+            break;
         }
-        std::copy( recordBuffer, recordBuffer + recLen, &mDbfBuffer[ pos ] );
-        delete [ ] recordBuffer;
-        pos += recLen;
     }
     // End of file
-    mDbfBuffer[ pos ] = 0x1a;
+    os.put( 0x1a );
+
+    return records == mDbfRecordCount && spool.eof();
 }
 
 void sosicon::shape::Shapefile::
 buildShx() {
 
-    mShxBufferSize = 8 * mDbfRecordSet.size();
-    try {
-        mShxBuffer = 0;
-        mShxBuffer = new char [ mShxBufferSize ];
-    }
-    catch( ... ) {
-        sosicon::logstream << "Memory allocation error\n";
-    }
-
     Int32Field fileLength;
-    fileLength.i = static_cast< uint32_t >( sizeof( mShxHeader ) + mShxBufferSize ) / 2;
-    std::copy( &mShpHeader[ 0 ], &mShpHeader[ 99 ], mShxHeader );
-    byteOrder::toBigEndian( fileLength.b,   &mShxHeader[ 24 ], 4 );
-    int pos = 0;
-
-    for( ShxOffsets::iterator i = mShxOffsets.begin(); i != mShxOffsets.end(); i++ ) {
-        byteOrder::toBigEndian( ( *i ).offset.b,  &mShxBuffer[ pos +  0 ], 4 ); // Offset
-        byteOrder::toBigEndian( ( *i ).length.b,  &mShxBuffer[ pos +  4 ], 4 ); // Length
-        pos += 8;
-    }
+    fileLength.i = static_cast< uint32_t >( sizeof( mShxHeader ) + 8 * mRecordNumber ) / 2;
+    std::copy( &mShpHeader[ 0 ], &mShpHeader[ 0 ] + sizeof( mShpHeader ), mShxHeader );
+    byteOrder::toBigEndian( fileLength.i,   &mShxHeader[ 24 ] );
 }
 
-int sosicon::shape::Shapefile::
-expandShpBuffer( int byteLen ) {
+void sosicon::shape::Shapefile::
+appendFile( const std::string& extension, std::vector<char>& buffer ) {
+
+    if( !mFailed && !buffer.empty() ) {
+        std::string fileName = mBasePath + extension;
+        std::ofstream fs( fileName.c_str(), std::ios::out | std::ios::app | std::ios::binary );
+        if( fs.is_open() ) {
+            fs.write( &buffer[ 0 ], buffer.size() );
+            fs.close();
+        }
+        if( !fs ) {
+            sosicon::logstream << "Error: Could not write " << fileName << "\n";
+            mFailed = true;
+        }
+    }
+    buffer.clear();
+}
 
-    int offset = 0;
-    size_t chunkSize = 0;
+void sosicon::shape::Shapefile::
+flushFiles() {
+    appendFile( ".shp", mShpFileBuffer );
+    appendFile( ".shx", mShxFileBuffer );
+    appendFile( ".dbf.tmp", mDbfFileBuffer );
+}
 
-    if( 0 == mShpBufferSize ) {
-        chunkSize = 1024;
-    }
-    else if( mShpBufferSize < ( MAX_BUFFER_CHUNK_SIZE / 2 ) ) {
-        chunkSize = mShpBufferSize * 2;
-    }
-    else {
-        chunkSize = MAX_BUFFER_CHUNK_SIZE;
+void sosicon::shape::Shapefile::
+openFiles() {
+
+    mShpFileBuffer.reserve( FILE_BUFFER_SIZE );
+    mShxFileBuffer.reserve( FILE_BUFFER_SIZE );
+    mDbfFileBuffer.reserve( FILE_BUFFER_SIZE );
+
+    // Placeholder headers, overwritten when the file is completed. The spool has no header.
+    const char placeholder[ 100 ] = { 0 };
+    const char* ext[ 3 ] = { ".shp", ".shx", ".dbf.tmp" };
+    const size_t placeholderSize[ 3 ] = { sizeof( placeholder ), sizeof( placeholder ), 0 };
+    mFilesCreated = true;
+    for( int i = 0; i < 3 && !mFailed; i++ ) {
+        std::string fileName = mBasePath + ext[ i ];
+        std::ofstream fs( fileName.c_str(), std::ios::out | std::ios::trunc | std::ios::binary );
+        fs.write( placeholder, placeholderSize[ i ] );
+        fs.close();
+        if( !fs ) {
+            sosicon::logstream << "Error: Could not create " << fileName << "\n";
+            mFailed = true;
+        }
     }
+}
+
+void sosicon::shape::Shapefile::
+removeFiles() {
+    std::remove( ( mBasePath + ".shp" ).c_str() );
+    std::remove( ( mBasePath + ".shx" ).c_str() );
+    std::remove( ( mBasePath + ".dbf" ).c_str() );
+    std::remove( ( mBasePath + ".dbf.tmp" ).c_str() );
+    mFilesCreated = false;
+}
 
-    if( 0 == mShpSize ) {
-        mShpSize = byteLen;
-        while( mShpBufferSize < static_cast< size_t >( mShpSize ) ) {
-            mShpBufferSize += chunkSize;
+void sosicon::shape::Shapefile::
+writeFileHeader( const std::string& extension, const char* header, size_t size ) {
+
+    if( !mFailed ) {
+        std::string fileName = mBasePath + extension;
+        std::fstream fs( fileName.c_str(), std::ios::in | std::ios::out | std::ios::binary );
+        if( fs.is_open() ) {
+            fs.seekp( 0 );
+            fs.write( header, size );
+            fs.close();
+        }
+        if( !fs ) {
+            sosicon::logstream << "Error: Could not write " << fileName << "\n";
+            mFailed = true;
         }
+    }
+}
+
+int sosicon::shape::Shapefile::
+reserveShpRecord( int byteLen ) {
+
+    if( mShpBufferSize < static_cast< size_t >( byteLen ) ) {
+        size_t bufferSize = std::max( static_cast< size_t >( byteLen ), mShpBufferSize * 2 );
+        delete [ ] mShpBuffer;
+        mShpBuffer = 0;
+        mShpBufferSize = 0;
         try {
-            mShpBuffer = new char [ mShpBufferSize ];
+            mShpBuffer = new char [ bufferSize ];
         }
         catch( ... ) {
             sosicon::logstream << "Memory allocation error\n";
             throw;
         }
+        mShpBufferSize = bufferSize;
     }
-    else {
-        offset = mShpSize;
-        mShpSize += byteLen;
-        if( mShpBufferSize < static_cast< size_t >( mShpSize ) ) {
-            while( mShpBufferSize < static_cast< size_t >( mShpSize ) ) {
-                mShpBufferSize += chunkSize;
-            }
-            char* oldBuffer = mShpBuffer;
-            try {
-                mShpBuffer = new char [ mShpBufferSize ];
-            }
-            catch( ... ) {
-                sosicon::logstream << "Memory allocation error\n";
-                throw;
-            }
-            std::copy( oldBuffer, oldBuffer + offset, mShpBuffer );
-            delete [ ] oldBuffer;
-        }
-    }
-    return offset;
+    return 0;
+}
+
+void sosicon::shape::Shapefile::
+writeShpRecord( int byteLen, int contentLen ) {
+
+    ShxIndex shxIndex;
+    shxIndex.offset.i = 50 + ( mShpSize / 2 );
+    shxIndex.length.i = contentLen;
+
+    char shxRecord[ 8 ];
+    byteOrder::toBigEndian( shxIndex.offset.i, &shxRecord[ 0 ] ); // Offset
+    byteOrder::toBigEndian( shxIndex.length.i, &shxRecord[ 4 ] ); // Length
+
+    mShxFileBuffer.insert( mShxFileBuffer.end(), shxRecord, shxRecord + sizeof( shxRecord ) );
+    mShpFileBuffer.insert( mShpFileBuffer.end(), mShpBuffer, mShpBuffer + byteLen );
+    mShpSize += byteLen;
 }
 
 void sosicon::shape::Shapefile::
-extractDbfFields( ISosiElement* sosi, DbfRecord& rec ) {
+extractDbfFields( ISosiElement* sosi ) {
 
     std::string field;
     std::string data;
@@ -502,78 +571,50 @@ extractDbfFields( ISosiElement* sosi, DbfRecord& rec ) {
         child = src.element();
         if( child->getType() != sosi::sosi_element_ne ) {
             data = utils::trim( child->getData() );
-            saveToDbf( rec, child->getName(), data );
-            extractDbfFields( child, rec );
+            saveToDbf( child->getName(), data );
+            extractDbfFields( child );
         }
     }
 }
 
 void sosicon::shape::Shapefile::
 insertDbfRecord( ISosiElement* sosi ) {
-    DbfRecord rec;
-    saveToDbf( rec, "SOSI_ID", sosi->getSerial() );
-    saveToDbf( rec, "TYPE", sosi->getName() );
-    extractDbfFields( sosi, rec );
-    mDbfRecordSet.push_back( rec );
-}
-
-void sosicon::shape::Shapefile::
-insertShxOffset( int contentLen ) {
-    ShxIndex shxIndex;
-    shxIndex.offset.i = 50 + ( mShpSize / 2 );
-    shxIndex.length.i = contentLen;
-    mShxOffsets.push_back( shxIndex );
+    saveToDbf( "SOSI_ID", sosi->getSerial() );
+    saveToDbf( "TYPE", sosi->getName() );
+    extractDbfFields( sosi );
+    Int16Field endOfRecord = { DBF_END_OF_RECORD };
+    mDbfFileBuffer.insert( mDbfFileBuffer.end(), endOfRecord.b, endOfRecord.b + sizeof( endOfRecord.b ) );
+    mDbfRecordCount++;
 }
 
 void sosicon::shape::Shapefile::
-saveToDbf( DbfRecord& rec, std::string field, std::string data ) {
+saveToDbf( const std::string& field, const std::string& data ) {
     int length = static_cast< int >( data.size() );
     if( !data.empty() && length < 254 ) {
-        if( mDbfFieldLengths.find( field ) != mDbfFieldLengths.end() ) {
-            mDbfFieldLengths[ field ] = std::max( mDbfFieldLengths[ field ], length );
+        DbfFields::iterator i = mDbfFields.find( field );
+        if( i != mDbfFields.end() ) {
+            i->second.length = std::max( i->second.length, length );
         }
         else {
-            mDbfFieldLengths[ field ] = length;
+            DbfField f = { static_cast< uint16_t >( mDbfFields.size() ), length };
+            i = mDbfFields.insert( std::make_pair( field, f ) ).first;
         }
-        rec[ field ] = data;
+        Int16Field id = { i->second.id };
+        Int8Field valueLength = { static_cast< uint8_t >( length ) };
+        mDbfFileBuffer.insert( mDbfFileBuffer.end(), id.b, id.b + sizeof( id.b ) );
+        mDbfFileBuffer.insert( mDbfFileBuffer.end(), valueLength.b, valueLength.b + sizeof( valueLength.b ) );
+        mDbfFileBuffer.insert( mDbfFileBuffer.end(), data.begin(), data.end() );
     }
 }
 
-void sosicon::shape::Shapefile::
-writeShp( std::ostream &os ) {
-    os.write( mShpHeader, sizeof( mShpHeader ) );
-    os.write( mShpBuffer, mShpSize );
-}
-
-void sosicon::shape::Shapefile::
-writeShx( std::ostream &os ) {
-    os.write( mShxHeader, sizeof( mShxHeader ) );
-    os.write( mShxBuffer, mShxBufferSize );
-}
-
-void sosicon::shape::Shapefile::
-writeDbf( std::ostream &os ) {
-    os.write( mDbfHeader, sizeof( mDbfHeader ) );
-    os.write( mDbfBuffer, mDbfBufferSize );
-}
-
 void sosicon::shape::Shapefile::
 writePrj( std::ostream &os ) {
-    sosi::SosiTranslationTable ttbl;
-    sosi::SosiElementSearch srcHeader( sosi::sosi_element_head );
-    sosi::SosiElementSearch srcTranspar( sosi::sosi_element_transpar );
-    sosi::SosiElementSearch srcKoordsys( sosi::sosi_element_coordsys );
-    if( mSosiTree &&
-        mSosiTree->getChild( srcHeader ) &&
-        srcHeader.element()->getChild( srcTranspar ) &&
-        srcTranspar.element()->getChild( srcKoordsys ) )
-    {
+    // Grid of the written coordinates, which may have been transformed (-srid)
+    int srid = mHeader->getSrid();
+    if( srid > 0 ) {
+        sosi::SosiTranslationTable ttbl;
         std::stringstream ss;
-        int coordSys;
-        ss << srcKoordsys.element()->getData();
-        ss >> coordSys;
-        if( coordSys > 0 && coordSys <= sosi::MAX_COORDSYS_TABLE ) {
-            os << ttbl.sysCodeToCoordSys( coordSys ).prjString();
-        }
+        ss << srid;
+        os << ttbl.sridToCoordSys( ss.str() ).prjString();
     }
 }
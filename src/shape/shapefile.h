@@ -20,6 +20,8 @@
 
 #include <algorithm>
 #include <ctime>
+#include <cstdio>
+#include <fstream>
 #include <string>
 #include <vector>
 #include <iostream>
@@ -28,11 +30,13 @@
 #include "../byte_order.h"
 #include "../utils.h"
 #include "../coordinate_collection.h"
+#include "../geometry_cache.h"
 #include "../sosi/sosi_types.h"
 #include "../sosi/sosi_element.h"
 #include "../sosi/sosi_element_search.h"
+#include "../sosi/sosi_header_context.h"
+#include "../sosi/sosi_translation_table.h"
 #include "../interface/i_shapefile.h"
-#include "../interface/i_coordinate.h"
 
 namespace sosicon {
 
@@ -48,47 +52,72 @@ namespace sosicon {
         //! Shapefile implementation
         /*!
             Wraps all ESRI Shape output files (shp, shx, dbf, prj...) in one class.
+            The shp and shx files are created when the first element is inserted, and
+            records are appended to them as they are built. Only the running file
+            length, bounding rectangle and a small output buffer are kept in memory, and
+            the file headers are rewritten in place by complete(). The files are only open
+            while a full buffer is appended to them, so a conversion with any number of
+            shapefiles needs no more than one file descriptor for each.
+
+            The DBF field lengths are not known until all elements have been inserted, so
+            the attributes are appended to a spool file (basePath.dbf.tmp) instead, one
+            variable-length record per element, and the DBF file is written from the spool
+            by complete().
             \author Espen Andersen
             \copyright GNU General Public License
         */
         class Shapefile : public IShapefile {
 
-            //! Buffer allocation size
+            //! Output file buffer size
             /*!
-                To speed things up, heap allocations are done in increasingly large
-                chunks. This parameters defines how many bytes to request for the largest
-                buffer expansion.
+                Size of the output buffer for each of the shp, shx and DBF spool files. A conversion
+                may build many shapefiles at the same time, one for each OBJTYPE and
+                geometry, so the buffers are kept moderate.
             */
-            static const int  MAX_BUFFER_CHUNK_SIZE = 262144;
+            static const int FILE_BUFFER_SIZE = 32768;
+
+            //! Field number marking the end of a record in the DBF spool
+            static const uint16_t DBF_END_OF_RECORD = 0xffff;
 
             ISosiElement* mSosiTree;   //!< SOSI source
 
+            const sosi::HeaderContext* mHeader; //!< Header context of the SOSI source
+
+            GeometryCache* mCache;     //!< Decoded curves of the SOSI source, or 0
+
+            std::string mBasePath;     //!< Output file path, without extension
+
             std::vector<std::string> mFilterSosiId;       //!< List of IDs of SOSI elements to be exported, if specified
             std::vector<std::string> mFilterSosiObjTypes; //!< Objtypes of selected elements to be exported, if specified
 
+            std::vector<char> mShpFileBuffer; //!< SHP output not yet appended to the file
+            std::vector<char> mShxFileBuffer; //!< SHX output not yet appended to the file
+            std::vector<char> mDbfFileBuffer; //!< DBF records not yet appended to the spool file
+
+            bool mFilesCreated;        //!< True while output files of an incomplete shapefile exist on disk
+            bool mFailed;              //!< True if an output file could not be written
+
             char mShpHeader[ 100 ];    //!< Main SHP file header
-            char* mShpBuffer;          //!< SHP file payload
-            int mShpSize;              //!< Data length of SHP file buffer
-            size_t mShpBufferSize;     //!< Allocated buffer length
+            char* mShpBuffer;          //!< SHP record in process
+            int mShpSize;              //!< Data length of SHP file payload written so far
+            size_t mShpBufferSize;     //!< Allocated record buffer length
 
             char mShxHeader[ 100 ];    //!< Index file header
-            char* mShxBuffer;          //!< Index file payload
-            size_t mShxBufferSize;     //!< Length of SHX file buffer
 
             char mDbfHeader[ 32 ];     //!< dBase file header
-            char* mDbfBuffer;          //!< dBase file payload
-            size_t mDbfBufferSize;     //!< Length of dBase file buffer
 
             int mRecordNumber;         //!< Number of current record in process
 
+            ShapeType mShapeType;      //!< Geometry type of the shapefile, given by the first element inserted
+
             double mXmin;              //!< Minimum bounding rectangle, min X
             double mYmin;              //!< Minimum bounding rectangle, min Y
             double mXmax;              //!< Minimum bounding rectangle, max X
             double mYmax;              //!< Minimum bounding rectangle, max Y
 
-            DbfFieldLengths mDbfFieldLengths; //!< Accumulation of DBF fields and their lenghts
-            DbfRecordSet mDbfRecordSet;       //!< All DBF records
-            ShxOffsets mShxOffsets;           //!< Index file offsets
+            DbfFields mDbfFields;      //!< Accumulation of DBF fields and their lenghts
+
+            int mDbfRecordCount;       //!< Number of DBF records in the spool
 
             //! Expand MBR to contain Coordinate collection
             /*!
@@ -106,8 +135,8 @@ namespace sosicon {
             //! Create SHP element
             /*!
                 If a shapefile equivalent to current SOSI element exists, this method
-                creates the low-level shape data structure and writes it to the output
-                buffer Shapefile::mShpBuffer.
+                creates the low-level shape data structure and appends it to the SHP and
+                SHX files.
                 \param sosi Pointer to SOSI element to be converted to shape.
                 \param type Type of Shapefile geometry equivalent to the
                             SOSI element to be converted.
@@ -117,7 +146,7 @@ namespace sosicon {
             //! Populate shape header struct
             /*!
                 Creates master file header for SHP and SHX file parts and writes it
-                to the DBF header buffer Shapefile::mDbfHeader.
+                to the SHP header buffer Shapefile::mShpHeader.
                 \param type The shape type for current file.
             */
             void buildShpHeader( ShapeType type );
@@ -151,7 +180,7 @@ namespace sosicon {
                 Build shapefile coordinate from the first coordinate pair in the
                 provided CoordinateCollection and update buffer position.
                 \param pos Reference to an integer holding current position within
-                           the shapefile buffer Shapefile::mShpBuffer. The position
+                           the record buffer Shapefile::mShpBuffer. The position
                            is updated to reflect the first "free" position after
                            writing to the buffer.
                 \param cc The coordinate collection from which the first coordinate
@@ -164,19 +193,20 @@ namespace sosicon {
                 Build shapefile coordinate from the provided coordinate pair and
                 update buffer position.
                 \param pos Reference to an integer holding current position within
-                           the shapefile buffer Shapefile::mShpBuffer. The position
+                           the record buffer Shapefile::mShpBuffer. The position
                            is updated to reflect the first "free" position after
                            writing to the buffer.
-                \param c The coordinate to be written to the buffer.
+                \param x East coordinate.
+                \param y North coordinate.
             */
-            void buildShpRecCoordinate( int& pos, ICoordinate* c );
+            void buildShpRecCoordinate( int& pos, double x, double y );
 
             //! Write multiple coordinate pairs to shapefile buffer
             /*!
                 Build shapefile coordinate from a collection of coordinate pairs and
                 update buffer position.
                 \param pos Reference to an integer holding current position within
-                           the shapefile buffer Shapefile::mShpBuffer. The position
+                           the record buffer Shapefile::mShpBuffer. The position
                            is updated to reflect the first "free" position after
                            writing to the buffer.
                 \param cc The coordinate collection to be written to the buffer.
@@ -189,7 +219,7 @@ namespace sosicon {
                 geometry types. This method writes the common part to the buffer.
                 \see Shapefile::buildShpRecHeaderExtended
                 \param pos Reference to an integer holding current position within
-                           the shapefile buffer Shapefile::mShpBuffer. The position
+                           the record buffer Shapefile::mShpBuffer. The position
                            is updated to reflect the first "free" position after
                            writing to the buffer.
                 \param contentLength Length of the record in 16-bit words, record
@@ -204,7 +234,7 @@ namespace sosicon {
                 shapefile record header.
                 \see Shapefile::buildShpRecHeaderCommonPart
                 \param pos Reference to an integer holding current position within
-                           the shapefile buffer Shapefile::mShpBuffer. The position
+                           the record buffer Shapefile::mShpBuffer. The position
                            is updated to reflect the first "free" position after
                            writing to the buffer.
                 \param cc The coordinate collection containing the points for the
@@ -220,7 +250,7 @@ namespace sosicon {
                 This method constructs the list of offset values for the multipart
                 geometry and writes it to the shapefile buffer.
                 \param pos Reference to an integer holding current position within
-                           the shapefile buffer Shapefile::mShpBuffer. The position
+                           the record buffer Shapefile::mShpBuffer. The position
                            is updated to reflect the first "free" position after
                            writing to the buffer.
                 \param cc The coordinate collection containing the points for the
@@ -228,14 +258,14 @@ namespace sosicon {
             */
             void buildShpRecHeaderOffsets( int& pos, CoordinateCollection& cc );
 
-            //! Create DBF file content
+            //! Create DBF file
             /*!
                 Part of DBF creation.
-                Creates the dBase file content for current shapefile. Populates
+                Creates the dBase file for current shapefile, writing the records one
+                by one from the spool file, which is then removed.
                 \see Shapefile::buildDbfHeader
                 \see Shapefile::buildDbfFieldDescriptor
                 \see Shapefile::buildDbfRecordSection
-                Shapefile::mDbfBuffer.
             */
             void buildDbf();
 
@@ -247,12 +277,9 @@ namespace sosicon {
                 \see Shapefile::buildDbf
                 \see Shapefile::buildDbfHeader
                 \see Shapefile::buildDbfRecordSection
-                \param pos Reference to an integer holding current position within
-                           the shapefile buffer Shapefile::mShpBuffer. The position
-                           is updated to reflect the first "free" position after
-                           writing to the buffer.
+                \param os Output DBF file.
             */
-            void buildDbfFieldDescriptor( int& pos );
+            void buildDbfFieldDescriptor( std::ostream& os );
             
             //! Create DBF header
             /*!
@@ -268,134 +295,155 @@ namespace sosicon {
             //! Create DBF records
             /*!
                 Part of DBF creation.
-                Iterates through all records and writes each one to the DBF buffer
-                Shapefile::mDbfBuffer.
+                Reads the records from the spool and writes each one to the DBF file,
+                padding the fields to their final lengths.
                 \see Shapefile::buildDbf
                 \see Shapefile::buildDbfFieldDescriptor
                 \see Shapefile::buildDbfHeader
-                \param pos Reference to an integer holding current position within
-                           the shapefile buffer Shapefile::mShpBuffer. The position
-                           is updated to reflect the first "free" position after
-                           writing to the buffer.
+                \param spool DBF spool file.
+                \param os Output DBF file.
                 \param recLen Length of a single record, in bytes.
+                \return True if all records were read from the spool.
             */
-            void buildDbfRecordSection( int& pos, int recLen );
+            bool buildDbfRecordSection( std::istream& spool, std::ostream& os, int recLen );
 
-            //! Create SHX file content
+            //! Create SHX header
             /*!
                 Part of SHX index creation.
-                Builds the shapefile index from the Shapefile::mShxOffsets entries and
-                writes it to the SHX buffer Shapefile::mShxBuffer and the SHX header
-                Shapefile::mShxHeader.
-                \see Shapefile::insertShxOffset
+                Copies the SHP header to the SHX header Shapefile::mShxHeader, with the
+                file length of the index.
             */
             void buildShx();
 
-            //! Append offset value to SHX (index)
+            //! Append buffered output to file
             /*!
-                For each shapefile record, it's offset within the main file is pushed
-                to the Shapefile::mShxOffsets vector.
-                \param contentLen Length of the shapefile record content, in 16-bit
-                                  words, record header not included.
+                Opens the file in append mode, writes the buffer and closes the file again.
+                On failure, the shapefile is marked as failed and nothing more is written.
+                \param extension File name extension, appended to the base path.
+                \param buffer Output to be written. The buffer is emptied.
             */
-            void insertShxOffset( int contentLen );
+            void appendFile( const std::string& extension, std::vector<char>& buffer );
+
+            //! Append buffered output to the SHP, SHX and DBF spool files
+            void flushFiles();
 
-            //! Expand shp payload buffer
+            //! Create SHP, SHX and DBF spool output files
             /*!
-                The shape buffer grows by larger chunks as it is gradually filled up with
-                smaller blocks. For each expansion, the allocation size is doubled, until
-                it reaches MAX_BUFFER_CHUNK_SIZE bytes. This is a tradeoff between execution
-                time and memory consumption. For larger files, there will be relatively few
-                buffer re-allocations and block transfers, in order to save time. For smaller
-                files there will be more frequent re-allocations to save memory.
-                \param byteLen The exact length in bytes of the amount of data about to be
-                               written to the shapefile buffer. If the current buffer is too
-                               small to hold the new block, it will be expanded.
+                Creates the files, SHP and SHX with placeholder headers to be overwritten by
+                complete().
             */
-            int expandShpBuffer( int byteLen );
+            void openFiles();
+
+            //! Remove output files
+            /*!
+                Removes the files of a shapefile that was not completed, or could not be
+                written.
+            */
+            void removeFiles();
+
+            //! Overwrite file header
+            /*!
+                Writes the header at the beginning of an existing output file.
+                \param extension File name extension, appended to the base path.
+                \param header The header.
+                \param size Length of the header, in bytes.
+            */
+            void writeFileHeader( const std::string& extension, const char* header, size_t size );
+
+            //! Prepare record buffer
+            /*!
+                Makes sure the record buffer Shapefile::mShpBuffer is large enough to hold
+                the next record. The buffer is reused for all records, and only grows when
+                a record is larger than any previous one.
+                \param byteLen The exact length in bytes of the record about to be built.
+                \return Start position of the record within the buffer.
+            */
+            int reserveShpRecord( int byteLen );
+
+            //! Write record to SHP and SHX files
+            /*!
+                Appends the record in Shapefile::mShpBuffer to the SHP file, and its offset
+                and length to the SHX file.
+                \param byteLen Length of the record in bytes, record header included.
+                \param contentLen Length of the shapefile record content, in 16-bit
+                                  words, record header not included.
+            */
+            void writeShpRecord( int byteLen, int contentLen );
 
             //! Recursive func to extract SOSI field data
             /*!
-                Traverses the SOSI element, mining the data fields and stores them in the
-                provided record set container.
+                Traverses the SOSI element, mining the data fields and appends them to the
+                current record in the DBF spool.
                 \see Shapefile::insertDbfRecord
                 \param sosi The SOSI element (sub tree) to extract data fields from.
-                \param rec The recordset container to populate with data.
             */
-            void extractDbfFields( ISosiElement* sosi, DbfRecord& rec );
+            void extractDbfFields( ISosiElement* sosi );
 
             //! Create and insert DBF record
             /*!
                 Prepares dBase record for current SOSI element. Creates the two mandatory
                 fields "SOSI_ID" and "TYPE", before it calls Shapefil::extractDbfFields to
-                retrieve the other data fields. The record is then inserted into the
-                Shapefile::mDbfRecordSet member.
+                retrieve the other data fields. The record is appended to the DBF spool
+                buffer Shapefile::mDbfFileBuffer.
                 \see Shapefil::extractDbfFields
                 \param sosi The SOSI element (sub tree) to extract data fields from.
             */
             void insertDbfRecord( ISosiElement* sosi );
 
-            //! Shapefile polys must have clockwise-ordered vertices
+            //! Append DBF field to current record
             /*!
-                This is one of the core functions for handling polygons. Tests the direction
-                for SOSI coordinates, and reverses them if they are in the wrong order with
-                respect to the Shapefile format epscification.
-
-                \note The direction of the vertices in a SOSI polygon is not significant, whist
-                in a Shapefile polygon, it is crucial. The vertices in the outer polygon should
-                always be ordered in a clockwise direction, while the holes or islands must be
-                ordered in a counter-clockwise direction.
-
-                \param neLst List of SOSI NorthEast elements describing current multipart
-                             gemoetry (polygon with holes/islands).
+                Appends data to the DFB record in the spool, updating list of field names
+                and lengths. If a field occurs more than once in the record, the last value
+                is the one exported.
             */
-            std::vector<ICoordinate*> getNormalized( sosi::NorthEastList& neLst );
-            
-            //! Update or insert new DBF field
-            /*!
-                Appends or updates data for the DFB record, updating list of field names
-                and lengths.
-            */
-            void saveToDbf( DbfRecord& rec, std::string field, std::string data );
+            void saveToDbf( const std::string& field, const std::string& data );
 
         public:
 
             //! Constructor
             /*!
                 Inlined, initializes native members.
+                \param basePath Output file path, without extension.
+                \param header Header context of the SOSI file the elements are taken from.
+                \param cache Decoded curves of the SOSI file, shared by all shapefiles built
+                       from the file, or 0 if curves shall not be cached.
             */
-            Shapefile() :
+            Shapefile( std::string basePath, const sosi::HeaderContext& header, GeometryCache* cache = 0 ) :
                 mSosiTree( 0 ),
+                mHeader( &header ),
+                mCache( cache ),
+                mBasePath( basePath ),
+                mFilesCreated( false ),
+                mFailed( false ),
                 mShpBuffer( 0 ),
                 mShpSize( 0 ),
                 mShpBufferSize( 0 ),
-                mShxBuffer( 0 ),
-                mShxBufferSize( 0 ),
-                mDbfBuffer( 0 ),
-                mDbfBufferSize( 0 ),
                 mRecordNumber( 0 ),
+                mShapeType( shape_type_none ),
                 mXmin( +99999999 ),
                 mYmin( +99999999 ),
                 mXmax( -99999999 ),
-                mYmax( -99999999 ) { };
+                mYmax( -99999999 ),
+                mDbfRecordCount( 0 ) { };
 
             //! Destructor
+            /*!
+                Output files of a shapefile that was never completed are incomplete and will
+                be removed.
+            */
             virtual ~Shapefile();
 
             //! Described in IShapefile
-            virtual int build( ISosiElement* sosiTree, std::string objType, sosi::ElementType geomType );
+            virtual void insert( ISosiElement* sosi );
 
             //! Described in IShapefile
-            virtual void filterSosiId( std::vector<std::string> sosiId ) { mFilterSosiId = sosiId; };
-
-            //! Described in IShapefileDbfPart
-            virtual void writeDbf( std::ostream &os );
+            virtual int complete( ISosiElement* sosiTree );
 
-            //! Described in IShapefileShpPart
-            virtual void writeShp( std::ostream &os );
+            //! Described in IShapefile
+            virtual void filterSosiId( std::vector<std::string> sosiId ) { mFilterSosiId = sosiId; };
 
-            //! Described in IShapefileShxPart
-            virtual void writeShx( std::ostream &os );
+            //! Described in IShapefile
+            virtual std::string getBasePath() { return mBasePath; };
 
             //! Described in IShapefilePrjPart
             virtual void writePrj( std::ostream &os );
@@ -85,10 +85,13 @@ namespace sosicon {
             Int32Field length;
         };
 
-        typedef std::map<std::string, std::string> DbfRecord;
-        typedef std::vector<DbfRecord> DbfRecordSet;
-        typedef std::map<std::string, int> DbfFieldLengths;
-        typedef std::vector<ShxIndex> ShxOffsets;
+        //! DBF field, accumulated as records are inserted
+        struct DbfField {
+            uint16_t id; //!< Field number in the record spool, in order of appearance
+            int length;  //!< Length of the longest value
+        };
+
+        typedef std::map<std::string, DbfField> DbfFields;
 
     }; // namespace shape
 }; // namespace sosicon
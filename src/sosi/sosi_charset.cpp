@@ -15,21 +15,34 @@
  *  You should have received a copy of the GNU General Public License
  *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
-#include "sosi_charset_singleton.h"
+#include "sosi_charset.h"
 
-sosicon::sosi::SosiCharsetSingleton* sosicon::sosi::SosiCharsetSingleton::mInstance = 0;
+sosicon::sosi::SosiCharset::
+SosiCharset() {
+    mCharset = sosi_charset_undetermined;
+    mSosiElement = 0;
+    mInitialized = false;
+}
 
-sosicon::sosi::SosiCharsetSingleton::
-SosiCharsetSingleton() {
+sosicon::sosi::SosiCharset::
+SosiCharset( const std::string& name ) {
     mCharset = sosi_charset_undetermined;
     mSosiElement = 0;
     mInitialized = false;
+    if( !name.empty() ) {
+        setEncodingName( name );
+    }
 }
 
-void sosicon::sosi::SosiCharsetSingleton::
+void sosicon::sosi::SosiCharset::
 init( ISosiElement* sosiElement ) {
     mSosiElement = sosiElement;
-    mCharsetName = sosiElement->getData();
+    setEncodingName( sosiElement->getData() );
+}
+
+void sosicon::sosi::SosiCharset::
+setEncodingName( const std::string& name ) {
+    mCharsetName = name;
     mInitialized = true;
          if( "ANSI"       == mCharsetName ) mCharset = sosi_charset_ansi;
     else if( "DECN7"      == mCharsetName ) mCharset = sosi_charset_decn7;
@@ -41,8 +54,8 @@ init( ISosiElement* sosiElement ) {
     else                                    mCharset = sosi_charset_iso8859_1;
 }
 
-std::string sosicon::sosi::SosiCharsetSingleton::
-toIso8859_1( const std::string& str ) {
+std::string sosicon::sosi::SosiCharset::
+toIso8859_1( const std::string& str ) const {
     unsigned char const* contable;
     switch( mCharset ) {
         case sosi_charset_ansi:
@@ -71,7 +84,7 @@ toIso8859_1( const std::string& str ) {
     return res;
 }
 
-std::string sosicon::sosi::SosiCharsetSingleton::
+std::string sosicon::sosi::SosiCharset::
 utf8ToIso8859_1( const char *in ) {
     std::string out;
     if ( in == NULL ) {
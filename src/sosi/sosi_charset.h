@@ -15,8 +15,8 @@
  *  You should have received a copy of the GNU General Public License
  *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
-#ifndef __SOSI_CHARSET_SINGLETON_H__
-#define __SOSI_CHARSET_SINGLETON_H__
+#ifndef __SOSI_CHARSET_H__
+#define __SOSI_CHARSET_H__
 
 #ifdef _MSC_VER
 #pragma warning ( disable: 4503 )
@@ -109,11 +109,10 @@ namespace sosicon {
 
         //! SOSI Character set
         /*!
-            Implements SOSI character set, as given via the TEGNSETT element.
+            Implements SOSI character set, as given via the TEGNSETT element. Each file has its
+            own character set, held by its element table and header context.
          */
-        class SosiCharsetSingleton : public ISosiHeadMember {
-
-            static SosiCharsetSingleton* mInstance;
+        class SosiCharset : public ISosiHeadMember {
 
             ISosiElement* mSosiElement;
 
@@ -125,46 +124,46 @@ namespace sosicon {
             //! Name of character set
             std::string mCharsetName;
 
-            //! Construct new SOSI Charset element
-            /*!
-                Declared private because it's a singleton.
-            */
-            SosiCharsetSingleton();
-
             //! Quick and dirty conversion from UTF-8 to ISO8859-10
             /*!
                 Invalid characters are dropped. Sorry.
             */
             static std::string utf8ToIso8859_1( const char * in );
 
+            //! Set character set from TEGNSETT value
+            void setEncodingName( const std::string& name );
+
         public:
 
-            static SosiCharsetSingleton* getInstance() {
-                if( 0 == mInstance ) {
-                    mInstance = new SosiCharsetSingleton();
-                }
-                return mInstance;
-            }
+            //! Construct undetermined character set
+            SosiCharset();
 
             //! Destructor
-            virtual ~SosiCharsetSingleton() { }
+            virtual ~SosiCharset() { }
 
             //! Construct new SOSI Charset element
-            SosiCharsetSingleton( ISosiElement* e ) { init( e ); }
+            SosiCharset( ISosiElement* e ) { init( e ); }
+
+            //! Construct character set by name
+            /*!
+                \param name TEGNSETT value, as returned by getEncodingName(). An empty name
+                       gives an undetermined character set.
+             */
+            explicit SosiCharset( const std::string& name );
 
             Charset getEncoding() const { return mCharset; }
 
-            std::string getEncodingName() { return mCharsetName; }
+            std::string getEncodingName() const { return mCharsetName; }
 
-            //! Initialize SOSI Unit element
+            //! Initialize SOSI Charset element
             virtual void init( ISosiElement* e );
 
             virtual bool initialized() { return mInitialized; }
 
             //! Convert string to ISO8859-1 (default Ragel charset)
-            std::string toIso8859_1( const std::string& str );
+            std::string toIso8859_1( const std::string& str ) const;
 
-        }; // class SosiCharsetSingleton
+        }; // class SosiCharset
        /*! @} end group sosi_elements */
 
     } // namespace sosi
@@ -15,33 +15,24 @@
  *  You should have received a copy of the GNU General Public License
  *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
-#ifndef __I_SHAPEFILE_SHX_PART_H__
-#define __I_SHAPEFILE_SHX_PART_H__
-
-#include <iostream>
-#include "i_binary_streamable.h"
-
-namespace sosicon {
-
-    /*!
-        \addtogroup interfaces Interfaces
-        @{
-    */
-    //! Interface: ShapefileShxPart
-    /*!
-        \author Espen Andersen
-        \copyright GNU General Public License
-    */
-    class IShapefileShxPart : public IBinaryStreamable {
-
-    public:
-
-        virtual void writeBinary( std::ostream &os ) { writeShx( os );  }
-
-        virtual void writeShx( std::ostream &os ) = 0;        
-
-    };
-   /*! @} end group interfaces */
-}; // namespace sosicon
-
-#endif
+#include "sosi_coord_sys.h"
+
+sosicon::sosi::SosiCoordSys::
+SosiCoordSys() {
+    mSosiElement = 0;
+    mSysCode = 0;
+    mSrid = 0;
+    mInitialized = false;
+}
+
+void sosicon::sosi::SosiCoordSys::
+init( ISosiElement* sosiElement ) {
+    mSosiElement = sosiElement;
+    std::stringstream ss;
+    ss << sosiElement->getData();
+    mSysCode = 0;
+    ss >> mSysCode;
+    SosiTranslationTable tt;
+    mSrid = std::atoi( tt.sysCodeToCoordSys( mSysCode ).srid().c_str() );
+    mInitialized = true;
+}
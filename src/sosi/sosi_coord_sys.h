@@ -0,0 +1,83 @@
+/*
+ *  This file is part of the command-line tool sosicon.
+ *  Copyright (C) 2014  Espen Andersen, Norwegian Broadcast Corporation (NRK)
+ *
+ *  This is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __SOSI_COORD_SYS_H__
+#define __SOSI_COORD_SYS_H__
+
+#include "../interface/i_sosi_element.h"
+#include "../interface/i_sosi_head_member.h"
+#include "sosi_types.h"
+#include "sosi_translation_table.h"
+#include <cstdlib>
+#include <string>
+#include <sstream>
+
+namespace sosicon {
+
+    //! SOSI
+    namespace sosi {
+
+        /*!
+            \addtogroup sosi_elements SOSI Elements
+            Implemented representation of SOSI file elements.
+            @{
+        */
+
+        //! SOSI coordinate system
+        /*!
+            Implements SOSI coordinate system, as given via the KOORDSYS element.
+         */
+        class SosiCoordSys : public ISosiHeadMember {
+
+            ISosiElement* mSosiElement;
+
+            bool mInitialized;
+
+            int mSysCode;
+
+            int mSrid;
+
+        public:
+
+            //! Construct new SOSI coordinate system element
+            SosiCoordSys();
+
+            //! Destructor
+            virtual ~SosiCoordSys() { }
+
+            //! Construct new SOSI coordinate system element
+            SosiCoordSys( ISosiElement* e ) { init( e ); }
+
+            //! SOSI KOORDSYS code, or 0 if not given
+            int getSysCode() { return mSysCode; }
+
+            //! EPSG code, or 0 if unknown
+            int getSrid() { return mSrid; }
+
+            //! Initnialize SOSI coordinate system element
+            virtual void init( ISosiElement* e );
+
+            virtual bool initialized() { return mInitialized; }
+
+        }; // class SosiCoordSys
+       /*! @} end group sosi_elements */
+
+    } // namespace sosi
+
+} // namespace sosicon
+
+#endif
@@ -16,84 +16,95 @@
  *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include "sosi_element.h"
+#include "sosi_element_table.h"
 
 sosicon::sosi::SosiElement::
-SosiElement( std::string name, std::string serial, std::string data, int level, ISosiElement* root, SosiElementMap& index ) : mIndex( index ) {
-    mName = name;
-    mSerial = serial;
-    mData = data;
-    mLevel = level;
-    mType = mTranslation.sosiNameToType( mName );
-    mObjType = sosi::sosi_objtype_unknown;
-    mRoot = root ? root : this;
-    if( !mSerial.empty() ) {
-        mIndex[ mSerial ] = this;
-    }
+SosiElement() {
+    mTable = 0;
+    mPosition = 0;
+    mParent = -1;
+    mEnd = 0;
+    mObjType = -1;
+    mLevel = 0;
+    mType = sosi_element_unknown;
+    mName = "";
+    mNameLength = 0;
+    mSerial = "";
+    mSerialLength = 0;
+    mData = "";
+    mDataLength = 0;
+    mCoordinates = 0;
+    mCoordinateCount = 0;
 }
 
-void sosicon::sosi::SosiElement::
-addChild( ISosiElement* child ) {
-    if( child->getType() == sosi::sosi_element_objtype ) {
-        mObjTypeStr = child->getData();
-        mObjType = mTranslation.sosiObjNameToType( mObjTypeStr );
-    }
-    mChildren.push_back( child );
-};
+sosicon::sosi::NorthEastSpan sosicon::sosi::SosiElement::
+coordinates() {
+    NorthEastSpan values;
+    values.values = mCoordinates;
+    values.size = mCoordinateCount;
+    return values;
+}
 
-void sosicon::sosi::SosiElement::
-deleteChildren() {
-    for( std::vector<ISosiElement*>::iterator i = mChildren.begin(); i != mChildren.end(); i++ ) {
-        ( *i )->deleteChildren();
-        delete *i;
+std::string sosicon::sosi::SosiElement::
+getData() {
+    if( mDataLength > 0 || 0 == mCoordinateCount ) {
+        return std::string( mData, mDataLength );
     }
+    std::string data;
+    char buf[ 24 ];
+    for( unsigned int i = 0; i < mCoordinateCount; i++ ) {
+        snprintf( buf, sizeof buf, i == 0 ? "%lld" : " %lld", mCoordinates[ i ] );
+        data += buf;
+    }
+    return data;
 }
 
 void sosicon::sosi::SosiElement::
 dump( int indent ) {
     std::string space = std::string( indent, ' ' );
-    sosicon::logstream << space << mName <<  "[ " << mSerial << " ]" << "\n";
-    sosicon::logstream << space << "    -> " << mData << "\n";
-    for( std::vector<ISosiElement*>::iterator i = mChildren.begin(); i != mChildren.end(); i++ ) {
-        ( *i )->dump( indent + 2 );
+    sosicon::logstream << space << getRawName() <<  "[ " << getSerial() << " ]" << "\n";
+    sosicon::logstream << space << "    -> " << getData() << "\n";
+    for( int i = mPosition + 1; i < mEnd; i = mTable->at( i )->mEnd ) {
+        mTable->at( i )->dump( indent + 2 );
     }
 }
 
 sosicon::ISosiElement* sosicon::sosi::SosiElement::
 find( std::string ref ) {
-    ISosiElement* e;
-    try {
-        e = mIndex[ ref ];
-    }
-    catch ( ... ) {
-        e = 0;
+    ISosiElement* root = mTable->getRoot();
+    if( root != this ) {
+        return root->find( ref );
     }
-    return e;
+    return mTable->find( ref );
 }
 
 bool sosicon::sosi::SosiElement::
 nextChild( SosiElementSearch& src ) {
-    SosiChildrenList::size_type n = mChildren.size();
-    bool moreToGo = n > 0;
-    if( moreToGo ) {
-        if( src.element() == 0 ) {
-            src.index( 0 );
-        }
-        if( src.index() < n ) {
-            src.element( mChildren[ src.index() ] );
-            moreToGo = true;
-            src.next();
-        }
-        else {
-            moreToGo = false;
-        }
+    if( src.element() == 0 ) {
+        src.index( mPosition + 1 );
     }
-    return moreToGo;
+    if( static_cast<int>( src.index() ) < mEnd ) {
+        SosiElement* child = mTable->at( static_cast<int>( src.index() ) );
+        src.element( child );
+        src.index( child->mEnd );
+        return true;
+    }
+    return false;
 }
 
 std::string sosicon::sosi::SosiElement::
 getName() {
-    SosiCharsetSingleton* cs = SosiCharsetSingleton::getInstance();
-    return cs->toIso8859_1( mName );
+    return mTable->getCharset().toIso8859_1( getRawName() );
+}
+
+std::string sosicon::sosi::SosiElement::
+getObjType() {
+    return mObjType < 0 ? std::string() : mTable->at( mObjType )->getData();
+}
+
+sosicon::ISosiElement* sosicon::sosi::SosiElement::
+getRoot() {
+    return mTable->getRoot();
 }
 
 bool sosicon::sosi::SosiElement::
@@ -18,12 +18,12 @@
 #ifndef __SOSI_ELEMENT_H__
 #define __SOSI_ELEMENT_H__
 
+#include <cstdio>
 #include <vector>
 #include <string>
 #include "../logger.h"
 #include "sosi_element_search.h"
-#include "sosi_translation_table.h"
-#include "sosi_charset_singleton.h"
+#include "sosi_element_index.h"
 #include "sosi_types.h"
 #include "../interface/i_sosi_element.h"
 
@@ -65,58 +65,75 @@ namespace sosicon {
          */
         ObjType sosiObjNameToType( std::string sosiObjTypeName );
 
+        class SosiElementTable;
+
         //! Basic SOSI element
         /*!
-            Implements basic characteristics of a SOSI element.
+            Implements basic characteristics of a SOSI element. Elements are fixed-size records
+            stored in pre-order in a SosiElementTable, and are created by the table only. The
+            children of an element are the contiguous range of records following it, up to the
+            end of its subtree. Names, serial numbers, data and coordinates are kept in the
+            table's arena.
          */
         class SosiElement : public ISosiElement {
 
-            //! SOSI string translations
-            SosiTranslationTable mTranslation;
+            friend class SosiElementTable;
+
+            //! Table holding the element
+            SosiElementTable* mTable;
+
+            //! Position of current element in table
+            int mPosition;
 
-            //! Current element's data content
-            std::string mData;
+            //! Position of parent element in table, or -1
+            int mParent;
 
-            //! List of children elements
-            SosiChildrenList mChildren;
+            //! Position following the last element of current element's subtree
+            int mEnd;
+
+            //! Position of current element's OBJTYPE child, or -1
+            int mObjType;
 
             //! Current element's nesting level
             int mLevel;
 
-            //! Current element's name
-            std::string mName;
-
             //! Current element's geometric type
             ElementType mType;
 
-            //! Current element's objtype
-            ObjType mObjType;
+            //! Current element's name, not null terminated
+            const char* mName;
+
+            //! Length of mName
+            unsigned int mNameLength;
 
-            //! Current element's objtype
-            std::string mObjTypeStr;
+            //! Current element's serial number if provided, not null terminated
+            const char* mSerial;
 
-            //! Current element's serial number if provided
-            std::string mSerial;
+            //! Length of mSerial
+            unsigned int mSerialLength;
 
-            //! Pointer to root element
-            ISosiElement* mRoot;
+            //! Current element's data content, not null terminated
+            const char* mData;
 
-            //! Reference to parser's lookup table
-            SosiElementMap& mIndex;
+            //! Length of mData
+            unsigned int mDataLength;
+
+            //! Coordinate values decoded by the parser (N\xD8 and N\xD8H only)
+            const long long* mCoordinates;
+
+            //! Number of values in mCoordinates
+            unsigned int mCoordinateCount;
 
             //! Increment to next child in list
             virtual bool nextChild( SosiElementSearch& src );
 
         public:
 
-            //! Construct new SOSI element
-            SosiElement( std::string name, std::string serial, std::string data, int level, ISosiElement* root, SosiElementMap& index );
-
-            //! Insert children element
-            virtual void addChild( ISosiElement* child );
-
-            //! Recursively deletes all children
-            virtual void deleteChildren();
+            //! Construct empty SOSI element
+            /*!
+                Elements are set up by SosiElementTable::append().
+             */
+            SosiElement();
 
             //! Debug function
             virtual void dump( int indent = 0 );
@@ -124,9 +141,7 @@ namespace sosicon {
             //! Find element by reference
             virtual ISosiElement* find( std::string ref );
 
-            std::vector<ISosiElement*>& children() { return mChildren; };
-			
-			//! Get next child in list
+            //! Get next child in list
             /*!
                 Always pass a null pointer to start iterating through the children list.
                 The referenced pointer will point to the next child in list when the function returns.
@@ -135,26 +150,58 @@ namespace sosicon {
             virtual bool getChild( SosiElementSearch& src );
 
             //! Get unparsed element data
-            virtual std::string getData() { return mData; };
+            /*!
+                For N\xD8 and N\xD8H elements decoded by the parser, the data is formatted from the
+                coordinate values on request.
+             */
+            virtual std::string getData();
+
+            //! Get coordinate values
+            /*!
+                Filled by the parser for N\xD8 and N\xD8H elements. Empty if the element data is not
+                plain coordinate values, in which case the coordinates must be read from getData().
+             */
+            virtual NorthEastSpan coordinates();
 
             //! Get nesting level of current element
             virtual int getLevel() { return mLevel; };
 
             //! Get ObjType of current element
-            virtual std::string getObjType() { return mObjTypeStr; };
+            virtual std::string getObjType();
 
             //! Get name of current element
             virtual std::string getName();
 
+            //! Get name of current element as given in the SOSI file, without charset conversion
+            virtual std::string getRawName() { return std::string( mName, mNameLength ); };
+
             //! Get root element
-            virtual ISosiElement* getRoot() { return mRoot; };
+            virtual ISosiElement* getRoot();
 
             //! Get serial number (ID) of current element
-            virtual std::string getSerial() { return mSerial; };
+            virtual std::string getSerial() { return std::string( mSerial, mSerialLength ); };
+
+            //! Get serial number of current element as integer
+            /*!
+                \param serial Receives the serial number.
+                \return False if the element has no serial number.
+             */
+            bool getSerialNumber( long long& serial ) {
+                return mSerialLength > 0 && SosiElementIndex::parseSerial( mSerial, mSerial + mSerialLength, serial );
+            };
 
             //! Get ElementType of current element
             virtual ElementType getType() { return mType; };
 
+            //! Get table holding current element
+            SosiElementTable* getTable() { return mTable; };
+
+            //! Get position of current element in its table
+            int getPosition() { return mPosition; };
+
+            //! Get position following the last element of current element's subtree
+            int getEnd() { return mEnd; };
+
         };
        /*! @} end group sosi_elements */
 
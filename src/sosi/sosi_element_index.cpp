@@ -0,0 +1,139 @@
+/*
+ *  This file is part of the command-line tool sosicon.
+ *  Copyright (C) 2014  Espen Andersen, Norwegian Broadcast Corporation (NRK)
+ *
+ *  This is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "sosi_element_index.h"
+
+sosicon::sosi::SosiElementIndex::
+SosiElementIndex() {
+    mCount = 0;
+    mShift = 64;
+}
+
+bool sosicon::sosi::SosiElementIndex::
+parseSerial( const char* begin, const char* end, long long& serial ) {
+    bool negative = begin < end && *begin == '-';
+    if( negative ) {
+        begin++;
+    }
+    if( begin == end || end - begin > 18 ) {
+        return false;
+    }
+    long long value = 0;
+    for( ; begin < end; begin++ ) {
+        if( *begin < '0' || *begin > '9' ) {
+            return false;
+        }
+        value = value * 10 + ( *begin - '0' );
+    }
+    serial = negative ? -value : value;
+    return true;
+}
+
+void sosicon::sosi::SosiElementIndex::
+grow() {
+    std::vector<Slot> slots( mSlots.empty() ? 16 : mSlots.size() * 2 );
+    mShift = mSlots.empty() ? 60 : mShift - 1;
+    slots.swap( mSlots );
+    mCount = 0;
+    for( std::vector<Slot>::iterator i = slots.begin(); i != slots.end(); i++ ) {
+        if( i->element ) {
+            insert( i->serial, i->element );
+        }
+    }
+}
+
+void sosicon::sosi::SosiElementIndex::
+insert( long long serial, ISosiElement* element ) {
+    if( 0 == element ) {
+        return;
+    }
+    if( ( mCount + 1 ) * 2 > mSlots.size() ) {
+        grow();
+    }
+    const size_t mask = mSlots.size() - 1;
+    for( size_t i = home( serial ); ; i = ( i + 1 ) & mask ) {
+        Slot& slot = mSlots[ i ];
+        if( 0 == slot.element ) {
+            slot.serial = serial;
+            slot.element = element;
+            mCount++;
+            return;
+        }
+        if( slot.serial == serial ) {
+            slot.element = element;
+            return;
+        }
+    }
+}
+
+sosicon::ISosiElement* sosicon::sosi::SosiElementIndex::
+find( long long serial ) const {
+    if( 0 == mCount ) {
+        return 0;
+    }
+    const size_t mask = mSlots.size() - 1;
+    for( size_t i = home( serial ); mSlots[ i ].element; i = ( i + 1 ) & mask ) {
+        if( mSlots[ i ].serial == serial ) {
+            return mSlots[ i ].element;
+        }
+    }
+    return 0;
+}
+
+void sosicon::sosi::SosiElementIndex::
+erase( long long serial, ISosiElement* element ) {
+    if( 0 == mCount ) {
+        return;
+    }
+    const size_t mask = mSlots.size() - 1;
+    size_t i = home( serial );
+    while( mSlots[ i ].element && mSlots[ i ].serial != serial ) {
+        i = ( i + 1 ) & mask;
+    }
+    if( mSlots[ i ].element != element || 0 == element ) {
+        return;
+    }
+
+    // Move back subsequent entries of the probe sequence that would otherwise no longer be
+    // reachable from their home slot.
+    for( size_t j = ( i + 1 ) & mask; mSlots[ j ].element; j = ( j + 1 ) & mask ) {
+        size_t k = home( mSlots[ j ].serial );
+        bool movable = i <= j ? ( k <= i || k > j ) : ( k <= i && k > j );
+        if( movable ) {
+            mSlots[ i ] = mSlots[ j ];
+            i = j;
+        }
+    }
+    mSlots[ i ].element = 0;
+    mCount--;
+}
+
+void sosicon::sosi::SosiElementIndex::
+reserve( size_t count ) {
+    while( count * 2 > mSlots.size() ) {
+        grow();
+    }
+}
+
+void sosicon::sosi::SosiElementIndex::
+merge( const SosiElementIndex& other ) {
+    for( std::vector<Slot>::const_iterator i = other.mSlots.begin(); i != other.mSlots.end(); i++ ) {
+        if( i->element ) {
+            insert( i->serial, i->element );
+        }
+    }
+}
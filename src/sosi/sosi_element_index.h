@@ -0,0 +1,133 @@
+/*
+ *  This file is part of the command-line tool sosicon.
+ *  Copyright (C) 2014  Espen Andersen, Norwegian Broadcast Corporation (NRK)
+ *
+ *  This is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __SOSI_ELEMENT_INDEX_H__
+#define __SOSI_ELEMENT_INDEX_H__
+
+#include <string>
+#include <vector>
+
+namespace sosicon {
+
+    //! Forward declarations
+    class ISosiElement;
+
+    //! SOSI
+    namespace sosi {
+
+        /*!
+            \addtogroup sosi_elements SOSI Elements
+            Implemented representation of SOSI file elements.
+            @{
+        */
+
+        //! Serial number index
+        /*!
+            \author Espen Andersen
+            \copyright GNU General Public License
+
+            Maps SOSI serial numbers to elements, to resolve references (REF elements). Serial
+            numbers are integers, and are used as keys in an open-addressing hash table with
+            linear probing. The table is kept at most half full, and deletion shifts subsequent
+            entries back, so there are no tombstones, and a lookup ends at the first free slot.
+            Lookups never modify the table.
+         */
+        class SosiElementIndex {
+
+            //! Hash table slot
+            struct Slot {
+                long long serial;       //!< Serial number
+                ISosiElement* element;  //!< Element, or null if the slot is free
+            };
+
+            //! Hash table
+            /*!
+                The number of slots is a power of two.
+             */
+            std::vector<Slot> mSlots;
+
+            //! Number of elements in table
+            size_t mCount;
+
+            //! Shift giving slot number from hash value
+            unsigned int mShift;
+
+            //! Get home slot of serial number
+            /*!
+                Fibonacci hashing spreads consecutive serial numbers, which are the norm, evenly
+                over the table.
+             */
+            size_t home( long long serial ) const {
+                return static_cast<size_t>( ( static_cast<unsigned long long>( serial ) * 0x9E3779B97F4A7C15ULL ) >> mShift );
+            };
+
+            //! Double the number of slots
+            void grow();
+
+        public:
+
+            //! Constructor
+            SosiElementIndex();
+
+            //! Parse serial number
+            /*!
+                \param begin Pointer to the first character of the serial number.
+                \param end Pointer to one past the last character of the serial number.
+                \param serial Receives the serial number.
+                \return False if the text is not an integer.
+             */
+            static bool parseSerial( const char* begin, const char* end, long long& serial );
+
+            //! Insert element
+            /*!
+                Replaces any element already registered with the same serial number.
+             */
+            void insert( long long serial, ISosiElement* element );
+
+            //! Find element
+            /*!
+                \return Element with the given serial number, or null if there is none.
+             */
+            ISosiElement* find( long long serial ) const;
+
+            //! Remove element
+            /*!
+                Does nothing unless the serial number is registered to the given element.
+             */
+            void erase( long long serial, ISosiElement* element );
+
+            //! Make room for elements
+            /*!
+                Grows the table to hold the given number of elements without further growth.
+             */
+            void reserve( size_t count );
+
+            //! Insert all elements of other index
+            void merge( const SosiElementIndex& other );
+
+            //! Get number of elements in index
+            size_t size() const { return mCount; };
+
+        };
+
+       /*! @} end group sosi_elements */
+
+    }; // namespace sosi
+
+}; // namespace sosicon
+
+#endif
@@ -36,9 +36,6 @@ namespace sosicon {
             @{
         */
 
-        //! Element index type
-        typedef std::map<std::string,ISosiElement*> SosiElementMap;
-
         typedef std::vector<ISosiElement*> SosiChildrenList;
 
         typedef SosiChildrenList::iterator SosiChildrenIterator;
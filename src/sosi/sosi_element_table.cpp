@@ -0,0 +1,363 @@
+/*
+ *  This file is part of the command-line tool sosicon.
+ *  Copyright (C) 2014  Espen Andersen, Norwegian Broadcast Corporation (NRK)
+ *
+ *  This is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "sosi_element_table.h"
+
+sosicon::sosi::SosiElementTable::
+SosiElementTable( ISosiElement* root, SosiElementIndex* index ) {
+    mSize = 0;
+    mFirstChunkSize = 0;
+    mCursor = 0;
+    mLimit = 0;
+    mRoot = root;
+    mIndex = index;
+    mHasHeaderSettings = false;
+}
+
+sosicon::sosi::SosiElementTable::
+~SosiElementTable() {
+    for( std::vector<char*>::iterator i = mBlocks.begin(); i != mBlocks.end(); i++ ) {
+        delete[] *i;
+    }
+}
+
+char* sosicon::sosi::SosiElementTable::
+allocate( size_t size, size_t alignment ) {
+    if( mCursor ) {
+        size_t misalignment = reinterpret_cast<size_t>( mCursor ) % alignment;
+        char* p = misalignment ? mCursor + ( alignment - misalignment ) : mCursor;
+        if( p + size <= mLimit ) {
+            mCursor = p + size;
+            return p;
+        }
+    }
+    if( size > MAX_BLOCK_SIZE / 4 ) {
+        char* block = new char[ size ];
+        insertBlock( block );
+        return block;
+    }
+    char* block = new char[ MAX_BLOCK_SIZE ];
+    mBlocks.push_back( block );
+    mCursor = block + size;
+    mLimit = block + MAX_BLOCK_SIZE;
+    return block;
+}
+
+void sosicon::sosi::SosiElementTable::
+insertBlock( char* block ) {
+    if( mCursor ) {
+        mBlocks.insert( mBlocks.end() - 1, block );
+    }
+    else {
+        mBlocks.push_back( block );
+    }
+}
+
+const char* sosicon::sosi::SosiElementTable::
+store( const char* text, size_t length ) {
+    if( 0 == length ) {
+        return "";
+    }
+    char* p = allocate( length, 1 );
+    memcpy( p, text, length );
+    return p;
+}
+
+sosicon::sosi::SosiElement* sosicon::sosi::SosiElementTable::
+appendSlot( const SosiElement& e ) {
+    if( mChunks.empty() || mChunks.back().size() == mChunks.back().capacity() ) {
+        mChunks.push_back( std::vector<SosiElement>() );
+        mChunks.back().reserve( MAX_CHUNK_SIZE );
+        if( 1 == mChunks.size() ) {
+            mFirstChunkSize = MAX_CHUNK_SIZE;
+        }
+    }
+    mChunks.back().push_back( e );
+    return &mChunks.back().back();
+}
+
+sosicon::sosi::SosiElement* sosicon::sosi::SosiElementTable::
+appendRecord( const SosiElement& e, int parent ) {
+    SosiElement* r = appendSlot( e );
+    r->mTable = this;
+    r->mPosition = mSize;
+    r->mParent = parent;
+    r->mEnd = ++mSize;
+    r->mObjType = -1;
+    for( int a = parent; a >= 0; a = at( a )->mParent ) {
+        at( a )->mEnd = mSize;
+    }
+    if( r->mType == sosi_element_objtype && parent >= 0 ) {
+        at( parent )->mObjType = r->mPosition;
+    }
+    long long serial;
+    if( r->getSerialNumber( serial ) ) {
+        mIndex->insert( serial, r );
+    }
+    return r;
+}
+
+sosicon::sosi::SosiElement* sosicon::sosi::SosiElementTable::
+append( int parent,
+        int level,
+        const std::string& name,
+        const std::string& serial,
+        const std::string& data,
+        const NorthEastArray& coordinates )
+{
+    SosiElement r;
+    r.mLevel = level;
+    r.mType = mTranslation.sosiNameToType( mCharset.toIso8859_1( name ) );
+    r.mName = store( name.data(), name.size() );
+    r.mNameLength = static_cast<unsigned int>( name.size() );
+    r.mSerial = store( serial.data(), serial.size() );
+    r.mSerialLength = static_cast<unsigned int>( serial.size() );
+    r.mData = store( data.data(), data.size() );
+    r.mDataLength = static_cast<unsigned int>( data.size() );
+    if( !coordinates.empty() ) {
+        long long* values = reinterpret_cast<long long*>( allocate( coordinates.size() * sizeof( long long ), sizeof( long long ) ) );
+        memcpy( values, &coordinates[ 0 ], coordinates.size() * sizeof( long long ) );
+        r.mCoordinates = values;
+        r.mCoordinateCount = static_cast<unsigned int>( coordinates.size() );
+    }
+    return appendRecord( r, parent );
+}
+
+sosicon::sosi::SosiElement* sosicon::sosi::SosiElementTable::
+appendSubtree( SosiElement* element, int parent ) {
+    SosiElementTable* source = element->mTable;
+    const int first = element->mPosition;
+    const int last = element->mEnd;
+
+    // A new table gets storage of exactly the size needed, since tables holding single
+    // features may be numerous.
+    if( mChunks.empty() && !mCursor ) {
+        mChunks.push_back( std::vector<SosiElement>() );
+        mChunks.back().reserve( last - first );
+        mFirstChunkSize = last - first;
+        size_t bytes = 0;
+        for( int i = first; i < last; i++ ) {
+            SosiElement* e = source->at( i );
+            bytes += e->mNameLength + e->mSerialLength + e->mDataLength;
+            if( e->mCoordinateCount > 0 ) {
+                bytes += e->mCoordinateCount * sizeof( long long ) + sizeof( long long ) - 1;
+            }
+        }
+        if( bytes > 0 ) {
+            mBlocks.push_back( new char[ bytes ] );
+            mCursor = mBlocks.back();
+            mLimit = mCursor + bytes;
+        }
+    }
+
+    const int base = mSize;
+    for( int i = first; i < last; i++ ) {
+        SosiElement r = *source->at( i );
+        r.mName = store( r.mName, r.mNameLength );
+        r.mSerial = store( r.mSerial, r.mSerialLength );
+        r.mData = store( r.mData, r.mDataLength );
+        if( r.mCoordinateCount > 0 ) {
+            long long* values = reinterpret_cast<long long*>( allocate( r.mCoordinateCount * sizeof( long long ), sizeof( long long ) ) );
+            memcpy( values, r.mCoordinates, r.mCoordinateCount * sizeof( long long ) );
+            r.mCoordinates = values;
+        }
+        appendRecord( r, i == first ? parent : r.mParent - first + base );
+    }
+    return at( base );
+}
+
+void sosicon::sosi::SosiElementTable::
+appendTable( SosiElementTable& other, int parent ) {
+    const int base = mSize;
+    for( int i = 1; i < other.mSize; i++ ) {
+        SosiElement* e = other.at( i );
+        appendRecord( *e, e->mParent <= 0 ? parent : e->mParent - 1 + base );
+    }
+    for( std::vector<char*>::iterator i = other.mBlocks.begin(); i != other.mBlocks.end(); i++ ) {
+        insertBlock( *i );
+    }
+    other.mBlocks.clear();
+    other.mChunks.clear();
+    other.mSize = 0;
+    other.mFirstChunkSize = 0;
+    other.mCursor = 0;
+    other.mLimit = 0;
+}
+
+sosicon::sosi::SosiElement* sosicon::sosi::SosiElementTable::
+appendImage( const ImageRecord* records,
+             int count,
+             int first,
+             const char* arena,
+             unsigned long long arenaSize,
+             int parent,
+             bool index )
+{
+    const Mark m = mark();
+    const int base = mSize;
+    const int last = first + count;
+    for( int i = 0; i < count; i++ ) {
+        const ImageRecord& ir = records[ i ];
+        const int position = first + i;
+        bool inside = ir.parent >= first;
+        bool valid =
+            ir.parent >= 0 && ir.parent < position && ( inside || ir.parent == records[ 0 ].parent ) &&
+            ir.end > position && ir.end <= last &&
+            ( ir.objType < 0 || ( ir.objType > position && ir.objType < ir.end ) ) &&
+            ir.nameOffset <= arenaSize && ir.nameLength <= arenaSize - ir.nameOffset &&
+            ir.serialOffset <= arenaSize && ir.serialLength <= arenaSize - ir.serialOffset &&
+            ir.dataOffset <= arenaSize && ir.dataLength <= arenaSize - ir.dataOffset &&
+            ir.coordinateOffset <= arenaSize && 0 == ir.coordinateOffset % sizeof( long long ) &&
+            ir.coordinateCount <= ( arenaSize - ir.coordinateOffset ) / sizeof( long long );
+        if( !valid ) {
+            release( m );
+            return 0;
+        }
+        SosiElement r;
+        r.mLevel = ir.level;
+        r.mType = static_cast<ElementType>( ir.type );
+        r.mName = arena + ir.nameOffset;
+        r.mNameLength = ir.nameLength;
+        r.mSerial = arena + ir.serialOffset;
+        r.mSerialLength = ir.serialLength;
+        r.mData = arena + ir.dataOffset;
+        r.mDataLength = ir.dataLength;
+        if( ir.coordinateCount > 0 ) {
+            r.mCoordinates = reinterpret_cast<const long long*>( arena + ir.coordinateOffset );
+            r.mCoordinateCount = ir.coordinateCount;
+        }
+        SosiElement* e = appendSlot( r );
+        e->mTable = this;
+        e->mPosition = mSize++;
+        e->mParent = inside ? ir.parent - first + base : parent;
+        e->mEnd = ir.end - first + base;
+        e->mObjType = ir.objType < 0 ? -1 : ir.objType - first + base;
+        if( !inside && parent >= 0 && r.mType == sosi_element_objtype ) {
+            at( parent )->mObjType = e->mPosition;
+        }
+    }
+    for( int a = parent; a >= 0; a = at( a )->mParent ) {
+        at( a )->mEnd = mSize;
+    }
+    if( index ) {
+        for( int i = base; i < mSize; i++ ) {
+            SosiElement* e = at( i );
+            long long serial;
+            if( e->getSerialNumber( serial ) ) {
+                mIndex->insert( serial, e );
+            }
+        }
+    }
+    return base < mSize ? at( base ) : 0;
+}
+
+void sosicon::sosi::SosiElementTable::
+exportSubtree( SosiElement* element,
+               int position,
+               int parent,
+               unsigned long long arenaOffset,
+               std::vector<ImageRecord>& records,
+               std::vector<char>& arena )
+{
+    SosiElementTable* source = element->mTable;
+    const int first = element->mPosition;
+    const int last = element->mEnd;
+    for( int i = first; i < last; i++ ) {
+        SosiElement* e = source->at( i );
+        ImageRecord r;
+        r.parent = i == first ? parent : e->mParent - first + position;
+        r.end = e->mEnd - first + position;
+        r.objType = e->mObjType < 0 ? -1 : e->mObjType - first + position;
+        r.level = e->mLevel;
+        r.type = e->mType;
+        r.nameLength = e->mNameLength;
+        r.serialLength = e->mSerialLength;
+        r.dataLength = e->mDataLength;
+        r.coordinateCount = e->mCoordinateCount;
+        r.reserved = 0;
+        r.nameOffset = arenaOffset + arena.size();
+        arena.insert( arena.end(), e->mName, e->mName + e->mNameLength );
+        r.serialOffset = arenaOffset + arena.size();
+        arena.insert( arena.end(), e->mSerial, e->mSerial + e->mSerialLength );
+        r.dataOffset = arenaOffset + arena.size();
+        arena.insert( arena.end(), e->mData, e->mData + e->mDataLength );
+        r.coordinateOffset = 0;
+        if( e->mCoordinateCount > 0 ) {
+            arena.resize( arena.size() + ( sizeof( long long ) - ( arenaOffset + arena.size() ) % sizeof( long long ) ) % sizeof( long long ), 0 );
+            r.coordinateOffset = arenaOffset + arena.size();
+            const char* values = reinterpret_cast<const char*>( e->mCoordinates );
+            arena.insert( arena.end(), values, values + e->mCoordinateCount * sizeof( long long ) );
+        }
+        records.push_back( r );
+    }
+}
+
+sosicon::ISosiElement* sosicon::sosi::SosiElementTable::
+find( const std::string& serial ) {
+    long long key;
+    if( !SosiElementIndex::parseSerial( serial.data(), serial.data() + serial.size(), key ) ) {
+        return 0;
+    }
+    return mIndex->find( key );
+}
+
+sosicon::sosi::SosiElementTable::Mark sosicon::sosi::SosiElementTable::
+mark() {
+    Mark m;
+    m.size = mSize;
+    m.blocks = mBlocks.size();
+    m.block = mCursor ? mBlocks.back() : 0;
+    m.cursor = mCursor;
+    m.limit = mLimit;
+    return m;
+}
+
+void sosicon::sosi::SosiElementTable::
+release( const Mark& m ) {
+    if( m.size < mSize ) {
+        int parent = at( m.size )->mParent;
+        while( mSize > m.size ) {
+            mChunks.back().pop_back();
+            if( mChunks.back().empty() && mChunks.size() > 1 ) {
+                mChunks.pop_back();
+            }
+            mSize--;
+        }
+        for( ; parent >= 0; parent = at( parent )->mParent ) {
+            SosiElement* a = at( parent );
+            a->mEnd = std::min( a->mEnd, mSize );
+            if( a->mObjType >= mSize ) {
+                a->mObjType = -1;
+            }
+        }
+    }
+
+    // Blocks added since the mark are at or after the position of the block that was current
+    // at the time, which is kept.
+    const size_t kept = m.block ? m.blocks - 1 : m.blocks;
+    for( size_t i = kept; i < mBlocks.size(); i++ ) {
+        if( mBlocks[ i ] != m.block ) {
+            delete[] mBlocks[ i ];
+        }
+    }
+    mBlocks.resize( kept );
+    if( m.block ) {
+        mBlocks.push_back( m.block );
+    }
+    mCursor = m.cursor;
+    mLimit = m.limit;
+}
@@ -0,0 +1,354 @@
+/*
+ *  This file is part of the command-line tool sosicon.
+ *  Copyright (C) 2014  Espen Andersen, Norwegian Broadcast Corporation (NRK)
+ *
+ *  This is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __SOSI_ELEMENT_TABLE_H__
+#define __SOSI_ELEMENT_TABLE_H__
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "sosi_charset.h"
+#include "sosi_element.h"
+#include "sosi_element_index.h"
+#include "sosi_translation_table.h"
+#include "sosi_types.h"
+
+namespace sosicon {
+
+    //! SOSI
+    namespace sosi {
+
+        /*!
+            \addtogroup sosi_elements SOSI Elements
+            Implemented representation of SOSI file elements.
+            @{
+        */
+
+        //! Flattened SOSI element tree
+        /*!
+            \author Espen Andersen
+            \copyright GNU General Public License
+
+            Stores SOSI elements as fixed-size records in pre-order (file order). Each record
+            knows the position of its parent and the end of its subtree, so that the children
+            of an element are a contiguous range of the table. Records are allocated in chunks,
+            and names, serial numbers, data and coordinates in a bump-allocated arena, so that
+            building the tree costs a handful of allocations per thousand elements, and freeing
+            it is a matter of releasing the chunks and arena blocks.
+
+            Element pointers stay valid until the table is destroyed, or the element is removed
+            by release().
+
+            A table may be saved as an image (see exportSubtree()), in which the records refer to
+            texts and coordinates by offsets into one arena. Elements appended from an image by
+            appendImage() refer to the image arena in place, so loading a binary cache copies the
+            records only.
+
+            Elements with a serial number are registered in the index given on construction.
+            Lookups go through the root element, which owns the index of the complete tree.
+         */
+        class SosiElementTable {
+
+            //! Table contents are not copied
+            SosiElementTable( const SosiElementTable& );
+
+            //! Table contents are not copied
+            SosiElementTable& operator=( const SosiElementTable& );
+
+        public:
+
+            //! Table state saved by mark()
+            struct Mark {
+                int size;           //!< Number of elements
+                size_t blocks;      //!< Number of arena blocks
+                char* block;        //!< Current arena block, or null
+                char* cursor;       //!< Next free byte of current arena block
+                char* limit;        //!< End of current arena block
+            };
+
+            //! Element record of a table image
+            /*!
+                Position-independent copy of an element, as stored in binary caches. Positions
+                are those of a table holding the complete tree, with the root at position 0.
+                Texts and coordinates are given as offsets into the arena of the image.
+             */
+            struct ImageRecord {
+                int parent;                         //!< Position of parent element
+                int end;                            //!< Position following the last element of the subtree
+                int objType;                        //!< Position of OBJTYPE child, or -1
+                int level;                          //!< SOSI level (number of dots)
+                int type;                           //!< ElementType
+                unsigned int nameLength;            //!< Length of name
+                unsigned int serialLength;          //!< Length of serial number
+                unsigned int dataLength;            //!< Length of data
+                unsigned int coordinateCount;       //!< Number of coordinate values
+                unsigned int reserved;              //!< Padding, always 0
+                unsigned long long nameOffset;      //!< Arena offset of name
+                unsigned long long serialOffset;    //!< Arena offset of serial number
+                unsigned long long dataOffset;      //!< Arena offset of data
+                unsigned long long coordinateOffset;//!< Arena offset of coordinate values, 8-byte aligned
+            };
+
+        private:
+
+            //! Maximum number of elements per chunk
+            static const int MAX_CHUNK_SIZE = 4096;
+
+            //! Maximum size of arena blocks, except for oversized values
+            static const size_t MAX_BLOCK_SIZE = 65536;
+
+            //! Element records
+            /*!
+                Each chunk is reserved to its full capacity on creation and never reallocated,
+                so element pointers are stable. All chunks hold MAX_CHUNK_SIZE elements, except
+                the first chunk of a table set up by appendSubtree(), which is sized to fit.
+             */
+            std::vector< std::vector<SosiElement> > mChunks;
+
+            //! Capacity of first chunk
+            int mFirstChunkSize;
+
+            //! Number of elements
+            int mSize;
+
+            //! Arena blocks
+            /*!
+                The current block, which is being filled, is always the last one. Blocks that
+                are not filled by the table itself (oversized values, blocks taken over from
+                other tables) are inserted before it.
+             */
+            std::vector<char*> mBlocks;
+
+            //! Next free byte of current arena block
+            char* mCursor;
+
+            //! End of current arena block
+            char* mLimit;
+
+            //! Root element of the complete tree, or null if this table holds it
+            ISosiElement* mRoot;
+
+            //! Serial number index of the complete tree
+            SosiElementIndex* mIndex;
+
+            //! SOSI string translations
+            SosiTranslationTable mTranslation;
+
+            //! Character set of element names and data
+            SosiCharset mCharset;
+
+            //! Header settings of the file, if the elements were loaded from an image
+            HeaderSettings mHeaderSettings;
+
+            //! True if mHeaderSettings is set
+            bool mHasHeaderSettings;
+
+            //! Allocate storage in arena
+            /*!
+                \param size Number of bytes.
+                \param alignment Required alignment of the storage.
+                \return Pointer to the storage.
+             */
+            char* allocate( size_t size, size_t alignment );
+
+            //! Add arena block not to be filled by the table
+            void insertBlock( char* block );
+
+            //! Copy text to arena
+            const char* store( const char* text, size_t length );
+
+            //! Append record
+            /*!
+                Links the new record to its parent and ancestors, and registers its serial
+                number in the index.
+                \param e Record to copy. Position, parent and subtree end are set here.
+                \param parent Position of parent element, or -1.
+             */
+            SosiElement* appendRecord( const SosiElement& e, int parent );
+
+            //! Append record to the last chunk
+            /*!
+                Starts a new chunk if the last one is full. The record is copied as is.
+             */
+            SosiElement* appendSlot( const SosiElement& e );
+
+        public:
+
+            //! Constructor
+            /*!
+                \param root Root element of the complete tree, or null if the first element
+                       appended to this table is the root.
+                \param index Serial number index to register elements in.
+             */
+            SosiElementTable( ISosiElement* root, SosiElementIndex* index );
+
+            //! Destructor
+            /*!
+                Releases all elements. The elements are not removed from the index.
+             */
+            ~SosiElementTable();
+
+            //! Set character set of element names and data
+            /*!
+                Determines the type of the elements appended from now on, and the names
+                returned by SosiElement::getName() for all elements of the table.
+             */
+            void setCharset( const SosiCharset& charset ) { mCharset = charset; }
+
+            //! Character set of element names and data
+            const SosiCharset& getCharset() const { return mCharset; }
+
+            //! Set header settings of the file
+            /*!
+                Called when the elements are loaded from a binary cache, which holds the header
+                settings as well.
+             */
+            void setHeaderSettings( const HeaderSettings& settings ) { mHeaderSettings = settings; mHasHeaderSettings = true; }
+
+            //! Header settings of the file
+            /*!
+                \return Settings loaded from a binary cache, or null if the elements were parsed.
+             */
+            const HeaderSettings* getHeaderSettings() const { return mHasHeaderSettings ? &mHeaderSettings : 0; }
+
+            //! Append new element
+            /*!
+                \param parent Position of parent element, or -1 for a root element.
+                \param level SOSI level of the element (number of dots).
+                \param name Element name.
+                \param serial Serial number, or empty string.
+                \param data Element data.
+                \param coordinates Decoded coordinate values.
+                \return Pointer to the new element.
+             */
+            SosiElement* append( int parent,
+                                 int level,
+                                 const std::string& name,
+                                 const std::string& serial,
+                                 const std::string& data,
+                                 const NorthEastArray& coordinates );
+
+            //! Append copy of element with subtree
+            /*!
+                Copies the element and its descendants from any table, including their names,
+                data and coordinates. The copies are registered in the index in place of the
+                originals.
+                \param element Element to copy.
+                \param parent Position of parent element in this table, or -1.
+                \return Pointer to the copy of element.
+             */
+            SosiElement* appendSubtree( SosiElement* element, int parent );
+
+            //! Move elements from other table
+            /*!
+                Appends all elements of other but its first (the root of other) to this table,
+                as children of parent, and takes over the arena of other. Text and coordinates
+                are thus not copied. The moved elements are registered in the index of this
+                table. Other is left empty.
+                \param other Table to take elements from.
+                \param parent Position of the new parent element in this table.
+             */
+            void appendTable( SosiElementTable& other, int parent );
+
+            //! Append elements from table image
+            /*!
+                Appends image records in file order. The elements refer to the image arena in
+                place, so the image must outlive the table. The records are checked against the
+                image as they are copied, and nothing is appended if any of them is out of
+                bounds.
+                \param records Records to append, a top-level element with its subtree, or all
+                       elements but the root.
+                \param count Number of records.
+                \param first Image position of records[0].
+                \param arena Arena of the image.
+                \param arenaSize Size of the arena in bytes.
+                \param parent Position in this table of the parent of top-level records.
+                \param index If true, elements with serial numbers are registered in the index.
+                       Otherwise the caller registers them, typically from the index stored
+                       with the image.
+                \return Pointer to the first element appended, or null if the records are not
+                        consistent with the image.
+             */
+            SosiElement* appendImage( const ImageRecord* records,
+                                      int count,
+                                      int first,
+                                      const char* arena,
+                                      unsigned long long arenaSize,
+                                      int parent,
+                                      bool index );
+
+            //! Make image of element with subtree
+            /*!
+                Appends records for the element and its descendants, and their texts and
+                coordinates to the arena.
+                \param element Element to copy, from any table.
+                \param position Image position of the element.
+                \param parent Image position of the parent of the element.
+                \param arenaOffset Arena offset of arena[0].
+                \param records Receives the records.
+                \param arena Receives the texts and coordinates. Coordinates are aligned by
+                       the arena offset.
+             */
+            static void exportSubtree( SosiElement* element,
+                                       int position,
+                                       int parent,
+                                       unsigned long long arenaOffset,
+                                       std::vector<ImageRecord>& records,
+                                       std::vector<char>& arena );
+
+            //! Get element at position
+            SosiElement* at( int position ) {
+                if( position < mFirstChunkSize ) {
+                    return &mChunks.front()[ position ];
+                }
+                position -= mFirstChunkSize;
+                return &mChunks[ 1 + position / MAX_CHUNK_SIZE ][ position % MAX_CHUNK_SIZE ];
+            };
+
+            //! Find element by serial number
+            ISosiElement* find( const std::string& serial );
+
+            //! Get root element of the complete tree
+            ISosiElement* getRoot() { return mRoot ? mRoot : at( 0 ); };
+
+            //! Save table state
+            /*!
+                \sa release()
+             */
+            Mark mark();
+
+            //! Remove elements appended after mark()
+            /*!
+                Releases the elements and arena storage added since the mark was taken. Used to
+                reuse the table for the next feature in streaming mode. The released elements
+                must have been removed from the index.
+             */
+            void release( const Mark& m );
+
+            //! Get number of elements
+            int size() { return mSize; };
+
+        };
+
+       /*! @} end group sosi_elements */
+
+    }; // namespace sosi
+
+}; // namespace sosicon
+
+#endif
@@ -0,0 +1,106 @@
+/*
+ *  This file is part of the command-line tool sosicon.
+ *  Copyright (C) 2014  Espen Andersen, Norwegian Broadcast Corporation (NRK)
+ *
+ *  This is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "sosi_header_context.h"
+#include "sosi_element_table.h"
+
+sosicon::sosi::HeaderContext::
+HeaderContext() {
+    mOrigoN = 0;
+    mOrigoE = 0;
+    mDivisor = 1;
+    mSysCode = 0;
+    mSourceSrid = 0;
+    mTransformation.init( 0, 0 );
+}
+
+sosicon::sosi::HeaderContext::
+HeaderContext( ISosiElement* root, int targetSrid ) {
+    SosiElement* rootElement = dynamic_cast<SosiElement*>( root );
+    const HeaderSettings* cached = rootElement ? rootElement->getTable()->getHeaderSettings() : 0;
+    if( cached ) {
+        mOrigoN = cached->origoN;
+        mOrigoE = cached->origoE;
+        mDivisor = cached->divisor;
+        mSysCode = cached->sysCode;
+        mSourceSrid = cached->sourceSrid;
+        mCharset = rootElement->getTable()->getCharset();
+    }
+    else {
+        SosiOrigoNE origo;
+        SosiUnit unit;
+        SosiCoordSys coordSys;
+        initHeadMember( root, origo, sosi_element_origo_ne, true );
+        initHeadMember( root, unit, sosi_element_unit, true );
+        initHeadMember( root, coordSys, sosi_element_coordsys, true );
+        initHeadMember( root, mCharset, sosi_element_charset, false );
+        mOrigoN = origo.getN();
+        mOrigoE = origo.getE();
+        mDivisor = unit.getDivisor();
+        mSysCode = coordSys.getSysCode();
+        mSourceSrid = coordSys.getSrid();
+    }
+    mTransformation.init( mSourceSrid, targetSrid );
+    if( mTransformation.active() ) {
+        sosicon::logstream << "Transforming coordinates from EPSG:" << mSourceSrid
+                           << " to EPSG:" << targetSrid << "\n";
+    }
+    else if( mTransformation.unavailable() ) {
+        sosicon::logstream << "Warning: Cannot transform coordinates from ";
+        if( mSourceSrid != 0 ) {
+            sosicon::logstream << "EPSG:" << mSourceSrid;
+        }
+        else if( mSysCode != 0 ) {
+            sosicon::logstream << "KOORDSYS " << mSysCode;
+        }
+        else {
+            sosicon::logstream << "unknown grid";
+        }
+        sosicon::logstream << " to EPSG:" << targetSrid << ", coordinates are kept in the source grid\n";
+    }
+}
+
+sosicon::sosi::HeaderSettings sosicon::sosi::HeaderContext::
+getSettings() const {
+    HeaderSettings settings;
+    settings.origoN = mOrigoN;
+    settings.origoE = mOrigoE;
+    settings.divisor = mDivisor;
+    settings.sysCode = mSysCode;
+    settings.sourceSrid = mSourceSrid;
+    return settings;
+}
+
+void sosicon::sosi::HeaderContext::
+initHeadMember( ISosiElement* root, ISosiHeadMember& headMember, ElementType type, bool transpar ) {
+    SosiElementSearch head( sosi_element_head );
+    if( !root || !root->getChild( head ) ) {
+        return;
+    }
+    ISosiElement* parent = head.element();
+    if( transpar ) {
+        SosiElementSearch src( sosi_element_transpar );
+        if( !parent->getChild( src ) ) {
+            return;
+        }
+        parent = src.element();
+    }
+    SosiElementSearch target( type );
+    if( parent->getChild( target ) ) {
+        headMember.init( target.element() );
+    }
+}
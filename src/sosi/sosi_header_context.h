@@ -0,0 +1,147 @@
+/*
+ *  This file is part of the command-line tool sosicon.
+ *  Copyright (C) 2014  Espen Andersen, Norwegian Broadcast Corporation (NRK)
+ *
+ *  This is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __SOSI_HEADER_CONTEXT_H__
+#define __SOSI_HEADER_CONTEXT_H__
+
+#include "../interface/i_sosi_element.h"
+#include "../interface/i_sosi_head_member.h"
+#include "../logger.h"
+#include "../projection.h"
+#include "sosi_types.h"
+#include "sosi_charset.h"
+#include "sosi_coord_sys.h"
+#include "sosi_element_search.h"
+#include "sosi_origo_ne.h"
+#include "sosi_unit.h"
+#include <string>
+
+namespace sosicon {
+
+    //! SOSI
+    namespace sosi {
+
+        /*!
+            \addtogroup sosi_elements SOSI Elements
+            Implemented representation of SOSI file elements.
+            @{
+        */
+
+        //! SOSI file header settings
+        /*!
+            \author Espen Andersen
+            \copyright GNU General Public License
+
+            Holds the settings of the HODE element of one SOSI file that are needed to interpret
+            its contents: origo and unit (HODE/TRANSPAR ORIGO-N\xD8 and ENHET), coordinate system
+            (KOORDSYS), character set (TEGNSETT), and the transformation to the requested output
+            grid. The context is built once per file, after its header has been parsed, and is
+            read-only from then on. It is passed explicitly to the code that reads coordinates
+            or names, so that several files may be processed at the same time.
+         */
+        class HeaderContext {
+
+            int mOrigoN;                       //!< Origo north, in file units
+            int mOrigoE;                       //!< Origo east, in file units
+            int mDivisor;                      //!< Units per metre (inverse of ENHET)
+            int mSysCode;                      //!< SOSI KOORDSYS code, or 0
+            int mSourceSrid;                   //!< EPSG code of the source grid, or 0
+            Transformation mTransformation;    //!< Source grid to requested output grid
+            SosiCharset mCharset;              //!< Character set of the file
+
+            //! Find member of HODE/TRANSPAR or HODE
+            /*!
+                \param root Root element of the SOSI file.
+                \param headMember Member to initialize.
+                \param type Element type of the member.
+                \param transpar If true, the member is looked up in HODE/TRANSPAR, otherwise in
+                       HODE.
+            */
+            static void initHeadMember( ISosiElement* root, ISosiHeadMember& headMember, ElementType type, bool transpar );
+
+        public:
+
+            //! Construct default header context
+            /*!
+                No origo, unit 1, unknown coordinate system and character set, and no
+                transformation.
+            */
+            HeaderContext();
+
+            //! Construct header context of a SOSI file
+            /*!
+                If the elements were loaded from a binary cache, the settings are taken from
+                the cache, see SosiElementTable::getHeaderSettings(). Otherwise they are read
+                from the HODE element.
+                \param root Root element of the SOSI file. At least the HODE element must have
+                       been parsed.
+                \param targetSrid Requested output grid (EPSG), or 0 to keep the source grid.
+                       Coordinates are transformed if both grids are supported by
+                       sosicon::Projection.
+            */
+            HeaderContext( ISosiElement* root, int targetSrid = 0 );
+
+            int getOrigoN() const { return mOrigoN; }
+
+            int getOrigoE() const { return mOrigoE; }
+
+            int getDivisor() const { return mDivisor; }
+
+            int getSysCode() const { return mSysCode; }
+
+            int getSourceSrid() const { return mSourceSrid; }
+
+            //! Settings read from the file, to be stored in a binary cache
+            HeaderSettings getSettings() const;
+
+            //! Grid of the coordinates read from the file
+            /*!
+                \return EPSG code of the output grid if the coordinates are transformed,
+                        otherwise of the source grid, or 0 if unknown.
+            */
+            int getSrid() const { return mTransformation.getSrid(); }
+
+            //! True if an output grid was requested that cannot be produced
+            /*!
+                The coordinates are then read in the source grid, and getSrid() returns the
+                source grid (or 0). Converters that must label or constrain their output grid
+                should refuse the file, see getTargetSrid().
+            */
+            bool transformUnavailable() const { return mTransformation.unavailable(); }
+
+            //! Requested output grid (EPSG), or 0 if none
+            int getTargetSrid() const { return mTransformation.getTargetSrid(); }
+
+            const Transformation& getTransformation() const { return mTransformation; }
+
+            const SosiCharset& getCharset() const { return mCharset; }
+
+            Charset getEncoding() const { return mCharset.getEncoding(); }
+
+            std::string getEncodingName() const { return mCharset.getEncodingName(); }
+
+            //! Convert string from the character set of the file to ISO8859-1
+            std::string toIso8859_1( const std::string& str ) const { return mCharset.toIso8859_1( str ); }
+
+        }; // class HeaderContext
+       /*! @} end group sosi_elements */
+
+    } // namespace sosi
+
+} // namespace sosicon
+
+#endif
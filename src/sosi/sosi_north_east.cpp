@@ -17,37 +17,27 @@
  */
 #include "sosi_north_east.h"
 
-void sosicon::sosi::
-deleteNorthEasts( NorthEastList& lst ) {
-    for( NorthEastList::iterator i = lst.begin(); i != lst.end(); i++ ) {
-        ( *i )->free();
-        delete *i;
-    }
-    lst.clear();
-}
-
-sosicon::sosi::SosiOrigoNE sosicon::sosi::SosiNorthEast::mOrigo = sosicon::sosi::SosiOrigoNE();
-sosicon::sosi::SosiUnit sosicon::sosi::SosiNorthEast::mUnit = sosicon::sosi::SosiUnit();
-
 sosicon::sosi::SosiNorthEast::
-SosiNorthEast( ISosiElement* e ) {
+SosiNorthEast( ISosiElement* e, const HeaderContext& header ) {
     mSosiElement = e;
-    mMinX = +9999999999;
-    mMinY = +9999999999;
-    mMaxX = -9999999999;
-    mMaxY = -9999999999;
-    std::string name = e->getName();
-    std::string data = e->getData();
-    if( e->getName() == "N\xD8H" ) {
+    NorthEastSpan values = e->coordinates();
+    if( !values.empty() ) {
+        // Decoded by the parser
+        size_t dim = northEastDimension( e->getName() );
+        mCoordinates.reserve( values.size / dim );
+        for( size_t i = 0; i + dim <= values.size; i += dim ) {
+            mCoordinates.append( static_cast<double>( values.values[ i ] ),
+                                 static_cast<double>( values.values[ i + 1 ] ) );
+        }
+    }
+    else if( northEastDimension( e->getName() ) == 3 ) {
         ragelParseCoordinatesNeh( mSosiElement->getData() );
     }
     else {
         ragelParseCoordinatesNe( mSosiElement->getData() );
     }
-    initHeadMember( mOrigo, sosi_element_origo_ne );
-    initHeadMember( mUnit, sosi_element_unit );
-    *this /= mUnit;
-    *this += mOrigo;
+    mCoordinates.scale( header.getDivisor(), header.getOrigoN(), header.getOrigoE() );
+    mCoordinates.transform( header.getTransformation() );
 }
 
 sosicon::sosi::SosiNorthEast::
@@ -77,114 +67,11 @@ append( std::string n, std::string e, std::string h ) {
     append( coordN, coordE, height );
 }
 
-void sosicon::sosi::SosiNorthEast::
-free() {
-	for( CoordinateList::iterator i = mCoordinates.begin(); i != mCoordinates.end(); i++ ) {
-		delete *i;
-	}
-	mCoordinates.clear();
-}
-
-void sosicon::sosi::SosiNorthEast::
-append( double n, double e ) {
-    append( n, e, 0 );
-}
-
-void sosicon::sosi::SosiNorthEast::
-append( double n, double e, double h ) {
-
-    ICoordinate* c = 0;
-    try {
-        c = new Coordinate();
-    }
-    catch( ... ) {
-        sosicon::logstream << "Memory allocation failed";
-    }
-
-    c->setN( n );
-    c->setE( e );
-    c->setH( h );
-
-    mMinX = std::min( mMinX, c->getE() );
-    mMinY = std::min( mMinY, c->getN() );
-    mMaxX = std::max( mMaxX, c->getE() );
-    mMaxY = std::max( mMaxY, c->getN() );
-    mCoordinates.push_back( c );
-}
-
-void sosicon::sosi::SosiNorthEast::
-initHeadMember( ISosiHeadMember& headMember, ElementType type ) {
-    if( !headMember.initialized() ) {
-        SosiElementSearch head( sosi_element_head );
-        SosiElementSearch transpar( sosi_element_transpar );
-        SosiElementSearch target( type );
-        ISosiElement* root = mSosiElement->getRoot();
-        if( root->getChild( head ) &&
-            head.element()->getChild( transpar ) &&
-            transpar.element()->getChild( target ) )
-        {
-            headMember.init( target.element() );
-        }
-    }
-}
-
 void sosicon::sosi::SosiNorthEast::
 dump() {
-    for( CoordinateList::iterator i = mCoordinates.begin(); i != mCoordinates.end(); i++ ) {
-        sosicon::logstream << ( *i )->toString() << "\n";
-    }
-}
-
-void sosicon::sosi::SosiNorthEast::
-expandBoundingBox( double& minX, double& minY, double& maxX, double& maxY ) {
-    minX = std::min( minX, mMinX );
-    minY = std::min( minY, mMinY );
-    maxX = std::max( maxX, mMaxX );
-    maxY = std::max( maxY, mMaxY );
-}
-
-bool sosicon::sosi::SosiNorthEast::
-getNext( ICoordinate*& coord ) {
-    bool moreToGo = mCoordinates.size() > 0;
-    if( moreToGo ) {
-        if( 0 == coord ) {
-            mCoordinatesIterator = mCoordinates.begin();
-        }
-        moreToGo = mCoordinatesIterator != mCoordinates.end();
-        if( moreToGo ) {
-            coord = *mCoordinatesIterator;
-            mCoordinatesIterator++;
-        }
-    }
-    return moreToGo;
-}
-
-sosicon::sosi::SosiNorthEast& sosicon::sosi::SosiNorthEast::
-operator+= ( SosiOrigoNE& origo ) {
-    int offsetN = origo.getN();
-    int offsetE = origo.getE();
-    ICoordinate* c = 0;
-    while( getNext( c ) ) {
-        c->shift( offsetN, offsetE );
-
-    }
-    mMinX += offsetE;
-    mMinY += offsetN;
-    mMaxX += offsetE;
-    mMaxY += offsetN;
-    return *this;
-}
-
-sosicon::sosi::SosiNorthEast& sosicon::sosi::SosiNorthEast::
-operator/= ( SosiUnit& unit ) {
-    ICoordinate* c = 0;
-    int divisor = unit.getDivisor();
-    while( getNext( c ) ) {
-        c->divide( divisor );
+    for( size_t i = 0; i < mCoordinates.size(); i++ ) {
+        std::stringstream ss;
+        ss << "POINT( " << std::fixed << mCoordinates.y( i ) << " " << std::fixed << mCoordinates.x( i ) << " )";
+        sosicon::logstream << ss.str() << "\n";
     }
-    mMinX /= divisor;
-    mMinY /= divisor;
-    mMaxX /= divisor;
-    mMaxY /= divisor;
-    return *this;
 }
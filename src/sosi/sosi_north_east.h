@@ -20,14 +20,11 @@
 
 #include "../logger.h"
 #include "../interface/i_sosi_element.h"
-#include "../interface/i_coordinate.h"
 #include "../common_types.h"
-#include "../coordinate.h"
+#include "../geometry_buffer.h"
+#include "../projection.h"
 #include "sosi_types.h"
-#include "sosi_origo_ne.h"
-#include "sosi_unit.h"
-#include <algorithm>
-#include <limits>
+#include "sosi_header_context.h"
 #include <string>
 #include <sstream>
 #include <vector>
@@ -45,43 +42,37 @@ namespace sosicon {
 
         //! SOSI North-east element
         /*!
-            Implements SOSI north east element, as given via the NØ element.
+            Implements SOSI north east element, as given via the N element. The
+            coordinates are held in a GeometryBuffer.
          */
         class SosiNorthEast {
 
             ISosiElement* mSosiElement;
 
-            CoordinateList mCoordinates;
-
-            CoordinateList::iterator mCoordinatesIterator;
-
-            static SosiOrigoNE mOrigo;
-
-            static SosiUnit mUnit;
-
-            double mMinX;
-            double mMinY;
-            double mMaxX;
-            double mMaxY;
+            GeometryBuffer mCoordinates;
 
             //! Populate mCoordinates
             void ragelParseCoordinatesNe( std::string data );
             void ragelParseCoordinatesNeh( std::string data );
 
-            void initHeadMember( ISosiHeadMember& headMember, ElementType type );
-
         public:
 
-            void append( double n, double e );
-            void append( double n, double e, double h );
+            void append( double n, double e ) { mCoordinates.append( n, e ); }
+            void append( double n, double e, double h ) { mCoordinates.append( n, e, h ); }
             void append( std::string n, std::string e );
             void append( std::string n, std::string e, std::string h );
 
             //!< Frees allocated memory
-            void free();
-            
+            void free() { mCoordinates.clear(); }
+
             //! Construct new SOSI north-east element
-            SosiNorthEast( ISosiElement* e );
+            /*!
+                Coordinates are scaled by the unit, shifted by the origo and transformed to the
+                output grid given by header.
+                \param e N or NH element.
+                \param header Header context of the file of e.
+            */
+            SosiNorthEast( ISosiElement* e, const HeaderContext& header );
 
             //! Destructor
             virtual ~SosiNorthEast();
@@ -89,35 +80,22 @@ namespace sosicon {
             //! Debug
             void dump();
 
-            void expandBoundingBox( double& minX, double& minY, double& maxX, double& maxY );
-
-            ICoordinate* front() { return mCoordinates.size() > 0 ? mCoordinates.front() : 0; }
+            void expandBoundingBox( double& minX, double& minY, double& maxX, double& maxY ) {
+                mCoordinates.expandBoundingBox( minX, minY, maxX, maxY );
+            }
 
-            ICoordinate* back() { return mCoordinates.size() > 0 ? mCoordinates.back() : 0; }
-
-            //* Get next coordinate in list
-            bool getNext( ICoordinate*& coord );
+            //! Coordinates of the element
+            const GeometryBuffer& getCoordinates() const { return mCoordinates; }
 
             //* Get number of points in current segment
             int getNumPoints() { return static_cast< int >( mCoordinates.size() ); }
 
             //! Reverse polygon (point order)
-            void reverse() { std::reverse( mCoordinates.begin(), mCoordinates.end() ); }
-
-            SosiNorthEast& operator+= ( SosiOrigoNE& origo );
-
-            SosiNorthEast& operator/= ( SosiUnit& unit );
+            void reverse() { mCoordinates.reverse(); }
 
         }; // class SosiNorthEast
        /*! @} end group sosi_elements */
 
-        //! List of SosiSNorthEast elements
-        typedef std::vector<SosiNorthEast*> NorthEastList;
-
-        //! Deletes SosiNorthEast elements of NorthEastList
-        void deleteNorthEasts( NorthEastList& lst );
-
-
     }; // namespace sosi
 
 }; // namespace sosicon
@@ -21,7 +21,6 @@
 #include <map>
 #include <vector>
 #include "sosi_types.h"
-#include "sosi_charset_singleton.h"
 
 namespace sosicon {
 
@@ -36,9 +35,6 @@ namespace sosicon {
 
         class SosiTranslationTable {
 
-            //! Character encoding element
-            SosiCharsetSingleton* mSosiCharset;
-
             //! Number of entries in KOORDSYS lookup table
             static const int MAX_COORDSYS_TABLE = 184;
 
@@ -62,6 +58,14 @@ namespace sosicon {
             */
             static CoordSys mCoordSysTable[ MAX_COORDSYS_TABLE + 1 ];
 
+            //! Populate the tables
+            /*!
+                Called once per process, on construction of the first translation table. The
+                tables are read-only from then on, and may be shared between threads.
+                \return true.
+             */
+            static bool initTables();
+
             //! Scan container looking for value, returning key
             template<typename Key, typename Val>
             Key reverseLookup( std::map<Key, Val>& c, Val v ) {
@@ -80,18 +84,33 @@ namespace sosicon {
                 else return mCoordSysTable[ 0 ];
             };
 
-            ElementType sosiNameToType( std::string typeName ) {
-                try { return mTypeNameMap[ mSosiCharset->toIso8859_1( typeName ) ]; }
-                catch( ... ) { return sosi_element_unknown; }
+            CoordSys& sridToCoordSys( std::string srid ) {
+                for( int i = 1; i <= MAX_COORDSYS_TABLE; i++ ) {
+                    if( mCoordSysTable[ i ].valid() && mCoordSysTable[ i ].srid() == srid ) return mCoordSysTable[ i ];
+                }
+                return mCoordSysTable[ 0 ];
+            };
+
+            //! Element type from element name
+            /*!
+                \param typeName Element name, converted to ISO8859-1 (see SosiCharset).
+             */
+            ElementType sosiNameToType( const std::string& typeName ) {
+                std::map<std::string, ElementType>::const_iterator i = mTypeNameMap.find( typeName );
+                return i == mTypeNameMap.end() ? sosi_element_unknown : i->second;
             };
 
             std::string sosiTypeToName( ElementType elementType ) {
                 return reverseLookup<std::string, ElementType>( mTypeNameMap, elementType );
             };
 
-            ObjType sosiObjNameToType( std::string objTypeName ) {
-                try { return mObjTypeNameMap[ mSosiCharset->toIso8859_1( objTypeName ) ]; }
-                catch( ... ) { return sosi_objtype_unknown; }
+            //! Object type from OBJTYPE name
+            /*!
+                \param objTypeName OBJTYPE name, converted to ISO8859-1 (see SosiCharset).
+             */
+            ObjType sosiObjNameToType( const std::string& objTypeName ) {
+                std::map<std::string, ObjType>::const_iterator i = mObjTypeNameMap.find( objTypeName );
+                return i == mObjTypeNameMap.end() ? sosi_objtype_unknown : i->second;
             };
 
             std::string sosiTypeToObjName( ObjType objType ) {
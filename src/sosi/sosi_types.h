@@ -18,7 +18,6 @@
 #ifndef __SOSI_TYPES_H__
 #define __SOSI_TYPES_H__
 
-#include "../interface/i_coordinate.h"
 #include <string>
 #include <vector>
 #include <map>
@@ -148,6 +147,19 @@ namespace sosicon {
             bool subtract;       //!< Parenthesis = subtract shape.
         };
 
+        //! SOSI file header settings
+        /*!
+            The settings of HeaderContext that are read from the file itself, as stored in
+            binary caches.
+         */
+        struct HeaderSettings {
+            int origoN;          //!< Origo north, in file units
+            int origoE;          //!< Origo east, in file units
+            int divisor;         //!< Units per metre (inverse of ENHET)
+            int sysCode;         //!< SOSI KOORDSYS code, or 0
+            int sourceSrid;      //!< EPSG code of the source grid, or 0
+        };
+
         //! SOSI coordinate system
         class CoordSys {
 
@@ -184,6 +196,42 @@ namespace sosicon {
         //! Collection of SOSI reference lists
         typedef std::vector<GeometryRef*> GeometryCollection;
 
+        //! Coordinate values of N or NH element
+        /*!
+            Integer values exactly as given in the SOSI file, before unit and origo are applied.
+            Each coordinate occupies two (north, east) or three (north, east, height) consecutive
+            entries.
+         */
+        typedef std::vector<long long> NorthEastArray;
+
+        //! Read-only view of coordinate values
+        /*!
+            Refers to the values of a N or NH element as stored in the element table. Laid
+            out like NorthEastArray.
+         */
+        struct NorthEastSpan {
+            const long long* values;    //!< First value
+            size_t size;                //!< Number of values
+            bool empty() const { return 0 == size; }
+        };
+
+        //! Get number of values per coordinate of element
+        /*!
+            The element name is taken as it is stored, so  may be given in ISO8859 (one
+            byte) or UTF-8 (two bytes), depending on TEGNSETT of the file.
+            \param elementName SOSI element name.
+            \return 2 for N, 3 for NH, 0 for any other element.
+         */
+        inline int northEastDimension( const std::string& elementName ) {
+            if( elementName == "N\xD8" || elementName == "N\xC3\x98" ) {
+                return 2;
+            }
+            if( elementName == "N\xD8H" || elementName == "N\xC3\x98H" ) {
+                return 3;
+            }
+            return 0;
+        }
+
        /*! @} end group sosi_elements */
 
     } // namespace sosi
@@ -0,0 +1,187 @@
+/*
+ *  This file is part of the command-line tool sosicon.
+ *  Copyright (C) 2014  Espen Andersen, Norwegian Broadcast Corporation (NRK)
+ *
+ *  This is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "sosi_cache.h"
+
+sosicon::SosiCache::
+SosiCache( std::string sourceFile ) {
+    mSourceFile = sourceFile;
+    mCacheFile = cacheFileName( sourceFile );
+    memset( &mHeader, 0, sizeof mHeader );
+}
+
+sosicon::SosiCache::
+~SosiCache() {
+    if( mOutput.is_open() ) {
+        discard();
+    }
+}
+
+std::string sosicon::SosiCache::
+cacheFileName( std::string sourceFile ) {
+    std::string::size_type n = sourceFile.size();
+    if( n > 4 && utils::toLower( sourceFile.substr( n - 4 ) ) == ".sos" ) {
+        return sourceFile + "c";
+    }
+    return sourceFile + ".sosc";
+}
+
+bool sosicon::SosiCache::
+fingerprint( const char* sourceBegin, const char* sourceEnd, bool hashContent ) {
+    long long size = 0, mtime = 0;
+    if( !utils::fileStatus( mSourceFile, size, mtime ) ||
+        size != static_cast<long long>( sourceEnd - sourceBegin ) )
+    {
+        return false;
+    }
+    memcpy( mHeader.magic, "SOSC", 4 );
+    mHeader.version = VERSION;
+    mHeader.sourceSize = static_cast<unsigned long long>( size );
+    mHeader.sourceMtime = mtime;
+    if( hashContent ) {
+        mHeader.sourceHash = utils::hash64( sourceBegin, sourceEnd );
+        mHeader.flags |= FLAG_HASHED;
+    }
+    return true;
+}
+
+bool sosicon::SosiCache::
+open( const char* sourceBegin, const char* sourceEnd, bool verifyContent ) {
+    if( !utils::fileExists( mCacheFile ) || !mMappedCache.open( mCacheFile ) ||
+        mMappedCache.size() < arenaOffset() )
+    {
+        return false;
+    }
+    memcpy( &mHeader, mMappedCache.begin(), sizeof mHeader );
+
+    // The sections must fill the file exactly, which also rules out a truncated cache.
+    const unsigned long long maxElements = 0x7fffffff;
+    bool valid = memcmp( mHeader.magic, "SOSC", 4 ) == 0 && mHeader.version == VERSION &&
+                 mHeader.elementCount < maxElements &&
+                 mHeader.arenaBytes <= mMappedCache.size() &&
+                 mHeader.indexCount <= mMappedCache.size() / sizeof( IndexEntry ) &&
+                 indexOffset() + mHeader.indexCount * sizeof( IndexEntry ) == mMappedCache.size() &&
+                 mHeader.sourceSize == static_cast<unsigned long long>( sourceEnd - sourceBegin );
+
+    // Size and modification time are trusted by default. The content hash costs a pass over
+    // the whole source file, and is only compared on request.
+    long long size = 0, mtime = 0;
+    valid = valid && utils::fileStatus( mSourceFile, size, mtime ) && mtime == mHeader.sourceMtime;
+    if( valid && verifyContent ) {
+        valid = ( mHeader.flags & FLAG_HASHED ) && utils::hash64( sourceBegin, sourceEnd ) == mHeader.sourceHash;
+    }
+    if( !valid ) {
+        mMappedCache.close();
+        memset( &mHeader, 0, sizeof mHeader );
+    }
+    return valid;
+}
+
+bool sosicon::SosiCache::
+create( const char* sourceBegin, const char* sourceEnd, bool hashContent ) {
+    if( !fingerprint( sourceBegin, sourceEnd, hashContent ) ) {
+        return false;
+    }
+    mTempFile = mCacheFile + ".tmp";
+    mRecordFile = mCacheFile + ".rec.tmp";
+    mOutput.open( mTempFile.c_str(), std::ios::out | std::ios::binary | std::ios::trunc );
+    mRecords.open( mRecordFile.c_str(), std::ios::out | std::ios::binary | std::ios::trunc );
+    if( !mOutput.is_open() || !mRecords.is_open() ) {
+        discard();
+        return false;
+    }
+
+    // Placeholder header, so that an unfinished cache is never mistaken for a valid one.
+    std::vector<char> placeholder( arenaOffset(), 0 );
+    mOutput.write( &placeholder[ 0 ], placeholder.size() );
+    return true;
+}
+
+void sosicon::SosiCache::
+discard() {
+    mOutput.close();
+    mRecords.close();
+    std::remove( mTempFile.c_str() );
+    std::remove( mRecordFile.c_str() );
+}
+
+void sosicon::SosiCache::
+write( sosi::SosiElement* feature ) {
+    if( !mOutput.is_open() ) {
+        return;
+    }
+    mFeatureRecords.clear();
+    mFeatureArena.clear();
+    const int position = static_cast<int>( mHeader.elementCount ) + 1;
+    sosi::SosiElementTable::exportSubtree( feature, position, 0, mHeader.arenaBytes, mFeatureRecords, mFeatureArena );
+
+    for( size_t i = 0; i < mFeatureRecords.size(); i++ ) {
+        const sosi::SosiElementTable::ImageRecord& r = mFeatureRecords[ i ];
+        const char* serial = mFeatureArena.empty() ? 0 : &mFeatureArena[ 0 ] + ( r.serialOffset - mHeader.arenaBytes );
+        IndexEntry entry;
+        if( r.serialLength > 0 && sosi::SosiElementIndex::parseSerial( serial, serial + r.serialLength, entry.serial ) ) {
+            entry.position = position + static_cast<long long>( i );
+            mIndex.push_back( entry );
+        }
+    }
+
+    if( !mFeatureArena.empty() ) {
+        mOutput.write( &mFeatureArena[ 0 ], mFeatureArena.size() );
+    }
+    mRecords.write( reinterpret_cast<const char*>( &mFeatureRecords[ 0 ] ), mFeatureRecords.size() * sizeof( sosi::SosiElementTable::ImageRecord ) );
+    mHeader.arenaBytes += mFeatureArena.size();
+    mHeader.elementCount += mFeatureRecords.size();
+}
+
+bool sosicon::SosiCache::
+commit( int lineCount, const sosi::HeaderSettings& settings, const std::string& charset ) {
+    if( !mOutput.is_open() ) {
+        return false;
+    }
+    mHeader.lineCount = static_cast<unsigned long long>( lineCount );
+    mHeader.settings = settings;
+    charset.copy( mHeader.charset, sizeof( mHeader.charset ) - 1 );
+    mHeader.indexCount = mIndex.size();
+
+    static const char padding[ 8 ] = { 0 };
+    mOutput.write( padding, align( mHeader.arenaBytes ) - mHeader.arenaBytes );
+    mRecords.close();
+    std::ifstream records( mRecordFile.c_str(), std::ios::in | std::ios::binary );
+    if( mHeader.elementCount > 0 ) {
+        mOutput << records.rdbuf();
+    }
+    records.close();
+    if( !mIndex.empty() ) {
+        mOutput.write( reinterpret_cast<const char*>( &mIndex[ 0 ] ), mIndex.size() * sizeof( IndexEntry ) );
+    }
+    bool complete = mOutput.good() && static_cast<unsigned long long>( mOutput.tellp() ) ==
+                    indexOffset() + mIndex.size() * sizeof( IndexEntry );
+    mOutput.seekp( 0 );
+    mOutput.write( reinterpret_cast<const char*>( &mHeader ), sizeof mHeader );
+    mOutput.close();
+    std::remove( mRecordFile.c_str() );
+    if( mOutput.fail() || !complete ) {
+        std::remove( mTempFile.c_str() );
+        return false;
+    }
+    std::remove( mCacheFile.c_str() );
+    if( std::rename( mTempFile.c_str(), mCacheFile.c_str() ) != 0 ) {
+        std::remove( mTempFile.c_str() );
+        return false;
+    }
+    return true;
+}
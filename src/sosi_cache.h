@@ -0,0 +1,254 @@
+/*
+ *  This file is part of the command-line tool sosicon.
+ *  Copyright (C) 2014  Espen Andersen, Norwegian Broadcast Corporation (NRK)
+ *
+ *  This is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __SOSI_CACHE_H__
+#define __SOSI_CACHE_H__
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "utils.h"
+#include "mapped_file.h"
+#include "sosi/sosi_element.h"
+#include "sosi/sosi_element_index.h"
+#include "sosi/sosi_element_table.h"
+#include "sosi/sosi_types.h"
+
+namespace sosicon {
+
+    //! Binary cache of parsed SOSI file
+    /*!
+        \author Espen Andersen
+        \copyright GNU General Public License
+
+        Reads and writes the sidecar file (.sosc) holding the parsed element tree of a SOSI
+        file. Loading the cache is much faster than parsing the SOSI text, so repeated
+        conversions of the same file only pay for parsing once. The cache is bound to the
+        source file by its size, modification time and content hash, and is ignored when any
+        of them differs. The content hash may be left out (-cachenohash), which saves a pass
+        over the source file.
+
+        The file is written in native byte order, and is an image of the element table (see
+        SosiElementTable::ImageRecord): a fixed-size header, the arena holding names, serial
+        numbers, data and decoded N/NH coordinate values, one fixed-size record per element
+        in pre-order (file order), and the serial number index. The header also holds the
+        header context settings (origo, unit, coordinate system) and character set of the
+        file. Sections are 8-byte aligned, so that the records and the arena are used in
+        place from the memory-mapped cache.
+     */
+    class SosiCache {
+
+    public:
+
+        //! Serial number index entry
+        struct IndexEntry {
+            long long serial;                   //!< Serial number
+            long long position;                 //!< Position of the element in the image
+        };
+
+    private:
+
+        //! Cache file header
+        struct Header {
+            char magic[ 4 ];                    //!< "SOSC"
+            unsigned int version;               //!< Cache format version
+            unsigned long long sourceSize;      //!< Size of the SOSI file
+            long long sourceMtime;              //!< Modification time of the SOSI file
+            unsigned long long sourceHash;      //!< Content hash of the SOSI file, if FLAG_HASHED
+            unsigned int flags;                 //!< FLAG_XXX
+            unsigned int reserved;              //!< Padding, always 0
+            unsigned long long lineCount;       //!< Number of lines in the SOSI file
+            unsigned long long elementCount;    //!< Number of element records, root not included
+            unsigned long long arenaBytes;      //!< Size of the arena
+            unsigned long long indexCount;      //!< Number of index entries
+            sosi::HeaderSettings settings;      //!< Header context settings of the SOSI file
+            char charset[ 32 ];                 //!< Character set name (TEGNSETT), or empty
+        };
+
+        //! Current cache format version
+        static const unsigned int VERSION = 2;
+
+        //! Header flag: sourceHash is set
+        static const unsigned int FLAG_HASHED = 1;
+
+        //! Path to the SOSI file
+        std::string mSourceFile;
+
+        //! Path to the cache file
+        std::string mCacheFile;
+
+        //! Path to the cache file while being written
+        std::string mTempFile;
+
+        //! Path to the element records while the cache is being written
+        std::string mRecordFile;
+
+        //! Header of cache being read or written
+        Header mHeader;
+
+        //! Mapped cache file when reading
+        MappedFile mMappedCache;
+
+        //! Cache file when writing
+        /*!
+            Receives the header and the arena. The element records are written to mRecords,
+            and appended to the cache file by commit().
+         */
+        std::ofstream mOutput;
+
+        //! Element records when writing
+        std::ofstream mRecords;
+
+        //! Serial number index when writing
+        std::vector<IndexEntry> mIndex;
+
+        //! Records of the feature being written
+        std::vector<sosi::SosiElementTable::ImageRecord> mFeatureRecords;
+
+        //! Arena of the feature being written
+        std::vector<char> mFeatureArena;
+
+        //! Round size up to 8-byte alignment
+        static unsigned long long align( unsigned long long size ) { return ( size + 7 ) & ~7ULL; }
+
+        //! Offset of the arena in the cache file
+        static unsigned long long arenaOffset() { return align( sizeof( Header ) ); }
+
+        //! Offset of the element records in the cache file
+        unsigned long long recordOffset() const { return arenaOffset() + align( mHeader.arenaBytes ); }
+
+        //! Offset of the serial number index in the cache file
+        unsigned long long indexOffset() const { return recordOffset() + mHeader.elementCount * sizeof( sosi::SosiElementTable::ImageRecord ); }
+
+        //! Fill mHeader with the fingerprint of the source file
+        /*!
+            \param hashContent If true, the content hash is computed as well.
+         */
+        bool fingerprint( const char* sourceBegin, const char* sourceEnd, bool hashContent );
+
+        //! Remove temporary files of a cache being written
+        void discard();
+
+        //! No copying of caches
+        SosiCache( const SosiCache& );
+
+        //! No copying of caches
+        SosiCache& operator=( const SosiCache& );
+
+    public:
+
+        //! Constructor
+        /*!
+            \param sourceFile Path to the SOSI file. The cache file is located next to it.
+         */
+        SosiCache( std::string sourceFile );
+
+        //! Destructor
+        /*!
+            Discards a cache file that was created, but never committed.
+         */
+        ~SosiCache();
+
+        //! Get path to the cache file of a SOSI file
+        /*!
+            Replaces the .sos extension by .sosc, or appends .sosc if the file has another
+            extension.
+         */
+        static std::string cacheFileName( std::string sourceFile );
+
+        //! Get path to the cache file
+        const std::string& cacheFile() const { return mCacheFile; };
+
+        //! Open existing cache for reading
+        /*!
+            Checks the cache header only. The records are checked as they are loaded, see
+            SosiElementTable::appendImage().
+            \param sourceBegin Pointer to the first byte of the SOSI file.
+            \param sourceEnd Pointer to one past the last byte of the SOSI file.
+            \param verifyContent If true, the cache must hold a content hash equal to that of
+                   the SOSI file. Otherwise only its size and modification time are compared.
+            \return False if there is no cache, or if it is not valid for the SOSI file.
+         */
+        bool open( const char* sourceBegin, const char* sourceEnd, bool verifyContent );
+
+        //! Get element records, root not included
+        /*!
+            The first record is at position 1 of the image.
+         */
+        const sosi::SosiElementTable::ImageRecord* records() const {
+            return reinterpret_cast<const sosi::SosiElementTable::ImageRecord*>( mMappedCache.begin() + recordOffset() );
+        };
+
+        //! Get number of element records
+        int recordCount() const { return static_cast<int>( mHeader.elementCount ); };
+
+        //! Get arena holding texts and coordinates of the elements
+        const char* arena() const { return mMappedCache.begin() + arenaOffset(); };
+
+        //! Get size of arena in bytes
+        unsigned long long arenaSize() const { return mHeader.arenaBytes; };
+
+        //! Get serial number index
+        const IndexEntry* index() const {
+            return reinterpret_cast<const IndexEntry*>( mMappedCache.begin() + indexOffset() );
+        };
+
+        //! Get number of serial number index entries
+        size_t indexCount() const { return static_cast<size_t>( mHeader.indexCount ); };
+
+        //! Get header context settings of the SOSI file
+        const sosi::HeaderSettings& headerSettings() const { return mHeader.settings; };
+
+        //! Get character set name of the SOSI file
+        std::string charsetName() const { return std::string( mHeader.charset, strnlen( mHeader.charset, sizeof( mHeader.charset ) ) ); };
+
+        //! Get number of lines in the SOSI file, as recorded when the cache was written
+        int lineCount() const { return static_cast<int>( mHeader.lineCount ); };
+
+        //! Start writing new cache
+        /*!
+            The cache is written to a temporary file, which replaces the cache file on commit().
+            \param sourceBegin Pointer to the first byte of the SOSI file.
+            \param sourceEnd Pointer to one past the last byte of the SOSI file.
+            \param hashContent If true, a content hash of the SOSI file is stored, so that the
+                   cache may be verified by content.
+            \return False if the cache file could not be created.
+         */
+        bool create( const char* sourceBegin, const char* sourceEnd, bool hashContent );
+
+        //! Append top-level element
+        /*!
+            Writes the element and its children. Top-level elements must be written in file
+            order.
+         */
+        void write( sosi::SosiElement* feature );
+
+        //! Finish writing cache
+        /*!
+            \param lineCount Number of lines in the SOSI file.
+            \param settings Header context settings of the SOSI file.
+            \param charset Character set name of the SOSI file, or empty.
+            \return False if the cache could not be written.
+         */
+        bool commit( int lineCount, const sosi::HeaderSettings& settings, const std::string& charset );
+
+    };
+};
+
+#endif
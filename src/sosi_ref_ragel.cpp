@@ -199,7 +199,7 @@ _match:
                 geomRef = new GeometryRef();
                 mRefListCollection.push_back( geomRef );
             }
-            geomRef->insert( geomRef->begin(), refData );
+            geomRef->push_back( refData );
         }
 	break;
 	case 1:
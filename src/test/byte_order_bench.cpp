@@ -0,0 +1,185 @@
+/*
+ *  This file is part of the command-line tool sosicon.
+ *  Copyright (C) 2014  Espen Andersen, Norwegian Broadcast Corporation (NRK)
+ *
+ *  This is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Microbenchmark of the compile-time byte order encoders in byte_order.h, against the
+// runtime conversion they replaced. Build and run with "make bench".
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include "../byte_order.h"
+
+namespace legacy {
+
+    // Runtime conversion as used by the shapefile writer before the compile-time encoders
+
+    enum Endianness { not_set, big, little } endianness = not_set;
+
+    Endianness determine() {
+        if( not_set == endianness ) {
+            union {
+                uint32_t i;
+                char b[ 4 ];
+            } test = { 0x01000000 };
+            endianness = test.b[ 0 ] == 1 ? big : little;
+        }
+        return endianness;
+    }
+
+    void toBigEndian( const char* from, char* to, size_t bufSize ) {
+        std::copy( from, from + bufSize, to );
+        if( determine() == little ) {
+            std::reverse( to, to + bufSize );
+        }
+    }
+
+    void doubleToLittleEndian( double from, char* to ) {
+        uint8_t sign = 0;
+        uint16_t exponent = 0;
+        uint64_t fraction = 0;
+        const uint16_t exp_base = 0x03ff;
+        double dbl = from;
+        if( std::signbit( dbl ) ) {
+            sign = 1;
+            dbl = -dbl;
+        }
+        if( std::isinf( dbl ) ) {
+            exponent = 0x7ff;
+        }
+        else if( std::isnan( dbl ) ) {
+            exponent = 0x7ff;
+            fraction = 0x8000000000000;
+        }
+        else {
+            int e;
+            double f = frexp( dbl, &e );
+            exponent = int16_t( e + exp_base - 1 );
+            unsigned bits = 0;
+            while( f ) {
+                f *= 2;
+                fraction <<= 1;
+                if( 1 <= f ) {
+                    fraction |= 1;
+                    f -= 1;
+                }
+                bits++;
+            }
+            fraction = ( fraction << ( 53 - bits ) ) & ( ( uint64_t( 1 ) << 52 ) - 1 );
+        }
+        uint8_t data[ sizeof( double ) ];
+        for( unsigned i = 0; i < 6; ++i ) {
+            data[ i ] = fraction & 0xff;
+            fraction >>= 8;
+        }
+        data[ 6 ] = ( exponent << 4 ) | static_cast< uint8_t >( fraction );
+        data[ 7 ] = ( sign << 7 ) | ( exponent >> 4 );
+        double result;
+        memcpy( &result, data, sizeof( double ) );
+        if( result != from && ( std::isnan( from ) != std::isnan( result ) ) ) {
+            std::reverse( data, data + sizeof( double ) );
+        }
+        std::copy( data, data + sizeof( double ), to );
+    }
+};
+
+namespace {
+
+    typedef std::chrono::steady_clock Clock;
+
+    const size_t COUNT = 4000000;
+    const int ROUNDS = 5;
+
+    // Best of ROUNDS runs, in nanoseconds per value
+    template<typename F>
+    double measure( F f ) {
+        double best = 0;
+        for( int r = 0; r < ROUNDS; r++ ) {
+            Clock::time_point t0 = Clock::now();
+            f();
+            double ns = std::chrono::duration<double, std::nano>( Clock::now() - t0 ).count() / COUNT;
+            best = r == 0 ? ns : std::min( best, ns );
+        }
+        return best;
+    }
+
+    void report( const char* name, double ns, double baseline ) {
+        printf( "  %-40s %7.2f ns/value %8.1fx\n", name, ns, baseline / ns );
+    }
+
+    bool same( const std::vector<char>& a, const std::vector<char>& b ) {
+        return a.size() == b.size() && memcmp( a.data(), b.data(), a.size() ) == 0;
+    }
+};
+
+int main() {
+
+    // Coordinates in the UTM range, like the vertices of a shapefile
+    std::vector<double> coords( COUNT );
+    std::vector<int32_t> ints( COUNT );
+    for( size_t i = 0; i < COUNT; i++ ) {
+        coords[ i ] = ( i % 2 ? 6600000.0 : 250000.0 ) + ( i * 7919 % 100000 ) / 100.0;
+        ints[ i ] = static_cast<int32_t>( i * 2654435761u );
+    }
+    std::vector<char> legacyOut( COUNT * 8 ), scalarOut( COUNT * 8 ), bulkOut( COUNT * 8 );
+
+    printf( "%u values, best of %d rounds\n\n", static_cast<unsigned>( COUNT ), ROUNDS );
+
+    printf( "double, little endian (shp coordinates)\n" );
+    double base = measure( [ & ]() {
+        for( size_t i = 0; i < COUNT; i++ ) {
+            legacy::doubleToLittleEndian( coords[ i ], &legacyOut[ i * 8 ] );
+        }
+    } );
+    double scalar = measure( [ & ]() {
+        for( size_t i = 0; i < COUNT; i++ ) {
+            sosicon::byteOrder::toLittleEndian( coords[ i ], &scalarOut[ i * 8 ] );
+        }
+    } );
+    double bulk = measure( [ & ]() {
+        sosicon::byteOrder::toLittleEndian( coords.data(), COUNT, &bulkOut[ 0 ] );
+    } );
+    report( "legacy doubleToLittleEndian", base, base );
+    report( "byteOrder::toLittleEndian( double )", scalar, base );
+    report( "byteOrder::toLittleEndian( array )", bulk, base );
+    bool ok = same( legacyOut, scalarOut ) && same( legacyOut, bulkOut );
+
+    printf( "\nint32, big endian (shp record headers)\n" );
+    base = measure( [ & ]() {
+        for( size_t i = 0; i < COUNT; i++ ) {
+            legacy::toBigEndian( reinterpret_cast<const char*>( &ints[ i ] ), &legacyOut[ i * 4 ], 4 );
+        }
+    } );
+    scalar = measure( [ & ]() {
+        for( size_t i = 0; i < COUNT; i++ ) {
+            sosicon::byteOrder::toBigEndian( ints[ i ], &scalarOut[ i * 4 ] );
+        }
+    } );
+    bulk = measure( [ & ]() {
+        sosicon::byteOrder::toBigEndian( ints.data(), COUNT, &bulkOut[ 0 ] );
+    } );
+    report( "legacy toBigEndian", base, base );
+    report( "byteOrder::toBigEndian( int32_t )", scalar, base );
+    report( "byteOrder::toBigEndian( array )", bulk, base );
+    ok = ok && same( legacyOut, scalarOut ) && same( legacyOut, bulkOut );
+
+    printf( "\n%s\n", ok ? "Output identical" : "OUTPUT DIFFERS" );
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,47 @@
+#!/bin/sh
+#
+#  This file is part of the command-line tool sosicon.
+#  Copyright (C) 2014  Espen Andersen, Norwegian Broadcast Corporation (NRK)
+#
+#  This is free software: you can redistribute it and/or modify
+#  it under the terms of the GNU General Public License as published by
+#  the Free Software Foundation, either version 3 of the License, or
+#  (at your option) any later version.
+#
+#  This program is distributed in the hope that it will be useful,
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#  GNU General Public License for more details.
+#
+#  You should have received a copy of the GNU General Public License
+#  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#
+#  Regression tests. Usage: run_tests.sh <path to sosicon binary>
+
+SOSICON=$1
+DATA=$(cd "$(dirname "$0")/data" && pwd)
+WORK=$(mktemp -d)
+FAILED=0
+
+trap 'rm -rf "$WORK"' EXIT
+
+check() {
+    if grep -q -- "$3" "$2"; then
+        echo "ok     $1"
+    else
+        echo "FAILED $1: expected $3 in $2"
+        FAILED=1
+    fi
+}
+
+cd "$WORK" || exit 1
+
+# A counter-clockwise KURVE (0,0) (1,0) (1,1) must keep its digitised direction
+"$SOSICON" -2tsv -o curve.tsv "$DATA/ccw_curve.sos" < /dev/null > /dev/null
+check "tsv curve direction" curve.tsv "LINESTRING(0.00000 0.00000,1.00000 0.00000,1.00000 1.00000)"
+"$SOSICON" -2xml -o curve.xml "$DATA/ccw_curve.sos" < /dev/null > /dev/null
+check "gml curve direction" curve.xml "posList>0.00000 0.00000 1.00000 0.00000 1.00000 1.00000<"
+"$SOSICON" -2geojson -srid 25832 -o curve.geojson "$DATA/ccw_curve.sos" < /dev/null > /dev/null
+check "geojson curve direction" curve.geojson '"coordinates":\[\[0.00,0.00\],\[1.00,0.00\],\[1.00,1.00\]\]'
+
+exit $FAILED
@@ -16,6 +16,7 @@
  *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include "utils.h"
+#include <cmath>
 
 using std::string;
 
@@ -79,6 +80,55 @@ isNumeric( const std::string& str ) {
     return true;
 }
 
+void sosicon::utils::
+appendFixed( std::string& str, double value, int decimals ) {
+    static const double scale[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9 };
+    double scaled = decimals >= 0 && decimals <= 9 ? std::fabs( value ) * scale[ decimals ] : 0.0;
+    if( !( scaled < 1e12 ) || decimals < 0 || decimals > 9 ) {
+        // Beyond exact rounding of the scaled value, infinite or NaN
+        std::ostringstream ss;
+        ss.precision( decimals );
+        ss << std::fixed << value;
+        str += ss.str();
+        return;
+    }
+    unsigned long long n = static_cast<unsigned long long>( scaled + 0.5 );
+    char buf[ 32 ];
+    char* p = buf + sizeof( buf );
+    for( int i = 0; i < decimals; i++ ) {
+        *--p = static_cast<char>( '0' + n % 10 );
+        n /= 10;
+    }
+    if( decimals > 0 ) {
+        *--p = '.';
+    }
+    do {
+        *--p = static_cast<char>( '0' + n % 10 );
+        n /= 10;
+    } while( n > 0 );
+    if( std::signbit( value ) ) {
+        *--p = '-';
+    }
+    str.append( p, buf + sizeof( buf ) - p );
+}
+
+string sosicon::utils::
+iso8859_1ToUtf8( const std::string& str ) {
+    string res;
+    res.reserve( str.size() );
+    for( string::size_type i = 0; i < str.size(); i++ ) {
+        unsigned char c = static_cast<unsigned char>( str[ i ] );
+        if( c < 0x80 ) {
+            res += static_cast<char>( c );
+        }
+        else {
+            res += static_cast<char>( 0xc0 | ( c >> 6 ) );
+            res += static_cast<char>( 0x80 | ( c & 0x3f ) );
+        }
+    }
+    return res;
+}
+
 void sosicon::utils::
 asciify( char* str ) {
     static unsigned char const transcodingTable[ 256 ] = {
@@ -221,6 +271,40 @@ sqlNormalize( const std::string &str )
     return res;
 }
 
+std::string sosicon::utils::
+copyNormalize( const std::string &str, bool escape )
+{
+    std::string tmp = trim( str );
+    std::string::size_type len = tmp.length();
+    if( len > 2 && tmp.at( 0 ) == '\"' && tmp.at( len - 1 ) == '\"' ) {
+        tmp = tmp.substr( 1, len - 2 );
+    }
+    if( !escape ) {
+        return tmp;
+    }
+    std::string res;
+    for( std::string::size_type n = 0; n < tmp.length(); n++ ) {
+        char c = tmp.at( n );
+        switch( c ) {
+            case '\\':
+                res += "\\\\";
+                break;
+            case '\t':
+                res += "\\t";
+                break;
+            case '\n':
+                res += "\\n";
+                break;
+            case '\r':
+                res += "\\r";
+                break;
+            default:
+                res += c;
+        }
+    }
+    return res;
+}
+
 string sosicon::utils::
 toFieldname( const std::string &str )
 {
@@ -397,3 +481,20 @@ wktToStr( Wkt wktGeom ) {
             return "";
     }
 }
+
+unsigned long long sosicon::utils::
+hash64( const char* begin, const char* end )
+{
+    const unsigned long long prime = 1099511628211ULL;
+    unsigned long long h = 14695981039346656037ULL;
+    while( end - begin >= 8 ) {
+        unsigned long long w;
+        memcpy( &w, begin, 8 );
+        h = ( h ^ w ) * prime;
+        begin += 8;
+    }
+    while( begin < end ) {
+        h = ( h ^ static_cast<unsigned char>( *begin++ ) ) * prime;
+    }
+    return h;
+}
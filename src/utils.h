@@ -64,6 +64,33 @@ namespace sosicon {
           return ( stat( name.c_str(), &buffer ) == 0 );
         }
 
+        //! Get file size and modification time
+        /*!
+            \param name Path to the file.
+            \param size Receives the file size in bytes.
+            \param mtime Receives the time of last modification, in seconds since the epoch.
+            \return False if the file does not exist.
+        */
+        inline bool fileStatus( const std::string& name, long long& size, long long& mtime ) {
+          struct stat buffer;
+          if( stat( name.c_str(), &buffer ) != 0 ) {
+              return false;
+          }
+          size = static_cast<long long>( buffer.st_size );
+          mtime = static_cast<long long>( buffer.st_mtime );
+          return true;
+        }
+
+        //! Compute 64-bit hash of buffer
+        /*!
+            FNV-1a variant processing eight bytes at a time. Fast enough to fingerprint large
+            files, but not suitable for cryptographic purposes.
+            \param begin Pointer to the first byte of the buffer.
+            \param end Pointer to one past the last byte of the buffer.
+            \return Hash value.
+        */
+        unsigned long long hash64( const char* begin, const char* end );
+
         //! Test if a string represents a numeric value
         /*!
             Returns true if the provided string contains numers only, and if the first
@@ -75,6 +102,28 @@ namespace sosicon {
         */
         bool isNumeric( const std::string& str );
 
+        //! Test if character is white space, as removed by trim()
+        inline bool isTrimChar( char c ) {
+            return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+        }
+
+        //! Append number in fixed-point notation
+        /*!
+            Gives the same result as std::fixed with the given precision, without the
+            overhead of a stream. Used for WKT coordinates in bulk output.
+            \param str The string to append to.
+            \param value The number.
+            \param decimals Number of decimals, 0 to 9.
+        */
+        void appendFixed( std::string& str, double value, int decimals );
+
+        //! Convert ISO8859-1 string to UTF-8
+        /*!
+            \param str ISO8859-1 encoded string, e.g. as returned by sosi::HeaderContext::toIso8859_1().
+            \return UTF-8 encoded copy of the string.
+        */
+        std::string iso8859_1ToUtf8( const std::string& str );
+
         //! Make acceptable ANSI version of string
         /*!
             Takes a ISO8859-1 encoded input string and replaces extended characters
@@ -150,6 +199,16 @@ namespace sosicon {
         */
         std::string sqlNormalize( const std::string &str );
 
+        //! Sanitizes PostgreSQL COPY data string.
+        /*!
+            Removes enclosing double quotes like sqlNormalize(), and escapes backslash, tab and
+            line break characters for use in a text format COPY data row.
+            \param str The target string.
+            \param escape Set to false for binary COPY data, which is not escaped.
+            \return A copy of the target string, with reserved characters escaped.
+        */
+        std::string copyNormalize( const std::string &str, bool escape = true );
+
         //! Remove trailing forward- and backward slashes from path component
         std::string stripTrailingSlash( const std::string &str );
 
@@ -0,0 +1,85 @@
+/*
+ *  This file is part of the command-line tool sosicon.
+ *  Copyright (C) 2014  Espen Andersen, Norwegian Broadcast Corporation (NRK)
+ *
+ *  This is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "wkb_writer.h"
+
+void sosicon::WkbWriter::
+writeHeader( Wkt wktGeom ) {
+    uint32_t type = 0;
+    switch( wktGeom ) {
+        case wkt_point:
+            type = 1;
+            break;
+        case wkt_linestring:
+            type = 2;
+            break;
+        case wkt_polygon:
+            type = 3;
+            break;
+        default:
+            break;
+    }
+    char buf[ 9 ];
+    buf[ 0 ] = 1; // Little endian
+    if( mSrid > 0 ) {
+        byteOrder::toLittleEndian( type | 0x20000000, &buf[ 1 ] ); // EWKB SRID flag
+        byteOrder::toLittleEndian( static_cast<uint32_t>( mSrid ), &buf[ 5 ] );
+        mBuffer.append( buf, 9 );
+    }
+    else {
+        byteOrder::toLittleEndian( type, &buf[ 1 ] );
+        mBuffer.append( buf, 5 );
+    }
+}
+
+void sosicon::WkbWriter::
+writeCount( size_t count ) {
+    char buf[ 4 ];
+    byteOrder::toLittleEndian( static_cast<uint32_t>( count ), buf );
+    mBuffer.append( buf, 4 );
+}
+
+void sosicon::WkbWriter::
+writeCoordinate( double x, double y ) {
+    const double point[ 2 ] = { x, y };
+    char buf[ 16 ];
+    byteOrder::toLittleEndian( point, 2, buf );
+    mBuffer.append( buf, 16 );
+}
+
+void sosicon::WkbWriter::
+writePoints( const GeometryBuffer& points, size_t begin, size_t end, bool close ) {
+    writeCount( end - begin + ( close ? 1 : 0 ) );
+    for( size_t i = begin; i < end; i++ ) {
+        writeCoordinate( points.x( i ), points.y( i ) );
+    }
+    if( close ) {
+        writeCoordinate( points.x( begin ), points.y( begin ) );
+    }
+}
+
+std::string sosicon::WkbWriter::
+hex() const {
+    static const char digits[] = "0123456789ABCDEF";
+    std::string res( mBuffer.size() * 2, '0' );
+    for( std::string::size_type i = 0; i < mBuffer.size(); i++ ) {
+        unsigned char b = static_cast<unsigned char>( mBuffer[ i ] );
+        res[ i * 2 ] = digits[ b >> 4 ];
+        res[ i * 2 + 1 ] = digits[ b & 0x0f ];
+    }
+    return res;
+}
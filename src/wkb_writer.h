@@ -0,0 +1,93 @@
+/*
+ *  This file is part of the command-line tool sosicon.
+ *  Copyright (C) 2014  Espen Andersen, Norwegian Broadcast Corporation (NRK)
+ *
+ *  This is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __WKB_WRITER_H__
+#define __WKB_WRITER_H__
+
+#include <string>
+#include <vector>
+#include "byte_order.h"
+#include "common_types.h"
+#include "geometry_buffer.h"
+
+namespace sosicon {
+
+    //! Well-known binary geometry builder
+    /*!
+        \author Espen Andersen
+        \copyright GNU General Public License
+
+        Serializes geometries to little endian WKB, or to PostGIS extended WKB (EWKB) if a
+        spatial reference ID is given. The caller writes the geometry structure piece by
+        piece: header, part counts and coordinates, in the order defined by the WKB
+        specification.
+     */
+    class WkbWriter {
+
+        //! Spatial reference ID, embedded in the geometry header if greater than zero
+        int mSrid;
+
+        //! Serialized geometry
+        std::string mBuffer;
+
+    public:
+
+        //! Constructor
+        /*!
+            \param srid Spatial reference ID to embed (EWKB), or 0 for plain WKB.
+         */
+        WkbWriter( int srid = 0 ) : mSrid( srid ) { }
+
+        //! Start new geometry
+        /*!
+            Writes byte order mark, geometry type and SRID (if any).
+            \param wktGeom Geometry type.
+         */
+        void writeHeader( Wkt wktGeom );
+
+        //! Write number of points in a linestring or ring, or number of rings in a polygon
+        void writeCount( size_t count );
+
+        //! Write one coordinate pair
+        void writeCoordinate( double x, double y );
+
+        //! Write points of linestring or polygon ring, preceded by the point count
+        /*!
+            \param points Vertex buffer.
+            \param begin Offset of the first vertex to write.
+            \param end Offset one past the last vertex to write.
+            \param close If true, the first vertex is repeated after the last one.
+         */
+        void writePoints( const GeometryBuffer& points, size_t begin, size_t end, bool close = false );
+
+        //! Write all points of the buffer, preceded by the point count
+        void writePoints( const GeometryBuffer& points ) { writePoints( points, 0, points.size() ); }
+
+        //! Discard buffer content
+        void clear() { mBuffer.clear(); }
+
+        //! Serialized geometry
+        const std::string& data() const { return mBuffer; }
+
+        //! Serialized geometry, hex encoded as accepted by PostGIS text input
+        std::string hex() const;
+
+    }; // class WkbWriter
+
+}; // namespace sosicon
+
+#endif